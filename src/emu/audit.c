@@ -28,6 +28,18 @@ media_auditor::media_auditor(const driver_enumerator &enumerator)
 		m_validation(AUDIT_VALIDATE_FULL),
 		m_searchpath(NULL)
 {
+	// remember hashes across audits of unchanged archives
+	hash_cache::open(m_enumerator.options());
+}
+
+
+//-------------------------------------------------
+//  ~media_auditor - destructor
+//-------------------------------------------------
+
+media_auditor::~media_auditor()
+{
+	hash_cache::close();
 }
 
 
@@ -289,9 +301,11 @@ media_auditor::summary media_auditor::audit_samples()
 			while (path.next(curpath, samplename))
 			{
 				// attempt to access the file (.flac) or (.wav)
+				osd_ticks_t start = osd_ticks();
 				file_error filerr = file.open(curpath, ".flac");
 				if (filerr != FILERR_NONE)
 					filerr = file.open(curpath, ".wav");
+				m_timing.open += osd_ticks() - start;
 
 				if (filerr == FILERR_NONE)
 				{
@@ -425,16 +439,35 @@ audit_record *media_auditor::audit_one_rom(const rom_entry *rom)
 	while (path.next(curpath, record.name()))
 	{
 		// open the file if we can
+		osd_ticks_t start = osd_ticks();
 		file_error filerr;
 		if (has_crc)
 			filerr = file.open(curpath, crc);
 		else
 			filerr = file.open(curpath);
+		m_timing.open += osd_ticks() - start;
 
 		// if it worked, get the actual length and hashes, then stop
 		if (filerr == FILERR_NONE)
 		{
+			m_timing.files++;
+
+			// asking for no hashes just picks up what is known already; only
+			// pull an archived file into memory if that is not enough
+			astring have;
+			file.hashes("").hash_types(have);
+			for (const char *scan = m_validation; *scan != 0; scan++)
+				if (have.chr(0, *scan) == -1)
+				{
+					start = osd_ticks();
+					file.load_archived();
+					m_timing.decompress += osd_ticks() - start;
+					break;
+				}
+
+			start = osd_ticks();
 			record.set_actual(file.hashes(m_validation), file.size());
+			m_timing.hash += osd_ticks() - start;
 			break;
 		}
 	}
@@ -456,11 +489,14 @@ audit_record *media_auditor::audit_one_disk(const rom_entry *rom, const char *lo
 
 	// open the disk
 	chd_file source;
+	osd_ticks_t start = osd_ticks();
 	chd_error err = chd_error(open_disk_image(m_enumerator.options(), &m_enumerator.driver(), rom, source, locationtag));
+	m_timing.open += osd_ticks() - start;
 
 	// if we succeeded, get the hashes
 	if (err == CHDERR_NONE)
 	{
+		m_timing.files++;
 		hash_collection hashes;
 
 		// if there's a SHA1 hash, add them to the output hash
@@ -598,3 +634,113 @@ audit_record::audit_record(const char *name, media_type type)
 		m_shared_device(NULL)
 {
 }
+
+
+
+//**************************************************************************
+//  AUDIT BATCH
+//**************************************************************************
+
+//-------------------------------------------------
+//  audit_batch - constructor; gathers the
+//  selected drivers and sets the workers going
+//-------------------------------------------------
+
+audit_batch::audit_batch(const driver_enumerator &enumerator, batch_type type, const char *validation)
+	: m_enumerator(enumerator),
+		m_type(type),
+		m_validation(validation),
+		m_results(NULL),
+		m_count(0),
+		m_position(-1),
+		m_lock(osd_lock_alloc()),
+		m_pool(*this)
+{
+	// results are stored in driver order so they can be reported that way
+	m_results = global_alloc_array(result, enumerator.count());
+	for (int index = 0; index < driver_list::total(); index++)
+		if (enumerator.included(index))
+			m_results[m_count++].index = index;
+	m_pool.start(m_count);
+}
+
+
+//-------------------------------------------------
+//  ~audit_batch - destructor
+//-------------------------------------------------
+
+audit_batch::~audit_batch()
+{
+	// stop handing out drivers and let the workers drain
+	m_pool.finish();
+	global_free(m_results);
+	osd_lock_free(m_lock);
+}
+
+
+//-------------------------------------------------
+//  next - advance to the next driver's result,
+//  waiting for its worker if needed; rethrows any
+//  fatal error raised while auditing it
+//-------------------------------------------------
+
+bool audit_batch::next()
+{
+	// at the end, make sure every worker has added in its timing
+	if (m_position + 1 >= m_count)
+	{
+		m_pool.finish();
+		return false;
+	}
+
+	if (!m_pool.wait(++m_position))
+		throw emu_fatalerror(m_pool.exitcode(m_position), "%s", m_pool.error(m_position));
+	return true;
+}
+
+
+//-------------------------------------------------
+//  work_begin - give a worker its own enumerator
+//  and auditor; machine configs are cached per
+//  enumerator, so they can't be shared
+//-------------------------------------------------
+
+void *audit_batch::work_begin()
+{
+	worker *state = global_alloc(worker);
+	state->enumerator = global_alloc(driver_enumerator(m_enumerator.options()));
+	state->auditor = global_alloc(media_auditor(*state->enumerator));
+	return state;
+}
+
+
+//-------------------------------------------------
+//  work_item - audit one driver
+//-------------------------------------------------
+
+void audit_batch::work_item(void *context, int index)
+{
+	worker &state = *reinterpret_cast<worker *>(context);
+	result &res = m_results[index];
+	state.enumerator->set_current(res.index);
+	res.summary = (m_type == BATCH_SAMPLES) ? state.auditor->audit_samples() : state.auditor->audit_media(m_validation);
+	if (res.summary != media_auditor::NOTFOUND)
+		state.auditor->summarize(state.enumerator->driver().name, &res.report);
+}
+
+
+//-------------------------------------------------
+//  work_end - fold a worker's timing into the
+//  total and free its state
+//-------------------------------------------------
+
+void audit_batch::work_end(void *context)
+{
+	worker *state = reinterpret_cast<worker *>(context);
+	osd_lock_acquire(m_lock);
+	m_timing += state->auditor->timing();
+	osd_lock_release(m_lock);
+	global_free(state->auditor);
+	global_free(state->enumerator);
+	global_free(state);
+}
@@ -15,6 +15,7 @@
 
 #include "drivenum.h"
 #include "hash.h"
+#include "workpool.h"
 
 
 
@@ -137,12 +138,26 @@ public:
 		NOTFOUND
 	};
 
+	// time spent in each stage of auditing files
+	struct stage_timing
+	{
+		stage_timing() : files(0), open(0), decompress(0), hash(0) { }
+		stage_timing &operator+=(const stage_timing &rhs) { files += rhs.files; open += rhs.open; decompress += rhs.decompress; hash += rhs.hash; return *this; }
+
+		UINT32              files;                  // number of files found
+		osd_ticks_t         open;                   // searching for and opening files
+		osd_ticks_t         decompress;             // loading archived files into memory
+		osd_ticks_t         hash;                   // computing hashes
+	};
+
 	// construction/destruction
 	media_auditor(const driver_enumerator &enumerator);
+	~media_auditor();
 
 	// getters
 	audit_record *first() const { return m_record_list.first(); }
 	int count() const { return m_record_list.count(); }
+	const stage_timing &timing() const { return m_timing; }
 
 	// audit operations
 	summary audit_media(const char *validation = AUDIT_VALIDATE_FULL);
@@ -163,6 +178,74 @@ private:
 	const driver_enumerator &   m_enumerator;
 	const char *                m_validation;
 	const char *                m_searchpath;
+	stage_timing                m_timing;
+};
+
+
+// ======================> audit_batch
+
+// audits every driver selected by an enumerator on a pool of worker
+// threads, handing the results back in driver order
+class audit_batch : public ordered_work_client
+{
+	DISABLE_COPYING(audit_batch);
+
+public:
+	// what to audit
+	enum batch_type
+	{
+		BATCH_MEDIA,
+		BATCH_SAMPLES
+	};
+
+	// construction/destruction
+	audit_batch(const driver_enumerator &enumerator, batch_type type, const char *validation = AUDIT_VALIDATE_FULL);
+	~audit_batch();
+
+	// getters for the current result
+	int current() const { return m_results[m_position].index; }
+	media_auditor::summary summary() const { return m_results[m_position].summary; }
+	const char *report() const { return m_results[m_position].report; }
+
+	// combined timing of all workers; complete once next() has returned false
+	const media_auditor::stage_timing &timing() const { return m_timing; }
+
+	// advance to the next result, waiting for it if necessary
+	bool next();
+
+private:
+	// the result of auditing one driver
+	struct result
+	{
+		result() : index(-1), summary(media_auditor::NOTFOUND) { }
+
+		int                     index;              // driver index
+		media_auditor::summary  summary;            // summary of the audit
+		astring                 report;             // text summary for display
+	};
+
+	// each worker's own enumerator and auditor
+	struct worker
+	{
+		driver_enumerator *     enumerator;
+		media_auditor *         auditor;
+	};
+
+	// ordered_work_client overrides
+	virtual void *work_begin();
+	virtual void work_item(void *context, int index);
+	virtual void work_end(void *context);
+
+	// internal state
+	const driver_enumerator &   m_enumerator;
+	batch_type                  m_type;
+	const char *                m_validation;
+	result *                    m_results;
+	int                         m_count;
+	int                         m_position;
+	osd_lock *                  m_lock;
+	ordered_work_pool           m_pool;
+	media_auditor::stage_timing m_timing;
 };
 
 
@@ -288,6 +288,16 @@ void cli_frontend::listxml(const char *gamename)
 	// create the XML and print it to stdout
 	info_xml_creator creator(drivlist);
 	creator.output(stdout);
+
+	// report timing on stderr so it stays out of the XML
+	if (m_options.verbose())
+	{
+		const info_xml_creator::output_timing &timing = creator.timing();
+		double scale = 1.0 / double(osd_ticks_per_second());
+		fprintf(stderr, "Generated %d drivers: config %.2fs, generate %.2fs (all threads); waiting %.2fs, devices %.2fs, total %.2fs\n",
+				timing.drivers, double(timing.config) * scale, double(timing.generate) * scale,
+				double(timing.wait) * scale, double(timing.devices) * scale, double(timing.total) * scale);
+	}
 }
 
 
@@ -436,18 +446,18 @@ void cli_frontend::listcrc(const char *gamename)
 		throw emu_fatalerror(MAMERR_NO_SUCH_GAME, "No matching games found for '%s'", gamename);
 
 	// iterate through matches, and then through ROMs
+	machine_info_cache cache(m_options);
 	while (drivlist.next())
 	{
-		device_iterator deviter(drivlist.config().root_device());
-		for (device_t *device = deviter.first(); device != NULL; device = deviter.next())
-			for (const rom_entry *region = rom_first_region(*device); region; region = rom_next_region(region))
-				for (const rom_entry *rom = rom_first_file(region); rom; rom = rom_next_file(rom))
-				{
-					// if we have a CRC, display it
-					UINT32 crc;
-					if (hash_collection(ROM_GETHASHDATA(rom)).crc(crc))
-						mame_printf_info("%08x %-16s \t %-8s \t %s\n", crc, ROM_GETNAME(rom), device->shortname(), device->name());
-				}
+		const machine_info &info = cache.get(drivlist);
+		for (int index = 0; index < info.roms(); index++)
+		{
+			// if we have a CRC, display it
+			UINT32 crc;
+			int device = info.rom_device(index);
+			if (hash_collection(info.rom_hashdata(index)).crc(crc))
+				mame_printf_info("%08x %-16s \t %-8s \t %s\n", crc, info.rom_name(index), info.device_shortname(device), info.device_name(device));
+		}
 	}
 }
 
@@ -465,10 +475,13 @@ void cli_frontend::listroms(const char *gamename)
 		throw emu_fatalerror(MAMERR_NO_SUCH_GAME, "No matching games found for '%s'", gamename);
 
 	// iterate through matches
+	machine_info_cache cache(m_options);
 	astring tempstr;
 	bool first = true;
 	while (drivlist.next())
 	{
+		const machine_info &info = cache.get(drivlist);
+
 		// print a header
 		if (!first)
 			mame_printf_info("\n");
@@ -477,40 +490,35 @@ void cli_frontend::listroms(const char *gamename)
 				"Name                    Size Checksum\n", drivlist.driver().name);
 
 		// iterate through roms
-		device_iterator deviter(drivlist.config().root_device());
-		for (device_t *device = deviter.first(); device != NULL; device = deviter.next())
-			for (const rom_entry *region = rom_first_region(*device); region; region = rom_next_region(region))
-				for (const rom_entry *rom = rom_first_file(region); rom; rom = rom_next_file(rom))
-				{
-					// accumulate the total length of all chunks
-					int length = -1;
-					if (ROMREGION_ISROMDATA(region))
-						length = rom_file_size(rom);
-
-					// start with the name
-					const char *name = ROM_GETNAME(rom);
-					mame_printf_info("%-20s ", name);
-
-					// output the length next
-					if (length >= 0)
-						mame_printf_info("%7d", length);
-					else
-						mame_printf_info("       ");
+		for (int index = 0; index < info.roms(); index++)
+		{
+			// the total length of all chunks, or -1 if not ROM data
+			int length = info.rom_length(index);
 
-					// output the hash data
-					hash_collection hashes(ROM_GETHASHDATA(rom));
-					if (!hashes.flag(hash_collection::FLAG_NO_DUMP))
-					{
-						if (hashes.flag(hash_collection::FLAG_BAD_DUMP))
-							mame_printf_info(" BAD");
-						mame_printf_info(" %s", hashes.macro_string(tempstr));
-					}
-					else
-						mame_printf_info(" NO GOOD DUMP KNOWN");
+			// start with the name
+			const char *name = info.rom_name(index);
+			mame_printf_info("%-20s ", name);
 
-					// end with a CR
-					mame_printf_info("\n");
-				}
+			// output the length next
+			if (length >= 0)
+				mame_printf_info("%7d", length);
+			else
+				mame_printf_info("       ");
+
+			// output the hash data
+			hash_collection hashes(info.rom_hashdata(index));
+			if (!hashes.flag(hash_collection::FLAG_NO_DUMP))
+			{
+				if (hashes.flag(hash_collection::FLAG_BAD_DUMP))
+					mame_printf_info(" BAD");
+				mame_printf_info(" %s", hashes.macro_string(tempstr));
+			}
+			else
+				mame_printf_info(" NO GOOD DUMP KNOWN");
+
+			// end with a CR
+			mame_printf_info("\n");
+		}
 	}
 }
 
@@ -558,13 +566,6 @@ void cli_frontend::listsamples(const char *gamename)
 //  referenced by a given game or set of games
 //-------------------------------------------------
 
-int cli_frontend::compare_devices(const void *i1, const void *i2)
-{
-	device_t *dev1 = *(device_t **)i1;
-	device_t *dev2 = *(device_t **)i2;
-	return strcmp(dev1->tag(), dev2->tag());
-}
-
 void cli_frontend::listdevices(const char *gamename)
 {
 	// determine which drivers to output; return an error if none found
@@ -573,31 +574,29 @@ void cli_frontend::listdevices(const char *gamename)
 		throw emu_fatalerror(MAMERR_NO_SUCH_GAME, "No matching games found for '%s'", gamename);
 
 	// iterate over drivers, looking for SAMPLES devices
+	machine_info_cache cache(m_options);
 	bool first = true;
 	while (drivlist.next())
 	{
+		const machine_info &info = cache.get(drivlist);
+
 		// print a header
 		if (!first)
 			printf("\n");
 		first = false;
 		printf("Driver %s (%s):\n", drivlist.driver().name, drivlist.driver().description);
 
-		// build a list of devices
-		device_iterator iter(drivlist.config().root_device());
-		dynamic_array<device_t *> device_list;
-		for (device_t *device = iter.first(); device != NULL; device = iter.next())
-			device_list.append(device);
-
-		// sort them by tag
-		qsort(&device_list[0], device_list.count(), sizeof(device_list[0]), compare_devices);
+		// get the devices sorted by tag
+		dynamic_array<int> device_list;
+		info.devices_by_tag(device_list);
 
 		// dump the results
 		for (int index = 0; index < device_list.count(); index++)
 		{
-			device_t *device = device_list[index];
+			int device = device_list[index];
 
 			// extract the tag, stripping the leading colon
-			const char *tag = device->tag();
+			const char *tag = info.device_tag(device);
 			if (*tag == ':')
 				tag++;
 
@@ -617,10 +616,10 @@ void cli_frontend::listdevices(const char *gamename)
 						depth++;
 					}
 			}
-			printf("   %*s%-*s%s", depth * 2, "", 24 - depth * 2, tag, device->name());
+			printf("   %*s%-*s%s", depth * 2, "", 24 - depth * 2, tag, info.device_name(device));
 
 			// add more information
-			UINT32 clock = device->clock();
+			UINT32 clock = info.device_clock(device);
 			if (clock >= 1000000000)
 				printf(" @ %d.%02d GHz\n", clock / 1000000000, (clock / 10000000) % 100);
 			else if (clock >= 1000000)
@@ -653,35 +652,29 @@ void cli_frontend::listslots(const char *gamename)
 	printf("----------  -----------  --------------  ----------------------\n");
 
 	// iterate over drivers
+	machine_info_cache cache(m_options);
 	while (drivlist.next())
 	{
-		// iterate
-		slot_interface_iterator iter(drivlist.config().root_device());
+		// iterate over the configurable slots
+		const machine_info &info = cache.get(drivlist);
 		bool first = true;
-		for (const device_slot_interface *slot = iter.first(); slot != NULL; slot = iter.next())
+		for (int slot = 0; slot < info.slots(); slot++)
 		{
-			if (slot->fixed()) continue;
 			// output the line, up to the list of extensions
-			printf("%-13s%-10s   ", first ? drivlist.driver().name : "", slot->device().tag()+1);
+			printf("%-13s%-10s   ", first ? drivlist.driver().name : "", info.slot_tag(slot));
 
 			bool first_option = true;
 
-			// get the options and print them
-			for (const device_slot_option *option = slot->first_option(); option != NULL; option = option->next())
+			// get the selectable options and print them
+			for (int option = 0; option < info.slot_options(slot); option++)
 			{
-				if (option->selectable())
-				{
-					device_t *dev = (*option->devtype())(drivlist.config(), "dummy", &drivlist.config().root_device(), 0);
-					dev->config_complete();
-					if (first_option) {
-						printf("%-15s %s\n", option->name(),dev->name());
-					} else {
-						printf("%-23s   %-15s %s\n", "",option->name(),dev->name());
-					}
-					global_free(dev);
-
-					first_option = false;
+				if (first_option) {
+					printf("%-15s %s\n", info.slot_option_name(slot, option), info.slot_option_device(slot, option));
+				} else {
+					printf("%-23s   %-15s %s\n", "", info.slot_option_name(slot, option), info.slot_option_device(slot, option));
 				}
+
+				first_option = false;
 			}
 			if (first_option)
 				printf("%-15s %s\n", "[none]","No options available");
@@ -714,22 +707,23 @@ void cli_frontend::listmedia(const char *gamename)
 	printf("----------  --------------------  ------------------------------------\n");
 
 	// iterate over drivers
+	machine_info_cache cache(m_options);
 	while (drivlist.next())
 	{
-		// iterate
-		image_interface_iterator iter(drivlist.config().root_device());
+		// iterate over the image devices
+		const machine_info &info = cache.get(drivlist);
 		bool first = true;
-		for (const device_image_interface *imagedev = iter.first(); imagedev != NULL; imagedev = iter.next())
+		for (int index = 0; index < info.media(); index++)
 		{
 			// extract the shortname with parentheses
 			astring paren_shortname;
-			paren_shortname.format("(%s)", imagedev->brief_instance_name());
+			paren_shortname.format("(%s)", info.media_brief(index));
 
 			// output the line, up to the list of extensions
-			printf("%-13s%-12s%-8s   ", first ? drivlist.driver().name : "", imagedev->instance_name(), paren_shortname.cstr());
+			printf("%-13s%-12s%-8s   ", first ? drivlist.driver().name : "", info.media_instance(index), paren_shortname.cstr());
 
 			// get the extensions and print them
-			astring extensions(imagedev->file_extensions());
+			astring extensions(info.media_extensions(index));
 			for (int start = 0, end = extensions.chr(0, ','); ; start = end + 1, end = extensions.chr(start, ','))
 			{
 				astring curext(extensions, start, (end == -1) ? extensions.len() - start : end - start);
@@ -760,6 +754,20 @@ void cli_frontend::listmididevices(const char *gamename)
 }
 
 
+//-------------------------------------------------
+//  display_audit_timing - report where an audit
+//  spent its time; times are summed over all
+//  worker threads
+//-------------------------------------------------
+
+static void display_audit_timing(const media_auditor::stage_timing &timing)
+{
+	double scale = 1.0 / double(osd_ticks_per_second());
+	mame_printf_verbose("Audited %d files: open %.2fs, decompress %.2fs, hash %.2fs\n", timing.files,
+			double(timing.open) * scale, double(timing.decompress) * scale, double(timing.hash) * scale);
+}
+
+
 //-------------------------------------------------
 //  verifyroms - verify the ROM sets of one or
 //  more games
@@ -774,14 +782,20 @@ void cli_frontend::verifyroms(const char *gamename)
 	int notfound = 0;
 	int matched = 0;
 
-	// iterate over drivers
+	// optionally open every archive up front so the audit only hits the cache
+	if (m_options.zip_preindex())
+		mame_printf_verbose("Indexed %d ZIP files\n", emu_file::preindex_archives(m_options.media_path()));
+
+	// audit the drivers in parallel, reporting in order
 	media_auditor auditor(drivlist);
-	while (drivlist.next())
+	audit_batch batch(drivlist, audit_batch::BATCH_MEDIA, AUDIT_VALIDATE_FAST);
+	while (batch.next())
 	{
+		drivlist.set_current(batch.current());
 		matched++;
 
 		// audit the ROMs in this set
-		media_auditor::summary summary = auditor.audit_media(AUDIT_VALIDATE_FAST);
+		media_auditor::summary summary = batch.summary();
 
 		// if not found, count that and leave it at that
 		if (summary == media_auditor::NOTFOUND)
@@ -791,9 +805,7 @@ void cli_frontend::verifyroms(const char *gamename)
 		else
 		{
 			// output the summary of the audit
-			astring summary_string;
-			auditor.summarize(drivlist.driver().name,&summary_string);
-			mame_printf_info("%s", summary_string.cstr());
+			mame_printf_info("%s", batch.report());
 
 			// output the name of the driver and its clone
 			mame_printf_info("romset %s ", drivlist.driver().name);
@@ -956,6 +968,11 @@ void cli_frontend::verifyroms(const char *gamename)
 		}
 	}
 
+	// report the time spent in each stage
+	media_auditor::stage_timing timing = batch.timing();
+	timing += auditor.timing();
+	display_audit_timing(timing);
+
 	// clear out any cached files
 	zip_file_cache_clear();
 
@@ -997,14 +1014,15 @@ void cli_frontend::verifysamples(const char *gamename)
 	int notfound = 0;
 	int matched = 0;
 
-	// iterate over drivers
-	media_auditor auditor(drivlist);
-	while (drivlist.next())
+	// audit the drivers in parallel, reporting in order
+	audit_batch batch(drivlist, audit_batch::BATCH_SAMPLES);
+	while (batch.next())
 	{
+		drivlist.set_current(batch.current());
 		matched++;
 
 		// audit the samples in this set
-		media_auditor::summary summary = auditor.audit_samples();
+		media_auditor::summary summary = batch.summary();
 
 		// if not found, count that and leave it at that
 		if (summary == media_auditor::NOTFOUND)
@@ -1014,9 +1032,7 @@ void cli_frontend::verifysamples(const char *gamename)
 		else if (summary != media_auditor::NONE_NEEDED)
 		{
 			// output the summary of the audit
-			astring summary_string;
-			auditor.summarize(drivlist.driver().name,&summary_string);
-			mame_printf_info("%s", summary_string.cstr());
+			mame_printf_info("%s", batch.report());
 
 			// output the name of the driver and its clone
 			mame_printf_info("sampleset %s ", drivlist.driver().name);
@@ -1048,6 +1064,9 @@ void cli_frontend::verifysamples(const char *gamename)
 		}
 	}
 
+	// report the time spent in each stage
+	display_audit_timing(batch.timing());
+
 	// clear out any cached files
 	zip_file_cache_clear();
 
@@ -1724,15 +1743,30 @@ void cli_frontend::display_suggestions(const char *gamename)
 //  MEDIA IDENTIFIER
 //**************************************************************************
 
+//-------------------------------------------------
+//  sha1_bucket - hash a SHA1 for the index
+//-------------------------------------------------
+
+static inline UINT32 sha1_bucket(const sha1_t &sha1)
+{
+	return (sha1.m_raw[0] << 24) | (sha1.m_raw[1] << 16) | (sha1.m_raw[2] << 8) | sha1.m_raw[3];
+}
+
+
 //-------------------------------------------------
 //  media_identifier - constructor
 //-------------------------------------------------
 
 media_identifier::media_identifier(cli_options &options)
 	: m_drivlist(options),
+		m_info(options),
 		m_total(0),
 		m_matches(0),
-		m_nonroms(0)
+		m_nonroms(0),
+		m_indexed(false),
+		m_files(NULL),
+		m_count(0),
+		m_pool(*this)
 {
 }
 
@@ -1748,16 +1782,8 @@ void media_identifier::identify(const char *filename)
 	osd_directory *directory = osd_opendir(filename);
 	if (directory != NULL)
 	{
-		// iterate over all files in the directory
-		for (const osd_directory_entry *entry = osd_readdir(directory); entry != NULL; entry = osd_readdir(directory))
-			if (entry->type == ENTTYPE_FILE)
-			{
-				astring curfile(filename, PATH_SEPARATOR, entry->name);
-				identify(curfile);
-			}
-
-		// close the directory and be done
 		osd_closedir(directory);
+		identify_directory(filename);
 	}
 
 	// if that failed, and the filename ends with .zip, identify as a ZIP file
@@ -1787,14 +1813,24 @@ void media_identifier::identify(const char *filename)
 
 				if (!(f->IsDir) && (f->Size != 0))
 				{
-					UINT8 *data = global_alloc_array(UINT8, f->Size);
-					if (data != NULL)
+					// members whose stored CRC matches nothing need not be decompressed
+					if (f->CrcDefined && !core_filename_ends_with((const char*)temp2, ".jed") && !might_match(f->Crc))
 					{
-						// decompress data into RAM and identify it
-						_7zerr = _7z_file_decompress(_7z, data, f->Size);
-						if (_7zerr == _7ZERR_NONE)
-							identify_data((const char*)temp2, data, f->Size);
-						global_free(data);
+						hash_collection hashes;
+						hashes.add_crc(f->Crc);
+						identify_hashes((const char*)temp2, hashes, f->Size);
+					}
+					else
+					{
+						UINT8 *data = global_alloc_array(UINT8, f->Size);
+						if (data != NULL)
+						{
+							// decompress data into RAM and identify it
+							_7zerr = _7z_file_decompress(_7z, data, f->Size);
+							if (_7zerr == _7ZERR_NONE)
+								identify_data((const char*)temp2, data, f->Size);
+							global_free(data);
+						}
 					}
 				}
 
@@ -1820,6 +1856,15 @@ void media_identifier::identify(const char *filename)
 			for (const zip_file_header *entry = zip_file_first_file(zip); entry != NULL; entry = zip_file_next_file(zip))
 				if (entry->uncompressed_length != 0)
 				{
+					// members whose stored CRC matches nothing need not be decompressed
+					if (!core_filename_ends_with(entry->filename, ".jed") && !might_match(entry->crc))
+					{
+						hash_collection hashes;
+						hashes.add_crc(entry->crc);
+						identify_hashes(entry->filename, hashes, entry->uncompressed_length);
+						continue;
+					}
+
 					UINT8 *data = global_alloc_array(UINT8, entry->uncompressed_length);
 					if (data != NULL)
 					{
@@ -1845,6 +1890,101 @@ void media_identifier::identify(const char *filename)
 }
 
 
+//-------------------------------------------------
+//  identify_directory - identify the files in a
+//  directory; plain files are loaded and hashed
+//  by workers while the results are reported in
+//  directory order
+//-------------------------------------------------
+
+void media_identifier::identify_directory(const char *dirname)
+{
+	// gather the files first
+	osd_directory *directory = osd_opendir(dirname);
+	if (directory == NULL)
+		return;
+	dynamic_array<astring *> names;
+	for (const osd_directory_entry *entry = osd_readdir(directory); entry != NULL; entry = osd_readdir(directory))
+		if (entry->type == ENTTYPE_FILE)
+			names.append(global_alloc(astring(dirname, PATH_SEPARATOR, entry->name)));
+	osd_closedir(directory);
+	if (names.count() == 0)
+		return;
+
+	// archives and CHDs are handled here; everything else goes to the workers
+	m_files = global_alloc_array(pending_file, names.count());
+	m_count = names.count();
+	for (int index = 0; index < m_count; index++)
+	{
+		m_files[index].name.cpy(*names[index]);
+		global_free(names[index]);
+	}
+
+	m_pool.start(m_count);
+
+	// report in order as the hashes arrive
+	for (int slot = 0; slot < m_count; slot++)
+	{
+		pending_file &file = m_files[slot];
+		const char *name = file.name;
+		if (core_filename_ends_with(name, ".7z") || core_filename_ends_with(name, ".zip") || core_filename_ends_with(name, ".chd"))
+		{
+			identify(name);
+			continue;
+		}
+
+		if (!m_pool.wait(slot))
+		{
+			m_pool.finish();
+			global_free(m_files);
+			m_files = NULL;
+			m_count = 0;
+			throw emu_fatalerror(m_pool.exitcode(slot), "%s", m_pool.error(slot));
+		}
+		if (file.loaded)
+			identify_hashes(name, file.hashes, file.length);
+	}
+
+	// let the workers drain
+	m_pool.finish();
+	global_free(m_files);
+	m_files = NULL;
+	m_count = 0;
+}
+
+
+//-------------------------------------------------
+//  work_item - load and hash one plain file;
+//  the main thread takes care of anything that
+//  is not a plain file
+//-------------------------------------------------
+
+void media_identifier::work_item(void *context, int index)
+{
+	pending_file &file = m_files[index];
+	const char *name = file.name;
+	if (core_filename_ends_with(name, ".7z") || core_filename_ends_with(name, ".zip") || core_filename_ends_with(name, ".chd"))
+		return;
+
+	UINT32 length;
+	void *data;
+	file_error filerr = core_fload(name, &data, &length);
+	if (filerr == FILERR_NONE)
+	{
+		if (length > 0)
+		{
+			const UINT8 *hashdata = reinterpret_cast<UINT8 *>(data);
+			UINT8 *tempjed = NULL;
+			file.length = convert_jed(name, hashdata, length, tempjed);
+			file.hashes.compute(hashdata, file.length, hash_collection::HASH_TYPES_CRC_SHA1);
+			file.loaded = true;
+			global_free(tempjed);
+		}
+		osd_free(data);
+	}
+}
+
+
 //-------------------------------------------------
 //  identify_file - identify a file
 //-------------------------------------------------
@@ -1906,15 +2046,13 @@ void media_identifier::identify_file(const char *name)
 
 
 //-------------------------------------------------
-//  identify_data - identify a buffer full of
-//  data; if it comes from a .JED file, parse the
-//  fusemap into raw data first
+//  convert_jed - if this is a '.jed' file,
+//  process it into raw bits and point to those
+//  instead; returns the length to hash
 //-------------------------------------------------
 
-void media_identifier::identify_data(const char *name, const UINT8 *data, int length)
+int media_identifier::convert_jed(const char *name, const UINT8 *&data, int length, UINT8 *&tempjed)
 {
-	// if this is a '.jed' file, process it into raw bits first
-	UINT8 *tempjed = NULL;
 	jed_data jed;
 	if (core_filename_ends_with(name, ".jed") && jed_parse(data, length, &jed) == JEDERR_NONE)
 	{
@@ -1924,11 +2062,38 @@ void media_identifier::identify_data(const char *name, const UINT8 *data, int le
 		jedbin_output(&jed, tempjed, length);
 		data = tempjed;
 	}
+	return length;
+}
+
+
+//-------------------------------------------------
+//  identify_data - identify a buffer full of
+//  data; if it comes from a .JED file, parse the
+//  fusemap into raw data first
+//-------------------------------------------------
+
+void media_identifier::identify_data(const char *name, const UINT8 *data, int length)
+{
+	UINT8 *tempjed = NULL;
+	length = convert_jed(name, data, length, tempjed);
 
 	// compute the hash of the data
 	hash_collection hashes;
 	hashes.compute(data, length, hash_collection::HASH_TYPES_CRC_SHA1);
+	identify_hashes(name, hashes, length);
+
+	// free any temporary JED data
+	global_free(tempjed);
+}
 
+
+//-------------------------------------------------
+//  identify_hashes - report on a file whose
+//  hashes are known
+//-------------------------------------------------
+
+void media_identifier::identify_hashes(const char *name, const hash_collection &hashes, int length)
+{
 	// output the name
 	m_total++;
 	astring basename;
@@ -1955,70 +2120,170 @@ void media_identifier::identify_data(const char *name, const UINT8 *data, int le
 	// if we did find it, count it as a match
 	else
 		m_matches++;
-
-	// free any temporary JED data
-	global_free(tempjed);
 }
 
 
 //-------------------------------------------------
-//  find_by_hash - scan for a file in the list
-//  of drivers by hash
+//  build_index - index the ROMs of every driver
+//  and software list by CRC and by SHA1
 //-------------------------------------------------
 
-int media_identifier::find_by_hash(const hash_collection &hashes, int length)
+int media_identifier::add_string(const char *string)
 {
-	int found = 0;
+	int offset = m_strings.count();
+	do
+		m_strings.append(*string);
+	while (*string++ != 0);
+	return offset;
+}
 
-	// iterate over drivers
+void media_identifier::add_entry(const char *hashdata, int driver, const char *name, const char *owner, const char *description)
+{
+	// no-dumps and ROMs with no hashes can never match
+	hash_collection romhashes(hashdata);
+	hash_entry entry;
+	entry.has_crc = romhashes.crc(entry.crc);
+	entry.has_sha1 = romhashes.sha1(entry.sha1);
+	if (romhashes.flag(hash_collection::FLAG_NO_DUMP) || (!entry.has_crc && !entry.has_sha1))
+		return;
+
+	entry.baddump = romhashes.flag(hash_collection::FLAG_BAD_DUMP);
+	entry.driver = driver;
+	entry.name = add_string(name);
+	entry.owner = (owner != NULL) ? add_string(owner) : -1;
+	entry.description = (description != NULL) ? add_string(description) : -1;
+	entry.next_crc = entry.next_sha1 = -1;
+	m_entries.append(entry);
+}
+
+void media_identifier::build_index()
+{
+	if (m_indexed)
+		return;
+	m_indexed = true;
+	osd_ticks_t start = osd_ticks();
+
+	// ROMs of every driver's devices, noting each software list once
+	tagmap_t<FPTR> listmap;
+	dynamic_array<int> listnames;
 	m_drivlist.reset();
 	while (m_drivlist.next())
 	{
-		// iterate over devices, regions and files within the region */
-		device_iterator deviter(m_drivlist.config().root_device());
-		for (device_t *device = deviter.first(); device != NULL; device = deviter.next())
-			for (const rom_entry *region = rom_first_region(*device); region != NULL; region = rom_next_region(region))
-				for (const rom_entry *rom = rom_first_file(region); rom != NULL; rom = rom_next_file(rom))
-				{
-					hash_collection romhashes(ROM_GETHASHDATA(rom));
-					if (!romhashes.flag(hash_collection::FLAG_NO_DUMP) && hashes == romhashes)
-					{
-						bool baddump = romhashes.flag(hash_collection::FLAG_BAD_DUMP);
+		const machine_info &info = m_info.get(m_drivlist);
+		for (int index = 0; index < info.roms(); index++)
+			add_entry(info.rom_hashdata(index), m_drivlist.current(), info.rom_name(index), NULL, NULL);
+		for (int index = 0; index < info.softlists(); index++)
+			if (listmap.add(info.softlist(index), 1, false) == TMERR_NONE)
+				listnames.append(add_string(info.softlist(index)));
+	}
 
-						// output information about the match
-						if (found)
-							mame_printf_info("                    ");
-						mame_printf_info("= %s%-20s  %-10s %s\n", baddump ? "(BAD) " : "", ROM_GETNAME(rom), m_drivlist.driver().name, m_drivlist.driver().description);
-						found++;
-					}
-				}
+	// then every software list
+	for (int listindex = 0; listindex < listnames.count(); listindex++)
+	{
+		astring listname(&m_strings[listnames[listindex]]);
+		software_list *list = software_list_open(m_drivlist.options(), listname, FALSE, NULL);
 
-		// next iterate over softlists
-		software_list_device_iterator iter(m_drivlist.config().root_device());
-		for (const software_list_device *swlist = iter.first(); swlist != NULL; swlist = iter.next())
+		astring owner;
+		for (software_info *swinfo = software_list_find(list, "*", NULL); swinfo != NULL; swinfo = software_list_find(list, "*", swinfo))
 		{
-			software_list *list = software_list_open(m_drivlist.options(), swlist->list_name(), FALSE, NULL);
-
-			for (software_info *swinfo = software_list_find(list, "*", NULL); swinfo != NULL; swinfo = software_list_find(list, "*", swinfo))
-				for (software_part *part = software_find_part(swinfo, NULL, NULL); part != NULL; part = software_part_next(part))
-					for (const rom_entry *region = part->romdata; region != NULL; region = rom_next_region(region))
-						for (const rom_entry *rom = rom_first_file(region); rom != NULL; rom = rom_next_file(rom))
-						{
-							hash_collection romhashes(ROM_GETHASHDATA(rom));
-							if (hashes == romhashes)
-							{
-								bool baddump = romhashes.flag(hash_collection::FLAG_BAD_DUMP);
+			owner.cpy(listname).cat(":").cat(swinfo->shortname);
+			for (software_part *part = software_find_part(swinfo, NULL, NULL); part != NULL; part = software_part_next(part))
+				for (const rom_entry *region = part->romdata; region != NULL; region = rom_next_region(region))
+					for (const rom_entry *rom = rom_first_file(region); rom != NULL; rom = rom_next_file(rom))
+						add_entry(ROM_GETHASHDATA(rom), -1, ROM_GETNAME(rom), owner, swinfo->longname);
+		}
+		software_list_close(list);
+	}
 
-								// output information about the match
-								if (found)
-									mame_printf_info("                    ");
-								mame_printf_info("= %s%-20s  %s:%s %s\n", baddump ? "(BAD) " : "", ROM_GETNAME(rom), swlist->list_name(), swinfo->shortname, swinfo->longname);
-								found++;
-							}
-						}
-			software_list_close(list);
+	// chain the entries into power-of-two hash tables
+	int size = 1024;
+	while (size < m_entries.count())
+		size <<= 1;
+	m_crc_table.resize(size);
+	m_sha1_table.resize(size);
+	for (int bucket = 0; bucket < size; bucket++)
+		m_crc_table[bucket] = m_sha1_table[bucket] = -1;
+	for (int index = m_entries.count() - 1; index >= 0; index--)
+	{
+		hash_entry &entry = m_entries[index];
+		if (entry.has_crc)
+		{
+			int &head = m_crc_table[entry.crc & (size - 1)];
+			entry.next_crc = head;
+			head = index;
+		}
+		if (entry.has_sha1)
+		{
+			int &head = m_sha1_table[sha1_bucket(entry.sha1) & (size - 1)];
+			entry.next_sha1 = head;
+			head = index;
 		}
 	}
 
-	return found;
+	mame_printf_verbose("Indexed %d ROMs from %d drivers and %d software lists in %.2f seconds\n", m_entries.count(), m_drivlist.count(), listnames.count(), double(osd_ticks() - start) / double(osd_ticks_per_second()));
+}
+
+
+//-------------------------------------------------
+//  might_match - return true if any ROM has the
+//  given CRC
+//-------------------------------------------------
+
+bool media_identifier::might_match(UINT32 crc)
+{
+	build_index();
+	for (int index = m_crc_table[crc & (m_crc_table.count() - 1)]; index != -1; index = m_entries[index].next_crc)
+		if (m_entries[index].crc == crc)
+			return true;
+	return false;
+}
+
+
+//-------------------------------------------------
+//  find_by_hash - look up a file in the index of
+//  driver and software list ROMs
+//-------------------------------------------------
+
+static int compare_indexes(const void *i1, const void *i2)
+{
+	return *(const int *)i1 - *(const int *)i2;
+}
+
+int media_identifier::find_by_hash(const hash_collection &hashes, int length)
+{
+	build_index();
+
+	// gather candidates from both tables; a ROM with a CRC is only taken
+	// from the SHA1 table if the file has no CRC to find it by
+	UINT32 crc;
+	sha1_t sha1;
+	bool has_crc = hashes.crc(crc);
+	bool has_sha1 = hashes.sha1(sha1);
+	dynamic_array<int> hits;
+	if (has_crc)
+		for (int index = m_crc_table[crc & (m_crc_table.count() - 1)]; index != -1; index = m_entries[index].next_crc)
+			if (m_entries[index].crc == crc && (!has_sha1 || !m_entries[index].has_sha1 || m_entries[index].sha1 == sha1))
+				hits.append(index);
+	if (has_sha1)
+		for (int index = m_sha1_table[sha1_bucket(sha1) & (m_sha1_table.count() - 1)]; index != -1; index = m_entries[index].next_sha1)
+			if (m_entries[index].sha1 == sha1 && !(has_crc && m_entries[index].has_crc))
+				hits.append(index);
+
+	// report them in driver order, software lists last
+	if (hits.count() > 1)
+		qsort(&hits[0], hits.count(), sizeof(hits[0]), compare_indexes);
+	for (int hit = 0; hit < hits.count(); hit++)
+	{
+		const hash_entry &entry = m_entries[hits[hit]];
+
+		// output information about the match
+		if (hit != 0)
+			mame_printf_info("                    ");
+		if (entry.driver != -1)
+			mame_printf_info("= %s%-20s  %-10s %s\n", entry.baddump ? "(BAD) " : "", &m_strings[entry.name], driver_list::driver(entry.driver).name, driver_list::driver(entry.driver).description);
+		else
+			mame_printf_info("= %s%-20s  %s %s\n", entry.baddump ? "(BAD) " : "", &m_strings[entry.name], &m_strings[entry.owner], &m_strings[entry.description]);
+	}
+
+	return hits.count();
 }
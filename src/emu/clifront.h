@@ -15,6 +15,8 @@
 
 #include "emuopts.h"
 #include "drivenum.h"
+#include "infocache.h"
+#include "workpool.h"
 
 
 //**************************************************************************
@@ -89,7 +91,6 @@ public:
 	void listcrc(const char *gamename = "*");
 	void listroms(const char *gamename = "*");
 	void listsamples(const char *gamename = "*");
-	static int compare_devices(const void *i1, const void *i2);
 	void listdevices(const char *gamename = "*");
 	void listslots(const char *gamename = "*");
 	void listmedia(const char *gamename = "*");
@@ -118,7 +119,7 @@ private:
 
 // media_identifier class identifies media by hash via a search in
 // the driver database
-class media_identifier
+class media_identifier : public ordered_work_client
 {
 public:
 	// construction/destruction
@@ -137,11 +138,61 @@ public:
 	int find_by_hash(const hash_collection &hashes, int length);
 
 private:
+	// a ROM in the hash index
+	struct hash_entry
+	{
+		UINT32                  crc;
+		sha1_t                  sha1;
+		bool                    has_crc;
+		bool                    has_sha1;
+		bool                    baddump;
+		int                     driver;             // driver index, or -1 for software
+		int                     name;               // offsets into m_strings
+		int                     owner;
+		int                     description;
+		int                     next_crc;           // hash chains
+		int                     next_sha1;
+	};
+
+	// a plain file in a directory, hashed by a worker
+	struct pending_file
+	{
+		pending_file() : length(0), loaded(false) { }
+
+		astring                 name;
+		hash_collection         hashes;
+		int                     length;             // length that was hashed
+		bool                    loaded;             // false if it could not be read
+	};
+
+	// internal helpers
+	void build_index();
+	int add_string(const char *string);
+	void add_entry(const char *hashdata, int driver, const char *name, const char *owner, const char *description);
+	bool might_match(UINT32 crc);
+	void identify_directory(const char *dirname);
+	void identify_hashes(const char *name, const hash_collection &hashes, int length);
+	static int convert_jed(const char *name, const UINT8 *&data, int length, UINT8 *&tempjed);
+	virtual void work_item(void *context, int index);
+
 	// internal state
 	driver_enumerator   m_drivlist;
+	machine_info_cache  m_info;
 	int                 m_total;
 	int                 m_matches;
 	int                 m_nonroms;
+
+	// hash index, built on first use
+	bool                        m_indexed;
+	dynamic_array<hash_entry>   m_entries;
+	dynamic_array<int>          m_crc_table;
+	dynamic_array<int>          m_sha1_table;
+	dynamic_array<char>         m_strings;
+
+	// directory hashing state
+	pending_file *      m_files;
+	int                 m_count;
+	ordered_work_pool   m_pool;
 };
 
 
@@ -10,6 +10,7 @@
 
 #include "emu.h"
 #include "debugger.h"
+#include "validity.h"
 
 
 //**************************************************************************
@@ -461,15 +462,15 @@ void device_execute_interface::interface_validity_check(validity_checker &valid)
 	{
 		screen_device_iterator iter(device().mconfig().root_device());
 		if (iter.first() == NULL)
-			mame_printf_error("VBLANK interrupt specified, but the driver is screenless\n");
+			valid.error("VBLANK interrupt specified, but the driver is screenless\n");
 		else if (m_vblank_interrupt_screen != NULL && device().siblingdevice(m_vblank_interrupt_screen) == NULL)
-			mame_printf_error("VBLANK interrupt references a non-existant screen tag '%s'\n", m_vblank_interrupt_screen);
+			valid.error("VBLANK interrupt references a non-existant screen tag '%s'\n", m_vblank_interrupt_screen);
 	}
 
 	if (!m_timed_interrupt.isnull() && m_timed_interrupt_period == attotime::zero)
-		mame_printf_error("Timed interrupt handler specified with 0 period\n");
+		valid.error("Timed interrupt handler specified with 0 period\n");
 	else if (m_timed_interrupt.isnull() && m_timed_interrupt_period != attotime::zero)
-		mame_printf_error("No timer interrupt handler specified, but has a non-0 period given\n");
+		valid.error("No timer interrupt handler specified, but has a non-0 period given\n");
 }
 
 
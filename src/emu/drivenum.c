@@ -18,6 +18,10 @@
 //  DRIVER LIST
 //**************************************************************************
 
+dynamic_array<int> driver_list::s_ngram_start;
+dynamic_array<int> driver_list::s_ngram_drivers;
+
+
 //-------------------------------------------------
 //  driver_list - constructor
 //-------------------------------------------------
@@ -118,6 +122,73 @@ int driver_list::penalty_compare(const char *source, const char *target)
 }
 
 
+//-------------------------------------------------
+//  ngram_hash - hash the first three characters
+//  of a string, ignoring case
+//-------------------------------------------------
+
+UINT32 driver_list::ngram_hash(const char *string)
+{
+	UINT32 result = tolower((UINT8)string[0]);
+	result = result * 61 + tolower((UINT8)string[1]);
+	result = result * 61 + tolower((UINT8)string[2]);
+	return result & (NGRAM_BUCKETS - 1);
+}
+
+
+//-------------------------------------------------
+//  build_ngram_index - index every driver under
+//  each three-character substring of its name and
+//  description; done once, on first use
+//-------------------------------------------------
+
+void driver_list::build_ngram_index()
+{
+	if (s_ngram_start.count() != 0)
+		return;
+
+	// two passes: count the drivers in each bucket, then fill them in
+	dynamic_array<int> last(NGRAM_BUCKETS);
+	dynamic_array<int> fill(NGRAM_BUCKETS);
+	s_ngram_start.resize(NGRAM_BUCKETS + 1);
+	memset(&s_ngram_start[0], 0, sizeof(s_ngram_start[0]) * s_ngram_start.count());
+	for (int pass = 0; pass < 2; pass++)
+	{
+		memset(&last[0], 0xff, sizeof(last[0]) * last.count());
+		for (int index = 0; index < s_driver_count; index++)
+			for (int field = 0; field < 2; field++)
+			{
+				const char *string = (field == 0) ? s_drivers_sorted[index]->name : s_drivers_sorted[index]->description;
+				if (string == NULL)
+					continue;
+				for ( ; string[0] != 0 && string[1] != 0 && string[2] != 0; string++)
+				{
+					// each driver goes in a bucket only once
+					UINT32 bucket = ngram_hash(string);
+					if (last[bucket] == index)
+						continue;
+					last[bucket] = index;
+					if (pass == 0)
+						s_ngram_start[bucket + 1]++;
+					else
+						s_ngram_drivers[fill[bucket]++] = index;
+				}
+			}
+
+		// turn the counts into offsets
+		if (pass == 0)
+		{
+			for (int bucket = 0; bucket < NGRAM_BUCKETS; bucket++)
+			{
+				s_ngram_start[bucket + 1] += s_ngram_start[bucket];
+				fill[bucket] = s_ngram_start[bucket];
+			}
+			s_ngram_drivers.resize(s_ngram_start[NGRAM_BUCKETS]);
+		}
+	}
+}
+
+
 
 //**************************************************************************
 //  DRIVER ENUMERATOR
@@ -345,6 +416,39 @@ void driver_enumerator::find_approximate_matches(const char *string, int count,
 	// allocate memory to track the penalty value
 	int *penalty = global_alloc_array(int, count);
 
+	// a driver sharing no three-character substring with the string can only
+	// match it in runs of one or two characters, so its penalty is at least
+	// half the string's length; if the drivers that do share one fill the
+	// table with better scores than that, nothing else can get in
+	int length = strlen(string);
+	if (length >= 3 && count > 0)
+	{
+		build_ngram_index();
+		UINT8 *candidate = global_alloc_array_clear(UINT8, s_driver_count);
+		for (const char *ngram = string; ngram[2] != 0; ngram++)
+		{
+			UINT32 bucket = ngram_hash(ngram);
+			for (int entry = s_ngram_start[bucket]; entry < s_ngram_start[bucket + 1]; entry++)
+				candidate[s_ngram_drivers[entry]] = 1;
+		}
+
+		for (int matchnum = 0; matchnum < count; matchnum++)
+		{
+			penalty[matchnum] = 9999;
+			results[matchnum] = -1;
+		}
+		for (int index = 0; index < s_driver_count; index++)
+			if (candidate[index] && m_included[index])
+				insert_match(string, index, count, penalty, results);
+		global_free(candidate);
+
+		if (results[count - 1] != -1 && penalty[count - 1] < (length + 1) / 2)
+		{
+			global_free(penalty);
+			return;
+		}
+	}
+
 	// initialize everyone's states
 	for (int matchnum = 0; matchnum < count; matchnum++)
 	{
@@ -355,36 +459,45 @@ void driver_enumerator::find_approximate_matches(const char *string, int count,
 	// scan the entire drivers array
 	for (int index = 0; index < s_driver_count; index++)
 		if (m_included[index])
-		{
-			// skip things that can't run
-			if ((s_drivers_sorted[index]->flags & GAME_NO_STANDALONE) != 0)
-				continue;
+			insert_match(string, index, count, penalty, results);
 
-			// pick the best match between driver name and description
-			int curpenalty = penalty_compare(string, s_drivers_sorted[index]->description);
-			int tmp = penalty_compare(string, s_drivers_sorted[index]->name);
-			curpenalty = MIN(curpenalty, tmp);
+	// free our temp memory
+	global_free(penalty);
+}
 
-			// insert into the sorted table of matches
-			for (int matchnum = count - 1; matchnum >= 0; matchnum--)
-			{
-				// stop if we're worse than the current entry
-				if (curpenalty >= penalty[matchnum])
-					break;
 
-				// as long as this isn't the last entry, bump this one down
-				if (matchnum < count - 1)
-				{
-					penalty[matchnum + 1] = penalty[matchnum];
-					results[matchnum + 1] = results[matchnum];
-				}
-				results[matchnum] = index;
-				penalty[matchnum] = curpenalty;
-			}
-		}
+//-------------------------------------------------
+//  insert_match - score a driver against a string
+//  and insert it into a sorted table of matches
+//-------------------------------------------------
 
-	// free our temp memory
-	global_free(penalty);
+void driver_enumerator::insert_match(const char *string, int index, int count, int *penalty, int *results)
+{
+	// skip things that can't run
+	if ((s_drivers_sorted[index]->flags & GAME_NO_STANDALONE) != 0)
+		return;
+
+	// pick the best match between driver name and description
+	int curpenalty = penalty_compare(string, s_drivers_sorted[index]->description);
+	int tmp = penalty_compare(string, s_drivers_sorted[index]->name);
+	curpenalty = MIN(curpenalty, tmp);
+
+	// insert into the sorted table of matches
+	for (int matchnum = count - 1; matchnum >= 0; matchnum--)
+	{
+		// stop if we're worse than the current entry
+		if (curpenalty >= penalty[matchnum])
+			break;
+
+		// as long as this isn't the last entry, bump this one down
+		if (matchnum < count - 1)
+		{
+			penalty[matchnum + 1] = penalty[matchnum];
+			results[matchnum + 1] = results[matchnum];
+		}
+		results[matchnum] = index;
+		penalty[matchnum] = curpenalty;
+	}
 }
 
 
@@ -55,10 +55,17 @@ protected:
 	// internal helpers
 	static int driver_sort_callback(const void *elem1, const void *elem2);
 	static int penalty_compare(const char *source, const char *target);
+	static UINT32 ngram_hash(const char *string);
+	static void build_ngram_index();
 
 	// internal state
 	static int                          s_driver_count;
 	static const game_driver * const    s_drivers_sorted[];
+
+	// index of the three-character substrings of driver names and descriptions
+	static const int NGRAM_BUCKETS = 65536;
+	static dynamic_array<int>           s_ngram_start;      // first entry of each bucket, plus an end marker
+	static dynamic_array<int>           s_ngram_drivers;    // driver indexes, ascending within each bucket
 };
 
 
@@ -116,6 +123,9 @@ public:
 	void find_approximate_matches(const char *string, int count, int *results);
 
 private:
+	// internal helpers
+	void insert_match(const char *string, int index, int count, int *penalty, int *results);
+
 	// entry in the config cache
 	struct config_entry
 	{
@@ -116,6 +116,7 @@ EMUOBJS = \
 	$(EMUOBJ)/hash.o \
 	$(EMUOBJ)/image.o \
 	$(EMUOBJ)/info.o \
+	$(EMUOBJ)/infocache.o \
 	$(EMUOBJ)/input.o \
 	$(EMUOBJ)/ioport.o \
 	$(EMUOBJ)/luaengine.o \
@@ -149,6 +150,7 @@ EMUOBJS = \
 	$(EMUOBJ)/uimenu.o \
 	$(EMUOBJ)/validity.o \
 	$(EMUOBJ)/video.o \
+	$(EMUOBJ)/workpool.o \
 	$(EMUOBJ)/debug/debugcmd.o \
 	$(EMUOBJ)/debug/debugcon.o \
 	$(EMUOBJ)/debug/debugcpu.o \
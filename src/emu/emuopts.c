@@ -66,6 +66,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SNAPNAME,                                   "%g/%i",     OPTION_STRING,     "override of the default snapshot/movie naming; %g == gamename, %i == index" },
 	{ OPTION_SNAPSIZE,                                   "auto",      OPTION_STRING,     "specify snapshot/movie resolution (<width>x<height>) or 'auto' to use minimal size " },
 	{ OPTION_SNAPVIEW,                                   "internal",  OPTION_STRING,     "specify snapshot/movie view or 'internal' to use internal pixel-aspect views" },
+	{ OPTION_SNAPLEVEL "(0-9)",                          "0",         OPTION_INTEGER,    "PNG compression level for snapshots and MNG movies, from 1 (fastest) to 9 (smallest); 0 for the default" },
 	{ OPTION_STATENAME,                                  "%g",        OPTION_STRING,     "override of the default state subfolder naming; %g == gamename" },
 	{ OPTION_BURNIN,                                     "0",         OPTION_BOOLEAN,    "create burn-in snapshots for each screen" },
 
@@ -169,6 +170,12 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_RAMSIZE ";ram",                             NULL,        OPTION_STRING,     "size of RAM (if supported by driver)" },
 	{ OPTION_CONFIRM_QUIT,                               "0",         OPTION_BOOLEAN,    "display confirm quit screen on exit" },
 	{ OPTION_UI_MOUSE,                                   "0",         OPTION_BOOLEAN,    "display ui mouse cursor" },
+	{ OPTION_VERIFY_CACHE,                               "1",         OPTION_BOOLEAN,    "remember verified ROM hashes keyed by archive contents" },
+	{ OPTION_REVERIFY,                                   "0",         OPTION_BOOLEAN,    "ignore remembered ROM hashes and fully re-verify" },
+	{ OPTION_ZIP_PREINDEX,                               "0",         OPTION_BOOLEAN,    "open and index every ZIP file on the rompath at startup" },
+	{ OPTION_SOFTLIST_CACHE,                             "1",         OPTION_BOOLEAN,    "keep compiled copies of software lists in the cfg directory" },
+	{ OPTION_VALIDATE_SOURCES,                           NULL,        OPTION_STRING,     "with -validate, only check drivers from these comma-separated changed source files" },
+	{ OPTION_LISTING_CACHE,                              "0",         OPTION_BOOLEAN,    "keep the device, ROM, media and slot information used by the listing commands in the cfg directory" },
 	{ OPTION_AUTOBOOT_COMMAND ";ab",                     NULL,        OPTION_STRING,     "command to execute after machine boot" },
 	{ OPTION_AUTOBOOT_DELAY,                             "2",         OPTION_INTEGER,    "timer delay in sec to trigger command execution on autoboot" },
 	{ OPTION_AUTOBOOT_SCRIPT ";script",                  NULL,        OPTION_STRING,     "lua script to execute after machine boot" },
@@ -78,6 +78,7 @@ enum
 #define OPTION_SNAPNAME             "snapname"
 #define OPTION_SNAPSIZE             "snapsize"
 #define OPTION_SNAPVIEW             "snapview"
+#define OPTION_SNAPLEVEL            "snaplevel"
 #define OPTION_STATENAME            "statename"
 #define OPTION_BURNIN               "burnin"
 
@@ -173,6 +174,13 @@ enum
 #define OPTION_CONFIRM_QUIT         "confirm_quit"
 #define OPTION_UI_MOUSE             "ui_mouse"
 
+#define OPTION_VERIFY_CACHE         "verify_cache"
+#define OPTION_REVERIFY             "reverify"
+#define OPTION_ZIP_PREINDEX         "zip_preindex"
+#define OPTION_SOFTLIST_CACHE       "softlist_cache"
+#define OPTION_VALIDATE_SOURCES     "validate_sources"
+#define OPTION_LISTING_CACHE        "listing_cache"
+
 #define OPTION_AUTOBOOT_COMMAND     "autoboot_command"
 #define OPTION_AUTOBOOT_DELAY       "autoboot_delay"
 #define OPTION_AUTOBOOT_SCRIPT      "autoboot_script"
@@ -244,6 +252,7 @@ public:
 	const char *snap_name() const { return value(OPTION_SNAPNAME); }
 	const char *snap_size() const { return value(OPTION_SNAPSIZE); }
 	const char *snap_view() const { return value(OPTION_SNAPVIEW); }
+	int snap_level() const { return int_value(OPTION_SNAPLEVEL); }
 	const char *state_name() const { return value(OPTION_STATENAME); }
 	bool burnin() const { return bool_value(OPTION_BURNIN); }
 
@@ -337,6 +346,13 @@ public:
 	bool confirm_quit() const { return bool_value(OPTION_CONFIRM_QUIT); }
 	bool ui_mouse() const { return bool_value(OPTION_UI_MOUSE); }
 
+	bool verify_cache() const { return bool_value(OPTION_VERIFY_CACHE); }
+	bool reverify() const { return bool_value(OPTION_REVERIFY); }
+	bool zip_preindex() const { return bool_value(OPTION_ZIP_PREINDEX); }
+	bool softlist_cache() const { return bool_value(OPTION_SOFTLIST_CACHE); }
+	const char *validate_sources() const { return value(OPTION_VALIDATE_SOURCES); }
+	bool listing_cache() const { return bool_value(OPTION_LISTING_CACHE); }
+
 	const char *autoboot_command() const { return value(OPTION_AUTOBOOT_COMMAND); }
 	int autoboot_delay() const { return int_value(OPTION_AUTOBOOT_DELAY); }
 	const char *autoboot_script() const { return value(OPTION_AUTOBOOT_SCRIPT); }
@@ -212,12 +212,68 @@ emu_file::operator core_file &()
 }
 
 
+//-------------------------------------------------
+//  load_archived - pull a file that was found in
+//  an archive into memory now rather than on
+//  first access; returns false if that failed
+//-------------------------------------------------
+
+bool emu_file::load_archived()
+{
+	return !compressed_file_ready();
+}
+
+
+//-------------------------------------------------
+//  preindex_archives - open every ZIP file in a
+//  search path so that later lookups find them
+//  already open and indexed; returns the number
+//  of archives indexed
+//-------------------------------------------------
+
+int emu_file::preindex_archives(const char *searchpath)
+{
+	file_enumerator path(searchpath);
+	const osd_directory_entry *entry;
+	int count = 0;
+	int reserved = 0;
+
+	while ((entry = path.next()) != NULL)
+	{
+		int length = strlen(entry->name);
+		if (entry->type != ENTTYPE_FILE || length < 4 || core_stricmp(&entry->name[length - 4], ".zip") != 0)
+			continue;
+
+		// closing hands the archive to the cache, so make sure there is room for it;
+		// grow by doubling, since each reserve copies the whole cache
+		astring fullpath(path.directory(), PATH_SEPARATOR, entry->name);
+		zip_file *zip;
+		if (zip_file_open(fullpath, &zip) == ZIPERR_NONE)
+		{
+			if (++count > reserved)
+			{
+				reserved = MAX(count, reserved * 2);
+				zip_file_cache_reserve(reserved);
+			}
+			zip_file_close(zip);
+		}
+	}
+	return count;
+}
+
+
 //-------------------------------------------------
 //  hash - returns the hash for a file
 //-------------------------------------------------
 
 hash_collection &emu_file::hashes(const char *types)
 {
+	// an archived file we have seen before may not need decompressing at all;
+	// remembered hashes are merged even if not asked for, so they still get checked
+	sha1_t sha1;
+	if (m_hashkey && !m_hashes.sha1(sha1))
+		hash_cache::find(m_hashkey, m_hashes);
+
 	// determine the hashes we already have
 	astring already_have;
 	m_hashes.hash_types(already_have);
@@ -242,12 +298,14 @@ hash_collection &emu_file::hashes(const char *types)
 	if (m__7zdata != NULL)
 	{
 		m_hashes.compute(m__7zdata, m__7zlength, needed);
+		hash_cache::add(m_hashkey, m_hashes);
 		return m_hashes;
 	}
 
 	if (m_zipdata != NULL)
 	{
 		m_hashes.compute(m_zipdata, m_ziplength, needed);
+		hash_cache::add(m_hashkey, m_hashes);
 		return m_hashes;
 	}
 
@@ -425,6 +483,7 @@ void emu_file::close()
 
 	// reset our hashes and path as well
 	m_hashes.reset();
+	m_hashkey.reset();
 	m_fullpath.reset();
 }
 
@@ -697,20 +756,20 @@ file_error emu_file::attempt_zipped()
 
 		// see if we can find a file with the right name and (if available) crc
 		const zip_file_header *header;
-		for (header = zip_file_first_file(zip); header != NULL; header = zip_file_next_file(zip))
+		for (header = zip_file_first_name_match(zip, filename); header != NULL; header = zip_file_next_name_match(zip))
 			if (zip_filename_match(*header, filename) && (!(m_openflags & OPEN_FLAG_HAS_CRC) || header->crc == m_crc))
 				break;
 
 		// if that failed, look for a file with the right crc, but the wrong filename
 		if (header == NULL && (m_openflags & OPEN_FLAG_HAS_CRC))
-			for (header = zip_file_first_file(zip); header != NULL; header = zip_file_next_file(zip))
-				if (header->crc == m_crc && !zip_header_is_path(*header))
+			for (header = zip_file_first_crc_match(zip, m_crc); header != NULL; header = zip_file_next_crc_match(zip))
+				if (!zip_header_is_path(*header))
 					break;
 
 		// if that failed, look for a file with the right name; reporting a bad checksum
 		// is more helpful and less confusing than reporting "rom not found"
 		if (header == NULL)
-			for (header = zip_file_first_file(zip); header != NULL; header = zip_file_next_file(zip))
+			for (header = zip_file_first_name_match(zip, filename); header != NULL; header = zip_file_next_name_match(zip))
 				if (zip_filename_match(*header, filename))
 					break;
 
@@ -723,6 +782,11 @@ file_error emu_file::attempt_zipped()
 			// build a hash with just the CRC
 			m_hashes.reset();
 			m_hashes.add_crc(header->crc);
+
+			// identify the member for the hash cache; the OSD layer has no
+			// timestamps, so the archive size and member header stand in
+			m_hashkey.printf("%s.zip|%" I64FMT "u|%08x|%u|%u|%u|%04x%04x", m_fullpath.cstr(), zip->length, header->crc,
+					header->uncompressed_length, header->compressed_length, header->local_header_offset, header->file_date, header->file_time);
 			return (m_openflags & OPEN_FLAG_NO_PRELOAD) ? FILERR_NONE : load_zipped_file();
 		}
 
@@ -850,6 +914,10 @@ file_error emu_file::attempt__7zped()
 			// build a hash with just the CRC
 			m_hashes.reset();
 			m_hashes.add_crc(_7z->crc);
+
+			// identify the member for the hash cache
+			m_hashkey.printf("%s.7z|%" I64FMT "u|%08x|%" I64FMT "u|%d", m_fullpath.cstr(), _7z->archiveStream.file._7z_length, UINT32(_7z->crc),
+					_7z->uncompressed_length, fileno);
 			return (m_openflags & OPEN_FLAG_NO_PRELOAD) ? FILERR_NONE : load__7zped_file();
 		}
 
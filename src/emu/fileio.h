@@ -69,6 +69,9 @@ public:
 	// iterator
 	const osd_directory_entry *next();
 
+	// directory containing the entry most recently returned
+	const char *directory() const { return m_pathbuffer; }
+
 private:
 	// internal state
 	path_iterator   m_iterator;
@@ -89,6 +92,9 @@ public:
 	emu_file(const char *searchpath, UINT32 openflags);
 	virtual ~emu_file();
 
+	// open and index every ZIP file in a search path ahead of time
+	static int preindex_archives(const char *searchpath);
+
 	// getters
 	operator core_file *();
 	operator core_file &();
@@ -116,6 +122,7 @@ public:
 	void close();
 
 	// control
+	bool load_archived();
 	file_error compress(int compress);
 	int seek(INT64 offset, int whence);
 	UINT64 tell();
@@ -162,6 +169,7 @@ private:
 	_7z_file *      m__7zfile;                      // 7Z file pointer
 	UINT8 *         m__7zdata;                      // 7Z file data
 	UINT64          m__7zlength;                    // 7Z file length
+	astring         m_hashkey;                      // archive/member key for the hash cache
 
 	bool            m_remove_on_close;              // flag: remove the file when closing
 };
@@ -25,6 +25,116 @@ const char *hash_collection::HASH_TYPES_ALL = "RS";
 
 
 
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+#define HASH_CACHE_FILENAME     "verify.cache"
+#define HASH_CACHE_HEADER       "# verify cache v2"
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// a single remembered set of hashes
+struct hash_cache_entry
+{
+	hash_cache_entry()
+		: m_next(NULL),
+			m_mtime(0) { }
+
+	hash_cache_entry *next() const { return m_next; }
+
+	hash_cache_entry *      m_next;
+	astring                 m_key;
+	astring                 m_hashes;
+	UINT64                  m_mtime;        // archive modification time, 0 until known
+};
+
+
+// the state shared by all users of the cache
+struct hash_cache_state
+{
+	hash_cache_state()
+		: m_refcount(1),
+			m_enabled(false),
+			m_reverify(false),
+			m_dirty(false) { }
+
+	int                     m_refcount;
+	bool                    m_enabled;
+	bool                    m_reverify;
+	bool                    m_dirty;
+	astring                 m_directory;
+	simple_list<hash_cache_entry> m_list;
+	tagmap_t<hash_cache_entry *, 6151> m_map;
+};
+
+
+// ROM loading hashes files on worker threads, so guard the shared state; the
+// lock lives only while the cache is open
+static osd_lock *hash_cache_lock = NULL;
+static hash_cache_state *hash_cache_data = NULL;
+
+
+
+//**************************************************************************
+//  CACHE FILE HELPERS
+//**************************************************************************
+
+//-------------------------------------------------
+//  read_line - read a whole line of any length
+//  from a text file, without the line ending
+//-------------------------------------------------
+
+static bool read_line(emu_file &file, astring &line)
+{
+	char buffer[256];
+	line.reset();
+
+	// core_fgets leaves a full buffer unterminated, so keep the last byte back
+	buffer[ARRAY_LENGTH(buffer) - 1] = 0;
+	while (file.gets(buffer, ARRAY_LENGTH(buffer) - 1) != NULL)
+	{
+		line.cat(buffer);
+		if (line[line.len() - 1] == 0x0d)
+			break;
+	}
+	if (line.len() == 0)
+		return false;
+	line.trimspace();
+	return true;
+}
+
+
+//-------------------------------------------------
+//  archive_field - extract one '|'-separated
+//  field of a cache key; the archive path comes
+//  first and its size second
+//-------------------------------------------------
+
+static void archive_field(const astring &key, int index, astring &field)
+{
+	int start = 0;
+	for ( ; index > 0 && start >= 0; index--)
+	{
+		start = key.chr(start, '|');
+		if (start >= 0)
+			start++;
+	}
+	if (start < 0)
+	{
+		field.reset();
+		return;
+	}
+	int end = key.chr(start, '|');
+	field.cpysubstr(key, start, (end < 0) ? -1 : end - start);
+}
+
+
+
 //**************************************************************************
 //  HASH COLLECTION
 //**************************************************************************
@@ -411,3 +521,235 @@ void hash_collection::copyfrom(const hash_collection &src)
 	// don't copy creators
 	m_creator = NULL;
 }
+
+
+
+//**************************************************************************
+//  HASH CACHE
+//**************************************************************************
+
+//-------------------------------------------------
+//  open - load the cache from the configuration
+//  directory, or just add a reference if it is
+//  already open
+//-------------------------------------------------
+
+void hash_cache::open(emu_options &options)
+{
+	// open and close only happen on the main thread, so the first user can
+	// safely create the lock
+	if (hash_cache_lock == NULL)
+		hash_cache_lock = osd_lock_alloc();
+
+	osd_lock_acquire(hash_cache_lock);
+	if (hash_cache_data != NULL)
+	{
+		hash_cache_data->m_refcount++;
+		osd_lock_release(hash_cache_lock);
+		return;
+	}
+
+	hash_cache_state *state = global_alloc(hash_cache_state);
+	state->m_enabled = options.verify_cache();
+	state->m_reverify = options.reverify();
+	state->m_directory.cpy(options.cfg_directory());
+
+	// read any existing cache; a missing or foreign file just starts us fresh
+	emu_file file(options.cfg_directory(), OPEN_FLAG_READ);
+	if (state->m_enabled && file.open(HASH_CACHE_FILENAME) == FILERR_NONE)
+	{
+		astring line, archive, size, lastarchive;
+		bool valid = false;
+		UINT64 lastsize = 0, lastmtime = 0;
+		bool lastexists = false;
+		while (read_line(file, line))
+		{
+			// the first line must be our header
+			if (!valid)
+			{
+				if (line != HASH_CACHE_HEADER)
+					break;
+				valid = true;
+				continue;
+			}
+
+			// each line is the hashes, the archive's modification time and the key,
+			// separated by tabs
+			int tab1 = line.chr(0, '\t');
+			int tab2 = (tab1 > 0) ? line.chr(tab1 + 1, '\t') : -1;
+			if (tab2 <= tab1 + 1)
+				continue;
+			hash_cache_entry *entry = global_alloc(hash_cache_entry);
+			entry->m_hashes.cpysubstr(line, 0, tab1);
+			astring mtime(line, tab1 + 1, tab2 - tab1 - 1);
+			sscanf(mtime, "%" I64FMT "u", &entry->m_mtime);
+			entry->m_key.cpysubstr(line, tab2 + 1, -1);
+
+			// drop entries for archives that were deleted, replaced or modified;
+			// members of one archive are stored together, so only stat when the
+			// archive changes
+			archive_field(entry->m_key, 0, archive);
+			if (archive != lastarchive)
+			{
+				osd_directory_entry *dirent = osd_stat(archive);
+				lastexists = (dirent != NULL && dirent->type == ENTTYPE_FILE);
+				lastsize = lastexists ? dirent->size : 0;
+				lastmtime = lastexists ? dirent->mtime : 0;
+				if (dirent != NULL)
+					osd_free(dirent);
+				lastarchive.cpy(archive);
+			}
+			archive_field(entry->m_key, 1, size);
+			UINT64 keysize = 0;
+			sscanf(size, "%" I64FMT "u", &keysize);
+			if (!lastexists || keysize != lastsize || entry->m_mtime != lastmtime)
+			{
+				global_free(entry);
+				state->m_dirty = true;
+				continue;
+			}
+			if (state->m_map.add(entry->m_key, entry) != TMERR_NONE)
+			{
+				global_free(entry);
+				continue;
+			}
+			state->m_list.append(*entry);
+		}
+		file.close();
+	}
+
+	hash_cache_data = state;
+	osd_lock_release(hash_cache_lock);
+}
+
+
+//-------------------------------------------------
+//  close - drop a reference; the last one out
+//  writes any changes back to disk
+//-------------------------------------------------
+
+void hash_cache::close()
+{
+	if (hash_cache_lock == NULL)
+		return;
+
+	osd_lock_acquire(hash_cache_lock);
+	hash_cache_state *state = hash_cache_data;
+	if (state == NULL || --state->m_refcount > 0)
+	{
+		osd_lock_release(hash_cache_lock);
+		return;
+	}
+	hash_cache_data = NULL;
+	osd_lock_release(hash_cache_lock);
+
+	// the last user is gone, and nobody else may be hashing by now
+	osd_lock_free(hash_cache_lock);
+	hash_cache_lock = NULL;
+
+	// write out the updated cache
+	if (state->m_dirty)
+	{
+		emu_file file(state->m_directory, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+		if (file.open(HASH_CACHE_FILENAME) == FILERR_NONE)
+		{
+			astring archive, lastarchive;
+			UINT64 lastmtime = 0;
+			file.printf("%s\n", HASH_CACHE_HEADER);
+			for (hash_cache_entry *entry = state->m_list.first(); entry != NULL; entry = entry->next())
+			{
+				// entries added this run pick up their archive's current time
+				if (entry->m_mtime == 0)
+				{
+					archive_field(entry->m_key, 0, archive);
+					if (archive != lastarchive)
+					{
+						osd_directory_entry *dirent = osd_stat(archive);
+						lastmtime = (dirent != NULL) ? dirent->mtime : 0;
+						if (dirent != NULL)
+							osd_free(dirent);
+						lastarchive.cpy(archive);
+					}
+					entry->m_mtime = lastmtime;
+				}
+				file.printf("%s\t%" I64FMT "u\t%s\n", entry->m_hashes.cstr(), entry->m_mtime, entry->m_key.cstr());
+			}
+		}
+	}
+	global_free(state);
+}
+
+
+//-------------------------------------------------
+//  find - merge any remembered hashes for the
+//  given key into a collection; returns false if
+//  nothing usable was found
+//-------------------------------------------------
+
+bool hash_cache::find(const char *key, hash_collection &hashes)
+{
+	// look up the entry and parse it while we hold the lock
+	hash_collection cached;
+	if (hash_cache_lock == NULL)
+		return false;
+	osd_lock_acquire(hash_cache_lock);
+	hash_cache_state *state = hash_cache_data;
+	hash_cache_entry *entry = (state != NULL && state->m_enabled && !state->m_reverify) ? state->m_map.find(key) : NULL;
+	bool found = (entry != NULL && cached.from_internal_string(entry->m_hashes));
+	osd_lock_release(hash_cache_lock);
+	if (!found)
+		return false;
+
+	// refuse anything that contradicts what the archive itself tells us
+	UINT32 crc, cachedcrc;
+	if (hashes.crc(crc) && (!cached.crc(cachedcrc) || crc != cachedcrc))
+		return false;
+
+	// fill in whatever is missing
+	sha1_t sha1;
+	if (!hashes.crc(crc) && cached.crc(crc))
+		hashes.add_crc(crc);
+	if (!hashes.sha1(sha1) && cached.sha1(sha1))
+		hashes.add_sha1(sha1);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  add - remember a complete set of hashes for
+//  the given key
+//-------------------------------------------------
+
+void hash_cache::add(const char *key, const hash_collection &hashes)
+{
+	// only complete sets are worth remembering
+	UINT32 crc;
+	sha1_t sha1;
+	if (!hashes.crc(crc) || !hashes.sha1(sha1))
+		return;
+	astring string;
+	hashes.internal_string(string);
+
+	if (hash_cache_lock == NULL)
+		return;
+	osd_lock_acquire(hash_cache_lock);
+	hash_cache_state *state = hash_cache_data;
+	if (state != NULL && state->m_enabled)
+	{
+		hash_cache_entry *entry = state->m_map.find(key);
+		if (entry == NULL)
+		{
+			entry = global_alloc(hash_cache_entry);
+			entry->m_key.cpy(key);
+			state->m_map.add(entry->m_key, entry);
+			state->m_list.append(*entry);
+		}
+		if (entry->m_hashes != string)
+		{
+			entry->m_hashes.cpy(string);
+			entry->m_mtime = 0;
+			state->m_dirty = true;
+		}
+	}
+	osd_lock_release(hash_cache_lock);
+}
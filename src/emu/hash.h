@@ -18,6 +18,10 @@
 #include "hashing.h"
 
 
+// forward references
+class emu_options;
+
+
 //**************************************************************************
 //  MACROS
 //**************************************************************************
@@ -117,4 +121,23 @@ private:
 };
 
 
+// ======================> hash_cache
+
+// persistent record of hashes already computed for archived files; keys
+// are built by emu_file from the archive and member metadata, and entries
+// are dropped on load when their archive's size or modification time changed
+class hash_cache
+{
+public:
+	// open/close; main thread only, calls nest, and the cache is written when
+	// the last user closes
+	static void open(emu_options &options);
+	static void close();
+
+	// lookup and update; safe to call from worker threads
+	static bool find(const char *key, hash_collection &hashes);
+	static void add(const char *key, const hash_collection &hashes);
+};
+
+
 #endif  /* __HASH_H__ */
@@ -175,9 +175,12 @@ const char info_xml_creator::s_dtd_string[] =
 //-------------------------------------------------
 
 info_xml_creator::info_xml_creator(driver_enumerator &drivlist)
-	: m_output(NULL),
-		m_drivlist(drivlist),
-		m_lookup_options(m_drivlist.options())
+	: m_drivlist(drivlist),
+		m_lookup_options(m_drivlist.options()),
+		m_fragments(NULL),
+		m_count(0),
+		m_lock(NULL),
+		m_pool(*this)
 {
 	m_lookup_options.remove_device_options();
 }
@@ -190,18 +193,19 @@ info_xml_creator::info_xml_creator(driver_enumerator &drivlist)
 
 void info_xml_creator::output(FILE *out)
 {
-	m_output = out;
+	osd_ticks_t start = osd_ticks();
+	m_timing = output_timing();
 
 	// output the DTD
-	fprintf(m_output, "<?xml version=\"1.0\"?>\n");
+	fprintf(out, "<?xml version=\"1.0\"?>\n");
 	astring dtd(s_dtd_string);
 	dtd.replace(0,"__XML_ROOT__", emulator_info::get_xml_root());
 	dtd.replace(0,"__XML_TOP__", emulator_info::get_xml_top());
 
-	fprintf(m_output, "%s\n\n", dtd.cstr());
+	fprintf(out, "%s\n\n", dtd.cstr());
 
 	// top-level tag
-	fprintf(m_output, "<%s build=\"%s\" debug=\""
+	fprintf(out, "<%s build=\"%s\" debug=\""
 #ifdef MAME_DEBUG
 		"yes"
 #else
@@ -209,19 +213,160 @@ void info_xml_creator::output(FILE *out)
 #endif
 		"\" mameconfig=\"%d\">\n",
 		emulator_info::get_xml_root(),
-		xml_normalize_string(build_version),
+		normalize(build_version),
 		CONFIG_VERSION
 	);
 
-	// iterate through the drivers, outputting one at a time
-	while (m_drivlist.next())
-		output_one();
+	// generate the drivers in parallel, writing them out in driver order
+	output_drivers(out);
 
 	// output devices (both devices with roms and slot devices)
+	osd_ticks_t devstart = osd_ticks();
+	m_output.reset();
 	output_devices();
+	fwrite(m_output.cstr(), 1, m_output.len(), out);
+	m_output.reset();
+	m_timing.devices = osd_ticks() - devstart;
 
 	// close the top level tag
-	fprintf(m_output, "</%s>\n",emulator_info::get_xml_root());
+	fprintf(out, "</%s>\n",emulator_info::get_xml_root());
+	m_timing.total = osd_ticks() - start;
+}
+
+
+//-------------------------------------------------
+//  output_drivers - hand the selected drivers to
+//  a pool of workers, each with its own
+//  enumerator and machine configs, and write
+//  their XML out in driver order as it arrives
+//-------------------------------------------------
+
+void info_xml_creator::output_drivers(FILE *out)
+{
+	// fragments are stored in driver order so they can be written that way
+	m_fragments = global_alloc_array(fragment, m_drivlist.count());
+	m_count = 0;
+	for (int index = 0; index < driver_list::total(); index++)
+		if (m_drivlist.included(index))
+			m_fragments[m_count++].index = index;
+	m_lock = osd_lock_alloc();
+	m_pool.start(m_count);
+
+	// write each fragment as soon as it is ready, stopping at the first error
+	astring error;
+	int exitcode = 0;
+	for (int slot = 0; slot < m_count; slot++)
+	{
+		fragment &frag = m_fragments[slot];
+		osd_ticks_t waitstart = osd_ticks();
+		bool ok = m_pool.wait(slot);
+		m_timing.wait += osd_ticks() - waitstart;
+
+		if (!ok)
+		{
+			error.cpy(m_pool.error(slot));
+			exitcode = m_pool.exitcode(slot);
+			break;
+		}
+		if (frag.text != NULL)
+		{
+			fwrite(frag.text->cstr(), 1, frag.text->len(), out);
+			global_free(frag.text);
+			frag.text = NULL;
+		}
+	}
+
+	// stop handing out drivers and let the workers drain
+	m_pool.finish();
+	for (int slot = 0; slot < m_count; slot++)
+		global_free(m_fragments[slot].text);
+	global_free(m_fragments);
+	m_fragments = NULL;
+	osd_lock_free(m_lock);
+	m_lock = NULL;
+
+	if (error)
+		throw emu_fatalerror(exitcode, "%s", error.cstr());
+}
+
+
+//-------------------------------------------------
+//  work_begin - give a worker its own enumerator
+//  and creator; machine configs are cached per
+//  enumerator, so they can't be shared
+//-------------------------------------------------
+
+void *info_xml_creator::work_begin()
+{
+	worker *state = global_alloc(worker);
+	state->enumerator = global_alloc(driver_enumerator(m_drivlist.options()));
+	state->creator = global_alloc(info_xml_creator(*state->enumerator));
+	return state;
+}
+
+
+//-------------------------------------------------
+//  work_item - generate the XML for one driver
+//-------------------------------------------------
+
+void info_xml_creator::work_item(void *context, int index)
+{
+	worker &state = *reinterpret_cast<worker *>(context);
+	fragment &frag = m_fragments[index];
+	state.enumerator->set_current(frag.index);
+	osd_ticks_t start = osd_ticks();
+	state.enumerator->config();
+	osd_ticks_t configured = osd_ticks();
+	state.creator->output_one();
+	state.timing.config += configured - start;
+	state.timing.generate += osd_ticks() - configured;
+	state.timing.drivers++;
+
+	frag.text = global_alloc(astring);
+	frag.text->cpy(state.creator->m_output);
+	state.creator->m_output.reset();
+}
+
+
+//-------------------------------------------------
+//  work_end - fold a worker's timing into the
+//  total and free its state
+//-------------------------------------------------
+
+void info_xml_creator::work_end(void *context)
+{
+	worker *state = reinterpret_cast<worker *>(context);
+	osd_lock_acquire(m_lock);
+	m_timing.drivers += state->timing.drivers;
+	m_timing.config += state->timing.config;
+	m_timing.generate += state->timing.generate;
+	osd_lock_release(m_lock);
+	global_free(state->creator);
+	global_free(state->enumerator);
+	global_free(state);
+}
+
+
+//-------------------------------------------------
+//  normalize - escape a string for use in XML;
+//  like xml_normalize_string, but the result is
+//  held per creator so workers don't share it
+//-------------------------------------------------
+
+const char *info_xml_creator::normalize(const char *string)
+{
+	m_normalized.reset();
+	if (string != NULL)
+		for ( ; *string != 0; string++)
+			switch (*string)
+			{
+				case '\"' : m_normalized.cat("&quot;"); break;
+				case '&'  : m_normalized.cat("&amp;"); break;
+				case '<'  : m_normalized.cat("&lt;"); break;
+				case '>'  : m_normalized.cat("&gt;"); break;
+				default   : m_normalized.cat(*string); break;
+			}
+	return m_normalized;
 }
 
 
@@ -246,8 +391,8 @@ void info_xml_creator::output_one()
 		portlist.append(*device, errors);
 
 	// print the header and the game name
-	fprintf(m_output, "\t<%s",emulator_info::get_xml_top());
-	fprintf(m_output, " name=\"%s\"", xml_normalize_string(driver.name));
+	m_output.catprintf("\t<%s",emulator_info::get_xml_top());
+	m_output.catprintf(" name=\"%s\"", normalize(driver.name));
 
 	// strip away any path information from the source_file and output it
 	const char *start = strrchr(driver.source_file, '/');
@@ -255,38 +400,38 @@ void info_xml_creator::output_one()
 		start = strrchr(driver.source_file, '\\');
 	if (start == NULL)
 		start = driver.source_file - 1;
-	fprintf(m_output, " sourcefile=\"%s\"", xml_normalize_string(start + 1));
+	m_output.catprintf(" sourcefile=\"%s\"", normalize(start + 1));
 
 	// append bios and runnable flags
 	if (driver.flags & GAME_IS_BIOS_ROOT)
-		fprintf(m_output, " isbios=\"yes\"");
+		m_output.catprintf(" isbios=\"yes\"");
 	if (driver.flags & GAME_NO_STANDALONE)
-		fprintf(m_output, " runnable=\"no\"");
+		m_output.catprintf(" runnable=\"no\"");
 	if (driver.flags & GAME_MECHANICAL)
-		fprintf(m_output, " ismechanical=\"yes\"");
+		m_output.catprintf(" ismechanical=\"yes\"");
 
 	// display clone information
 	int clone_of = m_drivlist.find(driver.parent);
 	if (clone_of != -1 && !(m_drivlist.driver(clone_of).flags & GAME_IS_BIOS_ROOT))
-		fprintf(m_output, " cloneof=\"%s\"", xml_normalize_string(m_drivlist.driver(clone_of).name));
+		m_output.catprintf(" cloneof=\"%s\"", normalize(m_drivlist.driver(clone_of).name));
 	if (clone_of != -1)
-		fprintf(m_output, " romof=\"%s\"", xml_normalize_string(m_drivlist.driver(clone_of).name));
+		m_output.catprintf(" romof=\"%s\"", normalize(m_drivlist.driver(clone_of).name));
 
 	// display sample information and close the game tag
 	output_sampleof();
-	fprintf(m_output, ">\n");
+	m_output.catprintf(">\n");
 
 	// output game description
 	if (driver.description != NULL)
-		fprintf(m_output, "\t\t<description>%s</description>\n", xml_normalize_string(driver.description));
+		m_output.catprintf("\t\t<description>%s</description>\n", normalize(driver.description));
 
 	// print the year only if is a number or another allowed character (? or +)
 	if (driver.year != NULL && strspn(driver.year, "0123456789?+") == strlen(driver.year))
-		fprintf(m_output, "\t\t<year>%s</year>\n", xml_normalize_string(driver.year));
+		m_output.catprintf("\t\t<year>%s</year>\n", normalize(driver.year));
 
 	// print the manufacturer information
 	if (driver.manufacturer != NULL)
-		fprintf(m_output, "\t\t<manufacturer>%s</manufacturer>\n", xml_normalize_string(driver.manufacturer));
+		m_output.catprintf("\t\t<manufacturer>%s</manufacturer>\n", normalize(driver.manufacturer));
 
 	// now print various additional information
 	output_bios();
@@ -308,7 +453,7 @@ void info_xml_creator::output_one()
 	output_ramoptions();
 
 	// close the topmost tag
-	fprintf(m_output, "\t</%s>\n",emulator_info::get_xml_top());
+	m_output.catprintf("\t</%s>\n",emulator_info::get_xml_top());
 }
 
 
@@ -340,13 +485,13 @@ void info_xml_creator::output_one_device(device_t &device, const char *devtag)
 			}
 
 	// start to output info
-	fprintf(m_output, "\t<%s", emulator_info::get_xml_top());
-	fprintf(m_output, " name=\"%s\"", xml_normalize_string(device.shortname()));
-	fprintf(m_output, " sourcefile=\"%s\"", xml_normalize_string(device.source()));
-	fprintf(m_output, " isdevice=\"yes\"");
-	fprintf(m_output, " runnable=\"no\"");
-	fprintf(m_output, ">\n");
-	fprintf(m_output, "\t\t<description>%s</description>\n", xml_normalize_string(device.name()));
+	m_output.catprintf("\t<%s", emulator_info::get_xml_top());
+	m_output.catprintf(" name=\"%s\"", normalize(device.shortname()));
+	m_output.catprintf(" sourcefile=\"%s\"", normalize(device.source()));
+	m_output.catprintf(" isdevice=\"yes\"");
+	m_output.catprintf(" runnable=\"no\"");
+	m_output.catprintf(">\n");
+	m_output.catprintf("\t\t<description>%s</description>\n", normalize(device.name()));
 
 	output_rom(device);
 
@@ -364,7 +509,7 @@ void info_xml_creator::output_one_device(device_t &device, const char *devtag)
 	output_adjusters(portlist);
 	output_images(device, devtag);
 	output_slots(device, devtag);
-	fprintf(m_output, "\t</%s>\n", emulator_info::get_xml_top());
+	m_output.catprintf("\t</%s>\n", emulator_info::get_xml_top());
 }
 
 
@@ -431,7 +576,7 @@ void info_xml_creator::output_device_roms()
 	device_iterator deviter(m_drivlist.config().root_device());
 	for (device_t *device = deviter.first(); device != NULL; device = deviter.next())
 		if (device->owner() != NULL && device->shortname()!= NULL && strlen(device->shortname())!=0)
-			fprintf(m_output, "\t\t<device_ref name=\"%s\"/>\n", xml_normalize_string(device->shortname()));
+			m_output.catprintf("\t\t<device_ref name=\"%s\"/>\n", normalize(device->shortname()));
 }
 
 
@@ -449,7 +594,7 @@ void info_xml_creator::output_sampleof()
 		samples_iterator sampiter(*device);
 		if (sampiter.altbasename() != NULL)
 		{
-			fprintf(m_output, " sampleof=\"%s\"", xml_normalize_string(sampiter.altbasename()));
+			m_output.catprintf(" sampleof=\"%s\"", normalize(sampiter.altbasename()));
 
 			// must stop here, as there can only be one attribute of the same name
 			return;
@@ -474,12 +619,12 @@ void info_xml_creator::output_bios()
 		if (ROMENTRY_ISSYSTEM_BIOS(rom))
 		{
 			// output extracted name and descriptions
-			fprintf(m_output, "\t\t<biosset");
-			fprintf(m_output, " name=\"%s\"", xml_normalize_string(ROM_GETNAME(rom)));
-			fprintf(m_output, " description=\"%s\"", xml_normalize_string(ROM_GETHASHDATA(rom)));
+			m_output.catprintf("\t\t<biosset");
+			m_output.catprintf(" name=\"%s\"", normalize(ROM_GETNAME(rom)));
+			m_output.catprintf(" description=\"%s\"", normalize(ROM_GETHASHDATA(rom)));
 			if (ROM_GETBIOSFLAGS(rom) == 1)
-				fprintf(m_output, " default=\"yes\"");
-			fprintf(m_output, "/>\n");
+				m_output.catprintf(" default=\"yes\"");
+			m_output.catprintf("/>\n");
 		}
 }
 
@@ -543,11 +688,11 @@ void info_xml_creator::output_rom(device_t &device)
 
 				// add name, merge, bios, and size tags */
 				if (name != NULL && name[0] != 0)
-					output.catprintf(" name=\"%s\"", xml_normalize_string(name));
+					output.catprintf(" name=\"%s\"", normalize(name));
 				if (merge_name != NULL)
-					output.catprintf(" merge=\"%s\"", xml_normalize_string(merge_name));
+					output.catprintf(" merge=\"%s\"", normalize(merge_name));
 				if (bios_name[0] != 0)
-					output.catprintf(" bios=\"%s\"", xml_normalize_string(bios_name));
+					output.catprintf(" bios=\"%s\"", normalize(bios_name));
 				if (!is_disk)
 					output.catprintf(" size=\"%d\"", rom_file_size(rom));
 
@@ -581,7 +726,7 @@ void info_xml_creator::output_rom(device_t &device)
 
 				output.cat("/>\n");
 
-				fprintf(m_output, "%s", output.cstr());
+				m_output.cat(output);
 			}
 		}
 }
@@ -607,7 +752,7 @@ void info_xml_creator::output_sample(device_t &device)
 				continue;
 
 			// output the sample name
-			fprintf(m_output, "\t\t<sample name=\"%s\"/>\n", xml_normalize_string(samplename));
+			m_output.catprintf("\t\t<sample name=\"%s\"/>\n", normalize(samplename));
 		}
 	}
 }
@@ -629,12 +774,12 @@ void info_xml_creator::output_chips(device_t &device, const char *root_tag)
 			astring newtag(exec->device().tag()), oldtag(":");
 			newtag.substr(newtag.find(oldtag.cat(root_tag)) + oldtag.len());
 
-			fprintf(m_output, "\t\t<chip");
-			fprintf(m_output, " type=\"cpu\"");
-			fprintf(m_output, " tag=\"%s\"", xml_normalize_string(newtag));
-			fprintf(m_output, " name=\"%s\"", xml_normalize_string(exec->device().name()));
-			fprintf(m_output, " clock=\"%d\"", exec->device().clock());
-			fprintf(m_output, "/>\n");
+			m_output.catprintf("\t\t<chip");
+			m_output.catprintf(" type=\"cpu\"");
+			m_output.catprintf(" tag=\"%s\"", normalize(newtag));
+			m_output.catprintf(" name=\"%s\"", normalize(exec->device().name()));
+			m_output.catprintf(" clock=\"%d\"", exec->device().clock());
+			m_output.catprintf("/>\n");
 		}
 	}
 
@@ -647,13 +792,13 @@ void info_xml_creator::output_chips(device_t &device, const char *root_tag)
 			astring newtag(sound->device().tag()), oldtag(":");
 			newtag.substr(newtag.find(oldtag.cat(root_tag)) + oldtag.len());
 
-			fprintf(m_output, "\t\t<chip");
-			fprintf(m_output, " type=\"audio\"");
-			fprintf(m_output, " tag=\"%s\"", xml_normalize_string(newtag));
-			fprintf(m_output, " name=\"%s\"", xml_normalize_string(sound->device().name()));
+			m_output.catprintf("\t\t<chip");
+			m_output.catprintf(" type=\"audio\"");
+			m_output.catprintf(" tag=\"%s\"", normalize(newtag));
+			m_output.catprintf(" name=\"%s\"", normalize(sound->device().name()));
 			if (sound->device().clock() != 0)
-				fprintf(m_output, " clock=\"%d\"", sound->device().clock());
-			fprintf(m_output, "/>\n");
+				m_output.catprintf(" clock=\"%d\"", sound->device().clock());
+			m_output.catprintf("/>\n");
 		}
 	}
 }
@@ -675,43 +820,43 @@ void info_xml_creator::output_display(device_t &device, const char *root_tag)
 			astring newtag(screendev->tag()), oldtag(":");
 			newtag.substr(newtag.find(oldtag.cat(root_tag)) + oldtag.len());
 
-			fprintf(m_output, "\t\t<display");
-			fprintf(m_output, " tag=\"%s\"", xml_normalize_string(newtag));
+			m_output.catprintf("\t\t<display");
+			m_output.catprintf(" tag=\"%s\"", normalize(newtag));
 
 			switch (screendev->screen_type())
 			{
-				case SCREEN_TYPE_RASTER:    fprintf(m_output, " type=\"raster\"");  break;
-				case SCREEN_TYPE_VECTOR:    fprintf(m_output, " type=\"vector\"");  break;
-				case SCREEN_TYPE_LCD:       fprintf(m_output, " type=\"lcd\"");     break;
-				default:                    fprintf(m_output, " type=\"unknown\""); break;
+				case SCREEN_TYPE_RASTER:    m_output.catprintf(" type=\"raster\"");  break;
+				case SCREEN_TYPE_VECTOR:    m_output.catprintf(" type=\"vector\"");  break;
+				case SCREEN_TYPE_LCD:       m_output.catprintf(" type=\"lcd\"");     break;
+				default:                    m_output.catprintf(" type=\"unknown\""); break;
 			}
 
 			// output the orientation as a string
 			switch (m_drivlist.driver().flags & ORIENTATION_MASK)
 			{
 				case ORIENTATION_FLIP_X:
-					fprintf(m_output, " rotate=\"0\" flipx=\"yes\"");
+					m_output.catprintf(" rotate=\"0\" flipx=\"yes\"");
 					break;
 				case ORIENTATION_FLIP_Y:
-					fprintf(m_output, " rotate=\"180\" flipx=\"yes\"");
+					m_output.catprintf(" rotate=\"180\" flipx=\"yes\"");
 					break;
 				case ORIENTATION_FLIP_X|ORIENTATION_FLIP_Y:
-					fprintf(m_output, " rotate=\"180\"");
+					m_output.catprintf(" rotate=\"180\"");
 					break;
 				case ORIENTATION_SWAP_XY:
-					fprintf(m_output, " rotate=\"90\" flipx=\"yes\"");
+					m_output.catprintf(" rotate=\"90\" flipx=\"yes\"");
 					break;
 				case ORIENTATION_SWAP_XY|ORIENTATION_FLIP_X:
-					fprintf(m_output, " rotate=\"90\"");
+					m_output.catprintf(" rotate=\"90\"");
 					break;
 				case ORIENTATION_SWAP_XY|ORIENTATION_FLIP_Y:
-					fprintf(m_output, " rotate=\"270\"");
+					m_output.catprintf(" rotate=\"270\"");
 					break;
 				case ORIENTATION_SWAP_XY|ORIENTATION_FLIP_X|ORIENTATION_FLIP_Y:
-					fprintf(m_output, " rotate=\"270\" flipx=\"yes\"");
+					m_output.catprintf(" rotate=\"270\" flipx=\"yes\"");
 					break;
 				default:
-					fprintf(m_output, " rotate=\"0\"");
+					m_output.catprintf(" rotate=\"0\"");
 					break;
 			}
 
@@ -719,12 +864,12 @@ void info_xml_creator::output_display(device_t &device, const char *root_tag)
 			if (screendev->screen_type() != SCREEN_TYPE_VECTOR)
 			{
 				const rectangle &visarea = screendev->visible_area();
-				fprintf(m_output, " width=\"%d\"", visarea.width());
-				fprintf(m_output, " height=\"%d\"", visarea.height());
+				m_output.catprintf(" width=\"%d\"", visarea.width());
+				m_output.catprintf(" height=\"%d\"", visarea.height());
 			}
 
 			// output refresh rate
-			fprintf(m_output, " refresh=\"%f\"", ATTOSECONDS_TO_HZ(screendev->refresh_attoseconds()));
+			m_output.catprintf(" refresh=\"%f\"", ATTOSECONDS_TO_HZ(screendev->refresh_attoseconds()));
 
 			// output raw video parameters only for games that are not vector
 			// and had raw parameters specified
@@ -732,15 +877,15 @@ void info_xml_creator::output_display(device_t &device, const char *root_tag)
 			{
 				int pixclock = screendev->width() * screendev->height() * ATTOSECONDS_TO_HZ(screendev->refresh_attoseconds());
 
-				fprintf(m_output, " pixclock=\"%d\"", pixclock);
-				fprintf(m_output, " htotal=\"%d\"", screendev->width());
-				fprintf(m_output, " hbend=\"%d\"", screendev->visible_area().min_x);
-				fprintf(m_output, " hbstart=\"%d\"", screendev->visible_area().max_x+1);
-				fprintf(m_output, " vtotal=\"%d\"", screendev->height());
-				fprintf(m_output, " vbend=\"%d\"", screendev->visible_area().min_y);
-				fprintf(m_output, " vbstart=\"%d\"", screendev->visible_area().max_y+1);
+				m_output.catprintf(" pixclock=\"%d\"", pixclock);
+				m_output.catprintf(" htotal=\"%d\"", screendev->width());
+				m_output.catprintf(" hbend=\"%d\"", screendev->visible_area().min_x);
+				m_output.catprintf(" hbstart=\"%d\"", screendev->visible_area().max_x+1);
+				m_output.catprintf(" vtotal=\"%d\"", screendev->height());
+				m_output.catprintf(" vbend=\"%d\"", screendev->visible_area().min_y);
+				m_output.catprintf(" vbstart=\"%d\"", screendev->visible_area().max_y+1);
 			}
-			fprintf(m_output, " />\n");
+			m_output.catprintf(" />\n");
 		}
 	}
 }
@@ -761,7 +906,7 @@ void info_xml_creator::output_sound(device_t &device)
 	if (snditer.first() == NULL)
 		speakers = 0;
 
-	fprintf(m_output, "\t\t<sound channels=\"%d\"/>\n", speakers);
+	m_output.catprintf("\t\t<sound channels=\"%d\"/>\n", speakers);
 }
 
 
@@ -970,17 +1115,17 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 		}
 
 	// output the basic info
-	fprintf(m_output, "\t\t<input");
-	fprintf(m_output, " players=\"%d\"", nplayer);
+	m_output.catprintf("\t\t<input");
+	m_output.catprintf(" players=\"%d\"", nplayer);
 	if (nbutton != 0)
-		fprintf(m_output, " buttons=\"%d\"", nbutton);
+		m_output.catprintf(" buttons=\"%d\"", nbutton);
 	if (ncoin != 0)
-		fprintf(m_output, " coins=\"%d\"", ncoin);
+		m_output.catprintf(" coins=\"%d\"", ncoin);
 	if (service)
-		fprintf(m_output, " service=\"yes\"");
+		m_output.catprintf(" service=\"yes\"");
 	if (tilt)
-		fprintf(m_output, " tilt=\"yes\"");
-	fprintf(m_output, ">\n");
+		m_output.catprintf(" tilt=\"yes\"");
+	m_output.catprintf(">\n");
 
 	// output the joystick types
 	if (joytype[1]==0 && joytype[2]!=0) { joytype[1] = joytype[2]; joytype[2] = 0; }
@@ -989,7 +1134,7 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 	if (joytype[0] != 0)
 	{
 		const char *joys = (joytype[2]!=0) ? "triple" : (joytype[1]!=0) ? "double" : "";
-		fprintf(m_output, "\t\t\t<control type=\"%sjoy\"", joys);
+		m_output.catprintf("\t\t\t<control type=\"%sjoy\"", joys);
 		for (int lp=0; lp<3 && joytype[lp]!=0; lp++)
 		{
 			const char *plural = (lp==2) ? "3" : (lp==1) ? "2" : "";
@@ -1021,46 +1166,46 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 					ways = "strange2";
 					break;
 			}
-			fprintf(m_output, " ways%s=\"%s\"", plural,ways);
+			m_output.catprintf(" ways%s=\"%s\"", plural,ways);
 		}
-		fprintf(m_output, "/>\n");
+		m_output.catprintf("/>\n");
 	}
 
 	// output analog types
 	for (int type = 0; type < ANALOG_TYPE_COUNT; type++)
 		if (control_info[type].type != NULL)
 		{
-			fprintf(m_output, "\t\t\t<control type=\"%s\"", xml_normalize_string(control_info[type].type));
+			m_output.catprintf("\t\t\t<control type=\"%s\"", normalize(control_info[type].type));
 			if (control_info[type].min != 0 || control_info[type].max != 0)
 			{
-				fprintf(m_output, " minimum=\"%d\"", control_info[type].min);
-				fprintf(m_output, " maximum=\"%d\"", control_info[type].max);
+				m_output.catprintf(" minimum=\"%d\"", control_info[type].min);
+				m_output.catprintf(" maximum=\"%d\"", control_info[type].max);
 			}
 			if (control_info[type].sensitivity != 0)
-				fprintf(m_output, " sensitivity=\"%d\"", control_info[type].sensitivity);
+				m_output.catprintf(" sensitivity=\"%d\"", control_info[type].sensitivity);
 			if (control_info[type].keydelta != 0)
-				fprintf(m_output, " keydelta=\"%d\"", control_info[type].keydelta);
+				m_output.catprintf(" keydelta=\"%d\"", control_info[type].keydelta);
 			if (control_info[type].reverse)
-				fprintf(m_output, " reverse=\"yes\"");
+				m_output.catprintf(" reverse=\"yes\"");
 
-			fprintf(m_output, "/>\n");
+			m_output.catprintf("/>\n");
 		}
 
 	// output keypad and keyboard
 	if (keypad)
-		fprintf(m_output, "\t\t\t<control type=\"keypad\"/>\n");
+		m_output.catprintf("\t\t\t<control type=\"keypad\"/>\n");
 	if (keyboard)
-		fprintf(m_output, "\t\t\t<control type=\"keyboard\"/>\n");
+		m_output.catprintf("\t\t\t<control type=\"keyboard\"/>\n");
 
 	// misc
 	if (mahjong)
-		fprintf(m_output, "\t\t\t<control type=\"mahjong\"/>\n");
+		m_output.catprintf("\t\t\t<control type=\"mahjong\"/>\n");
 	if (hanafuda)
-		fprintf(m_output, "\t\t\t<control type=\"hanafuda\"/>\n");
+		m_output.catprintf("\t\t\t<control type=\"hanafuda\"/>\n");
 	if (gambling)
-		fprintf(m_output, "\t\t\t<control type=\"gambling\"/>\n");
+		m_output.catprintf("\t\t\t<control type=\"gambling\"/>\n");
 
-	fprintf(m_output, "\t\t</input>\n");
+	m_output.catprintf("\t\t</input>\n");
 }
 
 
@@ -1082,20 +1227,20 @@ void info_xml_creator::output_switches(const ioport_list &portlist, const char *
 				newtag.substr(newtag.find(oldtag.cat(root_tag)) + oldtag.len());
 
 				// output the switch name information
-				astring normalized_field_name(xml_normalize_string(field->name()));
-				astring normalized_newtag(xml_normalize_string(newtag));
+				astring normalized_field_name(normalize(field->name()));
+				astring normalized_newtag(normalize(newtag));
 				output.catprintf("\t\t<%s name=\"%s\" tag=\"%s\" mask=\"%u\">\n", outertag, normalized_field_name.cstr(), normalized_newtag.cstr(), field->mask());
 
 				// loop over settings
 				for (ioport_setting *setting = field->first_setting(); setting != NULL; setting = setting->next())
 				{
-					output.catprintf("\t\t\t<%s name=\"%s\" value=\"%u\"%s/>\n", innertag, xml_normalize_string(setting->name()), setting->value(), setting->value() == field->defvalue() ? " default=\"yes\"" : "");
+					output.catprintf("\t\t\t<%s name=\"%s\" value=\"%u\"%s/>\n", innertag, normalize(setting->name()), setting->value(), setting->value() == field->defvalue() ? " default=\"yes\"" : "");
 				}
 
 				// terminate the switch entry
 				output.catprintf("\t\t</%s>\n", outertag);
 
-				fprintf(m_output, "%s", output.cstr());
+				m_output.cat(output);
 			}
 }
 
@@ -1108,14 +1253,14 @@ void info_xml_creator::output_ports(const ioport_list &portlist)
 	// cycle through ports
 	for (ioport_port *port = portlist.first(); port != NULL; port = port->next())
 	{
-		fprintf(m_output,"\t\t<port tag=\"%s\">\n",port->tag());
+		m_output.catprintf("\t\t<port tag=\"%s\">\n",port->tag());
 		for (ioport_field *field = port->first_field(); field != NULL; field = field->next())
 		{
 			if(field->is_analog())
-				fprintf(m_output,"\t\t\t<analog mask=\"%u\"/>\n",field->mask());
+				m_output.catprintf("\t\t\t<analog mask=\"%u\"/>\n",field->mask());
 		}
 		// close element
-		fprintf(m_output,"\t\t</port>\n");
+		m_output.catprintf("\t\t</port>\n");
 	}
 
 }
@@ -1131,7 +1276,7 @@ void info_xml_creator::output_adjusters(const ioport_list &portlist)
 	for (ioport_port *port = portlist.first(); port != NULL; port = port->next())
 		for (ioport_field *field = port->first_field(); field != NULL; field = field->next())
 			if (field->type() == IPT_ADJUSTER)
-				fprintf(m_output, "\t\t<adjuster name=\"%s\" default=\"%d\"/>\n", xml_normalize_string(field->name()), field->defvalue());
+				m_output.catprintf("\t\t<adjuster name=\"%s\" default=\"%d\"/>\n", normalize(field->name()), field->defvalue());
 }
 
 
@@ -1141,7 +1286,7 @@ void info_xml_creator::output_adjusters(const ioport_list &portlist)
 
 void info_xml_creator::output_driver()
 {
-	fprintf(m_output, "\t\t<driver");
+	m_output.catprintf("\t\t<driver");
 
 	/* The status entry is an hint for frontend authors */
 	/* to select working and not working games without */
@@ -1152,50 +1297,50 @@ void info_xml_creator::output_driver()
 	/* don't work or have major emulation problems. */
 
 	if (m_drivlist.driver().flags & (GAME_NOT_WORKING | GAME_UNEMULATED_PROTECTION | GAME_NO_SOUND | GAME_WRONG_COLORS | GAME_MECHANICAL))
-		fprintf(m_output, " status=\"preliminary\"");
+		m_output.catprintf(" status=\"preliminary\"");
 	else if (m_drivlist.driver().flags & (GAME_IMPERFECT_COLORS | GAME_IMPERFECT_SOUND | GAME_IMPERFECT_GRAPHICS))
-		fprintf(m_output, " status=\"imperfect\"");
+		m_output.catprintf(" status=\"imperfect\"");
 	else
-		fprintf(m_output, " status=\"good\"");
+		m_output.catprintf(" status=\"good\"");
 
 	if (m_drivlist.driver().flags & GAME_NOT_WORKING)
-		fprintf(m_output, " emulation=\"preliminary\"");
+		m_output.catprintf(" emulation=\"preliminary\"");
 	else
-		fprintf(m_output, " emulation=\"good\"");
+		m_output.catprintf(" emulation=\"good\"");
 
 	if (m_drivlist.driver().flags & GAME_WRONG_COLORS)
-		fprintf(m_output, " color=\"preliminary\"");
+		m_output.catprintf(" color=\"preliminary\"");
 	else if (m_drivlist.driver().flags & GAME_IMPERFECT_COLORS)
-		fprintf(m_output, " color=\"imperfect\"");
+		m_output.catprintf(" color=\"imperfect\"");
 	else
-		fprintf(m_output, " color=\"good\"");
+		m_output.catprintf(" color=\"good\"");
 
 	if (m_drivlist.driver().flags & GAME_NO_SOUND)
-		fprintf(m_output, " sound=\"preliminary\"");
+		m_output.catprintf(" sound=\"preliminary\"");
 	else if (m_drivlist.driver().flags & GAME_IMPERFECT_SOUND)
-		fprintf(m_output, " sound=\"imperfect\"");
+		m_output.catprintf(" sound=\"imperfect\"");
 	else
-		fprintf(m_output, " sound=\"good\"");
+		m_output.catprintf(" sound=\"good\"");
 
 	if (m_drivlist.driver().flags & GAME_IMPERFECT_GRAPHICS)
-		fprintf(m_output, " graphic=\"imperfect\"");
+		m_output.catprintf(" graphic=\"imperfect\"");
 	else
-		fprintf(m_output, " graphic=\"good\"");
+		m_output.catprintf(" graphic=\"good\"");
 
 	if (m_drivlist.driver().flags & GAME_NO_COCKTAIL)
-		fprintf(m_output, " cocktail=\"preliminary\"");
+		m_output.catprintf(" cocktail=\"preliminary\"");
 
 	if (m_drivlist.driver().flags & GAME_UNEMULATED_PROTECTION)
-		fprintf(m_output, " protection=\"preliminary\"");
+		m_output.catprintf(" protection=\"preliminary\"");
 
 	if (m_drivlist.driver().flags & GAME_SUPPORTS_SAVE)
-		fprintf(m_output, " savestate=\"supported\"");
+		m_output.catprintf(" savestate=\"supported\"");
 	else
-		fprintf(m_output, " savestate=\"unsupported\"");
+		m_output.catprintf(" savestate=\"unsupported\"");
 
-	fprintf(m_output, " palettesize=\"%d\"", m_drivlist.config().m_total_colors);
+	m_output.catprintf(" palettesize=\"%d\"", m_drivlist.config().m_total_colors);
 
-	fprintf(m_output, "/>\n");
+	m_output.catprintf("/>\n");
 }
 
 
@@ -1215,42 +1360,47 @@ void info_xml_creator::output_images(device_t &device, const char *root_tag)
 			newtag.substr(newtag.find(oldtag.cat(root_tag)) + oldtag.len());
 
 			// print m_output device type
-			fprintf(m_output, "\t\t<device type=\"%s\"", xml_normalize_string(imagedev->image_type_name()));
+			m_output.catprintf("\t\t<device type=\"%s\"", normalize(imagedev->image_type_name()));
 
 			// does this device have a tag?
 			if (imagedev->device().tag())
-				fprintf(m_output, " tag=\"%s\"", xml_normalize_string(newtag));
+				m_output.catprintf(" tag=\"%s\"", normalize(newtag));
 
 			// is this device mandatory?
 			if (imagedev->must_be_loaded())
-				fprintf(m_output, " mandatory=\"1\"");
+				m_output.catprintf(" mandatory=\"1\"");
 
 			if (imagedev->image_interface() && imagedev->image_interface()[0])
-				fprintf(m_output, " interface=\"%s\"", xml_normalize_string(imagedev->image_interface()));
+				m_output.catprintf(" interface=\"%s\"", normalize(imagedev->image_interface()));
 
 			// close the XML tag
-			fprintf(m_output, ">\n");
+			m_output.catprintf(">\n");
 
 			const char *name = imagedev->instance_name();
 			const char *shortname = imagedev->brief_instance_name();
 
-			fprintf(m_output, "\t\t\t<instance");
-			fprintf(m_output, " name=\"%s\"", xml_normalize_string(name));
-			fprintf(m_output, " briefname=\"%s\"", xml_normalize_string(shortname));
-			fprintf(m_output, "/>\n");
+			m_output.catprintf("\t\t\t<instance");
+			m_output.catprintf(" name=\"%s\"", normalize(name));
+			m_output.catprintf(" briefname=\"%s\"", normalize(shortname));
+			m_output.catprintf("/>\n");
 
 			astring extensions(imagedev->file_extensions());
 
-			char *ext = strtok((char *)extensions.cstr(), ",");
-			while (ext != NULL)
+			for (int start = 0, end = extensions.chr(0, ','); start < extensions.len(); start = end + 1, end = extensions.chr(start, ','))
 			{
-				fprintf(m_output, "\t\t\t<extension");
-				fprintf(m_output, " name=\"%s\"", xml_normalize_string(ext));
-				fprintf(m_output, "/>\n");
-				ext = strtok(NULL, ",");
+				astring ext;
+				ext.cpysubstr(extensions, start, (end == -1) ? -1 : end - start);
+				if (ext)
+				{
+					m_output.catprintf("\t\t\t<extension");
+					m_output.catprintf(" name=\"%s\"", normalize(ext));
+					m_output.catprintf("/>\n");
+				}
+				if (end == -1)
+					break;
 			}
 
-			fprintf(m_output, "\t\t</device>\n");
+			m_output.catprintf("\t\t</device>\n");
 		}
 	}
 }
@@ -1273,11 +1423,11 @@ void info_xml_creator::output_slots(device_t &device, const char *root_tag)
 			newtag.substr(newtag.find(oldtag.cat(root_tag)) + oldtag.len());
 
 			// print m_output device type
-			fprintf(m_output, "\t\t<slot name=\"%s\">\n", xml_normalize_string(newtag));
+			m_output.catprintf("\t\t<slot name=\"%s\">\n", normalize(newtag));
 
 			/*
 			 if (slot->slot_interface()[0])
-			 fprintf(m_output, " interface=\"%s\"", xml_normalize_string(slot->slot_interface()));
+			 m_output.catprintf(" interface=\"%s\"", normalize(slot->slot_interface()));
 			 */
 
 			for (const device_slot_option *option = slot->first_option(); option != NULL; option = option->next())
@@ -1286,19 +1436,19 @@ void info_xml_creator::output_slots(device_t &device, const char *root_tag)
 				if (!dev->configured())
 					dev->config_complete();
 
-				fprintf(m_output, "\t\t\t<slotoption");
-				fprintf(m_output, " name=\"%s\"", xml_normalize_string(option->name()));
-				fprintf(m_output, " devname=\"%s\"", xml_normalize_string(dev->shortname()));
+				m_output.catprintf("\t\t\t<slotoption");
+				m_output.catprintf(" name=\"%s\"", normalize(option->name()));
+				m_output.catprintf(" devname=\"%s\"", normalize(dev->shortname()));
 				if (slot->default_option())
 				{
 					if (strcmp(slot->default_option(),option->name())==0)
-						fprintf(m_output, " default=\"yes\"");
+						m_output.catprintf(" default=\"yes\"");
 				}
-				fprintf(m_output, "/>\n");
+				m_output.catprintf("/>\n");
 				const_cast<machine_config &>(m_drivlist.config()).device_remove(&m_drivlist.config().root_device(), "dummy");
 			}
 
-			fprintf(m_output, "\t\t</slot>\n");
+			m_output.catprintf("\t\t</slot>\n");
 		}
 	}
 }
@@ -1314,12 +1464,12 @@ void info_xml_creator::output_software_list()
 	software_list_device_iterator iter(m_drivlist.config().root_device());
 	for (const software_list_device *swlist = iter.first(); swlist != NULL; swlist = iter.next())
 	{
-		fprintf(m_output, "\t\t<softwarelist name=\"%s\" ", swlist->list_name());
-		fprintf(m_output, "status=\"%s\" ", (swlist->list_type() == SOFTWARE_LIST_ORIGINAL_SYSTEM) ? "original" : "compatible");
+		m_output.catprintf("\t\t<softwarelist name=\"%s\" ", swlist->list_name());
+		m_output.catprintf("status=\"%s\" ", (swlist->list_type() == SOFTWARE_LIST_ORIGINAL_SYSTEM) ? "original" : "compatible");
 		if (swlist->filter()) {
-			fprintf(m_output, "filter=\"%s\" ", swlist->filter());
+			m_output.catprintf("filter=\"%s\" ", swlist->filter());
 		}
-		fprintf(m_output, "/>\n");
+		m_output.catprintf("/>\n");
 	}
 }
 
@@ -1335,7 +1485,7 @@ void info_xml_creator::output_ramoptions()
 	ram_device_iterator iter(m_drivlist.config().root_device());
 	for (const ram_device *ram = iter.first(); ram != NULL; ram = iter.next())
 	{
-		fprintf(m_output, "\t\t<ramoption default=\"1\">%u</ramoption>\n", ram->default_size());
+		m_output.catprintf("\t\t<ramoption default=\"1\">%u</ramoption>\n", ram->default_size());
 
 		if (ram->extra_options() != NULL)
 		{
@@ -1344,7 +1494,7 @@ void info_xml_creator::output_ramoptions()
 			{
 				astring option;
 				option.cpysubstr(options, start, (end == -1) ? -1 : end - start);
-				fprintf(m_output, "\t\t<ramoption>%u</ramoption>\n", ram_device::parse_string(option));
+				m_output.catprintf("\t\t<ramoption>%u</ramoption>\n", ram_device::parse_string(option));
 				if (end == -1)
 					break;
 			}
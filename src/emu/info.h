@@ -14,6 +14,7 @@
 #define __INFO_H__
 
 #include "drivenum.h"
+#include "workpool.h"
 
 
 //**************************************************************************
@@ -21,16 +22,57 @@
 //**************************************************************************
 
 // helper class to putput
-class info_xml_creator
+class info_xml_creator : public ordered_work_client
 {
 public:
 	// construction/destruction
 	info_xml_creator(driver_enumerator &drivlist);
 
+	// where the time went during output(); config and generate are summed
+	// over all worker threads, the rest are wall-clock on the calling thread
+	struct output_timing
+	{
+		output_timing() : drivers(0), config(0), generate(0), wait(0), devices(0), total(0) { }
+
+		int             drivers;            // number of drivers generated
+		osd_ticks_t     config;             // building machine configs
+		osd_ticks_t     generate;           // walking them into XML
+		osd_ticks_t     wait;               // waiting for the next driver in order
+		osd_ticks_t     devices;            // the serial device section
+		osd_ticks_t     total;              // the whole of output()
+	};
+
 	// output
 	void output(FILE *out);
 
+	// getters
+	const output_timing &timing() const { return m_timing; }
+
 private:
+	// the XML for one driver, generated by a worker
+	struct fragment
+	{
+		fragment() : index(-1), text(NULL) { }
+
+		int                     index;              // driver index
+		astring *               text;               // generated XML
+	};
+
+	// each worker's own enumerator and creator, and the time they took
+	struct worker
+	{
+		driver_enumerator *     enumerator;
+		info_xml_creator *      creator;
+		output_timing           timing;
+	};
+
+	// parallel generation
+	void output_drivers(FILE *out);
+	virtual void *work_begin();
+	virtual void work_item(void *context, int index);
+	virtual void work_end(void *context);
+	const char *normalize(const char *string);
+
 	// internal helper
 	void output_one();
 	void output_sampleof();
@@ -57,10 +99,18 @@ private:
 	const char *get_merge_name(const hash_collection &romhashes);
 
 	// internal state
-	FILE *                  m_output;
+	astring                 m_output;
+	astring                 m_normalized;
 	driver_enumerator &     m_drivlist;
 	emu_options             m_lookup_options;
 
+	// parallel generation state
+	fragment *              m_fragments;
+	int                     m_count;
+	osd_lock *              m_lock;
+	output_timing           m_timing;
+	ordered_work_pool       m_pool;
+
 	static const char s_dtd_string[];
 };
 
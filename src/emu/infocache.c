@@ -0,0 +1,390 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    infocache.c
+
+    Cache of per-driver machine information for the listing commands.
+
+****************************************************************************
+
+    Building a machine_config for every driver dominates the run time of
+    the listing commands. With -listing_cache enabled, the parts of each
+    configuration they use are saved to listing.cache in the cfg
+    directory and read back on later runs instead.
+
+    The file is plain text. The first line names the build that wrote
+    it; a cache from any other build is ignored and rewritten. Each
+    driver is a line holding '@' and the driver name, followed by one
+    tab-separated line per item:
+
+        V  tag  shortname  clock  name          for each device
+        R  device  length  name  hashdata       for each ROM file
+        M  instance  brief  extensions          for each image device
+        S  tag                                  for each configurable slot
+        O  option  name                         for its selectable options
+        L  listname                             for each software list
+
+***************************************************************************/
+
+#include "emu.h"
+#include "emuopts.h"
+#include "infocache.h"
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+#define INFO_CACHE_NAME         "listing"
+#define INFO_CACHE_EXT          ".cache"
+#define INFO_CACHE_HEADER       "# listing cache v1 "
+
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  append_field - append a tab and a field to a
+//  record, keeping the field on one line
+//-------------------------------------------------
+
+static inline void append_field(astring &record, const char *field)
+{
+	astring text((field != NULL) ? field : "");
+	record.cat("\t").cat(text.replacechr('\t', ' ').replacechr('\n', ' '));
+}
+
+
+
+//**************************************************************************
+//  MACHINE INFO
+//**************************************************************************
+
+//-------------------------------------------------
+//  machine_info - constructor
+//-------------------------------------------------
+
+machine_info::machine_info()
+{
+}
+
+
+//-------------------------------------------------
+//  reset - forget the current driver
+//-------------------------------------------------
+
+void machine_info::reset()
+{
+	m_fields.resize(0);
+	m_devices.resize(0);
+	m_roms.resize(0);
+	m_media.resize(0);
+	m_slots.resize(0);
+	m_slot_first.resize(0);
+	m_options.resize(0);
+	m_softlists.resize(0);
+}
+
+
+//-------------------------------------------------
+//  parse - take a copy of a record and split it
+//  into fields; returns false if it is malformed
+//-------------------------------------------------
+
+bool machine_info::parse(const char *record, int length)
+{
+	reset();
+	m_record.resize(length + 1);
+	memcpy(&m_record[0], record, length);
+	m_record[length] = 0;
+
+	char *line = &m_record[0];
+	while (*line != 0)
+	{
+		// terminate the line and split it at the tabs
+		char *end = strchr(line, '\n');
+		if (end != NULL)
+			*end = 0;
+		int first = m_fields.count();
+		for (char *tab = strchr(line, '\t'); tab != NULL; tab = strchr(tab + 1, '\t'))
+		{
+			*tab = 0;
+			m_fields.append(tab + 1);
+		}
+		int fields = m_fields.count() - first;
+
+		// file it by type
+		bool valid;
+		switch (line[0])
+		{
+			case 'V':   valid = (fields == 4);  m_devices.append(first);    break;
+			case 'R':   valid = (fields == 4 && atoi(m_fields[first]) < m_devices.count()); m_roms.append(first); break;
+			case 'M':   valid = (fields == 3);  m_media.append(first);      break;
+			case 'S':   valid = (fields == 1);  m_slot_first.append(m_options.count()); m_slots.append(first); break;
+			case 'O':   valid = (fields == 2 && m_slots.count() != 0); m_options.append(first); break;
+			case 'L':   valid = (fields == 1);  m_softlists.append(first);  break;
+			default:    valid = false;                                      break;
+		}
+		if (!valid || line[1] != 0)
+			return false;
+
+		if (end == NULL)
+			break;
+		line = end + 1;
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  build - create the record for a machine
+//  configuration
+//-------------------------------------------------
+
+void machine_info::build(machine_config &config, astring &record)
+{
+	record.reset();
+
+	// devices, then the ROMs of each
+	device_iterator deviter(config.root_device());
+	for (device_t *device = deviter.first(); device != NULL; device = deviter.next())
+	{
+		record.cat("V");
+		append_field(record, device->tag());
+		append_field(record, device->shortname());
+		append_field(record, astring().format("%u", device->clock()));
+		append_field(record, device->name());
+		record.cat("\n");
+	}
+	int devindex = 0;
+	for (device_t *device = deviter.first(); device != NULL; device = deviter.next(), devindex++)
+		for (const rom_entry *region = rom_first_region(*device); region != NULL; region = rom_next_region(region))
+			for (const rom_entry *rom = rom_first_file(region); rom != NULL; rom = rom_next_file(rom))
+			{
+				record.cat("R");
+				append_field(record, astring().format("%d", devindex));
+				append_field(record, astring().format("%d", ROMREGION_ISROMDATA(region) ? int(rom_file_size(rom)) : -1));
+				append_field(record, ROM_GETNAME(rom));
+				append_field(record, ROM_GETHASHDATA(rom));
+				record.cat("\n");
+			}
+
+	// image devices
+	image_interface_iterator imageiter(config.root_device());
+	for (const device_image_interface *imagedev = imageiter.first(); imagedev != NULL; imagedev = imageiter.next())
+	{
+		record.cat("M");
+		append_field(record, imagedev->instance_name());
+		append_field(record, imagedev->brief_instance_name());
+		append_field(record, imagedev->file_extensions());
+		record.cat("\n");
+	}
+
+	// configurable slots; option names come from a temporary device
+	slot_interface_iterator slotiter(config.root_device());
+	for (const device_slot_interface *slot = slotiter.first(); slot != NULL; slot = slotiter.next())
+	{
+		if (slot->fixed())
+			continue;
+		record.cat("S");
+		append_field(record, slot->device().tag() + 1);
+		record.cat("\n");
+
+		for (const device_slot_option *option = slot->first_option(); option != NULL; option = option->next())
+			if (option->selectable())
+			{
+				device_t *dev = (*option->devtype())(config, "dummy", &config.root_device(), 0);
+				dev->config_complete();
+				record.cat("O");
+				append_field(record, option->name());
+				append_field(record, dev->name());
+				record.cat("\n");
+				global_free(dev);
+			}
+	}
+
+	// software lists
+	software_list_device_iterator switer(config.root_device());
+	for (const software_list_device *swlist = switer.first(); swlist != NULL; swlist = switer.next())
+	{
+		record.cat("L");
+		append_field(record, swlist->list_name());
+		record.cat("\n");
+	}
+}
+
+
+//-------------------------------------------------
+//  devices_by_tag - return the device indexes
+//  sorted by tag
+//-------------------------------------------------
+
+int machine_info::compare_tags(const void *i1, const void *i2)
+{
+	return strcmp(**(const char * const **)i1, **(const char * const **)i2);
+}
+
+void machine_info::devices_by_tag(dynamic_array<int> &order) const
+{
+	// sort pointers to the tag fields, which are in device order
+	dynamic_array<char * const *> tags;
+	for (int index = 0; index < m_devices.count(); index++)
+		tags.append(&m_fields[m_devices[index]]);
+	if (tags.count() != 0)
+		qsort(&tags[0], tags.count(), sizeof(tags[0]), compare_tags);
+
+	// map them back
+	order.resize(0);
+	for (int index = 0; index < tags.count(); index++)
+		for (int devindex = 0; devindex < m_devices.count(); devindex++)
+			if (&m_fields[m_devices[devindex]] == tags[index])
+			{
+				order.append(devindex);
+				break;
+			}
+}
+
+
+
+//**************************************************************************
+//  MACHINE INFO CACHE
+//**************************************************************************
+
+//-------------------------------------------------
+//  machine_info_cache - constructor
+//-------------------------------------------------
+
+machine_info_cache::machine_info_cache(emu_options &options)
+	: m_enabled(options.listing_cache()),
+		m_directory(options.cfg_directory()),
+		m_current(false)
+{
+	if (m_enabled)
+		load();
+}
+
+
+//-------------------------------------------------
+//  ~machine_info_cache - destructor
+//-------------------------------------------------
+
+machine_info_cache::~machine_info_cache()
+{
+	if (m_enabled && m_new.first() != NULL)
+		save();
+}
+
+
+//-------------------------------------------------
+//  get - return information about the current
+//  driver of an enumerator
+//-------------------------------------------------
+
+const machine_info &machine_info_cache::get(driver_enumerator &drivlist)
+{
+	const char *name = drivlist.driver().name;
+
+	// use the cached record if we have one and it is sound
+	FPTR offset = m_enabled ? m_offsets.find(name) : 0;
+	if (offset != 0)
+	{
+		const char *start = (const char *)&m_data[offset - 1];
+		const char *end = (*start == '@') ? start - 1 : strstr(start, "\n@");
+		int length = (end != NULL) ? end + 1 - start : strlen(start);
+		if (m_info.parse(start, length))
+			return m_info;
+		mame_printf_verbose("Ignoring damaged listing cache entry for %s\n", name);
+	}
+
+	// otherwise build one from the machine configuration
+	astring record;
+	machine_info::build(drivlist.config(), record);
+	m_info.parse(record, record.len());
+
+	// and remember it for next time
+	if (m_enabled)
+	{
+		new_record &entry = m_new.append(*global_alloc(new_record));
+		entry.m_name.cpy(name);
+		entry.m_record.cpy(record);
+	}
+	return m_info;
+}
+
+
+//-------------------------------------------------
+//  load - read the cache file and index the
+//  drivers in it
+//-------------------------------------------------
+
+void machine_info_cache::load()
+{
+	emu_file file(m_directory, OPEN_FLAG_READ);
+	if (file.open(INFO_CACHE_NAME, INFO_CACHE_EXT) != FILERR_NONE)
+		return;
+	UINT64 length = file.size();
+	if (length == 0 || length > 0x7fffffff)
+		return;
+	m_data.resize(length + 1);
+	if (file.read(&m_data[0], length) != length)
+	{
+		m_data.reset();
+		return;
+	}
+	m_data[length] = 0;
+
+	// the first line must name this build
+	astring header(INFO_CACHE_HEADER, build_version);
+	header.cat(" ").cat(build_id).cat("\n");
+	if (length < header.len() || memcmp(&m_data[0], header.cstr(), header.len()) != 0)
+	{
+		mame_printf_verbose("Listing cache was written by another build; rebuilding\n");
+		m_data.reset();
+		return;
+	}
+	m_current = true;
+
+	// index the drivers; a record runs from after its name to the next one
+	for (char *line = strchr((char *)&m_data[0], '\n'); line != NULL; line = strchr(line, '\n'))
+	{
+		line++;
+		if (*line != '@')
+			continue;
+		char *end = strchr(line, '\n');
+		if (end == NULL)
+			break;
+		*end = 0;
+		m_offsets.add(line + 1, end + 1 - (char *)&m_data[0] + 1, true);
+		*end = '\n';
+	}
+}
+
+
+//-------------------------------------------------
+//  save - write the cache with the new records
+//  appended
+//-------------------------------------------------
+
+void machine_info_cache::save()
+{
+	emu_file file(m_directory, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(INFO_CACHE_NAME, INFO_CACHE_EXT) != FILERR_NONE)
+		return;
+
+	// start with what we loaded, or a new header
+	if (m_current)
+		file.write(&m_data[0], m_data.count() - 1);
+	else
+		file.printf("%s%s %s\n", INFO_CACHE_HEADER, build_version, build_id);
+
+	// add the records we built; a truncated record fails to parse next time
+	for (new_record *entry = m_new.first(); entry != NULL; entry = entry->next())
+	{
+		file.printf("@%s\n", entry->m_name.cstr());
+		file.write(entry->m_record.cstr(), entry->m_record.len());
+	}
+}
@@ -0,0 +1,135 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    infocache.h
+
+    Cache of per-driver machine information for the listing commands.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __INFOCACHE_H__
+#define __INFOCACHE_H__
+
+#include "drivenum.h"
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> machine_info
+
+// the parts of a driver's machine configuration that the listing commands
+// need, either taken from a live machine_config or read back from the cache
+class machine_info
+{
+	friend class machine_info_cache;
+
+public:
+	// construction/destruction
+	machine_info();
+
+	// devices, in device_iterator order
+	int devices() const { return m_devices.count(); }
+	const char *device_tag(int index) const { return m_fields[m_devices[index]]; }
+	const char *device_shortname(int index) const { return m_fields[m_devices[index] + 1]; }
+	UINT32 device_clock(int index) const { return strtoul(m_fields[m_devices[index] + 2], NULL, 10); }
+	const char *device_name(int index) const { return m_fields[m_devices[index] + 3]; }
+	void devices_by_tag(dynamic_array<int> &order) const;
+
+	// ROMs, in device/region/file order
+	int roms() const { return m_roms.count(); }
+	int rom_device(int index) const { return atoi(m_fields[m_roms[index]]); }
+	int rom_length(int index) const { return atoi(m_fields[m_roms[index] + 1]); }
+	const char *rom_name(int index) const { return m_fields[m_roms[index] + 2]; }
+	const char *rom_hashdata(int index) const { return m_fields[m_roms[index] + 3]; }
+
+	// image devices
+	int media() const { return m_media.count(); }
+	const char *media_instance(int index) const { return m_fields[m_media[index]]; }
+	const char *media_brief(int index) const { return m_fields[m_media[index] + 1]; }
+	const char *media_extensions(int index) const { return m_fields[m_media[index] + 2]; }
+
+	// configurable slots and their selectable options
+	int slots() const { return m_slots.count(); }
+	const char *slot_tag(int index) const { return m_fields[m_slots[index]]; }
+	int slot_options(int index) const { return ((index + 1 < m_slots.count()) ? m_slot_first[index + 1] : m_options.count()) - m_slot_first[index]; }
+	const char *slot_option_name(int index, int option) const { return m_fields[m_options[m_slot_first[index] + option]]; }
+	const char *slot_option_device(int index, int option) const { return m_fields[m_options[m_slot_first[index] + option] + 1]; }
+
+	// software lists
+	int softlists() const { return m_softlists.count(); }
+	const char *softlist(int index) const { return m_fields[m_softlists[index]]; }
+
+private:
+	// internal helpers
+	void reset();
+	bool parse(const char *record, int length);
+	static void build(machine_config &config, astring &record);
+	static int compare_tags(const void *i1, const void *i2);
+
+	// internal state
+	dynamic_array<char>     m_record;           // tab-separated lines, split in place
+	dynamic_array<char *>   m_fields;           // fields of all lines
+	dynamic_array<int>      m_devices;          // first field of each line, by type
+	dynamic_array<int>      m_roms;
+	dynamic_array<int>      m_media;
+	dynamic_array<int>      m_slots;
+	dynamic_array<int>      m_slot_first;       // first option of each slot
+	dynamic_array<int>      m_options;
+	dynamic_array<int>      m_softlists;
+};
+
+
+// ======================> machine_info_cache
+
+// hands out machine_info for drivers, from the on-disk cache when it is
+// enabled and was written by this build, otherwise from the driver's
+// machine_config; new entries are saved when the cache is destroyed
+class machine_info_cache
+{
+	DISABLE_COPYING(machine_info_cache);
+
+public:
+	// construction/destruction
+	machine_info_cache(emu_options &options);
+	~machine_info_cache();
+
+	// get information for the current driver of an enumerator; the result is
+	// valid until the next call
+	const machine_info &get(driver_enumerator &drivlist);
+
+private:
+	// a record not yet on disk
+	class new_record
+	{
+		friend class simple_list<new_record>;
+
+	public:
+		new_record *next() const { return m_next; }
+
+		new_record *            m_next;
+		astring                 m_name;
+		astring                 m_record;
+	};
+
+	// internal helpers
+	void load();
+	void save();
+
+	// internal state
+	bool                    m_enabled;
+	astring                 m_directory;
+	dynamic_buffer          m_data;             // the file as loaded, if it is current
+	bool                    m_current;
+	tagmap_t<FPTR, 8191>    m_offsets;          // driver name to record offset + 1
+	simple_list<new_record> m_new;
+	machine_info            m_info;
+};
+
+
+#endif  /* __INFOCACHE_H__ */
@@ -263,6 +263,7 @@ struct ioport_port_live
 	simple_list<dynamic_field> writelist;       // list of dynamic write fields
 	ioport_value            defvalue;           // combined default value across the port
 	ioport_value            digital;            // current value from all digital inputs
+	ioport_value            scripted;           // digital inputs held down by scripts
 	ioport_value            outputvalue;        // current value for outputs
 };
 
@@ -2432,11 +2433,29 @@ void ioport_port::frame_update(ioport_field *mouse_field)
 	for (ioport_field *field = first_field(); field != NULL; field = field->next())
 		field->frame_update(m_live->digital, field == mouse_field);
 
+	// inputs held down by scripts
+	m_live->digital |= m_live->scripted;
+
 	// hook for MESS's natural keyboard support
 	manager().natkeyboard().frame_update(*this, m_live->digital);
 }
 
 
+//-------------------------------------------------
+//  set_scripted - press or release digital
+//  inputs on behalf of a script; they take effect
+//  from the next frame update
+//-------------------------------------------------
+
+void ioport_port::set_scripted(ioport_value mask, bool pressed)
+{
+	if (pressed)
+		m_live->scripted |= mask;
+	else
+		m_live->scripted &= ~mask;
+}
+
+
 //-------------------------------------------------
 //  collapse_fields - remove any fields that are
 //  wholly overlapped by other fields
@@ -2534,6 +2553,7 @@ void ioport_port::init_live_state()
 ioport_port_live::ioport_port_live(ioport_port &port)
 	: defvalue(0),
 		digital(0),
+		scripted(0),
 		outputvalue(0)
 {
 	// iterate over fields
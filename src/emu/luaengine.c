@@ -41,10 +41,375 @@ int lua_engine::emu_keypost(lua_State *L)
 	return 1;
 }
 
+//-------------------------------------------------
+//  emu_romname - returns game short name
+//-------------------------------------------------
+
+int lua_engine::emu_romname(lua_State *L)
+{
+	lua_pushstring(L, luaThis->machine().system().name);
+	return 1;
+}
+
+//-------------------------------------------------
+//  emu_time - returns emulated time in seconds
+//-------------------------------------------------
+
+int lua_engine::emu_time(lua_State *L)
+{
+	lua_pushnumber(L, luaThis->machine().time().as_double());
+	return 1;
+}
+
+//-------------------------------------------------
+//  emu_frame_number - returns the number of
+//  frames a screen has drawn
+//-------------------------------------------------
+
+int lua_engine::emu_frame_number(lua_State *L)
+{
+	lua_pushnumber(L, double(get_screen(L, 1).frame_number()));
+	return 1;
+}
+
+//-------------------------------------------------
+//  emu_wait_frame - suspend the script until the
+//  next frame
+//-------------------------------------------------
+
+int lua_engine::emu_wait_frame(lua_State *L)
+{
+	return lua_yield(L, 0);
+}
+
+//-------------------------------------------------
+//  emu_register_frame - call a function once per
+//  frame, for as long as the VM lives
+//-------------------------------------------------
+
+int lua_engine::emu_register_frame(lua_State *L)
+{
+	luaL_checktype(L, 1, LUA_TFUNCTION);
+
+	// hooks are {function, screen tag} pairs in a registry table
+	lua_rawgeti(L, LUA_REGISTRYINDEX, luaThis->m_frame_ref);
+	lua_createtable(L, 2, 0);
+	lua_pushvalue(L, 1);
+	lua_rawseti(L, -2, 1);
+	lua_rawseti(L, -2, lua_rawlen(L, -2) + 1);
+	lua_pop(L, 1);
+	return 0;
+}
+
+//-------------------------------------------------
+//  emu_register_vblank - call a function with
+//  the new state at each VBLANK change of a screen
+//-------------------------------------------------
+
+int lua_engine::emu_register_vblank(lua_State *L)
+{
+	luaL_checktype(L, 1, LUA_TFUNCTION);
+	screen_device &screen = get_screen(L, 2);
+
+	lua_rawgeti(L, LUA_REGISTRYINDEX, luaThis->m_vblank_ref);
+	lua_createtable(L, 2, 0);
+	lua_pushvalue(L, 1);
+	lua_rawseti(L, -2, 1);
+	lua_pushstring(L, screen.tag());
+	lua_rawseti(L, -2, 2);
+	lua_rawseti(L, -2, lua_rawlen(L, -2) + 1);
+	lua_pop(L, 1);
+
+	// screens cannot drop callbacks, so register with each one only once
+	for (int index = 0; index < luaThis->m_vblank_screens.count(); index++)
+		if (luaThis->m_vblank_screens[index] == &screen)
+			return 0;
+	screen.register_vblank_callback(vblank_state_delegate(FUNC(lua_engine::on_vblank), luaThis));
+	luaThis->m_vblank_screens.append(&screen);
+	return 0;
+}
+
+//-------------------------------------------------
+//  emu_read_memory - read a block of an address
+//  space as a string:
+//  read_memory(tag, address, length [, space])
+//-------------------------------------------------
+
+int lua_engine::emu_read_memory(lua_State *L)
+{
+	address_space &space = get_space(L, 4);
+	offs_t byteaddress = space.address_to_byte(luaL_checkunsigned(L, 2));
+	lua_Unsigned length = luaL_checkunsigned(L, 3);
+	luaL_argcheck(L, length <= 0x10000000, 3, "length too large");
+
+	// one string for the whole block, filled in place
+	luaL_Buffer buffer;
+	UINT8 *dest = (UINT8 *)luaL_buffinitsize(L, &buffer, length);
+	for (lua_Unsigned offset = 0; offset < length; offset++)
+		dest[offset] = space.read_byte(byteaddress + offset);
+	luaL_pushresultsize(&buffer, length);
+	return 1;
+}
+
+//-------------------------------------------------
+//  emu_write_memory - write a string to an
+//  address space:
+//  write_memory(tag, address, data [, space])
+//-------------------------------------------------
+
+int lua_engine::emu_write_memory(lua_State *L)
+{
+	address_space &space = get_space(L, 4);
+	offs_t byteaddress = space.address_to_byte(luaL_checkunsigned(L, 2));
+	size_t length;
+	const UINT8 *data = (const UINT8 *)luaL_checklstring(L, 3, &length);
+
+	for (size_t offset = 0; offset < length; offset++)
+		space.write_byte(byteaddress + offset, data[offset]);
+	return 0;
+}
+
+//-------------------------------------------------
+//  emu_read_share - read a block of a memory
+//  share directly: read_share(tag, offset, length)
+//-------------------------------------------------
+
+int lua_engine::emu_read_share(lua_State *L)
+{
+	memory_share *share = luaThis->machine().root_device().memshare(luaL_checkstring(L, 1));
+	if (share == NULL)
+		return luaL_error(L, "no memory share '%s'", lua_tostring(L, 1));
+	lua_Unsigned offset = luaL_checkunsigned(L, 2);
+	lua_Unsigned length = luaL_optunsigned(L, 3, share->bytes() - MIN(offset, share->bytes()));
+	luaL_argcheck(L, offset <= share->bytes() && length <= share->bytes() - offset, 3, "out of range");
+
+	lua_pushlstring(L, (const char *)share->ptr() + offset, length);
+	return 1;
+}
+
+//-------------------------------------------------
+//  emu_write_share - write a string to a memory
+//  share directly: write_share(tag, offset, data)
+//-------------------------------------------------
+
+int lua_engine::emu_write_share(lua_State *L)
+{
+	memory_share *share = luaThis->machine().root_device().memshare(luaL_checkstring(L, 1));
+	if (share == NULL)
+		return luaL_error(L, "no memory share '%s'", lua_tostring(L, 1));
+	lua_Unsigned offset = luaL_checkunsigned(L, 2);
+	size_t length;
+	const char *data = luaL_checklstring(L, 3, &length);
+	luaL_argcheck(L, offset <= share->bytes() && length <= share->bytes() - offset, 3, "out of range");
+
+	memcpy((UINT8 *)share->ptr() + offset, data, length);
+	return 0;
+}
+
+//-------------------------------------------------
+//  emu_read_region - read a block of a memory
+//  region: read_region(tag, offset, length)
+//-------------------------------------------------
+
+int lua_engine::emu_read_region(lua_State *L)
+{
+	memory_region *region = luaThis->machine().root_device().memregion(luaL_checkstring(L, 1));
+	if (region == NULL)
+		return luaL_error(L, "no memory region '%s'", lua_tostring(L, 1));
+	lua_Unsigned offset = luaL_checkunsigned(L, 2);
+	lua_Unsigned length = luaL_optunsigned(L, 3, region->bytes() - MIN(offset, region->bytes()));
+	luaL_argcheck(L, offset <= region->bytes() && length <= region->bytes() - offset, 3, "out of range");
+
+	lua_pushlstring(L, (const char *)region->base() + offset, length);
+	return 1;
+}
+
+//-------------------------------------------------
+//  emu_screen_size - returns the size of a
+//  screen's visible area
+//-------------------------------------------------
+
+int lua_engine::emu_screen_size(lua_State *L)
+{
+	screen_device &screen = get_screen(L, 1);
+	lua_pushinteger(L, screen.visible_area().width());
+	lua_pushinteger(L, screen.visible_area().height());
+	return 2;
+}
+
+//-------------------------------------------------
+//  emu_screen_pixel - returns the RGB value of a
+//  pixel: screen_pixel(x, y [, tag])
+//-------------------------------------------------
+
+int lua_engine::emu_screen_pixel(lua_State *L)
+{
+	screen_device &screen = get_screen(L, 3);
+	lua_pushunsigned(L, screen.pixel(luaL_checkinteger(L, 1), luaL_checkinteger(L, 2)));
+	return 1;
+}
+
+//-------------------------------------------------
+//  emu_screen_pixels - returns the visible area
+//  of the last frame as a string of 32-bit RGB
+//  values in host order, plus its width and height
+//-------------------------------------------------
+
+int lua_engine::emu_screen_pixels(lua_State *L)
+{
+	screen_device &screen = get_screen(L, 1);
+	int width = screen.visible_area().width();
+	int height = screen.visible_area().height();
+
+	dynamic_array<UINT32> pixels(width * height);
+	screen.pixels(pixels);
+	lua_pushlstring(L, (const char *)&pixels[0], width * height * sizeof(UINT32));
+	lua_pushinteger(L, width);
+	lua_pushinteger(L, height);
+	return 3;
+}
+
+//-------------------------------------------------
+//  emu_input - press or release inputs from the
+//  next frame on: input(port, mask, pressed)
+//-------------------------------------------------
+
+int lua_engine::emu_input(lua_State *L)
+{
+	ioport_port *port = luaThis->machine().root_device().ioport(luaL_checkstring(L, 1));
+	if (port == NULL)
+		return luaL_error(L, "no input port '%s'", lua_tostring(L, 1));
+	port->set_scripted(luaL_checkunsigned(L, 2), lua_toboolean(L, 3));
+	return 0;
+}
+
+//-------------------------------------------------
+//  emu_save_state/emu_load_state - schedule a
+//  save or load of a named state
+//-------------------------------------------------
+
+int lua_engine::emu_save_state(lua_State *L)
+{
+	luaThis->machine().schedule_save(luaL_checkstring(L, 1));
+	return 0;
+}
+
+int lua_engine::emu_load_state(lua_State *L)
+{
+	luaThis->machine().schedule_load(luaL_checkstring(L, 1));
+	return 0;
+}
+
+//-------------------------------------------------
+//  emu_pause/emu_unpause - pause or resume
+//  emulation
+//-------------------------------------------------
+
+int lua_engine::emu_pause(lua_State *L)
+{
+	luaThis->machine().pause();
+	return 0;
+}
+
+int lua_engine::emu_unpause(lua_State *L)
+{
+	luaThis->machine().resume();
+	return 0;
+}
+
+//-------------------------------------------------
+//  emu_throttle/emu_fastforward/emu_frameskip -
+//  return the current setting, changing it if a
+//  new value is given
+//-------------------------------------------------
+
+int lua_engine::emu_throttle(lua_State *L)
+{
+	video_manager &video = luaThis->machine().video();
+	lua_pushboolean(L, video.throttled());
+	if (!lua_isnoneornil(L, 1))
+		video.set_throttled(lua_toboolean(L, 1));
+	return 1;
+}
+
+int lua_engine::emu_fastforward(lua_State *L)
+{
+	video_manager &video = luaThis->machine().video();
+	lua_pushboolean(L, video.fastforward());
+	if (!lua_isnoneornil(L, 1))
+		video.set_fastforward(lua_toboolean(L, 1));
+	return 1;
+}
+
+int lua_engine::emu_frameskip(lua_State *L)
+{
+	video_manager &video = luaThis->machine().video();
+	lua_pushinteger(L, video.frameskip());
+	if (!lua_isnoneornil(L, 1))
+		video.set_frameskip(luaL_checkinteger(L, 1));
+	return 1;
+}
+
+//-------------------------------------------------
+//  get_space - find the address space named by
+//  the device tag in argument 1 and an optional
+//  space number
+//-------------------------------------------------
+
+address_space &lua_engine::get_space(lua_State *L, int arg)
+{
+	const char *tag = luaL_checkstring(L, 1);
+	int spacenum = luaL_optint(L, arg, AS_PROGRAM);
+	device_t *device = luaThis->machine().device(tag);
+	device_memory_interface *memory;
+	if (device == NULL || !device->interface(memory))
+		luaL_error(L, "no device with memory '%s'", tag);
+	if (spacenum < 0 || spacenum >= ADDRESS_SPACES || !memory->has_space(spacenum))
+		luaL_error(L, "device '%s' has no address space %d", tag, spacenum);
+	return memory->space(spacenum);
+}
+
+//-------------------------------------------------
+//  get_screen - find the screen named by an
+//  optional argument, or the primary screen
+//-------------------------------------------------
+
+screen_device &lua_engine::get_screen(lua_State *L, int arg)
+{
+	screen_device *screen = luaThis->machine().primary_screen;
+	if (!lua_isnoneornil(L, arg))
+		screen = dynamic_cast<screen_device *>(luaThis->machine().device(luaL_checkstring(L, arg)));
+	if (screen == NULL)
+		luaL_error(L, "no such screen");
+	return *screen;
+}
+
 static const struct luaL_Reg emu_funcs [] =
 {
 	{ "gamename", lua_engine::emu_gamename },
 	{ "keypost", lua_engine::emu_keypost },
+	{ "romname", lua_engine::emu_romname },
+	{ "time", lua_engine::emu_time },
+	{ "frame_number", lua_engine::emu_frame_number },
+	{ "wait_frame", lua_engine::emu_wait_frame },
+	{ "register_frame", lua_engine::emu_register_frame },
+	{ "register_vblank", lua_engine::emu_register_vblank },
+	{ "read_memory", lua_engine::emu_read_memory },
+	{ "write_memory", lua_engine::emu_write_memory },
+	{ "read_share", lua_engine::emu_read_share },
+	{ "write_share", lua_engine::emu_write_share },
+	{ "read_region", lua_engine::emu_read_region },
+	{ "screen_size", lua_engine::emu_screen_size },
+	{ "screen_pixel", lua_engine::emu_screen_pixel },
+	{ "screen_pixels", lua_engine::emu_screen_pixels },
+	{ "input", lua_engine::emu_input },
+	{ "save_state", lua_engine::emu_save_state },
+	{ "load_state", lua_engine::emu_load_state },
+	{ "pause", lua_engine::emu_pause },
+	{ "unpause", lua_engine::emu_unpause },
+	{ "throttle", lua_engine::emu_throttle },
+	{ "fastforward", lua_engine::emu_fastforward },
+	{ "frameskip", lua_engine::emu_frameskip },
 	{ NULL, NULL }  /* sentinel */
 };
 
@@ -77,6 +442,8 @@ lua_engine::lua_engine(running_machine &machine)
 {
 	luaThis = this;
 	m_lua_state = NULL;
+	m_thread = NULL;
+	m_thread_ref = m_frame_ref = m_vblank_ref = LUA_NOREF;
 }
 
 //-------------------------------------------------
@@ -108,6 +475,8 @@ void lua_engine::close()
 		lua_close(m_lua_state);
 		mame_printf_verbose("[LUA] End executing script\n");
 		m_lua_state = NULL;
+		m_thread = NULL;
+		m_thread_ref = m_frame_ref = m_vblank_ref = LUA_NOREF;
 	}
 }
 
@@ -137,7 +506,36 @@ void lua_engine::createvm()
 	m_lua_state = luaL_newstate();
 	luaL_openlibs(m_lua_state);
 	luaL_requiref(m_lua_state, "emu", luaopen_emu, 1);
-	lua_sethook(m_lua_state, hook, LUA_MASKLINE, 0);
+	lua_pop(m_lua_state, 1);
+
+	// tables of frame and VBLANK hooks
+	lua_newtable(m_lua_state);
+	m_frame_ref = luaL_ref(m_lua_state, LUA_REGISTRYINDEX);
+	lua_newtable(m_lua_state);
+	m_vblank_ref = luaL_ref(m_lua_state, LUA_REGISTRYINDEX);
+
+	// the script runs in its own coroutine so hooks can be called while it
+	// is suspended; it yields to the next frame every so many instructions
+	m_thread = lua_newthread(m_lua_state);
+	m_thread_ref = luaL_ref(m_lua_state, LUA_REGISTRYINDEX);
+	lua_sethook(m_thread, hook, LUA_MASKCOUNT, LUA_SLICE_INSTRUCTIONS);
+}
+
+//-------------------------------------------------
+//  start_script - report the result of loading
+//  a script
+//-------------------------------------------------
+
+void lua_engine::start_script(int status)
+{
+	if (status != LUA_OK)
+	{
+		lua_xmove(m_thread, m_lua_state, 1);
+		report_errors(status);
+		return;
+	}
+
+	mame_printf_verbose("[LUA] Start executing script\n");
 }
 
 //-------------------------------------------------
@@ -147,11 +545,7 @@ void lua_engine::createvm()
 void lua_engine::execute(const char *filename)
 {
 	createvm();
-
-	int s = luaL_loadfile(m_lua_state, filename);
-	report_errors(s);
-
-	mame_printf_verbose("[LUA] Start executing script\n");
+	start_script(luaL_loadfile(m_thread, filename));
 }
 
 //-------------------------------------------------
@@ -161,12 +555,68 @@ void lua_engine::execute(const char *filename)
 void lua_engine::execute_string(const char *value)
 {
 	createvm();
+	start_script(luaL_loadstring(m_thread, value));
+}
 
-	int s = luaL_loadstring(m_lua_state, value);
-	report_errors(s);
+//-------------------------------------------------
+//  call_hooks - call the functions in a hook
+//  table; with a tag, only those registered for
+//  it, passing the state. Returns false if one
+//  failed and the VM was closed
+//-------------------------------------------------
 
-	mame_printf_verbose("[LUA] Start executing script\n");
+bool lua_engine::call_hooks(int ref, const char *tag, bool state)
+{
+	lua_State *L = m_lua_state;
+	lua_rawgeti(L, LUA_REGISTRYINDEX, ref);
+	int count = lua_rawlen(L, -1);
+	for (int index = 1; index <= count; index++)
+	{
+		// skip hooks for other screens
+		lua_rawgeti(L, -1, index);
+		if (tag != NULL)
+		{
+			lua_rawgeti(L, -1, 2);
+			bool wanted = (strcmp(lua_tostring(L, -1), tag) == 0);
+			lua_pop(L, 1);
+			if (!wanted)
+			{
+				lua_pop(L, 1);
+				continue;
+			}
+		}
+
+		// replace the entry with its function and call it
+		lua_rawgeti(L, -1, 1);
+		lua_remove(L, -2);
+		int args = 0;
+		if (tag != NULL)
+		{
+			lua_pushboolean(L, state);
+			args = 1;
+		}
+		int s = lua_pcall(L, args, 0, 0);
+		if (s != LUA_OK)
+		{
+			report_errors(s);
+			return false;
+		}
+	}
+	lua_pop(L, 1);
+	return true;
 }
+
+//-------------------------------------------------
+//  on_vblank - call the VBLANK hooks for a screen
+//-------------------------------------------------
+
+void lua_engine::on_vblank(screen_device &screen, bool vblank_state)
+{
+	if (m_lua_state == NULL)
+		return;
+	call_hooks(m_vblank_ref, screen.tag(), vblank_state);
+}
+
 //-------------------------------------------------
 //  lua_execute - execute slice of lua script
 //  this callback is hooked to frame notification
@@ -176,10 +626,27 @@ void lua_engine::lua_execute()
 {
 	if (m_lua_state==NULL) return;
 
-	int s = lua_resume(m_lua_state, m_lua_state, 0);
+	// frame hooks first, then the next slice of the script
+	if (!call_hooks(m_frame_ref, NULL, false) || m_thread == NULL)
+		return;
 
-	if (s != LUA_YIELD) {
+	int s = lua_resume(m_thread, m_lua_state, 0);
+	if (s == LUA_YIELD)
+		return;
+	if (s != LUA_OK) {
+		lua_xmove(m_thread, m_lua_state, 1);
 		report_errors(s);
-		close();
+		return;
 	}
+
+	// the script has finished; keep the VM only while it has hooks
+	luaL_unref(m_lua_state, LUA_REGISTRYINDEX, m_thread_ref);
+	m_thread = NULL;
+	m_thread_ref = LUA_NOREF;
+	lua_rawgeti(m_lua_state, LUA_REGISTRYINDEX, m_frame_ref);
+	lua_rawgeti(m_lua_state, LUA_REGISTRYINDEX, m_vblank_ref);
+	bool hooked = (lua_rawlen(m_lua_state, -1) != 0 || lua_rawlen(m_lua_state, -2) != 0);
+	lua_pop(m_lua_state, 2);
+	if (!hooked)
+		close();
 }
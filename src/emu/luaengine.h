@@ -18,6 +18,11 @@
 #define __LUA_ENGINE_H__
 
 struct lua_State;
+class address_space;
+class screen_device;
+
+// number of VM instructions a script runs before yielding to the next frame
+#define LUA_SLICE_INSTRUCTIONS  100000
 
 class lua_engine
 {
@@ -41,10 +46,44 @@ public:
 	//static
 	static int emu_gamename(lua_State *L);
 	static int emu_keypost(lua_State *L);
+	static int emu_romname(lua_State *L);
+	static int emu_time(lua_State *L);
+	static int emu_frame_number(lua_State *L);
+	static int emu_wait_frame(lua_State *L);
+	static int emu_register_frame(lua_State *L);
+	static int emu_register_vblank(lua_State *L);
+	static int emu_read_memory(lua_State *L);
+	static int emu_write_memory(lua_State *L);
+	static int emu_read_share(lua_State *L);
+	static int emu_write_share(lua_State *L);
+	static int emu_read_region(lua_State *L);
+	static int emu_screen_size(lua_State *L);
+	static int emu_screen_pixel(lua_State *L);
+	static int emu_screen_pixels(lua_State *L);
+	static int emu_input(lua_State *L);
+	static int emu_save_state(lua_State *L);
+	static int emu_load_state(lua_State *L);
+	static int emu_pause(lua_State *L);
+	static int emu_unpause(lua_State *L);
+	static int emu_throttle(lua_State *L);
+	static int emu_fastforward(lua_State *L);
+	static int emu_frameskip(lua_State *L);
 private:
+	// internal helpers
+	void start_script(int status);
+	bool call_hooks(int ref, const char *tag, bool state);
+	void on_vblank(screen_device &screen, bool vblank_state);
+	static address_space &get_space(lua_State *L, int arg);
+	static screen_device &get_screen(lua_State *L, int arg);
+
 	// internal state
 	running_machine &   m_machine;                          // reference to our machine
 	lua_State*          m_lua_state;
+	lua_State*          m_thread;                           // the script, resumed once per frame
+	int                 m_thread_ref;                       // registry references
+	int                 m_frame_ref;
+	int                 m_vblank_ref;
+	dynamic_array<screen_device *> m_vblank_screens;        // screens we are registered with
 
 	static lua_engine*  luaThis;
 };
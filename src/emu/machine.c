@@ -334,6 +334,10 @@ void running_machine::start()
 	// initialize lua
 	m_lua_engine.initialize();
 
+	// let the frontend hook in while notifiers can still be added
+	if (!m_init_callback.isnull())
+		m_init_callback();
+
 	// disallow save state registrations starting here
 	m_save.allow_registration(false);
 }
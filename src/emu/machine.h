@@ -233,6 +233,7 @@ public:
 	void add_notifier(machine_notification event, machine_notify_delegate callback);
 	void call_notifiers(machine_notification which);
 	void add_logerror_callback(logerror_callback callback);
+	void set_init_callback(machine_notify_delegate callback) { m_init_callback = callback; }
 	void set_ui_active(bool active) { m_ui_active = active; }
 
 	// TODO: Do saves and loads still require scheduling?
@@ -343,6 +344,7 @@ private:
 	astring                 m_context;              // context string buffer
 	int                     m_sample_rate;          // the digital audio sample rate
 	emu_file *              m_logfile;              // pointer to the active log file
+	machine_notify_delegate m_init_callback;        // frontend hook, called at the end of the init phase
 
 	// load/save management
 	enum saveload_schedule
@@ -10,6 +10,7 @@
 
 #include "emu.h"
 #include "machine/eeprom.h"
+#include "validity.h"
 
 
 
@@ -216,11 +217,11 @@ void eeprom_base_device::device_validity_check(validity_checker &valid) const
 {
 	// ensure the number of cells is an even power of 2
 	if (m_cells != (1 << m_address_bits))
-		mame_printf_error("Invalid EEPROM size %d specified\n", m_cells);
+		valid.error("Invalid EEPROM size %d specified\n", m_cells);
 
 	// ensure only the sizes we support are requested
 	if (m_data_bits != 8 && m_data_bits != 16)
-		mame_printf_error("Invalid EEPROM data width %d specified\n", m_data_bits);
+		valid.error("Invalid EEPROM data width %d specified\n", m_data_bits);
 }
 
 
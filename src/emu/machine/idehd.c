@@ -26,10 +26,23 @@ ata_mass_storage_device::ata_mass_storage_device(const machine_config &mconfig,
 	m_num_sectors(0),
 	m_num_heads(0),
 	m_master_password(NULL),
-	m_user_password(NULL)
+	m_user_password(NULL),
+	m_work_queue(NULL),
+	m_read_item(NULL),
+	m_queued_lba(0),
+	m_readresult(READ_NONE)
 {
 }
 
+ata_mass_storage_device::~ata_mass_storage_device()
+{
+	if (m_work_queue != NULL)
+	{
+		cancel_read();
+		osd_work_queue_free(m_work_queue);
+	}
+}
+
 /*************************************
  *
  *  Compute the LBA address
@@ -184,12 +197,16 @@ void ata_mass_storage_device::device_start()
 	save_item(NAME(m_master_password_enable));
 	save_item(NAME(m_user_password_enable));
 	save_item(NAME(m_block_count));
+
+	m_work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
 }
 
 void ata_mass_storage_device::soft_reset()
 {
 	ata_hle_device::soft_reset();
 
+	cancel_read();
+
 	m_cur_lba = 0;
 	m_status |= IDE_STATUS_DSC;
 
@@ -381,6 +398,7 @@ void ata_mass_storage_device::fill_buffer()
 			set_dasp(ASSERT_LINE);
 
 			start_busy(TIME_BETWEEN_SECTORS, PARAM_COMMAND);
+			queue_read(lba_address());
 		}
 		break;
 	}
@@ -393,8 +411,16 @@ void ata_mass_storage_device::finished_read()
 
 	set_dasp(CLEAR_LINE);
 
-	/* now do the read */
-	count = read_sector(lba, m_buffer);
+	/* now do the read, using the background read if it fetched the right sector */
+	wait_read();
+	if (m_readresult != READ_NONE && m_queued_lba == UINT32(lba))
+	{
+		memcpy(m_buffer, m_readbuffer, IDE_DISK_SECTOR_SIZE);
+		count = m_readresult;
+	}
+	else
+		count = read_sector(lba, m_buffer);
+	m_readresult = READ_NONE;
 
 	/* if we succeeded, advance to the next sector and set the nice bits */
 	if (count == 1)
@@ -450,9 +476,59 @@ void ata_mass_storage_device::read_first_sector()
 		set_dasp(ASSERT_LINE);
 
 		start_busy(seek_time(), PARAM_COMMAND);
+		queue_read(lba_address());
 	}
 }
 
+
+/*************************************
+ *
+ *  Background sector reads
+ *
+ *  The host side of a read is issued
+ *  as soon as the emulated command
+ *  starts so it overlaps the emulated
+ *  seek/transfer time; the result is
+ *  collected when the busy period ends.
+ *
+ *************************************/
+
+void ata_mass_storage_device::queue_read(UINT32 lba)
+{
+	cancel_read();
+
+	if (m_work_queue == NULL || !can_read_async())
+		return;
+
+	m_queued_lba = lba;
+	m_read_item = osd_work_item_queue(m_work_queue, read_async_static, this, 0);
+}
+
+void *ata_mass_storage_device::read_async_static(void *param, int threadid)
+{
+	ata_mass_storage_device &drive = *reinterpret_cast<ata_mass_storage_device *>(param);
+	return (void *)(FPTR)drive.read_sector(drive.m_queued_lba, drive.m_readbuffer);
+}
+
+void ata_mass_storage_device::wait_read()
+{
+	// the buffer and result belong to the work item until it has completed;
+	// its completion is what makes them visible to this thread
+	if (m_read_item != NULL)
+	{
+		while (!osd_work_item_wait(m_read_item, osd_ticks_per_second() * 10)) ;
+		m_readresult = (int)(FPTR)osd_work_item_result(m_read_item);
+		osd_work_item_release(m_read_item);
+		m_read_item = NULL;
+	}
+}
+
+void ata_mass_storage_device::cancel_read()
+{
+	wait_read();
+	m_readresult = READ_NONE;
+}
+
 /*************************************
  *
  *  Sector writing
@@ -523,6 +599,9 @@ void ata_mass_storage_device::finished_write()
 
 	set_dasp(CLEAR_LINE);
 
+	/* a background read must not race the write, nor return stale data */
+	cancel_read();
+
 	/* now do the write */
 	count = write_sector(lba, m_buffer);
 
@@ -755,6 +834,8 @@ void ide_hdd_device::device_start()
 
 void ide_hdd_device::device_reset()
 {
+	cancel_read();
+
 	m_handle = m_image->get_chd_file();
 	m_disk = m_image->get_hard_disk_file();
 
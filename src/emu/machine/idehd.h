@@ -24,6 +24,7 @@ class ata_mass_storage_device : public ata_hle_device
 {
 public:
 	ata_mass_storage_device(const machine_config &mconfig, device_type type, const char *name, const char *tag, device_t *owner, UINT32 clock,const char *shortname, const char *source);
+	~ata_mass_storage_device();
 
 	UINT16 *identify_device_buffer() { return m_identify_buffer; }
 
@@ -45,6 +46,11 @@ protected:
 	virtual int read_sector(UINT32 lba, void *buffer) = 0;
 	virtual int write_sector(UINT32 lba, const void *buffer) = 0;
 
+	// return true if read_sector may be called from a worker thread
+	virtual bool can_read_async() { return false; }
+	void wait_read();
+	void cancel_read();
+
 	void ide_build_identify_device();
 
 	static const int IDE_DISK_SECTOR_SIZE = 512;
@@ -73,7 +79,13 @@ private:
 	void read_first_sector();
 	void soft_reset();
 	attotime seek_time();
+	void queue_read(UINT32 lba);
+	static void *read_async_static(void *param, int threadid);
 
+	enum
+	{
+		READ_NONE = -1
+	};
 	UINT32          m_cur_lba;
 	UINT16          m_block_count;
 	UINT16          m_sectors_until_int;
@@ -82,6 +94,12 @@ private:
 	UINT8           m_user_password_enable;
 	const UINT8 *   m_master_password;
 	const UINT8 *   m_user_password;
+
+	osd_work_queue *m_work_queue;
+	osd_work_item * m_read_item;
+	UINT32          m_queued_lba;
+	int             m_readresult;
+	UINT8           m_readbuffer[IDE_DISK_SECTOR_SIZE];
 };
 
 // ======================> ide_hdd_device
@@ -95,6 +113,7 @@ public:
 
 	virtual int read_sector(UINT32 lba, void *buffer) { if (m_disk == NULL) return 0; return hard_disk_read(m_disk, lba, buffer); }
 	virtual int write_sector(UINT32 lba, const void *buffer) { if (m_disk == NULL) return 0; return hard_disk_write(m_disk, lba, buffer); }
+	virtual bool can_read_async() { return m_disk != NULL; }
 
 protected:
 	// device-level overrides
@@ -4,23 +4,42 @@
 const device_type NSCSI_HARDDISK = &device_creator<nscsi_harddisk_device>;
 
 nscsi_harddisk_device::nscsi_harddisk_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock) :
-	nscsi_full_device(mconfig, NSCSI_HARDDISK, "SCSI HARDDISK", tag, owner, clock, "scsi_harddisk", __FILE__)
+	nscsi_full_device(mconfig, NSCSI_HARDDISK, "SCSI HARDDISK", tag, owner, clock, "scsi_harddisk", __FILE__),
+	work_queue(NULL),
+	read_item(NULL),
+	next_lba(-1),
+	next_result(READ_NONE)
 {
 }
 
 nscsi_harddisk_device::nscsi_harddisk_device(const machine_config &mconfig, device_type type, const char *name, const char *tag, device_t *owner, UINT32 clock, const char *shortname, const char *source) :
-	nscsi_full_device(mconfig, type, name, tag, owner, clock, shortname, source)
+	nscsi_full_device(mconfig, type, name, tag, owner, clock, shortname, source),
+	work_queue(NULL),
+	read_item(NULL),
+	next_lba(-1),
+	next_result(READ_NONE)
 {
 }
 
+nscsi_harddisk_device::~nscsi_harddisk_device()
+{
+	if(work_queue) {
+		wait_read();
+		osd_work_queue_free(work_queue);
+	}
+}
+
 void nscsi_harddisk_device::device_start()
 {
 	nscsi_full_device::device_start();
+	work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
 }
 
 void nscsi_harddisk_device::device_reset()
 {
 	nscsi_full_device::device_reset();
+	wait_read();
+	next_result = READ_NONE;
 	harddisk_image_device *hd = subdevice<harddisk_image_device>("image");
 	harddisk = hd->get_hard_disk_file();
 	if(!harddisk) {
@@ -31,6 +50,7 @@ void nscsi_harddisk_device::device_reset()
 		bytes_per_sector = hdinfo->sectorbytes;
 	}
 	cur_lba = -1;
+	cur_data = block;
 }
 
 harddisk_interface nscsi_harddisk_device::hd_intf = { NULL, NULL, "scsi_hdd", NULL };
@@ -51,12 +71,58 @@ UINT8 nscsi_harddisk_device::scsi_get_data(int id, int pos)
 	int clba = lba + pos / bytes_per_sector;
 	if(clba != cur_lba) {
 		cur_lba = clba;
-		if(!hard_disk_read(harddisk, cur_lba, block)) {
-			logerror("%s: HD READ ERROR !\n", tag());
-			memset(block, 0, sizeof(block));
+		// read straight out of a mapped uncompressed image when we can
+		cur_data = (const UINT8 *)hard_disk_sector_pointer(harddisk, cur_lba);
+		if(!cur_data) {
+			cur_data = block;
+			// pick up the background read if it fetched this sector
+			wait_read();
+			int result = (next_result != READ_NONE && next_lba == cur_lba) ? next_result : -1;
+			if(result != -1)
+				memcpy(block, next_block, sizeof(block));
+			else
+				result = hard_disk_read(harddisk, cur_lba, block);
+			next_result = READ_NONE;
+			if(!result) {
+				logerror("%s: HD READ ERROR !\n", tag());
+				memset(block, 0, sizeof(block));
+			}
+
+			// fetch the next sector while the host drains this one
+			if(cur_lba + 1 < lba + blocks && !hard_disk_sector_pointer(harddisk, cur_lba + 1))
+				queue_read(cur_lba + 1);
 		}
 	}
-	return block[pos % bytes_per_sector];
+	return cur_data[pos % bytes_per_sector];
+}
+
+void nscsi_harddisk_device::queue_read(int _lba)
+{
+	wait_read();
+	next_result = READ_NONE;
+	if(!work_queue)
+		return;
+
+	next_lba = _lba;
+	read_item = osd_work_item_queue(work_queue, read_async_static, this, 0);
+}
+
+void *nscsi_harddisk_device::read_async_static(void *param, int threadid)
+{
+	nscsi_harddisk_device &hd = *reinterpret_cast<nscsi_harddisk_device *>(param);
+	return (void *)(FPTR)hard_disk_read(hd.harddisk, hd.next_lba, hd.next_block);
+}
+
+void nscsi_harddisk_device::wait_read()
+{
+	// next_block and the result belong to the work item until it has
+	// completed; its completion is what makes them visible to this thread
+	if(read_item) {
+		while(!osd_work_item_wait(read_item, osd_ticks_per_second() * 10)) ;
+		next_result = (int)(FPTR)osd_work_item_result(read_item);
+		osd_work_item_release(read_item);
+		read_item = NULL;
+	}
 }
 
 void nscsi_harddisk_device::scsi_put_data(int id, int pos, UINT8 data)
@@ -66,8 +132,13 @@ void nscsi_harddisk_device::scsi_put_data(int id, int pos, UINT8 data)
 		return;
 	}
 
+	// don't let a background read race the write or go stale
+	wait_read();
+	next_result = READ_NONE;
+
 	int offset = pos % bytes_per_sector;
 	block[offset] = data;
+	cur_lba = -1;
 	int clba = lba + pos / bytes_per_sector;
 	if(offset == bytes_per_sector-1) {
 		if(!hard_disk_write(harddisk, clba, block))
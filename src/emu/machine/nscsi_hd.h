@@ -9,6 +9,7 @@ class nscsi_harddisk_device : public nscsi_full_device
 public:
 	nscsi_harddisk_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock);
 	nscsi_harddisk_device(const machine_config &mconfig, device_type type, const char *name, const char *tag, device_t *owner, UINT32 clock, const char *shortname, const char *source);
+	~nscsi_harddisk_device();
 
 	virtual machine_config_constructor device_mconfig_additions() const;
 
@@ -22,10 +23,23 @@ protected:
 	virtual UINT8 scsi_get_data(int id, int pos);
 	virtual void scsi_put_data(int buf, int offset, UINT8 data);
 
+	void queue_read(int lba);
+	void wait_read();
+	static void *read_async_static(void *param, int threadid);
+
 	UINT8 block[512];
+	const UINT8 *cur_data;
 	hard_disk_file *harddisk;
 	int lba, cur_lba, blocks;
 	int bytes_per_sector;
+
+	// background read of the sector following the one being transferred
+	enum { READ_NONE = -1 };
+	osd_work_queue *work_queue;
+	osd_work_item *read_item;
+	UINT8 next_block[512];
+	int next_lba;
+	int next_result;
 };
 
 extern const device_type NSCSI_HARDDISK;
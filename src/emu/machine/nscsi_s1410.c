@@ -61,6 +61,8 @@ void nscsi_s1410_device::scsi_command()
 		UINT8 *data = global_alloc_array(UINT8,track_length);
 		memset(data, 0xc6, track_length);
 
+		wait_read();
+		next_result = READ_NONE;
 		if(!hard_disk_write(harddisk, lba, data)) {
 			logerror("%s: HD WRITE ERROR !\n", tag());
 			scsi_status_complete(SS_FORMAT_ERROR);
@@ -28,6 +28,9 @@
 
 #define TEMPBUFFER_MAX_SIZE     (1024 * 1024 * 1024)
 
+/* how far ahead of the region loader the background file loads may run */
+#define PREFETCH_MAX_BYTES      (64 * 1024 * 1024)
+
 
 
 /***************************************************************************
@@ -57,6 +60,48 @@ private:
 };
 
 
+class rom_prefetch
+{
+	friend class simple_list<rom_prefetch>;
+
+public:
+	rom_prefetch(running_machine &machine, const char *location, const rom_entry *romp)
+		: m_next(NULL),
+			m_machine(machine),
+			m_location(location != NULL ? location : ""),
+			m_has_location(location != NULL),
+			m_romp(romp),
+			m_item(NULL),
+			m_file(NULL),
+			m_failed(false),
+			m_ticks(0) { }
+	~rom_prefetch();
+
+	rom_prefetch *next() const { return m_next; }
+	const rom_entry *romp() const { return m_romp; }
+	osd_ticks_t ticks() const { return m_ticks; }
+
+	void queue(osd_work_queue *queue);
+	bool wait();
+	emu_file *detach_file(astring &tried_file_names) { tried_file_names = m_tried_file_names; emu_file *file = m_file; m_file = NULL; return file; }
+
+private:
+	static void *load_static(void *param, int threadid);
+	void load();
+
+	rom_prefetch *      m_next;                 /* pointer to next in the list */
+	running_machine &   m_machine;              /* machine we are loading for */
+	astring             m_location;             /* location tag to search */
+	bool                m_has_location;         /* was a location tag given? */
+	const rom_entry *   m_romp;                 /* ROM entry being loaded */
+	osd_work_item *     m_item;                 /* work item, if queued */
+	emu_file *          m_file;                 /* opened and hashed file, or NULL */
+	astring             m_tried_file_names;     /* where we looked */
+	bool                m_failed;               /* the search must be redone on the main thread */
+	osd_ticks_t         m_ticks;                /* host time spent opening and hashing */
+};
+
+
 struct romload_private
 {
 	running_machine &machine() const { assert(m_machine != NULL); return *m_machine; }
@@ -75,6 +120,13 @@ struct romload_private
 	emu_file *      file;               /* current file */
 	simple_list<open_chd> chd_list;     /* disks */
 
+	osd_work_queue *prefetch_queue;     /* queue for background file loads */
+	simple_list<rom_prefetch> prefetch_list; /* files being loaded in the background */
+	rom_prefetch *  prefetch_next;      /* next file to hand to the queue */
+	UINT32          prefetch_bytes;     /* bytes queued but not yet consumed */
+	osd_ticks_t     prefetch_ticks;     /* background time spent on consumed files */
+	osd_ticks_t     prefetch_wait;      /* time spent waiting on background loads */
+
 	memory_region * region;             /* info about current region */
 
 	astring         errorstring;        /* error string */
@@ -562,35 +614,31 @@ static void region_post_process(romload_private *romdata, const char *rgntag, bo
 
 
 /*-------------------------------------------------
-    open_rom_file - open a ROM file, searching
-    up the parent and loading by checksum
+    find_rom_file - open a ROM file, searching
+    up the parent and loading by checksum; this
+    may be called from a worker thread
 -------------------------------------------------*/
 
-static int open_rom_file(romload_private *romdata, const char *regiontag, const rom_entry *romp, astring &tried_file_names, bool from_list)
+static emu_file *find_rom_file(running_machine &machine, const char *regiontag, const rom_entry *romp, astring &tried_file_names)
 {
-	file_error filerr = FILERR_NOT_FOUND;
-	UINT32 romsize = rom_file_size(romp);
+	emu_file *file = NULL;
 	tried_file_names = "";
 
-	/* update status display */
-	display_loading_rom_message(romdata, ROM_GETNAME(romp), from_list);
-
 	/* extract CRC to use for searching */
 	UINT32 crc = 0;
 	bool has_crc = hash_collection(ROM_GETHASHDATA(romp)).crc(crc);
 
 	/* attempt reading up the chain through the parents. It automatically also
 	 attempts any kind of load by checksum supported by the archives. */
-	romdata->file = NULL;
-	for (int drv = driver_list::find(romdata->machine().system()); romdata->file == NULL && drv != -1; drv = driver_list::clone(drv)) {
+	for (int drv = driver_list::find(machine.system()); file == NULL && drv != -1; drv = driver_list::clone(drv)) {
 		if(tried_file_names.len() != 0)
 			tried_file_names += " ";
 		tried_file_names += driver_list::driver(drv).name;
-		filerr = common_process_file(romdata->machine().options(), driver_list::driver(drv).name, has_crc, crc, romp, &romdata->file);
+		common_process_file(machine.options(), driver_list::driver(drv).name, has_crc, crc, romp, &file);
 	}
 
 	/* if the region is load by name, load the ROM from there */
-	if (romdata->file == NULL && regiontag != NULL)
+	if (file == NULL && regiontag != NULL)
 	{
 		// check if we are dealing with softwarelists. if so, locationtag
 		// is actually a concatenation of: listname + setname + parentname
@@ -639,43 +687,235 @@ static int open_rom_file(romload_private *romdata, const char *regiontag, const
 		if (!is_list)
 		{
 			tried_file_names += " " + tag1;
-			filerr = common_process_file(romdata->machine().options(), tag1.cstr(), has_crc, crc, romp, &romdata->file);
+			common_process_file(machine.options(), tag1.cstr(), has_crc, crc, romp, &file);
 		}
 		else
 		{
 			// try to load from list/setname
-			if ((romdata->file == NULL) && (tag2.cstr() != NULL))
+			if ((file == NULL) && (tag2.cstr() != NULL))
 			{
 				tried_file_names += " " + tag2;
-				filerr = common_process_file(romdata->machine().options(), tag2.cstr(), has_crc, crc, romp, &romdata->file);
+				common_process_file(machine.options(), tag2.cstr(), has_crc, crc, romp, &file);
 			}
 			// try to load from list/parentname
-			if ((romdata->file == NULL) && has_parent && (tag3.cstr() != NULL))
+			if ((file == NULL) && has_parent && (tag3.cstr() != NULL))
 			{
 				tried_file_names += " " + tag3;
-				filerr = common_process_file(romdata->machine().options(), tag3.cstr(), has_crc, crc, romp, &romdata->file);
+				common_process_file(machine.options(), tag3.cstr(), has_crc, crc, romp, &file);
 			}
 			// try to load from setname
-			if ((romdata->file == NULL) && (tag4.cstr() != NULL))
+			if ((file == NULL) && (tag4.cstr() != NULL))
 			{
 				tried_file_names += " " + tag4;
-				filerr = common_process_file(romdata->machine().options(), tag4.cstr(), has_crc, crc, romp, &romdata->file);
+				common_process_file(machine.options(), tag4.cstr(), has_crc, crc, romp, &file);
 			}
 			// try to load from parentname
-			if ((romdata->file == NULL) && has_parent && (tag5.cstr() != NULL))
+			if ((file == NULL) && has_parent && (tag5.cstr() != NULL))
 			{
 				tried_file_names += " " + tag5;
-				filerr = common_process_file(romdata->machine().options(), tag5.cstr(), has_crc, crc, romp, &romdata->file);
+				common_process_file(machine.options(), tag5.cstr(), has_crc, crc, romp, &file);
 			}
 		}
 	}
 
+	return file;
+}
+
+
+/*-------------------------------------------------
+    ~rom_prefetch - destructor
+-------------------------------------------------*/
+
+rom_prefetch::~rom_prefetch()
+{
+	wait();
+	if (m_file != NULL)
+		global_free(m_file);
+}
+
+
+/*-------------------------------------------------
+    rom_prefetch::queue - start loading the file
+    in the background, or right now if there is
+    no queue
+-------------------------------------------------*/
+
+void rom_prefetch::queue(osd_work_queue *queue)
+{
+	if (queue != NULL)
+		m_item = osd_work_item_queue(queue, load_static, this, 0);
+	if (m_item == NULL)
+		load();
+}
+
+
+/*-------------------------------------------------
+    rom_prefetch::wait - wait for the background
+    load; returns false if the search has to be
+    repeated on the main thread
+-------------------------------------------------*/
+
+bool rom_prefetch::wait()
+{
+	if (m_item != NULL)
+	{
+		while (!osd_work_item_wait(m_item, osd_ticks_per_second()))
+			;
+		osd_work_item_release(m_item);
+		m_item = NULL;
+	}
+	return !m_failed;
+}
+
+
+/*-------------------------------------------------
+    rom_prefetch::load - open, decompress and hash
+    the file; runs on a worker thread
+-------------------------------------------------*/
+
+void *rom_prefetch::load_static(void *param, int threadid)
+{
+	reinterpret_cast<rom_prefetch *>(param)->load();
+	return NULL;
+}
+
+void rom_prefetch::load()
+{
+	osd_ticks_t start = osd_ticks();
+	try
+	{
+		m_file = find_rom_file(m_machine, m_has_location ? m_location.cstr() : NULL, m_romp, m_tried_file_names);
+
+		// compute the hashes we will verify against while we are still in the background
+		if (m_file != NULL)
+		{
+			astring tempstr;
+			m_file->hashes(hash_collection(ROM_GETHASHDATA(m_romp)).hash_types(tempstr));
+		}
+	}
+	catch (emu_fatalerror &)
+	{
+		// let the main thread repeat the search and report the error properly
+		if (m_file != NULL)
+			global_free(m_file);
+		m_file = NULL;
+		m_failed = true;
+	}
+	m_ticks = osd_ticks() - start;
+}
+
+
+/*-------------------------------------------------
+    queue_prefetches - hand files to the
+    background loader until enough data is in
+    flight
+-------------------------------------------------*/
+
+static void queue_prefetches(romload_private *romdata)
+{
+	while (romdata->prefetch_next != NULL && (romdata->prefetch_bytes < PREFETCH_MAX_BYTES || romdata->prefetch_next == romdata->prefetch_list.first()))
+	{
+		rom_prefetch *prefetch = romdata->prefetch_next;
+		romdata->prefetch_next = prefetch->next();
+		romdata->prefetch_bytes += rom_file_size(prefetch->romp());
+		prefetch->queue(romdata->prefetch_queue);
+	}
+}
+
+
+/*-------------------------------------------------
+    add_prefetches - list the files of a region
+    for background loading, in the order the
+    region will consume them
+-------------------------------------------------*/
+
+static void add_prefetches(romload_private *romdata, const char *regiontag, const rom_entry *region, device_t *device)
+{
+	for (const rom_entry *rom = rom_first_file(region); rom != NULL; rom = rom_next_file(rom))
+		if (ROM_GETBIOSFLAGS(rom) == 0 || ROM_GETBIOSFLAGS(rom) == device->system_bios())
+		{
+			rom_prefetch &prefetch = romdata->prefetch_list.append(*global_alloc(rom_prefetch(romdata->machine(), regiontag, rom)));
+			if (romdata->prefetch_next == NULL)
+				romdata->prefetch_next = &prefetch;
+		}
+}
+
+
+/*-------------------------------------------------
+    flush_prefetches - discard any background
+    loads that were not consumed
+-------------------------------------------------*/
+
+static void flush_prefetches(romload_private *romdata)
+{
+	romdata->prefetch_list.reset();
+	romdata->prefetch_next = NULL;
+	romdata->prefetch_bytes = 0;
+}
+
+
+/*-------------------------------------------------
+    report_region_time - report how long a region
+    took to load and how much of that was spent
+    waiting on the background loader
+-------------------------------------------------*/
+
+static void report_region_time(romload_private *romdata, const char *regiontag, osd_ticks_t start)
+{
+	double scale = 1.0 / (double)osd_ticks_per_second();
+	mame_printf_verbose("ROM region %s: %.3fs (%.3fs opening/decompressing/hashing in background, %.3fs waiting on it)\n",
+			regiontag, (double)(osd_ticks() - start) * scale, (double)romdata->prefetch_ticks * scale, (double)romdata->prefetch_wait * scale);
+	romdata->prefetch_ticks = romdata->prefetch_wait = 0;
+}
+
+
+/*-------------------------------------------------
+    open_rom_file - open a ROM file, taking it
+    from the background loader when possible
+-------------------------------------------------*/
+
+static int open_rom_file(romload_private *romdata, const char *regiontag, const rom_entry *romp, astring &tried_file_names, bool from_list)
+{
+	UINT32 romsize = rom_file_size(romp);
+
+	/* update status display */
+	display_loading_rom_message(romdata, ROM_GETNAME(romp), from_list);
+
+	/* see if this file was loaded in the background */
+	rom_prefetch *prefetch;
+	for (prefetch = romdata->prefetch_list.first(); prefetch != NULL && prefetch != romdata->prefetch_next; prefetch = prefetch->next())
+		if (prefetch->romp() == romp)
+			break;
+	if (prefetch == romdata->prefetch_next)
+		prefetch = NULL;
+
+	/* if so, wait for it; otherwise search for it now */
+	romdata->file = NULL;
+	if (prefetch != NULL)
+	{
+		osd_ticks_t start = osd_ticks();
+		bool loaded = prefetch->wait();
+		romdata->prefetch_wait += osd_ticks() - start;
+		romdata->prefetch_ticks += prefetch->ticks();
+		romdata->prefetch_bytes -= romsize;
+		if (loaded)
+			romdata->file = prefetch->detach_file(tried_file_names);
+		romdata->prefetch_list.remove(*prefetch);
+		if (!loaded)
+			romdata->file = find_rom_file(romdata->machine(), regiontag, romp, tried_file_names);
+	}
+	else
+		romdata->file = find_rom_file(romdata->machine(), regiontag, romp, tried_file_names);
+
+	/* keep the background loader busy */
+	queue_prefetches(romdata);
+
 	/* update counters */
 	romdata->romsloaded++;
 	romdata->romsloadedsize += romsize;
 
 	/* return the result */
-	return (filerr == FILERR_NONE);
+	return (romdata->file != NULL);
 }
 
 
@@ -1338,6 +1578,12 @@ void load_software_part_region(device_t *device, char *swlist, char *swname, rom
 		romdata->softwarningstring.catprintf("Support for software %s (in list %s) is only preliminary\n", swname, swlist);
 	}
 
+	/* start loading the files in the background */
+	for (region = start_region; region != NULL; region = rom_next_region(region))
+		if (ROMREGION_ISROMDATA(region))
+			add_prefetches(romdata, locationtag, region, device);
+	queue_prefetches(romdata);
+
 	/* loop until we hit the end */
 	for (region = start_region; region != NULL; region = rom_next_region(region))
 	{
@@ -1389,10 +1635,15 @@ void load_software_part_region(device_t *device, char *swlist, char *swname, rom
 
 		/* now process the entries in the region */
 		if (ROMREGION_ISROMDATA(region))
+		{
+			osd_ticks_t start = osd_ticks();
 			process_rom_entries(romdata, locationtag, region, region + 1, device, TRUE);
+			report_region_time(romdata, regiontag, start);
+		}
 		else if (ROMREGION_ISDISKDATA(region))
 			process_disk_entries(romdata, core_strdup(regiontag.cstr()), region, region + 1, locationtag);
 	}
+	flush_prefetches(romdata);
 
 	/* now go back and post-process all the regions */
 	for (region = start_region; region != NULL; region = rom_next_region(region))
@@ -1413,9 +1664,17 @@ void load_software_part_region(device_t *device, char *swlist, char *swname, rom
 static void process_region_list(romload_private *romdata)
 {
 	astring regiontag;
+	osd_ticks_t totalstart = osd_ticks();
 
-	/* loop until we hit the end */
+	/* start loading the files in the background, in the order we will consume them */
 	device_iterator deviter(romdata->machine().root_device());
+	for (device_t *device = deviter.first(); device != NULL; device = deviter.next())
+		for (const rom_entry *region = rom_first_region(*device); region != NULL; region = rom_next_region(region))
+			if (ROMREGION_ISROMDATA(region))
+				add_prefetches(romdata, device->shortname(), region, device);
+	queue_prefetches(romdata);
+
+	/* loop until we hit the end */
 	for (device_t *device = deviter.first(); device != NULL; device = deviter.next())
 		for (const rom_entry *region = rom_first_region(*device); region != NULL; region = rom_next_region(region))
 		{
@@ -1454,11 +1713,14 @@ static void process_region_list(romload_private *romdata)
 #endif
 
 				/* now process the entries in the region */
+				osd_ticks_t start = osd_ticks();
 				process_rom_entries(romdata, device->shortname(), region, region + 1, device, FALSE);
+				report_region_time(romdata, regiontag, start);
 			}
 			else if (ROMREGION_ISDISKDATA(region))
 				process_disk_entries(romdata, regiontag, region, region + 1, NULL);
 		}
+	flush_prefetches(romdata);
 
 	/* now go back and post-process all the regions */
 	for (device_t *device = deviter.first(); device != NULL; device = deviter.next())
@@ -1467,6 +1729,8 @@ static void process_region_list(romload_private *romdata)
 			rom_region_name(regiontag, *device, region);
 			region_post_process(romdata, regiontag, ROMREGION_ISINVERTED(region));
 		}
+
+	mame_printf_verbose("ROM loading took %.3fs\n", (double)(osd_ticks() - totalstart) / (double)osd_ticks_per_second());
 }
 
 
@@ -1487,6 +1751,12 @@ void rom_init(running_machine &machine)
 
 	/* reset the romdata struct */
 	romdata->m_machine = &machine;
+	romdata->prefetch_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	hash_cache::open(machine.options());
+
+	/* optionally open every archive up front so ROM lookups only hit the cache */
+	if (machine.options().zip_preindex())
+		mame_printf_verbose("Indexed %d ZIP files\n", emu_file::preindex_archives(machine.options().media_path()));
 
 	/* figure out which BIOS we are using */
 	device_iterator deviter(romdata->machine().config().root_device());
@@ -1526,6 +1796,14 @@ void rom_init(running_machine &machine)
 
 static void rom_exit(running_machine &machine)
 {
+	romload_private *romdata = machine.romload_data;
+
+	/* make sure nothing is still loading in the background */
+	flush_prefetches(romdata);
+	if (romdata->prefetch_queue != NULL)
+		osd_work_queue_free(romdata->prefetch_queue);
+	romdata->prefetch_queue = NULL;
+	hash_cache::close();
 }
 
 
@@ -12,6 +12,7 @@
 #include "emuopts.h"
 #include "png.h"
 #include "rendutil.h"
+#include "validity.h"
 
 
 
@@ -221,22 +222,22 @@ void screen_device::device_validity_check(validity_checker &valid) const
 {
 	// sanity check dimensions
 	if (m_width <= 0 || m_height <= 0)
-		mame_printf_error("Invalid display dimensions\n");
+		valid.error("Invalid display dimensions\n");
 
 	// sanity check display area
 	if (m_type != SCREEN_TYPE_VECTOR)
 	{
 		if (m_visarea.empty() || m_visarea.max_x >= m_width || m_visarea.max_y >= m_height)
-			mame_printf_error("Invalid display area\n");
+			valid.error("Invalid display area\n");
 
 		// sanity check screen formats
 		if (m_screen_update_ind16.isnull() && m_screen_update_rgb32.isnull())
-			mame_printf_error("Missing SCREEN_UPDATE function\n");
+			valid.error("Missing SCREEN_UPDATE function\n");
 	}
 
 	// check for zero frame rate
 	if (m_refresh == 0)
-		mame_printf_error("Invalid (zero) refresh rate\n");
+		valid.error("Invalid (zero) refresh rate\n");
 }
 
 
@@ -756,6 +757,74 @@ void screen_device::register_screen_bitmap(bitmap_t &bitmap)
 }
 
 
+//-------------------------------------------------
+//  pixel - return the color of a pixel of the
+//  last completed frame; coordinates are relative
+//  to the visible area
+//-------------------------------------------------
+
+UINT32 screen_device::pixel(INT32 x, INT32 y)
+{
+	screen_bitmap &curbitmap = m_bitmap[m_curtexture];
+	x += m_visarea.min_x;
+	y += m_visarea.min_y;
+	if (!curbitmap.valid() || x < m_visarea.min_x || x > m_visarea.max_x || y < m_visarea.min_y || y > m_visarea.max_y)
+		return 0;
+
+	switch (curbitmap.format())
+	{
+		case BITMAP_FORMAT_IND16:
+			return palette_entry_list_adjusted(machine().palette)[curbitmap.as_ind16().pix16(y, x)];
+
+		case BITMAP_FORMAT_RGB32:
+			return curbitmap.as_rgb32().pix32(y, x);
+
+		default:
+			return 0;
+	}
+}
+
+
+//-------------------------------------------------
+//  pixels - copy the visible area of the last
+//  completed frame to a buffer of
+//  visible_area().width() * visible_area().height()
+//  RGB values
+//-------------------------------------------------
+
+void screen_device::pixels(UINT32 *buffer)
+{
+	screen_bitmap &curbitmap = m_bitmap[m_curtexture];
+	int width = m_visarea.width();
+	if (!curbitmap.valid())
+	{
+		memset(buffer, 0, width * m_visarea.height() * sizeof(*buffer));
+		return;
+	}
+
+	for (int y = m_visarea.min_y; y <= m_visarea.max_y; y++, buffer += width)
+		switch (curbitmap.format())
+		{
+			case BITMAP_FORMAT_IND16:
+			{
+				const rgb_t *palette = palette_entry_list_adjusted(machine().palette);
+				const UINT16 *src = &curbitmap.as_ind16().pix16(y, m_visarea.min_x);
+				for (int x = 0; x < width; x++)
+					buffer[x] = palette[src[x]];
+				break;
+			}
+
+			case BITMAP_FORMAT_RGB32:
+				memcpy(buffer, &curbitmap.as_rgb32().pix32(y, m_visarea.min_x), width * sizeof(*buffer));
+				break;
+
+			default:
+				memset(buffer, 0, width * sizeof(*buffer));
+				break;
+		}
+}
+
+
 //-------------------------------------------------
 //  vblank_begin - call any external callbacks to
 //  signal the VBLANK period has begun
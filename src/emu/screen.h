@@ -202,6 +202,10 @@ public:
 	void register_screen_bitmap(bitmap_t &bitmap);
 	int vblank_port_read();
 
+	// pixels of the visible area of the last completed frame, as RGB
+	UINT32 pixel(INT32 x, INT32 y);
+	void pixels(UINT32 *buffer);
+
 	// internal to the video system
 	bool update_quads();
 	void update_burnin();
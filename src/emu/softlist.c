@@ -11,6 +11,7 @@
 #include "pool.h"
 #include "emuopts.h"
 #include "softlist.h"
+#include "validity.h"
 #include "clifront.h"
 
 #include <ctype.h>
@@ -24,6 +25,9 @@ typedef tagmap_t<software_info *> softlist_map;
 
 tagmap_t<UINT8> software_list_device::s_checked_lists;
 
+// drivers may be validated on several threads at once
+static osd_lock *checked_lists_lock = osd_lock_alloc();
+
 // device type definition
 const device_type SOFTWARE_LIST = &device_creator<software_list_device>;
 
@@ -116,7 +120,7 @@ INLINE void ATTR_PRINTF(2,3) parse_error(parse_state *state, const char *fmt, ..
 		va_start(va, fmt);
 		vsnprintf(buf, ARRAY_LENGTH(buf), fmt, va);
 		va_end(va);
-		(*state->error_proc)(buf);
+		(*state->error_proc)(buf, state->param);
 	}
 }
 
@@ -922,6 +926,7 @@ static void start_handler(void *data, const char *tagname, const char **attribut
 									return;
 
 								strcpy( s_name, str_name );
+								hashdata[0] = 0;
 								if (nodump) {
 									sprintf( hashdata, "%s", NO_DUMP);
 									if (str_crc && str_sha1) {
@@ -1172,17 +1177,527 @@ UINT32 software_get_support(emu_options &options, char *swlist, const char *swna
 }
 
 
+/***************************************************************************
+    COMPILED SOFTWARE LISTS
+
+    Parsing a large list with expat costs seconds, so once a list has been
+    parsed it is saved to the configuration directory as <listname>.swdb,
+    keyed by the length and CRC of the XML it came from. The file holds no
+    pointers: every reference is a table index or an offset into the string
+    table, so it is used exactly as it is mapped (or, failing that, read)
+    from disk.
+    Entries are turned back into software_info structures one at a time,
+    when software_list_find first returns them, and lookups by plain
+    shortname go through a hash table rather than a scan.
+***************************************************************************/
+
+#define SOFTLIST_DB_EXT             ".swdb"
+#define SOFTLIST_DB_VERSION         1
+
+/* set if a shortname would match as a wildcard, defeating the hash table */
+#define SOFTLIST_DB_FLAG_WILDNAMES  0x00000001
+
+struct softlist_db_header
+{
+	char    magic[8];           /* "MAMESWDB" */
+	UINT32  version;            /* SOFTLIST_DB_VERSION */
+	UINT32  xml_length;         /* length of the source XML */
+	UINT32  xml_crc;            /* CRC of the source XML */
+	UINT32  flags;              /* SOFTLIST_DB_FLAG_* */
+	UINT32  description;        /* list description string */
+	UINT32  software_count;     /* number of software entries, in XML order */
+	UINT32  software_offset;
+	UINT32  hash_mask;          /* hash buckets - 1 */
+	UINT32  hash_offset;
+	UINT32  interface_count;    /* distinct interfaces of first parts */
+	UINT32  interface_offset;
+	UINT32  feature_count;
+	UINT32  feature_offset;
+	UINT32  part_count;
+	UINT32  part_offset;
+	UINT32  rom_count;
+	UINT32  rom_offset;
+	UINT32  string_length;
+	UINT32  string_offset;
+};
+
+struct softlist_db_software
+{
+	UINT32  shortname;
+	UINT32  longname;
+	UINT32  parentname;
+	UINT32  year;
+	UINT32  publisher;
+	UINT32  supported;
+	UINT32  other_info;         /* first feature and count */
+	UINT32  other_info_count;
+	UINT32  shared_info;        /* first feature and count */
+	UINT32  shared_info_count;
+	UINT32  parts;              /* first part and count */
+	UINT32  part_count;
+	UINT32  hash_next;          /* next entry in the bucket plus one, 0 at the end */
+};
+
+struct softlist_db_feature
+{
+	UINT32  name;
+	UINT32  value;
+};
+
+struct softlist_db_part
+{
+	UINT32  name;
+	UINT32  interface_;
+	UINT32  features;           /* first feature and count */
+	UINT32  feature_count;
+	UINT32  roms;               /* first rom_entry and count, including the end */
+	UINT32  rom_count;
+};
+
+struct softlist_db_rom
+{
+	UINT32  name;
+	UINT32  hashdata;           /* fill value rather than a string for ROMENTRYTYPE_FILL */
+	UINT32  offset;
+	UINT32  length;
+	UINT32  flags;
+};
+
+static const char softlist_db_magic[8] = { 'M','A','M','E','S','W','D','B' };
+
+
+/*-------------------------------------------------
+    softlist_db_hash - hash a shortname the way
+    mame_strwildcmp compares it: only the first
+    16 characters, ignoring case
+-------------------------------------------------*/
+
+static UINT32 softlist_db_hash(const char *name)
+{
+	UINT32 hash = 0;
+	for (int index = 0; index < 16 && name[index] != 0; index++)
+		hash = hash * 31 + tolower((UINT8)name[index]);
+	return hash;
+}
+
+
+/*-------------------------------------------------
+    softlist_db_string - return a string from the
+    string table; offset 0 is NULL
+-------------------------------------------------*/
+
+INLINE const char *softlist_db_string(const software_list *swlist, UINT32 offset)
+{
+	const softlist_db_header *header = (const softlist_db_header *)swlist->db;
+	if (offset == 0 || offset >= header->string_length)
+		return NULL;
+	return (const char *)swlist->db + header->string_offset + offset;
+}
+
+
+/*-------------------------------------------------
+    softlist_db_features - rebuild a feature list
+    from a run of the feature table
+-------------------------------------------------*/
+
+static feature_list *softlist_db_features(software_list *swlist, UINT32 first, UINT32 count)
+{
+	const softlist_db_header *header = (const softlist_db_header *)swlist->db;
+	if (count == 0 || first > header->feature_count || count > header->feature_count - first)
+		return NULL;
+
+	const softlist_db_feature *src = (const softlist_db_feature *)(swlist->db + header->feature_offset) + first;
+	feature_list *list = (feature_list *)pool_malloc_lib(swlist->pool, count * sizeof(feature_list));
+	for (UINT32 index = 0; index < count; index++)
+	{
+		list[index].next = (index + 1 < count) ? &list[index + 1] : NULL;
+		list[index].name = (char *)softlist_db_string(swlist, src[index].name);
+		list[index].value = (char *)softlist_db_string(swlist, src[index].value);
+	}
+	return list;
+}
+
+
+/*-------------------------------------------------
+    softlist_db_resolve - return the software_info
+    for an entry, building it on first use
+-------------------------------------------------*/
+
+static software_info *softlist_db_resolve(const software_list *constlist, UINT32 index)
+{
+	software_list *swlist = const_cast<software_list *>(constlist);
+	if (swlist->db_entries[index] != NULL)
+		return swlist->db_entries[index];
+
+	const softlist_db_header *header = (const softlist_db_header *)swlist->db;
+	const softlist_db_software &src = ((const softlist_db_software *)(swlist->db + header->software_offset))[index];
+
+	software_info *info = (software_info *)pool_malloc_lib(swlist->pool, sizeof(software_info));
+	memset(info, 0, sizeof(*info));
+	info->index = index;
+	info->shortname = softlist_db_string(swlist, src.shortname);
+	info->longname = softlist_db_string(swlist, src.longname);
+	info->parentname = softlist_db_string(swlist, src.parentname);
+	info->year = softlist_db_string(swlist, src.year);
+	info->publisher = softlist_db_string(swlist, src.publisher);
+	info->supported = src.supported;
+	info->other_info = softlist_db_features(swlist, src.other_info, src.other_info_count);
+
+	/* the parser keeps an empty head on the shared list */
+	info->shared_info = (feature_list *)pool_malloc_lib(swlist->pool, sizeof(feature_list));
+	memset(info->shared_info, 0, sizeof(feature_list));
+	info->shared_info->next = softlist_db_features(swlist, src.shared_info, src.shared_info_count);
+
+	/* parts, terminated by one with no name */
+	UINT32 part_count = (src.parts <= header->part_count && src.part_count <= header->part_count - src.parts) ? src.part_count : 0;
+	info->part_entries = info->current_part_entry = part_count + 1;
+	info->partdata = (software_part *)pool_malloc_lib(swlist->pool, (part_count + 1) * sizeof(software_part));
+	memset(info->partdata, 0, (part_count + 1) * sizeof(software_part));
+
+	const softlist_db_part *srcpart = (const softlist_db_part *)(swlist->db + header->part_offset) + src.parts;
+	for (UINT32 partnum = 0; partnum < part_count; partnum++)
+	{
+		software_part &part = info->partdata[partnum];
+		part.name = softlist_db_string(swlist, srcpart[partnum].name);
+		part.interface_ = softlist_db_string(swlist, srcpart[partnum].interface_);
+		part.featurelist = softlist_db_features(swlist, srcpart[partnum].features, srcpart[partnum].feature_count);
+
+		UINT32 first = srcpart[partnum].roms, count = srcpart[partnum].rom_count;
+		if (count != 0 && first <= header->rom_count && count <= header->rom_count - first)
+		{
+			const softlist_db_rom *srcrom = (const softlist_db_rom *)(swlist->db + header->rom_offset) + first;
+			part.romdata = (rom_entry *)pool_malloc_lib(swlist->pool, count * sizeof(rom_entry));
+			for (UINT32 romnum = 0; romnum < count; romnum++)
+			{
+				rom_entry &rom = part.romdata[romnum];
+				rom._name = softlist_db_string(swlist, srcrom[romnum].name);
+				if ((srcrom[romnum].flags & ROMENTRY_TYPEMASK) == ROMENTRYTYPE_FILL)
+					rom._hashdata = (const char *)(FPTR)srcrom[romnum].hashdata;
+				else
+					rom._hashdata = softlist_db_string(swlist, srcrom[romnum].hashdata);
+				rom._offset = srcrom[romnum].offset;
+				rom._length = srcrom[romnum].length;
+				rom._flags = srcrom[romnum].flags;
+			}
+
+			/* never hand out a region list without its end */
+			part.romdata[count - 1]._name = NULL;
+			part.romdata[count - 1]._flags = ROMENTRYTYPE_END;
+		}
+	}
+
+	swlist->db_entries[index] = info;
+	return info;
+}
+
+
+/*-------------------------------------------------
+    softlist_db_find - software_list_find for a
+    compiled list
+-------------------------------------------------*/
+
+static const software_info *softlist_db_find(const software_list *swlist, const char *look_for, const software_info *prev)
+{
+	const softlist_db_header *header = (const softlist_db_header *)swlist->db;
+	const softlist_db_software *software = (const softlist_db_software *)(swlist->db + header->software_offset);
+	UINT32 first = (prev != NULL) ? prev->index + 1 : 0;
+
+	/* plain names go through the hash table, whose chains are in list order */
+	if (look_for[0] != 0 && strpbrk(look_for, "*?") == NULL && !(header->flags & SOFTLIST_DB_FLAG_WILDNAMES))
+	{
+		const UINT32 *buckets = (const UINT32 *)(swlist->db + header->hash_offset);
+		UINT32 last = 0;
+		for (UINT32 entry = buckets[softlist_db_hash(look_for) & header->hash_mask]; entry > last && entry <= header->software_count; entry = software[entry - 1].hash_next)
+		{
+			last = entry;
+			if (entry - 1 >= first && !mame_strwildcmp(look_for, softlist_db_string(swlist, software[entry - 1].shortname)))
+				return softlist_db_resolve(swlist, entry - 1);
+		}
+		return NULL;
+	}
+
+	/* anything else is a scan, but only the matches get built */
+	for (UINT32 index = first; index < header->software_count; index++)
+	{
+		const char *shortname = softlist_db_string(swlist, software[index].shortname);
+		if (shortname != NULL && !mame_strwildcmp(look_for, shortname))
+			return softlist_db_resolve(swlist, index);
+	}
+	return NULL;
+}
+
+
+/*-------------------------------------------------
+    softlist_db_open - load the compiled copy of
+    a list if it matches the XML; otherwise note
+    that it needs to be rebuilt after parsing
+-------------------------------------------------*/
+
+static void softlist_db_open(software_list *swlist, emu_options &options, const char *listname)
+{
+	// key the compiled copy on the XML it came from
+	UINT32 crc;
+	if (!swlist->file->hashes(hash_collection::HASH_TYPES_CRC).crc(crc))
+		return;
+	swlist->xml_length = swlist->file->size();
+	swlist->xml_crc = crc;
+	swlist->listname = pool_strdup_lib(swlist->pool, listname);
+	swlist->db_directory = pool_strdup_lib(swlist->pool, options.cfg_directory());
+	swlist->db_stale = TRUE;
+
+	emu_file *file = global_alloc(emu_file(options.cfg_directory(), OPEN_FLAG_READ));
+	UINT64 length = 0;
+	if (file->open(listname, SOFTLIST_DB_EXT) == FILERR_NONE)
+		length = file->size();
+	if (length <= sizeof(softlist_db_header) || length > 0x7fffffff)
+	{
+		global_free(file);
+		return;
+	}
+
+	// map it if we can, so only the entries we look at are ever paged in;
+	// otherwise read it all and let go of the file
+	UINT64 maplength;
+	const UINT8 *db = (const UINT8 *)core_fmap(*file, &maplength);
+	if (db == NULL || maplength != length)
+	{
+		UINT8 *buffer = global_alloc_array(UINT8, length);
+		bool ok = (file->read(buffer, length) == length);
+		global_free(file);
+		file = NULL;
+		if (!ok)
+		{
+			global_free(buffer);
+			return;
+		}
+		db = buffer;
+	}
+
+	// make sure it is ours, current, and that every table lies within the file
+	const softlist_db_header *header = (const softlist_db_header *)db;
+	bool valid = memcmp(header->magic, softlist_db_magic, sizeof(header->magic)) == 0 &&
+		header->version == SOFTLIST_DB_VERSION &&
+		header->xml_length == swlist->xml_length &&
+		header->xml_crc == crc &&
+		((header->hash_mask + 1) & header->hash_mask) == 0 &&
+		header->software_offset + UINT64(header->software_count) * sizeof(softlist_db_software) <= length &&
+		header->hash_offset + (UINT64(header->hash_mask) + 1) * sizeof(UINT32) <= length &&
+		header->interface_offset + UINT64(header->interface_count) * sizeof(UINT32) <= length &&
+		header->feature_offset + UINT64(header->feature_count) * sizeof(softlist_db_feature) <= length &&
+		header->part_offset + UINT64(header->part_count) * sizeof(softlist_db_part) <= length &&
+		header->rom_offset + UINT64(header->rom_count) * sizeof(softlist_db_rom) <= length &&
+		header->string_length != 0 && header->string_offset + UINT64(header->string_length) == length &&
+		db[length - 1] == 0;
+	if (!valid)
+	{
+		if (file != NULL)
+			global_free(file);
+		else
+			global_free(db);
+		return;
+	}
+
+	swlist->db_file = file;
+	swlist->db = db;
+	swlist->db_length = length;
+	swlist->db_entries = (software_info **)pool_malloc_lib(swlist->pool, (header->software_count + 1) * sizeof(software_info *));
+	memset(swlist->db_entries, 0, (header->software_count + 1) * sizeof(software_info *));
+	swlist->description = softlist_db_string(swlist, header->description);
+	swlist->list_entries = header->software_count;
+	swlist->db_stale = FALSE;
+}
+
+
+/*-------------------------------------------------
+    softlist_db_writer - accumulates the tables
+    of a compiled list
+-------------------------------------------------*/
+
+class softlist_db_writer
+{
+public:
+	softlist_db_writer()
+	{
+		// offset 0 stands for NULL
+		m_strings.append(0);
+	}
+
+	UINT32 string(const char *string)
+	{
+		if (string == NULL)
+			return 0;
+		UINT32 offset = m_stringmap.find(string);
+		if (offset == 0)
+		{
+			offset = m_strings.count();
+			for (const char *scan = string; ; scan++)
+			{
+				m_strings.append(*scan);
+				if (*scan == 0)
+					break;
+			}
+			m_stringmap.add(string, offset);
+		}
+		return offset;
+	}
+
+	void features(const feature_list *list, UINT32 &first, UINT32 &count)
+	{
+		first = m_features.count();
+		for ( ; list != NULL; list = list->next)
+		{
+			softlist_db_feature feature;
+			feature.name = string(list->name);
+			feature.value = string(list->value);
+			m_features.append(feature);
+		}
+		count = m_features.count() - first;
+	}
+
+	dynamic_array<softlist_db_software>     m_software;
+	dynamic_array<softlist_db_feature>      m_features;
+	dynamic_array<softlist_db_part>         m_parts;
+	dynamic_array<softlist_db_rom>          m_roms;
+	dynamic_array<UINT32>                   m_interfaces;
+	dynamic_buffer                          m_strings;
+	tagmap_t<UINT32, 4099>                  m_stringmap;
+};
+
+
+/*-------------------------------------------------
+    softlist_db_write - save the compiled copy of
+    a freshly parsed list
+-------------------------------------------------*/
+
+static void softlist_db_write(const software_list *swlist)
+{
+	softlist_db_writer writer;
+	UINT32 flags = 0;
+	tagmap_t<UINT8> interfaces;
+
+	for (const software_info *info = swlist->software_info_list; info != NULL; info = info->next)
+	{
+		softlist_db_software software;
+		software.shortname = writer.string(info->shortname);
+		software.longname = writer.string(info->longname);
+		software.parentname = writer.string(info->parentname);
+		software.year = writer.string(info->year);
+		software.publisher = writer.string(info->publisher);
+		software.supported = info->supported;
+		software.hash_next = 0;
+		writer.features(info->other_info, software.other_info, software.other_info_count);
+		writer.features(info->shared_info ? info->shared_info->next : NULL, software.shared_info, software.shared_info_count);
+		if (info->shortname[0] == 0 || strpbrk(info->shortname, "*?") != NULL)
+			flags |= SOFTLIST_DB_FLAG_WILDNAMES;
+
+		software.parts = writer.m_parts.count();
+		for (const software_part *part = info->partdata; part != NULL && part->name != NULL; part++)
+		{
+			softlist_db_part dbpart;
+			dbpart.name = writer.string(part->name);
+			dbpart.interface_ = writer.string(part->interface_);
+			writer.features(part->featurelist, dbpart.features, dbpart.feature_count);
+
+			dbpart.roms = writer.m_roms.count();
+			if (part->romdata != NULL)
+				for (const rom_entry *rom = part->romdata; ; rom++)
+				{
+					softlist_db_rom dbrom;
+					dbrom.name = writer.string(rom->_name);
+					dbrom.hashdata = ROMENTRY_ISFILL(rom) ? (FPTR)rom->_hashdata : writer.string(rom->_hashdata);
+					dbrom.offset = rom->_offset;
+					dbrom.length = rom->_length;
+					dbrom.flags = rom->_flags;
+					writer.m_roms.append(dbrom);
+					if (ROMENTRY_ISEND(rom))
+						break;
+				}
+			dbpart.rom_count = writer.m_roms.count() - dbpart.roms;
+			writer.m_parts.append(dbpart);
+		}
+		software.part_count = writer.m_parts.count() - software.parts;
+
+		// remember the interface the menus check against
+		if (info->partdata != NULL && info->partdata[0].name != NULL && info->partdata[0].interface_ != NULL)
+			if (interfaces.add(info->partdata[0].interface_, 1) == TMERR_NONE)
+				writer.m_interfaces.append(writer.string(info->partdata[0].interface_));
+
+		writer.m_software.append(software);
+	}
+
+	// build the hash table, inserting backwards so every chain is in list order
+	UINT32 buckets = 16;
+	while (buckets < UINT32(writer.m_software.count()) * 2)
+		buckets <<= 1;
+	dynamic_array<UINT32> hash(buckets);
+	memset(&hash[0], 0, buckets * sizeof(UINT32));
+	for (int index = writer.m_software.count() - 1; index >= 0; index--)
+	{
+		UINT32 &bucket = hash[softlist_db_hash((const char *)&writer.m_strings[writer.m_software[index].shortname]) & (buckets - 1)];
+		writer.m_software[index].hash_next = bucket;
+		bucket = index + 1;
+	}
+
+	// lay out the header and tables, with the strings last
+	softlist_db_header header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, softlist_db_magic, sizeof(header.magic));
+	header.version = SOFTLIST_DB_VERSION;
+	header.xml_length = swlist->xml_length;
+	header.xml_crc = swlist->xml_crc;
+	header.flags = flags;
+	header.description = writer.string(swlist->description);
+	header.software_count = writer.m_software.count();
+	header.software_offset = sizeof(header);
+	header.hash_mask = buckets - 1;
+	header.hash_offset = header.software_offset + header.software_count * sizeof(softlist_db_software);
+	header.interface_count = writer.m_interfaces.count();
+	header.interface_offset = header.hash_offset + buckets * sizeof(UINT32);
+	header.feature_count = writer.m_features.count();
+	header.feature_offset = header.interface_offset + header.interface_count * sizeof(UINT32);
+	header.part_count = writer.m_parts.count();
+	header.part_offset = header.feature_offset + header.feature_count * sizeof(softlist_db_feature);
+	header.rom_count = writer.m_roms.count();
+	header.rom_offset = header.part_offset + header.part_count * sizeof(softlist_db_part);
+	header.string_length = writer.m_strings.count();
+	header.string_offset = header.rom_offset + header.rom_count * sizeof(softlist_db_rom);
+
+	// write it out; a partial file fails validation next time and is rebuilt
+	emu_file file(swlist->db_directory, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(swlist->listname, SOFTLIST_DB_EXT) != FILERR_NONE)
+		return;
+	file.write(&header, sizeof(header));
+	if (header.software_count != 0)
+		file.write(&writer.m_software[0], header.software_count * sizeof(softlist_db_software));
+	file.write(&hash[0], buckets * sizeof(UINT32));
+	if (header.interface_count != 0)
+		file.write(&writer.m_interfaces[0], header.interface_count * sizeof(UINT32));
+	if (header.feature_count != 0)
+		file.write(&writer.m_features[0], header.feature_count * sizeof(softlist_db_feature));
+	if (header.part_count != 0)
+		file.write(&writer.m_parts[0], header.part_count * sizeof(softlist_db_part));
+	if (header.rom_count != 0)
+		file.write(&writer.m_roms[0], header.rom_count * sizeof(softlist_db_rom));
+	file.write(&writer.m_strings[0], header.string_length);
+}
+
+
 /*-------------------------------------------------
     software_list_parse
 -------------------------------------------------*/
 
 void software_list_parse(software_list *swlist,
-	void (*error_proc)(const char *message),
+	void (*error_proc)(const char *message, void *param),
 	void *param)
 {
 	char buf[1024];
 	UINT32 len;
 	XML_Memory_Handling_Suite memcallbacks;
+	bool parsed = false;
+
+	/* a compiled list needs no parsing */
+	if (swlist->db != NULL)
+		return;
 
 	swlist->file->seek(0, SEEK_SET);
 
@@ -1216,6 +1731,7 @@ void software_list_parse(software_list *swlist,
 			goto done;
 		}
 	}
+	parsed = true;
 
 done:
 	if (swlist->state.parser)
@@ -1223,6 +1739,13 @@ done:
 	swlist->state.parser = NULL;
 	swlist->current_software_info = swlist->software_info_list;
 	swlist->list_entries = software_list_get_count(swlist);
+
+	/* save a compiled copy for next time */
+	if (parsed && swlist->db_stale)
+	{
+		softlist_db_write(swlist);
+		swlist->db_stale = FALSE;
+	}
 }
 
 
@@ -1258,9 +1781,13 @@ software_list *software_list_open(emu_options &options, const char *listname, in
 	if (filerr != FILERR_NONE)
 		goto error;
 
-	if (is_preload)
+	/* use the compiled copy if there is a current one; validation wants the parser's diagnostics */
+	if (error_proc == NULL && options.softlist_cache())
+		softlist_db_open(swlist, options, listname);
+
+	if (is_preload && swlist->db == NULL)
 	{
-		software_list_parse(swlist, swlist->error_proc, NULL);
+		software_list_parse(swlist, NULL, NULL);
 		swlist->current_software_info = NULL;
 	}
 
@@ -1284,6 +1811,10 @@ void software_list_close(const software_list *swlist)
 
 	if (swlist->file != NULL)
 		global_free(swlist->file);
+	if (swlist->db_file != NULL)
+		global_free(swlist->db_file);
+	else if (swlist->db != NULL)
+		global_free(swlist->db);
 	pool_free_lib(swlist->pool);
 }
 
@@ -1298,6 +1829,40 @@ const char *software_list_get_description(const software_list *swlist)
 }
 
 
+/*-------------------------------------------------
+ software_list_has_interface - does any entry's
+ first part fit the given interface
+ -------------------------------------------------*/
+
+bool software_list_has_interface(const software_list *swlist, const char *interface)
+{
+	if (swlist == NULL || interface == NULL)
+		return false;
+
+	/* a compiled list knows its interfaces without building any entries */
+	if (swlist->db != NULL)
+	{
+		const softlist_db_header *header = (const softlist_db_header *)swlist->db;
+		const UINT32 *interfaces = (const UINT32 *)(swlist->db + header->interface_offset);
+		for (UINT32 index = 0; index < header->interface_count; index++)
+		{
+			const char *part_interface = softlist_db_string(swlist, interfaces[index]);
+			if (part_interface != NULL && softlist_contain_interface(interface, part_interface))
+				return true;
+		}
+		return false;
+	}
+
+	for (const software_info *swinfo = software_list_find(swlist, "*", NULL); swinfo != NULL; swinfo = software_list_find(swlist, "*", swinfo))
+	{
+		const software_part *part = software_find_part(swinfo, NULL, NULL);
+		if (part != NULL && softlist_contain_interface(interface, part->interface_))
+			return true;
+	}
+	return false;
+}
+
+
 /*-------------------------------------------------
  software_list_find_by_number
  -------------------------------------------------*/
@@ -1431,10 +1996,14 @@ const software_info *software_list_find(const software_list *swlist, const char
 	if (look_for == NULL)
 		return NULL;
 
+	/* A compiled list builds entries as they are found */
+	if ( swlist->db )
+		return softlist_db_find( swlist, look_for, prev );
+
 	/* If we haven't read in the xml file yet, then do it now */
 	/* Just-in-time parsing, hence the const-cast */
 	if ( ! swlist->software_info_list )
-		software_list_parse( const_cast<software_list *>(swlist), swlist->error_proc, NULL );
+		software_list_parse( const_cast<software_list *>(swlist), NULL, NULL );
 
 	for ( prev = prev ? prev->next : swlist->software_info_list; prev; prev = prev->next )
 	{
@@ -1605,7 +2174,7 @@ void software_display_matches(const machine_config &config,emu_options &options,
 			software_info *matches[16] = { 0 };
 			int softnum;
 
-			software_list_parse(list, list->error_proc, NULL);
+			software_list_parse(list, NULL, NULL);
 			// get the top 16 approximate matches for the selected device interface (i.e. only carts for cartslot, etc.)
 			software_list_find_approx_matches(swlist, list, name, ARRAY_LENGTH(matches), matches, interface);
 
@@ -2003,16 +2572,24 @@ bool swinfo_has_multiple_parts(const software_info *swinfo, const char *interfac
 ***************************************************************************/
 
 
-void validate_error_proc(const char *message)
+static void validate_alloc_error_proc(const char *message)
 {
 	mame_printf_error("%s", message);
 }
 
+static void validate_parse_error_proc(const char *message, void *param)
+{
+	reinterpret_cast<validity_checker *>(param)->error("%s", message);
+}
+
 void software_list_device::device_validity_check(validity_checker &valid) const
 {
 	// add to the global map whenever we check a list so we don't re-check
 	// it in the future
-	if (s_checked_lists.add(m_list_name, 1, false) == TMERR_DUPLICATE)
+	osd_lock_acquire(checked_lists_lock);
+	bool checked = (s_checked_lists.add(m_list_name, 1, false) == TMERR_DUPLICATE);
+	osd_lock_release(checked_lists_lock);
+	if (checked)
 		return;
 
 	// do device validation only in case of validate command
@@ -2023,10 +2600,12 @@ void software_list_device::device_validity_check(validity_checker &valid) const
 
 	enum { NAME_LEN_PARENT = 8, NAME_LEN_CLONE = 16 };
 
-	software_list *list = software_list_open(mconfig().options(), m_list_name, FALSE, NULL);
+	// an error callback keeps us on the XML parser, which is what reports
+	// problems in the list
+	software_list *list = software_list_open(mconfig().options(), m_list_name, FALSE, &validate_alloc_error_proc);
 	if ( list )
 	{
-		software_list_parse( list, &validate_error_proc, NULL );
+		software_list_parse( list, &validate_parse_error_proc, &valid );
 
 		for (software_info *swinfo = software_list_find(list, "*", NULL); swinfo != NULL; swinfo = software_list_find(list, "*", swinfo))
 		{
@@ -2038,21 +2617,21 @@ void software_list_device::device_validity_check(validity_checker &valid) const
 			/* Did we lost any description? */
 			if (swinfo->longname == NULL)
 			{
-				mame_printf_error("%s: %s has no description\n", list->file->filename(), swinfo->shortname);
+				valid.error("%s: %s has no description\n", list->file->filename(), swinfo->shortname);
 				break;
 			}
 
 			/* Did we lost any year? */
 			if (swinfo->year == NULL)
 			{
-				mame_printf_error("%s: %s has no year\n", list->file->filename(), swinfo->shortname);
+				valid.error("%s: %s has no year\n", list->file->filename(), swinfo->shortname);
 				break;
 			}
 
 			/* Did we lost any publisher? */
 			if (swinfo->publisher == NULL)
 			{
-				mame_printf_error("%s: %s has no publisher\n", list->file->filename(), swinfo->shortname);
+				valid.error("%s: %s has no publisher\n", list->file->filename(), swinfo->shortname);
 				break;
 			}
 
@@ -2062,12 +2641,12 @@ void software_list_device::device_validity_check(validity_checker &valid) const
 			if (names.add(swinfo->shortname, swinfo, FALSE) == TMERR_DUPLICATE)
 			{
 				software_info *match = names.find(swinfo->shortname);
-				mame_printf_error("%s: %s is a duplicate name (%s)\n", list->file->filename(), swinfo->shortname, match->shortname);
+				valid.error("%s: %s is a duplicate name (%s)\n", list->file->filename(), swinfo->shortname, match->shortname);
 			}
 
 			/* check for duplicate descriptions */
 			if (descriptions.add(astring(swinfo->longname).makelower().cstr(), swinfo, FALSE) == TMERR_DUPLICATE)
-				mame_printf_error("%s: %s is a duplicate description (%s)\n", list->file->filename(), swinfo->longname, swinfo->shortname);
+				valid.error("%s: %s is a duplicate description (%s)\n", list->file->filename(), swinfo->longname, swinfo->shortname);
 
 			if (swinfo->parentname != NULL)
 			{
@@ -2075,7 +2654,7 @@ void software_list_device::device_validity_check(validity_checker &valid) const
 
 				if (strcmp(swinfo->parentname, swinfo->shortname) == 0)
 				{
-					mame_printf_error("%s: %s is set as a clone of itself\n", list->file->filename(), swinfo->shortname);
+					valid.error("%s: %s is set as a clone of itself\n", list->file->filename(), swinfo->shortname);
 					break;
 				}
 
@@ -2083,21 +2662,21 @@ void software_list_device::device_validity_check(validity_checker &valid) const
 				software_info *swinfo2 = software_list_find(list, swinfo->parentname, NULL );
 
 				if (!swinfo2)
-					mame_printf_error("%s: parent '%s' software for '%s' not found\n", list->file->filename(), swinfo->parentname, swinfo->shortname);
+					valid.error("%s: parent '%s' software for '%s' not found\n", list->file->filename(), swinfo->parentname, swinfo->shortname);
 				else if (swinfo2->parentname != NULL)
-					mame_printf_error("%s: %s is a clone of a clone\n", list->file->filename(), swinfo->shortname);
+					valid.error("%s: %s is a clone of a clone\n", list->file->filename(), swinfo->shortname);
 			}
 
 			/* make sure the driver name is 8 chars or less */
 			if ((is_clone && strlen(swinfo->shortname) > NAME_LEN_CLONE) || ((!is_clone) && strlen(swinfo->shortname) > NAME_LEN_PARENT))
-				mame_printf_error("%s: %s %s driver name must be %d characters or less\n", list->file->filename(), swinfo->shortname,
+				valid.error("%s: %s %s driver name must be %d characters or less\n", list->file->filename(), swinfo->shortname,
 									is_clone ? "clone" : "parent", is_clone ? NAME_LEN_CLONE : NAME_LEN_PARENT);
 
 			/* make sure the year is only digits, '?' or '+' */
 			for (s = swinfo->year; *s; s++)
 				if (!isdigit((UINT8)*s) && *s != '?' && *s != '+')
 				{
-					mame_printf_error("%s: %s has an invalid year '%s'\n", list->file->filename(), swinfo->shortname, swinfo->year);
+					valid.error("%s: %s has an invalid year '%s'\n", list->file->filename(), swinfo->shortname, swinfo->year);
 					break;
 				}
 
@@ -2106,13 +2685,13 @@ void software_list_device::device_validity_check(validity_checker &valid) const
 			for (software_part *swpart = software_find_part(swinfo, NULL, NULL); swpart != NULL; swpart = software_part_next(swpart))
 			{
 				if (swpart->interface_ == NULL)
-					mame_printf_error("%s: %s has a part (%s) without interface\n", list->file->filename(), swinfo->shortname, swpart->name);
+					valid.error("%s: %s has a part (%s) without interface\n", list->file->filename(), swinfo->shortname, swpart->name);
 
 				if (software_find_romdata(swpart, NULL) == NULL)
-					mame_printf_error("%s: %s has a part (%s) with no data\n", list->file->filename(), swinfo->shortname, swpart->name);
+					valid.error("%s: %s has a part (%s) with no data\n", list->file->filename(), swinfo->shortname, swpart->name);
 
 				if (part_names.add(swpart->name, swinfo, FALSE) == TMERR_DUPLICATE)
-					mame_printf_error("%s: %s has a part (%s) whose name is duplicate\n", list->file->filename(), swinfo->shortname, swpart->name);
+					valid.error("%s: %s has a part (%s) whose name is duplicate\n", list->file->filename(), swinfo->shortname, swpart->name);
 
 				for (struct rom_entry *swdata = software_find_romdata(swpart, NULL); swdata != NULL;  swdata = software_romdata_next(swdata))
 				{
@@ -2126,14 +2705,14 @@ void software_list_device::device_validity_check(validity_checker &valid) const
 						for (str = data->_name; *str; str++)
 							if (tolower((UINT8)*str) != *str)
 							{
-								mame_printf_error("%s: %s has upper case ROM name %s\n", list->file->filename(), swinfo->shortname, data->_name);
+								valid.error("%s: %s has upper case ROM name %s\n", list->file->filename(), swinfo->shortname, data->_name);
 								break;
 							}
 
 						/* make sure the hash is valid */
 						hash_collection hashes;
 						if (!hashes.from_internal_string(data->_hashdata))
-							mame_printf_error("%s: %s has rom '%s' with an invalid hash string '%s'\n", list->file->filename(), swinfo->shortname, data->_name, data->_hashdata);
+							valid.error("%s: %s has rom '%s' with an invalid hash string '%s'\n", list->file->filename(), swinfo->shortname, data->_name, data->_hashdata);
 					}
 				}
 			}
@@ -134,6 +134,7 @@ struct software_info
 	int current_part_entry;
 	software_part *partdata;
 	struct software_info *next; // Used internally
+	UINT32 index;               // Position in a compiled list, used internally
 };
 
 
@@ -152,7 +153,7 @@ struct parse_state
 	XML_Parser  parser;
 	int         done;
 
-	void (*error_proc)(const char *message);
+	void (*error_proc)(const char *message, void *param);
 	void *param;
 
 	enum softlist_parse_position pos;
@@ -174,6 +175,17 @@ struct software_list
 	int current_rom_entry;
 	void (*error_proc)(const char *message);
 	int list_entries;
+
+	/* compiled copy of the list, see softlist.c */
+	const char *listname;
+	const char *db_directory;
+	emu_file *db_file;          /* open while db is mapped from it */
+	const UINT8 *db;
+	UINT32 db_length;
+	software_info **db_entries;
+	UINT32 xml_length;
+	UINT32 xml_crc;
+	int db_stale;
 };
 
 /* Handling a software list */
@@ -181,7 +193,8 @@ software_list *software_list_open(emu_options &options, const char *listname, in
 void software_list_close(const software_list *swlist);
 software_info *software_list_find(software_list *swlist, const char *look_for, software_info *prev);
 const char *software_list_get_description(const software_list *swlist);
-void software_list_parse(software_list *swlist, void (*error_proc)(const char *message), void *param);
+bool software_list_has_interface(const software_list *swlist, const char *interface);
+void software_list_parse(software_list *swlist, void (*error_proc)(const char *message, void *param), void *param);
 
 software_part *software_find_part(software_info *sw, const char *partname, const char *interface_);
 software_part *software_part_next(software_part *part);
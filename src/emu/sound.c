@@ -1039,6 +1039,8 @@ void sound_manager::update(void *ptr, int param)
 		machine().video().add_sound_to_recording(finalmix, finalmix_offset / 2);
 		if (m_wavfile != NULL)
 			wav_add_data_16(m_wavfile, finalmix, finalmix_offset);
+		if (!m_output_callback.isnull())
+			m_output_callback(finalmix, finalmix_offset / 2);
 	}
 
 	// see if we ticked over to the next second
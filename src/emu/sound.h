@@ -168,6 +168,12 @@ private:
 };
 
 
+// ======================> sound_output_delegate
+
+// receives each block of the final stereo mix: interleaved samples, sample pairs
+typedef delegate<void (const INT16 *, int)> sound_output_delegate;
+
+
 // ======================> sound_manager
 
 class sound_manager
@@ -210,6 +216,9 @@ public:
 	// user gain controls
 	bool indexed_mixer_input(int index, mixer_input &info) const;
 
+	// final mix output
+	void set_output_callback(sound_output_delegate callback) { m_output_callback = callback; }
+
 private:
 	// internal helpers
 	void mute(bool mute, UINT8 reason);
@@ -235,6 +244,7 @@ private:
 	int                 m_nosound_mode;
 
 	wav_file *          m_wavfile;
+	sound_output_delegate m_output_callback;    // extra consumer of the final mix
 
 	// streams data
 	simple_list<sound_stream> m_stream_list;    // list of streams
@@ -333,15 +333,7 @@ void ui_menu_software::populate()
 
 			if (list && interface)
 			{
-				bool found = false;
-				for (const software_info *swinfo = software_list_find(list, "*", NULL); swinfo != NULL; swinfo = software_list_find(list, "*", swinfo))
-				{
-					const software_part *part = software_find_part(swinfo, NULL, NULL);
-					if (softlist_contain_interface(interface,part->interface_)) {
-						found = true;
-					}
-				}
-				if (found) {
+				if (software_list_has_interface(list, interface)) {
 					item_append(list->description, NULL, 0, (void *)swlist);
 				}
 
@@ -359,15 +351,7 @@ void ui_menu_software::populate()
 
 			if (list && interface)
 			{
-				bool found = false;
-				for (const software_info *swinfo = software_list_find(list, "*", NULL); swinfo != NULL; swinfo = software_list_find(list, "*", swinfo))
-				{
-					const software_part *part = software_find_part(swinfo, NULL, NULL);
-					if (softlist_contain_interface(interface,part->interface_)) {
-						found = true;
-					}
-				}
-				if (found) {
+				if (software_list_has_interface(list, interface)) {
 					if (!haveCompatible) {
 						item_append("[compatible lists]", NULL, MENU_FLAG_DISABLE, NULL);
 					}
@@ -15,6 +15,7 @@
 
 #include "emu.h"
 #include "drivenum.h"
+#include "workpool.h"
 
 
 //**************************************************************************
@@ -26,7 +27,7 @@ class machine_config;
 
 
 // core validity checker class
-class validity_checker
+class validity_checker : public ordered_work_client
 {
 	// internal map types
 	typedef tagmap_t<const game_driver *> game_driver_map;
@@ -46,16 +47,35 @@ public:
 
 	// helpers for devices
 	void validate_tag(const char *tag);
+	void error(const char *format, ...) ATTR_PRINTF(2,3);
+	void warning(const char *format, ...) ATTR_PRINTF(2,3);
 
 private:
 	// internal helpers
 	const char *ioport_string_from_index(UINT32 index);
 	int get_defstr_index(const char *string, bool suppress_error = false);
 
+	// the outcome of validating one driver on a worker
+	struct result
+	{
+		result() : driver(NULL) { }
+
+		const game_driver *     driver;             // driver to validate
+		astring                 report;             // diagnostics, ready for output
+	};
+
 	// core helpers
 	void validate_begin();
+	void validate_reset();
 	void validate_end();
-	void validate_one(const game_driver &driver);
+	void validate_drivers(const game_driver **drivers, int count);
+	void validate_one(const game_driver &driver, astring &report);
+	bool select_sources(const char *sources, int_map &selected);
+
+	// parallel validation
+	virtual void *work_begin();
+	virtual void work_item(void *context, int index);
+	virtual void work_end(void *context);
 
 	// internal sub-checks
 	void validate_core();
@@ -101,6 +121,13 @@ private:
 	// callbacks
 	output_delegate         m_saved_error_output;
 	output_delegate         m_saved_warning_output;
+
+	// parallel validation state
+	const validity_checker *m_master;
+	result *                m_results;
+	int                     m_count;
+	osd_lock *              m_lock;
+	ordered_work_pool       m_pool;
 };
 
 #endif
@@ -100,11 +100,21 @@ video_manager::video_manager(running_machine &machine)
 		m_snap_native(true),
 		m_snap_width(0),
 		m_snap_height(0),
+		m_snap_queue(NULL),
 		m_mngfile(NULL),
 		m_avifile(NULL),
 		m_movie_frame_period(attotime::zero),
 		m_movie_next_frame_time(attotime::zero),
-		m_movie_frame(0)
+		m_movie_frame(0),
+		m_movie_queue(NULL),
+		m_movie_head(0),
+		m_movie_tail(0),
+		m_movie_pending(0),
+		m_movie_draining(0),
+		m_movie_failed(0),
+		m_movie_peak(0),
+		m_movie_stalls(0),
+		m_movie_stall_ticks(0)
 {
 	// request a callback upon exiting
 	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(video_manager::exit), this));
@@ -142,6 +152,9 @@ video_manager::video_manager(running_machine &machine)
 	if (sscanf(machine.options().snap_size(), "%dx%d", &m_snap_width, &m_snap_height) != 2)
 		m_snap_width = m_snap_height = 0;
 
+	// PNG compression is spread over several threads when possible
+	m_snap_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+
 	// start recording movie if specified
 	const char *filename = machine.options().mng_write();
 	if (filename[0] != 0)
@@ -307,6 +320,8 @@ void video_manager::save_snapshot(screen_device *screen, emu_file &file)
 	png_info pnginfo = { 0 };
 	png_add_text(&pnginfo, "Software", text1);
 	png_add_text(&pnginfo, "System", text2);
+	pnginfo.level = machine().options().snap_level();
+	pnginfo.workqueue = m_snap_queue;
 
 	// now do the actual work
 	const rgb_t *palette = (machine().palette != NULL) ? palette_entry_list_adjusted(machine().palette) : NULL;
@@ -445,6 +460,17 @@ void video_manager::begin_recording(const char *name, movie_format format)
 			m_mngfile = NULL;
 		}
 	}
+
+	// hand the writing to a worker thread if we can
+	if (is_recording())
+	{
+		m_movie_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+		m_movie_head = m_movie_tail = 0;
+		m_movie_pending = m_movie_draining = m_movie_failed = 0;
+		m_movie_peak = 0;
+		m_movie_stalls = 0;
+		m_movie_stall_ticks = 0;
+	}
 }
 
 
@@ -454,6 +480,25 @@ void video_manager::begin_recording(const char *name, movie_format format)
 
 void video_manager::end_recording()
 {
+	// let the writer finish what is queued
+	if (m_movie_queue != NULL)
+	{
+		while (!osd_work_queue_wait(m_movie_queue, osd_ticks_per_second()))
+			;
+		osd_work_queue_free(m_movie_queue);
+		m_movie_queue = NULL;
+	}
+	if (is_recording() && m_movie_frame != 0)
+		mame_printf_verbose("Movie recording: %d frames, writer queue peak %d of %d, emulation waited %d times for %.3f seconds\n",
+				m_movie_frame, m_movie_peak, MOVIE_QUEUE_ITEMS, m_movie_stalls, (double)m_movie_stall_ticks / (double)osd_ticks_per_second());
+
+	// release the pooled buffers
+	for (int index = 0; index < MOVIE_QUEUE_ITEMS; index++)
+	{
+		m_movie_items[index].bitmap.reset();
+		m_movie_items[index].sound.reset();
+	}
+
 	// close the file if it exists
 	if (m_avifile != NULL)
 	{
@@ -484,14 +529,20 @@ void video_manager::add_sound_to_recording(const INT16 *sound, int numsamples)
 	// only record if we have a file
 	if (m_avifile != NULL)
 	{
+		if (m_movie_failed)
+			return end_recording();
+
 		g_profiler.start(PROFILER_MOVIE_REC);
 
-		// write the next frame
-		avi_error avierr = avi_append_sound_samples(m_avifile, 0, sound + 0, numsamples, 1);
-		if (avierr == AVIERR_NONE)
-			avierr = avi_append_sound_samples(m_avifile, 1, sound + 1, numsamples, 1);
-		if (avierr != AVIERR_NONE)
-			end_recording();
+		// copy the samples for the writer
+		movie_item &item = movie_item_alloc();
+		item.frames = 0;
+		item.first = false;
+		item.sound.resize(numsamples * 2);
+		if (numsamples != 0)
+			memcpy(&item.sound[0], sound, numsamples * 2 * sizeof(*sound));
+		item.samples = numsamples;
+		movie_item_queue();
 
 		g_profiler.stop();
 	}
@@ -515,6 +566,9 @@ void video_manager::exit()
 	// free the snapshot target
 	machine().render().target_free(m_snap_target);
 	m_snap_bitmap.reset();
+	if (m_snap_queue != NULL)
+		osd_work_queue_free(m_snap_queue);
+	m_snap_queue = NULL;
 
 	// print a final result if we have at least 2 seconds' worth of data
 	if (m_overall_emutime.seconds >= 1)
@@ -1194,58 +1248,160 @@ void video_manager::record_frame()
 	// ignore if nothing to do
 	if (m_mngfile == NULL && m_avifile == NULL)
 		return;
+	if (m_movie_failed)
+		return end_recording();
 
 	// start the profiler and get the current time
 	g_profiler.start(PROFILER_MOVIE_REC);
 	attotime curtime = machine().time();
 
-	// create the bitmap
-	create_snapshot_bitmap(NULL);
-
-	// loop until we hit the right time
+	// count the movie frames that are due; they all get the current image
+	int frames = 0;
 	while (m_movie_next_frame_time <= curtime)
 	{
-		// handle an AVI recording
-		if (m_avifile != NULL)
+		m_movie_next_frame_time += m_movie_frame_period;
+		frames++;
+	}
+
+	if (frames != 0)
+	{
+		// create the bitmap and copy it for the writer
+		create_snapshot_bitmap(NULL);
+		movie_item &item = movie_item_alloc();
+		if (!item.bitmap.valid() || item.bitmap.width() != m_snap_bitmap.width() || item.bitmap.height() != m_snap_bitmap.height())
+			item.bitmap.allocate(m_snap_bitmap.width(), m_snap_bitmap.height());
+		copybitmap(item.bitmap, m_snap_bitmap, 0, 0, 0, 0, m_snap_bitmap.cliprect());
+		item.frames = frames;
+		item.first = (m_movie_frame == 0);
+		item.samples = 0;
+		movie_item_queue();
+
+		// advance the frame count
+		m_movie_frame += frames;
+	}
+	g_profiler.stop();
+}
+
+
+//-------------------------------------------------
+//  movie_item_alloc - return the next free movie
+//  item, waiting for the writer if they are all
+//  in use
+//-------------------------------------------------
+
+video_manager::movie_item &video_manager::movie_item_alloc()
+{
+	if (m_movie_pending == MOVIE_QUEUE_ITEMS)
+	{
+		osd_ticks_t start = osd_ticks();
+		while (m_movie_pending == MOVIE_QUEUE_ITEMS)
+			osd_work_queue_wait(m_movie_queue, osd_ticks_per_second() / 1000);
+		m_movie_stalls++;
+		m_movie_stall_ticks += osd_ticks() - start;
+	}
+	return m_movie_items[m_movie_tail];
+}
+
+
+//-------------------------------------------------
+//  movie_item_queue - pass the item returned by
+//  movie_item_alloc to the writer
+//-------------------------------------------------
+
+void video_manager::movie_item_queue()
+{
+	m_movie_tail = (m_movie_tail + 1) % MOVIE_QUEUE_ITEMS;
+	INT32 pending = atomic_increment32(&m_movie_pending);
+	if (pending > m_movie_peak)
+		m_movie_peak = pending;
+
+	// without a worker, write it right away
+	if (m_movie_queue == NULL)
+		movie_work();
+
+	// otherwise start a writer unless one is already going
+	else if (atomic_exchange32(&m_movie_draining, 1) == 0)
+		osd_work_item_queue(m_movie_queue, movie_work_static, this, WORK_ITEM_FLAG_AUTO_RELEASE);
+}
+
+
+//-------------------------------------------------
+//  movie_work - write pending movie items in
+//  order until there are none left
+//-------------------------------------------------
+
+void *video_manager::movie_work_static(void *param, int threadid)
+{
+	reinterpret_cast<video_manager *>(param)->movie_work();
+	return NULL;
+}
+
+void video_manager::movie_work()
+{
+	do
+	{
+		while (m_movie_pending != 0)
 		{
-			// write the next frame
-			avi_error avierr = avi_append_video_frame(m_avifile, m_snap_bitmap);
-			if (avierr != AVIERR_NONE)
-			{
-				g_profiler.stop();
-				return end_recording();
-			}
+			// after an error, just discard the rest
+			movie_item &item = m_movie_items[m_movie_head];
+			if (!m_movie_failed && !movie_write(item))
+				atomic_exchange32(&m_movie_failed, 1);
+			m_movie_head = (m_movie_head + 1) % MOVIE_QUEUE_ITEMS;
+			atomic_decrement32(&m_movie_pending);
 		}
+		atomic_exchange32(&m_movie_draining, 0);
+
+	// pick up anything queued after the last check, unless a new writer will
+	} while (m_movie_pending != 0 && atomic_exchange32(&m_movie_draining, 1) == 0);
+}
+
+
+//-------------------------------------------------
+//  movie_write - write a single movie item;
+//  returns false on an error
+//-------------------------------------------------
+
+bool video_manager::movie_write(movie_item &item)
+{
+	for (int frame = 0; frame < item.frames; frame++)
+	{
+		// handle an AVI recording
+		if (m_avifile != NULL && avi_append_video_frame(m_avifile, item.bitmap) != AVIERR_NONE)
+			return false;
 
 		// handle a MNG recording
 		if (m_mngfile != NULL)
 		{
 			// set up the text fields in the movie info
 			png_info pnginfo = { 0 };
-			if (m_movie_frame == 0)
+			if (item.first && frame == 0)
 			{
 				astring text1(emulator_info::get_appname(), " ", build_version);
 				astring text2(machine().system().manufacturer, " ", machine().system().description);
 				png_add_text(&pnginfo, "Software", text1);
 				png_add_text(&pnginfo, "System", text2);
 			}
+			pnginfo.level = machine().options().snap_level();
+			pnginfo.workqueue = m_snap_queue;
 
-			// write the next frame
-			const rgb_t *palette = (machine().palette != NULL) ? palette_entry_list_adjusted(machine().palette) : NULL;
-			png_error error = mng_capture_frame(*m_mngfile, &pnginfo, m_snap_bitmap, machine().total_colors(), palette);
+			// write the next frame; the bitmap is RGB, so no palette is needed
+			png_error error = mng_capture_frame(*m_mngfile, &pnginfo, item.bitmap, 0, NULL);
 			png_free(&pnginfo);
 			if (error != PNGERR_NONE)
-			{
-				g_profiler.stop();
-				return end_recording();
-			}
+				return false;
 		}
+	}
 
-		// advance time
-		m_movie_next_frame_time += m_movie_frame_period;
-		m_movie_frame++;
+	// sound only goes to AVI files
+	if (item.samples != 0 && m_avifile != NULL)
+	{
+		avi_error avierr = avi_append_sound_samples(m_avifile, 0, &item.sound[0], item.samples, 1);
+		if (avierr == AVIERR_NONE)
+			avierr = avi_append_sound_samples(m_avifile, 1, &item.sound[1], item.samples, 1);
+		if (avierr != AVIERR_NONE)
+			return false;
 	}
-	g_profiler.stop();
+	return true;
 }
 
 
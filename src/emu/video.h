@@ -108,10 +108,26 @@ private:
 	void update_refresh_speed();
 	void recompute_speed(attotime emutime);
 
+	// movie data waiting for the writer
+	static const int MOVIE_QUEUE_ITEMS = 16;
+	struct movie_item
+	{
+		bitmap_rgb32        bitmap;                 // image to write
+		int                 frames;                 // number of movie frames it fills
+		bool                first;                  // first frame of the movie?
+		dynamic_array<INT16> sound;                 // interleaved stereo samples
+		int                 samples;                // number of sample pairs
+	};
+
 	// snapshot/movie helpers
 	void create_snapshot_bitmap(screen_device *screen);
 	file_error open_next(emu_file &file, const char *extension);
 	void record_frame();
+	movie_item &movie_item_alloc();
+	void movie_item_queue();
+	static void *movie_work_static(void *param, int threadid);
+	void movie_work();
+	bool movie_write(movie_item &item);
 
 	// internal state
 	running_machine &   m_machine;                  // reference to our machine
@@ -158,6 +174,7 @@ private:
 	bool                m_snap_native;              // are we using native per-screen layouts?
 	INT32               m_snap_width;               // width of snapshots (0 == auto)
 	INT32               m_snap_height;              // height of snapshots (0 == auto)
+	osd_work_queue *    m_snap_queue;               // queue for compressing PNGs in parallel
 
 	// movie recording
 	emu_file *          m_mngfile;                  // handle to the open movie file
@@ -166,6 +183,18 @@ private:
 	attotime            m_movie_next_frame_time;    // time of next frame
 	UINT32              m_movie_frame;              // current movie frame number
 
+	// movie writing, off the emulation thread when possible
+	osd_work_queue *    m_movie_queue;              // queue for the writer, or NULL to write inline
+	movie_item          m_movie_items[MOVIE_QUEUE_ITEMS]; // ring of pooled buffers
+	int                 m_movie_head;               // next item to write
+	int                 m_movie_tail;               // next item to fill
+	volatile INT32      m_movie_pending;            // items filled but not yet written
+	volatile INT32      m_movie_draining;           // is a writer work item queued?
+	volatile INT32      m_movie_failed;             // did the writer hit an error?
+	INT32               m_movie_peak;               // most items ever pending
+	UINT32              m_movie_stalls;             // times the emulation waited for the writer
+	osd_ticks_t         m_movie_stall_ticks;        // total time spent waiting
+
 	static const UINT8      s_skiptable[FRAMESKIP_LEVELS][FRAMESKIP_LEVELS];
 
 	static const attoseconds_t ATTOSECONDS_PER_SPEED_UPDATE = ATTOSECONDS_PER_SECOND / 4;
@@ -165,6 +165,7 @@ struct poly_manager
 	size_t              extra_size;             /* size of each extra data, in bytes */
 
 	/* misc data */
+	running_machine *   machine;                /* owning machine, or NULL if standalone */
 	UINT8               flags;                  /* flags */
 
 	/* buckets */
@@ -183,6 +184,7 @@ struct poly_manager
 	UINT32              extra_max;              /* maximum extra data used */
 	UINT32              conflicts[WORK_MAX_THREADS]; /* number of conflicts found, per thread */
 	UINT32              resolved[WORK_MAX_THREADS]; /* number of conflicts resolved, per thread */
+	UINT64              setup_ticks;            /* profiling ticks spent in polygon setup */
 #endif
 };
 
@@ -192,7 +194,9 @@ struct poly_manager
     FUNCTION PROTOTYPES
 ***************************************************************************/
 
-static void **allocate_array(running_machine &machine, size_t *itemsize, UINT32 itemcount);
+static poly_manager *allocate_manager(running_machine *machine, int max_polys, size_t extra_data_size, UINT8 flags);
+static void **allocate_array(running_machine *machine, size_t *itemsize, UINT32 itemcount);
+static void free_array(void **ptrarray);
 static void *poly_item_callback(void *param, int threadid);
 static void poly_state_presave(poly_manager *poly);
 
@@ -310,33 +314,7 @@ INLINE polygon_info *allocate_polygon(poly_manager *poly, int miny, int maxy)
 
 poly_manager *poly_alloc(running_machine &machine, int max_polys, size_t extra_data_size, UINT8 flags)
 {
-	poly_manager *poly;
-
-	/* allocate the manager itself */
-	poly = auto_alloc_clear(machine, poly_manager);
-	poly->flags = flags;
-
-	/* allocate polygons */
-	poly->polygon_size = sizeof(polygon_info);
-	poly->polygon_count = MAX(max_polys, 1);
-	poly->polygon_next = 0;
-	poly->polygon = (polygon_info **)allocate_array(machine, &poly->polygon_size, poly->polygon_count);
-
-	/* allocate extra data */
-	poly->extra_size = extra_data_size;
-	poly->extra_count = poly->polygon_count;
-	poly->extra_next = 1;
-	poly->extra = allocate_array(machine, &poly->extra_size, poly->extra_count);
-
-	/* allocate triangle work units */
-	poly->unit_size = (flags & POLYFLAG_ALLOW_QUADS) ? sizeof(quad_work_unit) : sizeof(tri_work_unit);
-	poly->unit_count = MIN(poly->polygon_count * UNITS_PER_POLY, 65535);
-	poly->unit_next = 0;
-	poly->unit = (work_unit **)allocate_array(machine, &poly->unit_size, poly->unit_count);
-
-	/* create the work queue */
-	if (!(flags & POLYFLAG_NO_WORK_QUEUE))
-		poly->queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+	poly_manager *poly = allocate_manager(&machine, max_polys, extra_data_size, flags);
 
 	/* request a pre-save callback for synchronization */
 	machine.save().register_presave(save_prepost_delegate(FUNC(poly_state_presave), poly));
@@ -344,6 +322,18 @@ poly_manager *poly_alloc(running_machine &machine, int max_polys, size_t extra_d
 }
 
 
+/*-------------------------------------------------
+    poly_alloc - initialize a new polygon
+    manager that is not tied to a machine, for
+    use by tools; poly_free releases its memory
+-------------------------------------------------*/
+
+poly_manager *poly_alloc(int max_polys, size_t extra_data_size, UINT8 flags)
+{
+	return allocate_manager(NULL, max_polys, extra_data_size, flags);
+}
+
+
 /*-------------------------------------------------
     poly_free - free a polygon manager
 -------------------------------------------------*/
@@ -364,6 +354,7 @@ void poly_free(poly_manager *poly)
 		printf("Total pixels   = %d%09d\n", (UINT32)(poly->pixels / 1000000000), (UINT32)(poly->pixels % 1000000000));
 	else
 		printf("Total pixels   = %d\n", (UINT32)poly->pixels);
+	printf("Setup:      %d ticks per polygon, %d polygons\n", (UINT32)(poly->setup_ticks / MAX(poly->triangles + poly->quads, 1)), poly->triangles + poly->quads);
 	printf("Conflicts:  %d resolved, %d total\n", resolved, conflicts);
 	printf("Units:      %5d used, %5d allocated, %5d waits, %4d bytes each, %7d total\n", poly->unit_max, poly->unit_count, poly->unit_waits, poly->unit_size, poly->unit_count * poly->unit_size);
 	printf("Polygons:   %5d used, %5d allocated, %5d waits, %4d bytes each, %7d total\n", poly->polygon_max, poly->polygon_count, poly->polygon_waits, poly->polygon_size, poly->polygon_count * poly->polygon_size);
@@ -374,6 +365,15 @@ void poly_free(poly_manager *poly)
 	/* free the work queue */
 	if (poly->queue != NULL)
 		osd_work_queue_free(poly->queue);
+
+	/* a machine frees its own allocations */
+	if (poly->machine == NULL)
+	{
+		free_array((void **)poly->unit);
+		free_array(poly->extra);
+		free_array((void **)poly->polygon);
+		global_free(poly);
+	}
 }
 
 
@@ -462,6 +462,9 @@ void *poly_get_extra_data(poly_manager *poly)
 
 UINT32 poly_render_triangle(poly_manager *poly, void *dest, const rectangle &cliprect, poly_draw_scanline_func callback, int paramcount, const poly_vertex *v1, const poly_vertex *v2, const poly_vertex *v3)
 {
+#if KEEP_STATISTICS
+	osd_ticks_t setup_start = get_profile_ticks();
+#endif
 	float dxdy_v1v2, dxdy_v1v3, dxdy_v2v3;
 	const poly_vertex *tv;
 	INT32 curscan, scaninc;
@@ -632,6 +635,9 @@ UINT32 poly_render_triangle(poly_manager *poly, void *dest, const rectangle &cli
 		osd_work_item_queue_multiple(poly->queue, poly_item_callback, poly->unit_next - startunit, poly->unit[startunit], poly->unit_size, WORK_ITEM_FLAG_AUTO_RELEASE);
 
 	/* return the total number of pixels in the triangle */
+#if KEEP_STATISTICS
+	poly->setup_ticks += get_profile_ticks() - setup_start;
+#endif
 	poly->triangles++;
 	poly->pixels += pixels;
 	return pixels;
@@ -662,6 +668,9 @@ UINT32 poly_render_triangle_fan(poly_manager *poly, void *dest, const rectangle
 
 UINT32 poly_render_triangle_custom(poly_manager *poly, void *dest, const rectangle &cliprect, poly_draw_scanline_func callback, int startscanline, int numscanlines, const poly_extent *extents)
 {
+#if KEEP_STATISTICS
+	osd_ticks_t setup_start = get_profile_ticks();
+#endif
 	INT32 curscan, scaninc;
 	polygon_info *polygon;
 	INT32 v1yclip, v3yclip;
@@ -740,6 +749,9 @@ UINT32 poly_render_triangle_custom(poly_manager *poly, void *dest, const rectang
 		osd_work_item_queue_multiple(poly->queue, poly_item_callback, poly->unit_next - startunit, poly->unit[startunit], poly->unit_size, WORK_ITEM_FLAG_AUTO_RELEASE);
 
 	/* return the total number of pixels in the object */
+#if KEEP_STATISTICS
+	poly->setup_ticks += get_profile_ticks() - setup_start;
+#endif
 	poly->triangles++;
 	poly->pixels += pixels;
 	return pixels;
@@ -758,6 +770,9 @@ UINT32 poly_render_triangle_custom(poly_manager *poly, void *dest, const rectang
 
 UINT32 poly_render_quad(poly_manager *poly, void *dest, const rectangle &cliprect, poly_draw_scanline_func callback, int paramcount, const poly_vertex *v1, const poly_vertex *v2, const poly_vertex *v3, const poly_vertex *v4)
 {
+#if KEEP_STATISTICS
+	osd_ticks_t setup_start = get_profile_ticks();
+#endif
 	poly_edge fedgelist[3], bedgelist[3];
 	const poly_edge *ledge, *redge;
 	const poly_vertex *v[4];
@@ -965,6 +980,9 @@ UINT32 poly_render_quad(poly_manager *poly, void *dest, const rectangle &cliprec
 		osd_work_item_queue_multiple(poly->queue, poly_item_callback, poly->unit_next - startunit, poly->unit[startunit], poly->unit_size, WORK_ITEM_FLAG_AUTO_RELEASE);
 
 	/* return the total number of pixels in the triangle */
+#if KEEP_STATISTICS
+	poly->setup_ticks += get_profile_ticks() - setup_start;
+#endif
 	poly->quads++;
 	poly->pixels += pixels;
 	return pixels;
@@ -1000,6 +1018,9 @@ UINT32 poly_render_quad_fan(poly_manager *poly, void *dest, const rectangle &cli
 
 UINT32 poly_render_polygon(poly_manager *poly, void *dest, const rectangle &cliprect, poly_draw_scanline_func callback, int paramcount, int numverts, const poly_vertex *v)
 {
+#if KEEP_STATISTICS
+	osd_ticks_t setup_start = get_profile_ticks();
+#endif
 	poly_edge fedgelist[MAX_POLYGON_VERTS - 1], bedgelist[MAX_POLYGON_VERTS - 1];
 	const poly_edge *ledge, *redge;
 	poly_edge *edgeptr;
@@ -1197,6 +1218,9 @@ UINT32 poly_render_polygon(poly_manager *poly, void *dest, const rectangle &clip
 		osd_work_item_queue_multiple(poly->queue, poly_item_callback, poly->unit_next - startunit, poly->unit[startunit], poly->unit_size, WORK_ITEM_FLAG_AUTO_RELEASE);
 
 	/* return the total number of pixels in the triangle */
+#if KEEP_STATISTICS
+	poly->setup_ticks += get_profile_ticks() - setup_start;
+#endif
 	poly->quads++;
 	poly->pixels += pixels;
 	return pixels;
@@ -1245,11 +1269,54 @@ int poly_zclip_if_less(int numverts, const poly_vertex *v, poly_vertex *outv, in
     INTERNAL FUNCTIONS
 ***************************************************************************/
 
+/*-------------------------------------------------
+    allocate_manager - allocate a polygon manager
+    and its arrays, from the machine's pool if
+    there is one
+-------------------------------------------------*/
+
+static poly_manager *allocate_manager(running_machine *machine, int max_polys, size_t extra_data_size, UINT8 flags)
+{
+	poly_manager *poly;
+
+	/* allocate the manager itself */
+	if (machine != NULL)
+		poly = auto_alloc_clear(*machine, poly_manager);
+	else
+		poly = global_alloc_clear(poly_manager);
+	poly->machine = machine;
+	poly->flags = flags;
+
+	/* allocate polygons */
+	poly->polygon_size = sizeof(polygon_info);
+	poly->polygon_count = MAX(max_polys, 1);
+	poly->polygon_next = 0;
+	poly->polygon = (polygon_info **)allocate_array(machine, &poly->polygon_size, poly->polygon_count);
+
+	/* allocate extra data */
+	poly->extra_size = extra_data_size;
+	poly->extra_count = poly->polygon_count;
+	poly->extra_next = 1;
+	poly->extra = allocate_array(machine, &poly->extra_size, poly->extra_count);
+
+	/* allocate triangle work units */
+	poly->unit_size = (flags & POLYFLAG_ALLOW_QUADS) ? sizeof(quad_work_unit) : sizeof(tri_work_unit);
+	poly->unit_count = MIN(poly->polygon_count * UNITS_PER_POLY, 65535);
+	poly->unit_next = 0;
+	poly->unit = (work_unit **)allocate_array(machine, &poly->unit_size, poly->unit_count);
+
+	/* create the work queue */
+	if (!(flags & POLYFLAG_NO_WORK_QUEUE))
+		poly->queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+	return poly;
+}
+
+
 /*-------------------------------------------------
     allocate_array - allocate an array of pointers
 -------------------------------------------------*/
 
-static void **allocate_array(running_machine &machine, size_t *itemsize, UINT32 itemcount)
+static void **allocate_array(running_machine *machine, size_t *itemsize, UINT32 itemcount)
 {
 	void **ptrarray;
 	int itemnum;
@@ -1261,11 +1328,17 @@ static void **allocate_array(running_machine &machine, size_t *itemsize, UINT32
 	/* round to a cache line boundary */
 	*itemsize = ((*itemsize + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE) * CACHE_LINE_SIZE;
 
-	/* allocate the array */
-	ptrarray = auto_alloc_array_clear(machine, void *, itemcount);
-
-	/* allocate the actual items */
-	ptrarray[0] = auto_alloc_array_clear(machine, UINT8, *itemsize * itemcount);
+	/* allocate the array and the actual items */
+	if (machine != NULL)
+	{
+		ptrarray = auto_alloc_array_clear(*machine, void *, itemcount);
+		ptrarray[0] = auto_alloc_array_clear(*machine, UINT8, *itemsize * itemcount);
+	}
+	else
+	{
+		ptrarray = global_alloc_array_clear(void *, itemcount);
+		ptrarray[0] = global_alloc_array_clear(UINT8, *itemsize * itemcount);
+	}
 
 	/* initialize the pointer array */
 	for (itemnum = 1; itemnum < itemcount; itemnum++)
@@ -1274,6 +1347,20 @@ static void **allocate_array(running_machine &machine, size_t *itemsize, UINT32
 }
 
 
+/*-------------------------------------------------
+    free_array - free an array allocated by
+    allocate_array without a machine
+-------------------------------------------------*/
+
+static void free_array(void **ptrarray)
+{
+	if (ptrarray == NULL)
+		return;
+	global_free(ptrarray[0]);
+	global_free(ptrarray);
+}
+
+
 /*-------------------------------------------------
     poly_item_callback - callback for each poly
     item
@@ -58,12 +58,22 @@
 #define POLYFLAG_INCLUDE_BOTTOM_EDGE        0x01
 #define POLYFLAG_INCLUDE_RIGHT_EDGE         0x02
 #define POLYFLAG_NO_WORK_QUEUE              0x04
+#define POLYFLAG_TILE_BINNING               0x08
 
 #define SCANLINES_PER_BUCKET                8
 #define CACHE_LINE_SIZE                     64          // this is a general guess
 #define TOTAL_BUCKETS                       (512 / SCANLINES_PER_BUCKET)
 #define UNITS_PER_POLY                      (100 / SCANLINES_PER_BUCKET)
 
+// tile binning: screen tiles are TILE_WIDTH x TILE_HEIGHT pixels; tile
+// coordinates wrap at TILE_COLUMNS x TILE_ROWS, the same way buckets wrap
+#define TILE_WIDTH                          64
+#define TILE_HEIGHT                         (4 * SCANLINES_PER_BUCKET)
+#define TILE_COLUMNS                        (1024 / TILE_WIDTH)
+#define TILE_ROWS                           (512 / TILE_HEIGHT)
+#define TOTAL_TILES                         (TILE_COLUMNS * TILE_ROWS)
+#define BIN_ENTRIES_PER_UNIT                4
+
 
 
 //**************************************************************************
@@ -121,10 +131,11 @@ public:
 	// construction/destruction
 	poly_manager(running_machine &machine, UINT8 flags = 0);
 	poly_manager(screen_device &screen, UINT8 flags = 0);
+	explicit poly_manager(UINT8 flags);         // with no machine, for tools
 	virtual ~poly_manager();
 
 	// getters
-	running_machine &machine() const { return m_machine; }
+	running_machine &machine() const { assert(m_machine != NULL); return *m_machine; }
 	screen_device &screen() const { assert(m_screen != NULL); return *m_screen; }
 
 	// synchronization
@@ -181,15 +192,16 @@ private:
 
 	public:
 		// construction
-		poly_array(running_machine &machine, poly_manager &manager)
+		poly_array(running_machine *machine, poly_manager &manager)
 			: m_manager(manager),
-				m_base(auto_alloc_array_clear(machine, UINT8, k_itemsize * _Count)),
+				m_machine(machine),
+				m_base((machine != NULL) ? auto_alloc_array_clear(*machine, UINT8, k_itemsize * _Count) : global_alloc_array_clear(UINT8, k_itemsize * _Count)),
 				m_next(0),
 				m_max(0),
 				m_waits(0) { }
 
 		// destruction
-		~poly_array() { auto_free(m_manager.machine(), m_base); }
+		~poly_array() { if (m_machine != NULL) auto_free(*m_machine, m_base); else global_free(m_base); }
 
 		// operators
 		_Type &operator[](int index) const { assert(index >= 0 && index < _Count); return *reinterpret_cast<_Type *>(m_base + index * k_itemsize); }
@@ -211,12 +223,29 @@ private:
 	private:
 		// internal state
 		poly_manager &      m_manager;
+		running_machine *   m_machine;
 		UINT8 *             m_base;
 		int                 m_next;
 		int                 m_max;
 		int                 m_waits;
 	};
 
+	// reference from a tile bin to a work unit that touches the tile
+	struct bin_entry
+	{
+		UINT32              next;                   // index of the next entry in the same bin
+		UINT16              unit;                   // index of the work unit
+		INT16               tilex;                  // left edge of the tile, in pixels
+	};
+
+	// list of work units touching one screen tile, in submission order
+	struct tile_bin
+	{
+		poly_manager *      owner;                  // pointer back to the poly manager
+		UINT32              head;                   // index of the first entry
+		UINT32              tail;                   // index of the last entry
+	};
+
 	// internal array types
 	typedef poly_array<polygon_info, _MaxPolys> polygon_array;
 	typedef poly_array<_ObjectData, _MaxPolys + 1> objectdata_array;
@@ -236,6 +265,21 @@ private:
 		m_polygon.wait_for_space();
 		m_unit.wait_for_space((maxy - miny) / SCANLINES_PER_BUCKET + 2);
 
+		// when binning, also make sure every unit can be added to every tile it spans
+		if (m_bin_entry != NULL)
+		{
+			int columns = (MIN(maxx, TILE_COLUMNS * TILE_WIDTH * 2) - MAX(minx, 0)) / TILE_WIDTH + 2;
+			columns = MAX(columns, 1);
+			UINT32 needed = ((maxy - miny) / SCANLINES_PER_BUCKET + 2) * columns;
+			if (m_bin_entry_next + needed >= m_bin_entry_count)
+				wait("Out of bin entries");
+		}
+
+#if KEEP_STATISTICS
+		if (m_batch_start == 0)
+			m_batch_start = osd_ticks();
+#endif
+
 		// return and initialize the next one
 		polygon_info &polygon = m_polygon.next();
 		polygon.m_owner = this;
@@ -245,10 +289,14 @@ private:
 	}
 
 	static void *work_item_callback(void *param, int threadid);
+	static void *bin_item_callback(void *param, int threadid);
+	void init_bins();
+	void enqueue_units(UINT32 startunit);
+	void flush_bins();
 	void presave() { wait("pre-save"); }
 
 	// queue management
-	running_machine &   m_machine;
+	running_machine *   m_machine;                  // owning machine (NULL for tools)
 	screen_device *     m_screen;
 	osd_work_queue *    m_queue;                    // work queue
 
@@ -263,6 +311,14 @@ private:
 	// buckets
 	UINT16              m_unit_bucket[TOTAL_BUCKETS]; // buckets for tracking unit usage
 
+	// tile bins
+	tile_bin            m_bin[TOTAL_TILES];         // per-tile lists of work units
+	tile_bin *          m_active_bin[TOTAL_TILES];  // bins with at least one entry
+	int                 m_active_bins;              // number of active bins
+	bin_entry *         m_bin_entry;                // pool of bin entries (NULL if not binning)
+	UINT32              m_bin_entry_next;           // index of the next free bin entry
+	UINT32              m_bin_entry_count;          // total number of bin entries
+
 	// statistics
 	UINT32              m_tiles;                    // number of tiles queued
 	UINT32              m_triangles;                // number of triangles queued
@@ -271,6 +327,9 @@ private:
 #if KEEP_STATISTICS
 	UINT32              m_conflicts[WORK_MAX_THREADS]; // number of conflicts found, per thread
 	UINT32              m_resolved[WORK_MAX_THREADS];   // number of conflicts resolved, per thread
+	UINT64              m_setup_ticks;              // profiling ticks spent in polygon setup
+	osd_ticks_t         m_batch_start;              // time the first polygon since the last wait was queued
+	osd_ticks_t         m_render_ticks;             // time from queueing each batch to finishing it
 #endif
 };
 
@@ -281,13 +340,18 @@ private:
 
 template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(running_machine &machine, UINT8 flags)
-	: m_machine(machine),
+	: m_machine(&machine),
 		m_screen(NULL),
 		m_queue(NULL),
-		m_polygon(machine, *this),
-		m_object(machine, *this),
-		m_unit(machine, *this),
+		m_polygon(&machine, *this),
+		m_object(&machine, *this),
+		m_unit(&machine, *this),
 		m_flags(flags),
+		m_active_bins(0),
+		m_bin_entry(NULL),
+		m_bin_entry_next(0),
+		m_bin_entry_count(0),
+		m_tiles(0),
 		m_triangles(0),
 		m_quads(0),
 		m_pixels(0)
@@ -295,12 +359,18 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(runnin
 #if KEEP_STATISTICS
 	memset(m_conflicts, 0, sizeof(m_conflicts));
 	memset(m_resolved, 0, sizeof(m_resolved));
+	m_setup_ticks = 0;
+	m_batch_start = 0;
+	m_render_ticks = 0;
 #endif
 
 	// create the work queue
 	if (!(flags & POLYFLAG_NO_WORK_QUEUE))
 		m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
 
+	// allocate the tile bins if requested
+	init_bins();
+
 	// request a pre-save callback for synchronization
 	machine.save().register_presave(save_prepost_delegate(FUNC(poly_manager::presave), this));
 }
@@ -308,13 +378,18 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(runnin
 
 template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(screen_device &screen, UINT8 flags)
-	: m_machine(screen.machine()),
+	: m_machine(&screen.machine()),
 		m_screen(&screen),
 		m_queue(NULL),
-		m_polygon(screen.machine(), *this),
-		m_object(screen.machine(), *this),
-		m_unit(screen.machine(), *this),
+		m_polygon(&screen.machine(), *this),
+		m_object(&screen.machine(), *this),
+		m_unit(&screen.machine(), *this),
 		m_flags(flags),
+		m_active_bins(0),
+		m_bin_entry(NULL),
+		m_bin_entry_next(0),
+		m_bin_entry_count(0),
+		m_tiles(0),
 		m_triangles(0),
 		m_quads(0),
 		m_pixels(0)
@@ -322,17 +397,58 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(screen
 #if KEEP_STATISTICS
 	memset(m_conflicts, 0, sizeof(m_conflicts));
 	memset(m_resolved, 0, sizeof(m_resolved));
+	m_setup_ticks = 0;
+	m_batch_start = 0;
+	m_render_ticks = 0;
 #endif
 
 	// create the work queue
 	if (!(flags & POLYFLAG_NO_WORK_QUEUE))
 		m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
 
+	// allocate the tile bins if requested
+	init_bins();
+
 	// request a pre-save callback for synchronization
 	machine().save().register_presave(save_prepost_delegate(FUNC(poly_manager::presave), this));
 }
 
 
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(UINT8 flags)
+	: m_machine(NULL),
+		m_screen(NULL),
+		m_queue(NULL),
+		m_polygon(NULL, *this),
+		m_object(NULL, *this),
+		m_unit(NULL, *this),
+		m_flags(flags),
+		m_active_bins(0),
+		m_bin_entry(NULL),
+		m_bin_entry_next(0),
+		m_bin_entry_count(0),
+		m_tiles(0),
+		m_triangles(0),
+		m_quads(0),
+		m_pixels(0)
+{
+#if KEEP_STATISTICS
+	memset(m_conflicts, 0, sizeof(m_conflicts));
+	memset(m_resolved, 0, sizeof(m_resolved));
+	m_setup_ticks = 0;
+	m_batch_start = 0;
+	m_render_ticks = 0;
+#endif
+
+	// create the work queue
+	if (!(flags & POLYFLAG_NO_WORK_QUEUE))
+		m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+
+	// allocate the tile bins if requested; there is nothing to save
+	init_bins();
+}
+
+
 //-------------------------------------------------
 //  ~poly_manager - destructor
 //-------------------------------------------------
@@ -358,6 +474,9 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::~poly_manager()
 	else
 		printf("Total pixels   = %d\n", (UINT32)m_pixels);
 
+	printf("Setup:       %d ticks per polygon, %d polygons\n", (UINT32)(m_setup_ticks / MAX(m_tiles + m_triangles + m_quads, 1)), m_tiles + m_triangles + m_quads);
+	if (m_render_ticks != 0)
+		printf("Throughput:  %d polygons/second queued to finished (%s)\n", (UINT32)((double)(m_tiles + m_triangles + m_quads) * (double)osd_ticks_per_second() / (double)m_render_ticks), (m_bin_entry != NULL) ? "tile binned" : "scanline buckets");
 	printf("Conflicts:   %d resolved, %d total\n", resolved, conflicts);
 	printf("Units:       %5d used, %5d allocated, %5d waits, %4d bytes each, %7d total\n", m_unit.max(), m_unit.allocated(), m_unit.waits(), m_unit.itemsize(), m_unit.allocated() * m_unit.itemsize());
 	printf("Polygons:    %5d used, %5d allocated, %5d waits, %4d bytes each, %7d total\n", m_polygon.max(), m_polygon.allocated(), m_polygon.waits(), m_polygon.itemsize(), m_polygon.allocated() * m_polygon.itemsize());
@@ -368,6 +487,38 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::~poly_manager()
 	// free the work queue
 	if (m_queue != NULL)
 		osd_work_queue_free(m_queue);
+
+	// free the bin entries
+	if (m_bin_entry != NULL)
+	{
+		if (m_machine != NULL)
+			auto_free(*m_machine, m_bin_entry);
+		else
+			global_free(m_bin_entry);
+	}
+}
+
+
+//-------------------------------------------------
+//  init_bins - set up the tile bins if binning
+//  was requested
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::init_bins()
+{
+	for (int binnum = 0; binnum < TOTAL_TILES; binnum++)
+	{
+		m_bin[binnum].owner = this;
+		m_bin[binnum].head = m_bin[binnum].tail = ~0;
+	}
+	memset(m_unit_bucket, 0xff, sizeof(m_unit_bucket));
+
+	if (m_flags & POLYFLAG_TILE_BINNING)
+	{
+		m_bin_entry_count = m_unit.allocated() * BIN_ENTRIES_PER_UNIT;
+		m_bin_entry = (m_machine != NULL) ? auto_alloc_array(*m_machine, bin_entry, m_bin_entry_count) : global_alloc_array(bin_entry, m_bin_entry_count);
+	}
 }
 
 
@@ -433,6 +584,154 @@ void *poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::work_item_cal
 }
 
 
+//-------------------------------------------------
+//  bin_item_callback - process every work unit
+//  that touches one screen tile, clipping each
+//  extent to the tile
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void *poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::bin_item_callback(void *param, int threadid)
+{
+	tile_bin &bin = **(tile_bin **)param;
+	poly_manager &owner = *bin.owner;
+
+	// entries are linked in submission order, which preserves primitive order within the tile
+	for (UINT32 entrynum = bin.head; entrynum != ~0; entrynum = owner.m_bin_entry[entrynum].next)
+	{
+		const bin_entry &entry = owner.m_bin_entry[entrynum];
+		const work_unit &unit = owner.m_unit[entry.unit];
+		const polygon_info &polygon = *unit.polygon;
+		INT32 tilestart = entry.tilex;
+		INT32 tilestop = entry.tilex + TILE_WIDTH;
+		int count = unit.count_next & 0xffff;
+
+		for (int curscan = 0; curscan < count; curscan++)
+		{
+			const extent_t &extent = unit.extent[curscan];
+
+			// skip spans that miss the tile entirely
+			if (extent.startx >= extent.stopx || extent.startx >= tilestop || extent.stopx <= tilestart)
+				continue;
+
+			// spans entirely within the tile are passed straight through
+			if (extent.startx >= tilestart && extent.stopx <= tilestop)
+			{
+				polygon.m_callback(unit.scanline + curscan, extent, *polygon.m_object, threadid);
+				continue;
+			}
+
+			// otherwise, clip a copy and advance the parameters to the new start
+			extent_t clipped = extent;
+			if (clipped.startx < tilestart)
+			{
+				_BaseType dx = _BaseType(tilestart - clipped.startx);
+				for (int paramnum = 0; paramnum < _MaxParams; paramnum++)
+					clipped.param[paramnum].start += dx * clipped.param[paramnum].dpdx;
+				clipped.startx = tilestart;
+			}
+			if (clipped.stopx > tilestop)
+				clipped.stopx = tilestop;
+			polygon.m_callback(unit.scanline + curscan, clipped, *polygon.m_object, threadid);
+		}
+	}
+	return NULL;
+}
+
+
+//-------------------------------------------------
+//  enqueue_units - hand off the work units
+//  starting at startunit, either directly to the
+//  work queue or to the tile bins
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::enqueue_units(UINT32 startunit)
+{
+	// without binning, queue the units immediately
+	if (m_bin_entry == NULL)
+	{
+		if (m_queue != NULL)
+			osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+		return;
+	}
+
+	// otherwise, add each unit to every tile its extents touch; the work is queued in wait()
+	for (UINT32 unitnum = startunit; unitnum < m_unit.count(); unitnum++)
+	{
+		const work_unit &unit = m_unit[unitnum];
+		int count = unit.count_next & 0xffff;
+
+		// determine the horizontal range covered by this unit
+		INT32 minx = 0x7fff, maxx = -0x8000;
+		for (int extnum = 0; extnum < count; extnum++)
+			if (unit.extent[extnum].startx < unit.extent[extnum].stopx)
+			{
+				minx = MIN(minx, unit.extent[extnum].startx);
+				maxx = MAX(maxx, unit.extent[extnum].stopx);
+			}
+		if (minx >= maxx)
+			continue;
+
+		// append to the bin for each tile in that range
+		UINT32 row = ((UINT32)unit.scanline / TILE_HEIGHT) % TILE_ROWS;
+		for (INT32 tilex = minx & ~(TILE_WIDTH - 1); tilex < maxx; tilex += TILE_WIDTH)
+		{
+			tile_bin &bin = m_bin[row * TILE_COLUMNS + ((UINT32)tilex / TILE_WIDTH) % TILE_COLUMNS];
+
+			// polygon_alloc makes room for a typical polygon, but one wider than the
+			// bins wrap around can still run the pool dry; wait() would throw away
+			// the units not binned yet, so just render what is binned to free it
+			if (m_bin_entry_next >= m_bin_entry_count)
+				flush_bins();
+			UINT32 entrynum = m_bin_entry_next++;
+
+			bin_entry &entry = m_bin_entry[entrynum];
+			entry.next = ~0;
+			entry.unit = unitnum;
+			entry.tilex = tilex;
+
+			if (bin.head == ~0)
+			{
+				bin.head = entrynum;
+				m_active_bin[m_active_bins++] = &bin;
+			}
+			else
+				m_bin_entry[bin.tail].next = entrynum;
+			bin.tail = entrynum;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  flush_bins - render everything binned so far
+//  and empty the bins, leaving the work units
+//  in place
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::flush_bins()
+{
+	// nothing has been queued yet, so hand each active tile to a worker, or run them now without a queue
+	if (m_queue != NULL)
+	{
+		if (m_active_bins > 0)
+			osd_work_item_queue_multiple(m_queue, bin_item_callback, m_active_bins, &m_active_bin[0], sizeof(m_active_bin[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		osd_work_queue_wait(m_queue, osd_ticks_per_second() * 100);
+	}
+	else
+		for (int binnum = 0; binnum < m_active_bins; binnum++)
+			bin_item_callback(&m_active_bin[binnum], 0);
+
+	// empty the tile bins
+	for (int binnum = 0; binnum < m_active_bins; binnum++)
+		m_active_bin[binnum]->head = m_active_bin[binnum]->tail = ~0;
+	m_active_bins = 0;
+	m_bin_entry_next = 0;
+}
+
+
 //-------------------------------------------------
 //  wait - stall until all work is complete
 //-------------------------------------------------
@@ -446,14 +745,25 @@ void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::wait(const cha
 	if (LOG_WAITS)
 		time = get_profile_ticks();
 
-	// wait for all pending work items to complete
-	if (m_queue != NULL)
+	// in binning mode render the bins, which also empties them
+	if (m_bin_entry != NULL)
+		flush_bins();
+
+	// otherwise wait for all pending work items to complete
+	else if (m_queue != NULL)
 		osd_work_queue_wait(m_queue, osd_ticks_per_second() * 100);
 
 	// if we don't have a queue, just run the whole list now
 	else
 		for (int unitnum = 0; unitnum < m_unit.count(); unitnum++)
 			work_item_callback(&m_unit[unitnum], 0);
+#if KEEP_STATISTICS
+	// buckets render while polygons are still being queued and bins only once we get here,
+	// so time each batch from its first polygon rather than just the wait
+	if (m_batch_start != 0)
+		m_render_ticks += osd_ticks() - m_batch_start;
+	m_batch_start = 0;
+#endif
 
 	// log any long waits
 	if (LOG_WAITS)
@@ -500,6 +810,10 @@ _ObjectData &poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::object
 template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
 UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tile(const rectangle &cliprect, render_delegate callback, int paramcount, const vertex_t &_v1, const vertex_t &_v2)
 {
+#if KEEP_STATISTICS
+	osd_ticks_t setup_start = get_profile_ticks();
+#endif
+
 	const vertex_t *v1 = &_v1;
 	const vertex_t *v2 = &_v2;
 
@@ -614,10 +928,12 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tile(
 	}
 
 	// enqueue the work items
-	if (m_queue != NULL)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	enqueue_units(startunit);
 
 	// return the total number of pixels in the triangle
+#if KEEP_STATISTICS
+	m_setup_ticks += get_profile_ticks() - setup_start;
+#endif
 	m_tiles++;
 	m_pixels += pixels;
 	return pixels;
@@ -632,6 +948,10 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tile(
 template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
 UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_triangle(const rectangle &cliprect, render_delegate callback, int paramcount, const vertex_t &_v1, const vertex_t &_v2, const vertex_t &_v3)
 {
+#if KEEP_STATISTICS
+	osd_ticks_t setup_start = get_profile_ticks();
+#endif
+
 	const vertex_t *v1 = &_v1;
 	const vertex_t *v2 = &_v2;
 	const vertex_t *v3 = &_v3;
@@ -802,10 +1122,12 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_trian
 	}
 
 	// enqueue the work items
-	if (m_queue != NULL)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	enqueue_units(startunit);
 
 	// return the total number of pixels in the triangle
+#if KEEP_STATISTICS
+	m_setup_ticks += get_profile_ticks() - setup_start;
+#endif
 	m_triangles++;
 	m_pixels += pixels;
 	return pixels;
@@ -852,6 +1174,10 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_trian
 template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
 UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_triangle_custom(const rectangle &cliprect, render_delegate callback, int startscanline, int numscanlines, const extent_t *extents)
 {
+#if KEEP_STATISTICS
+	osd_ticks_t setup_start = get_profile_ticks();
+#endif
+
 	// clip coordinates
 	INT32 v1yclip = MAX(startscanline, cliprect.min_y);
 	INT32 v3yclip = MIN(startscanline + numscanlines, cliprect.max_y + 1);
@@ -859,7 +1185,7 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_trian
 		return 0;
 
 	// allocate and populate a new polygon
-	polygon_info &polygon = polygon_alloc(0, 0, v1yclip, v3yclip, callback);
+	polygon_info &polygon = polygon_alloc(cliprect.min_x, cliprect.max_x + 1, v1yclip, v3yclip, callback);
 
 	// compute the X extents for each scanline
 	INT32 pixels = 0;
@@ -918,10 +1244,12 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_trian
 	}
 
 	// enqueue the work items
-	if (m_queue != NULL)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	enqueue_units(startunit);
 
 	// return the total number of pixels in the object
+#if KEEP_STATISTICS
+	m_setup_ticks += get_profile_ticks() - setup_start;
+#endif
 	m_triangles++;
 	m_pixels += pixels;
 	return pixels;
@@ -937,6 +1265,10 @@ template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
 template<int _NumVerts>
 UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_polygon(const rectangle &cliprect, render_delegate callback, int paramcount, const vertex_t *v)
 {
+#if KEEP_STATISTICS
+	osd_ticks_t setup_start = get_profile_ticks();
+#endif
+
 	// determine min/max Y vertices
 	_BaseType minx = v[0].x;
 	_BaseType maxx = v[0].x;
@@ -1117,10 +1449,12 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_polyg
 	}
 
 	// enqueue the work items
-	if (m_queue != NULL)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	enqueue_units(startunit);
 
 	// return the total number of pixels in the triangle
+#if KEEP_STATISTICS
+	m_setup_ticks += get_profile_ticks() - setup_start;
+#endif
 	m_quads++;
 	m_pixels += pixels;
 	return pixels;
@@ -1358,6 +1358,16 @@ struct voodoo_state;
 struct poly_extra_data;
 
 
+/* the part of a polygon manager extent that the rasterizers look at */
+struct voodoo_extent
+{
+	INT32               startx;                 /* starting X (inclusive) */
+	INT32               stopx;                  /* ending X (exclusive) */
+};
+
+typedef void (*voodoo_raster_func)(void *destbase, INT32 y, const voodoo_extent *extent, const void *extradata, int threadid);
+
+
 struct rgba
 {
 #ifdef LSB_FIRST
@@ -1609,7 +1619,7 @@ struct dac_state
 struct raster_info
 {
 	raster_info *       next;                   /* pointer to next entry with the same hash */
-	poly_draw_scanline_func callback;           /* callback pointer */
+	voodoo_raster_func  callback;               /* callback pointer */
 	UINT8               is_generic;             /* TRUE if this is one of the generic rasterizers */
 	UINT8               display;                /* display index */
 	UINT32              hits;                   /* how many hits (pixels) we've used this for */
@@ -1620,6 +1630,8 @@ struct raster_info
 	UINT32              eff_fbz_mode;           /* effective fbzMode value */
 	UINT32              eff_tex_mode_0;         /* effective textureMode value for TMU #0 */
 	UINT32              eff_tex_mode_1;         /* effective textureMode value for TMU #1 */
+	UINT8               is_specialized;         /* TRUE if the callback is a specialized generic rasterizer */
+	INT64 volatile      ticks;                  /* time spent in the callback, if being logged */
 };
 
 
@@ -1659,6 +1671,60 @@ struct poly_extra_data
 };
 
 
+/* object data queued with each polygon */
+struct voodoo_poly_data
+{
+	poly_extra_data     extra;                  /* rasterizer parameters */
+	void *              dest;                   /* destination buffer */
+	voodoo_raster_func  callback;               /* rasterizer */
+};
+
+
+/* polygon manager handing each span to the rasterizer in its object data */
+class voodoo_renderer : public poly_manager<float, voodoo_poly_data, 1, 64>
+{
+public:
+	voodoo_renderer(running_machine &machine, UINT8 flags = 0)
+		: poly_manager<float, voodoo_poly_data, 1, 64>(machine, flags) { }
+	explicit voodoo_renderer(UINT8 flags)
+		: poly_manager<float, voodoo_poly_data, 1, 64>(flags) { }
+
+	/* queue a triangle using the last object data allocated */
+	UINT32 draw_triangle(const rectangle &cliprect, const vertex_t *vert)
+	{
+		return render_triangle(cliprect, render_delegate(FUNC(voodoo_renderer::render_span), this), 0, vert[0], vert[1], vert[2]);
+	}
+
+	/* queue a rectangle in blocks of scanlines, for fastfill */
+	UINT32 draw_block(const rectangle &cliprect, INT32 startx, INT32 stopx, INT32 starty, INT32 stopy)
+	{
+		extent_t extents[64];
+		UINT32 pixels = 0;
+
+		for (int extnum = 0; extnum < ARRAY_LENGTH(extents); extnum++)
+		{
+			extents[extnum].startx = startx;
+			extents[extnum].stopx = stopx;
+		}
+		for (int y = starty; y < stopy; y += ARRAY_LENGTH(extents))
+		{
+			int count = MIN(stopy - y, ARRAY_LENGTH(extents));
+			pixels += render_triangle_custom(cliprect, render_delegate(FUNC(voodoo_renderer::render_span), this), y, count, extents);
+		}
+		return pixels;
+	}
+
+private:
+	void render_span(INT32 scanline, const extent_t &extent, const voodoo_poly_data &object, int threadid)
+	{
+		voodoo_extent span;
+		span.startx = extent.startx;
+		span.stopx = extent.stopx;
+		(*object.callback)(object.dest, scanline, &span, &object.extra, threadid);
+	}
+};
+
+
 struct banshee_info
 {
 	UINT32              io[0x40];               /* I/O registers */
@@ -1689,6 +1755,131 @@ struct banshee_info
 };
 
 
+/* display list capture records; see capture_start() in voodoo.c */
+#define VOODOO_CAPTURE_VERSION  1
+
+enum
+{
+	VOODOO_CAPTURE_SETUP = 1,               /* voodoo_capture_setup */
+	VOODOO_CAPTURE_MEMORY,                  /* voodoo_capture_memory, then the data */
+	VOODOO_CAPTURE_REGS,                    /* array of voodoo_capture_reg */
+	VOODOO_CAPTURE_FBI,                     /* voodoo_capture_fbi */
+	VOODOO_CAPTURE_TMU,                     /* voodoo_capture_tmu */
+	VOODOO_CAPTURE_FASTFILL,                /* voodoo_capture_fastfill */
+	VOODOO_CAPTURE_TRIANGLE,                /* voodoo_capture_triangle, then poly_extra_data */
+	VOODOO_CAPTURE_SWAP                     /* no payload; marks the end of a frame */
+};
+
+/* memory regions in VOODOO_CAPTURE_MEMORY records */
+enum
+{
+	VOODOO_CAPTURE_FBRAM = 0,
+	VOODOO_CAPTURE_TMURAM                   /* + TMU number */
+};
+
+/* texel lookup sources in VOODOO_CAPTURE_TMU records */
+enum
+{
+	VOODOO_LOOKUP_NONE = 0,
+	VOODOO_LOOKUP_RGB332,
+	VOODOO_LOOKUP_ALPHA8,
+	VOODOO_LOOKUP_INT8,
+	VOODOO_LOOKUP_AI44,
+	VOODOO_LOOKUP_RGB565,
+	VOODOO_LOOKUP_ARGB1555,
+	VOODOO_LOOKUP_ARGB4444,
+	VOODOO_LOOKUP_PALETTE,
+	VOODOO_LOOKUP_PALETTEA,
+	VOODOO_LOOKUP_NCC0,
+	VOODOO_LOOKUP_NCC1
+};
+
+
+struct voodoo_capture_setup
+{
+	UINT32              type;                   /* type of system */
+	UINT32              tmus;                   /* number of TMUs */
+	UINT32              fbmem;                  /* bytes of frame buffer RAM */
+	UINT32              tmumem[MAX_TMU];        /* bytes of texture RAM per TMU */
+};
+
+
+struct voodoo_capture_memory
+{
+	UINT32              region;                 /* VOODOO_CAPTURE_FBRAM or _TMURAM + n */
+	UINT32              offset;                 /* byte offset of the data */
+};
+
+
+struct voodoo_capture_reg
+{
+	UINT32              index;                  /* register index */
+	UINT32              value;                  /* new value */
+};
+
+
+struct voodoo_capture_fbi
+{
+	UINT32              rowpixels;              /* pixels per row */
+	UINT32              auxoffs;                /* byte offset to aux buffer */
+	UINT32              yorigin;                /* Y origin subtract value */
+	UINT8               fogblend[64];           /* 64-entry fog table */
+	UINT8               fogdelta[64];           /* 64-entry fog table */
+	UINT8               fogdelta_mask;          /* mask for for delta */
+};
+
+
+struct voodoo_capture_tmu
+{
+	UINT32              which;                  /* TMU number */
+	UINT32              lookup;                 /* VOODOO_LOOKUP_* source of the texel lookup */
+	INT32               lodmin, lodmax;         /* min, max LOD values */
+	INT32               lodbias;                /* LOD bias */
+	UINT32              lodmask;                /* mask of available LODs */
+	UINT32              lodoffset[9];           /* offset of texture base for each LOD */
+	INT32               detailmax;              /* detail clamp */
+	INT32               detailbias;             /* detail bias */
+	UINT32              detailscale;            /* detail scale */
+	UINT32              wmask;                  /* mask for the current texture width */
+	UINT32              hmask;                  /* mask for the current texture height */
+	UINT32              bilinear_mask;          /* mask for bilinear resolution */
+	rgb_t               palette[256];           /* palette lookup table */
+	rgb_t               palettea[256];          /* palette+alpha lookup table */
+	rgb_t               ncc[2][256];            /* NCC texel lookups */
+};
+
+
+struct voodoo_capture_fastfill
+{
+	UINT32              drawoffs;               /* byte offset of the RGB buffer, or ~0 */
+	INT32               sx, ex;                 /* X extents */
+	INT32               sy, ey;                 /* Y extents */
+	UINT16              dither[16];             /* dither matrix */
+};
+
+
+struct voodoo_capture_triangle
+{
+	UINT32              drawoffs;               /* byte offset of the RGB buffer */
+	UINT32              texcount;               /* number of TMUs involved */
+	float               x[3], y[3];             /* vertex coordinates */
+};
+
+
+class display_list_writer;
+
+struct capture_state
+{
+	display_list_writer *writer;                /* open capture file, or NULL */
+	UINT32              swaps;                  /* buffer swaps seen so far */
+	UINT32              frames;                 /* frames left to capture */
+	voodoo_reg          reg[0x400];             /* registers as last written */
+	voodoo_capture_fbi  fbi;                    /* FBI state as last written */
+	voodoo_capture_tmu  tmu[MAX_TMU];           /* TMU state as last written */
+	UINT8 *             tmudirty[MAX_TMU];      /* 4k pages of texture RAM written since last flush */
+};
+
+
 struct voodoo_state
 {
 	UINT8               index;                  /* index of board */
@@ -1715,7 +1906,7 @@ struct voodoo_state
 	tmu_shared_state    tmushare;               /* TMU shared state */
 	banshee_info        banshee;                /* Banshee state */
 
-	poly_manager *      poly;                   /* polygon manager */
+	voodoo_renderer *   poly;                   /* polygon manager */
 	stats_block *       thread_stats;           /* per-thread statistics */
 
 	voodoo_stats        stats;                  /* internal statistics */
@@ -1726,6 +1917,9 @@ struct voodoo_state
 	int                 next_rasterizer;        /* next rasterizer index */
 	raster_info         rasterizer[MAX_RASTERIZERS]; /* array of rasterizers */
 	raster_info *       raster_hash[RASTER_HASH_SIZE]; /* hash table of rasterizers */
+
+	capture_state       capture;                /* display list capture state */
+	UINT32              replay_flags;           /* display list replay flags */
 };
 
 
@@ -2427,6 +2621,9 @@ do
 		int sb = (BB);                                                          \
 		int sa = (AA);                                                          \
 		int ta;                                                                 \
+		rgbint srcfactor, dstfactor;                                            \
+		rgbint srcblend, dstblend;                                              \
+		rgb_t blended;                                                          \
 																				\
 		/* apply dither subtraction */                                          \
 		if (FBZMODE_ALPHA_DITHER_SUBTRACT(FBZMODE))                             \
@@ -2440,117 +2637,101 @@ do
 			db = ((db << 1) + 15 - dith) >> 1;                                  \
 		}                                                                       \
 																				\
-		/* compute source portion */                                            \
+		/* select the per-channel source scale factors */                       \
 		switch (ALPHAMODE_SRCRGBBLEND(ALPHAMODE))                               \
 		{                                                                       \
 			default:    /* reserved */                                          \
 			case 0:     /* AZERO */                                             \
-				(RR) = (GG) = (BB) = 0;                                         \
+				rgb_comp_to_rgbint(&srcfactor, 0, 0, 0);                        \
 				break;                                                          \
 																				\
 			case 1:     /* ASRC_ALPHA */                                        \
-				(RR) = (sr * (sa + 1)) >> 8;                                    \
-				(GG) = (sg * (sa + 1)) >> 8;                                    \
-				(BB) = (sb * (sa + 1)) >> 8;                                    \
+				rgb_comp_to_rgbint(&srcfactor, sa + 1, sa + 1, sa + 1);         \
 				break;                                                          \
 																				\
 			case 2:     /* A_COLOR */                                           \
-				(RR) = (sr * (dr + 1)) >> 8;                                    \
-				(GG) = (sg * (dg + 1)) >> 8;                                    \
-				(BB) = (sb * (db + 1)) >> 8;                                    \
+				rgb_comp_to_rgbint(&srcfactor, dr + 1, dg + 1, db + 1);         \
 				break;                                                          \
 																				\
 			case 3:     /* ADST_ALPHA */                                        \
-				(RR) = (sr * (da + 1)) >> 8;                                    \
-				(GG) = (sg * (da + 1)) >> 8;                                    \
-				(BB) = (sb * (da + 1)) >> 8;                                    \
+				rgb_comp_to_rgbint(&srcfactor, da + 1, da + 1, da + 1);         \
 				break;                                                          \
 																				\
 			case 4:     /* AONE */                                              \
+				rgb_comp_to_rgbint(&srcfactor, 0x100, 0x100, 0x100);            \
 				break;                                                          \
 																				\
 			case 5:     /* AOMSRC_ALPHA */                                      \
-				(RR) = (sr * (0x100 - sa)) >> 8;                                \
-				(GG) = (sg * (0x100 - sa)) >> 8;                                \
-				(BB) = (sb * (0x100 - sa)) >> 8;                                \
+				rgb_comp_to_rgbint(&srcfactor, 0x100 - sa, 0x100 - sa, 0x100 - sa); \
 				break;                                                          \
 																				\
 			case 6:     /* AOM_COLOR */                                         \
-				(RR) = (sr * (0x100 - dr)) >> 8;                                \
-				(GG) = (sg * (0x100 - dg)) >> 8;                                \
-				(BB) = (sb * (0x100 - db)) >> 8;                                \
+				rgb_comp_to_rgbint(&srcfactor, 0x100 - dr, 0x100 - dg, 0x100 - db); \
 				break;                                                          \
 																				\
 			case 7:     /* AOMDST_ALPHA */                                      \
-				(RR) = (sr * (0x100 - da)) >> 8;                                \
-				(GG) = (sg * (0x100 - da)) >> 8;                                \
-				(BB) = (sb * (0x100 - da)) >> 8;                                \
+				rgb_comp_to_rgbint(&srcfactor, 0x100 - da, 0x100 - da, 0x100 - da); \
 				break;                                                          \
 																				\
 			case 15:    /* ASATURATE */                                         \
 				ta = (sa < (0x100 - da)) ? sa : (0x100 - da);                   \
-				(RR) = (sr * (ta + 1)) >> 8;                                    \
-				(GG) = (sg * (ta + 1)) >> 8;                                    \
-				(BB) = (sb * (ta + 1)) >> 8;                                    \
+				rgb_comp_to_rgbint(&srcfactor, ta + 1, ta + 1, ta + 1);         \
 				break;                                                          \
 		}                                                                       \
 																				\
-		/* add in dest portion */                                               \
+		/* select the per-channel dest scale factors */                         \
 		switch (ALPHAMODE_DSTRGBBLEND(ALPHAMODE))                               \
 		{                                                                       \
 			default:    /* reserved */                                          \
 			case 0:     /* AZERO */                                             \
+				rgb_comp_to_rgbint(&dstfactor, 0, 0, 0);                        \
 				break;                                                          \
 																				\
 			case 1:     /* ASRC_ALPHA */                                        \
-				(RR) += (dr * (sa + 1)) >> 8;                                   \
-				(GG) += (dg * (sa + 1)) >> 8;                                   \
-				(BB) += (db * (sa + 1)) >> 8;                                   \
+				rgb_comp_to_rgbint(&dstfactor, sa + 1, sa + 1, sa + 1);         \
 				break;                                                          \
 																				\
 			case 2:     /* A_COLOR */                                           \
-				(RR) += (dr * (sr + 1)) >> 8;                                   \
-				(GG) += (dg * (sg + 1)) >> 8;                                   \
-				(BB) += (db * (sb + 1)) >> 8;                                   \
+				rgb_comp_to_rgbint(&dstfactor, sr + 1, sg + 1, sb + 1);         \
 				break;                                                          \
 																				\
 			case 3:     /* ADST_ALPHA */                                        \
-				(RR) += (dr * (da + 1)) >> 8;                                   \
-				(GG) += (dg * (da + 1)) >> 8;                                   \
-				(BB) += (db * (da + 1)) >> 8;                                   \
+				rgb_comp_to_rgbint(&dstfactor, da + 1, da + 1, da + 1);         \
 				break;                                                          \
 																				\
 			case 4:     /* AONE */                                              \
-				(RR) += dr;                                                     \
-				(GG) += dg;                                                     \
-				(BB) += db;                                                     \
+				rgb_comp_to_rgbint(&dstfactor, 0x100, 0x100, 0x100);            \
 				break;                                                          \
 																				\
 			case 5:     /* AOMSRC_ALPHA */                                      \
-				(RR) += (dr * (0x100 - sa)) >> 8;                               \
-				(GG) += (dg * (0x100 - sa)) >> 8;                               \
-				(BB) += (db * (0x100 - sa)) >> 8;                               \
+				rgb_comp_to_rgbint(&dstfactor, 0x100 - sa, 0x100 - sa, 0x100 - sa); \
 				break;                                                          \
 																				\
 			case 6:     /* AOM_COLOR */                                         \
-				(RR) += (dr * (0x100 - sr)) >> 8;                               \
-				(GG) += (dg * (0x100 - sg)) >> 8;                               \
-				(BB) += (db * (0x100 - sb)) >> 8;                               \
+				rgb_comp_to_rgbint(&dstfactor, 0x100 - sr, 0x100 - sg, 0x100 - sb); \
 				break;                                                          \
 																				\
 			case 7:     /* AOMDST_ALPHA */                                      \
-				(RR) += (dr * (0x100 - da)) >> 8;                               \
-				(GG) += (dg * (0x100 - da)) >> 8;                               \
-				(BB) += (db * (0x100 - da)) >> 8;                               \
+				rgb_comp_to_rgbint(&dstfactor, 0x100 - da, 0x100 - da, 0x100 - da); \
 				break;                                                          \
 																				\
 			case 15:    /* A_COLORBEFOREFOG */                                  \
-				(RR) += (dr * (prefogr + 1)) >> 8;                              \
-				(GG) += (dg * (prefogg + 1)) >> 8;                              \
-				(BB) += (db * (prefogb + 1)) >> 8;                              \
+				rgb_comp_to_rgbint(&dstfactor, prefogr + 1, prefogg + 1, prefogb + 1); \
 				break;                                                          \
 		}                                                                       \
 																				\
+		/* scale both colors and sum them; each product is at most */           \
+		/* 0xff, so this matches the per-channel integer math exactly */        \
+		rgb_comp_to_rgbint(&srcblend, sr, sg, sb);                              \
+		rgb_comp_to_rgbint(&dstblend, dr, dg, db);                              \
+		rgbint_scale_channel_and_clamp(&srcblend, &srcfactor);                  \
+		rgbint_scale_channel_and_clamp(&dstblend, &dstfactor);                  \
+		rgbint_add(&srcblend, &dstblend);                                       \
+		blended = rgbint_to_rgb_clamp(&srcblend);                               \
+		(RR) = RGB_RED(blended);                                                \
+		(GG) = RGB_GREEN(blended);                                              \
+		(BB) = RGB_BLUE(blended);                                               \
+																				\
 		/* blend the source alpha */                                            \
 		(AA) = 0;                                                               \
 		if (ALPHAMODE_SRCALPHABLEND(ALPHAMODE) == 4)                            \
@@ -2561,9 +2742,6 @@ do
 			(AA) += da;                                                         \
 																				\
 		/* clamp */                                                             \
-		CLAMP((RR), 0x00, 0xff);                                                \
-		CLAMP((GG), 0x00, 0xff);                                                \
-		CLAMP((BB), 0x00, 0xff);                                                \
 		CLAMP((AA), 0x00, 0xff);                                                \
 	}                                                                           \
 }                                                                               \
@@ -3532,7 +3710,11 @@ while (0)
 
 #define RASTERIZER(name, TMUS, FBZCOLORPATH, FBZMODE, ALPHAMODE, FOGMODE, TEXMODE0, TEXMODE1) \
 																				\
-static void raster_##name(void *destbase, INT32 y, const poly_extent *extent, const void *extradata, int threadid) \
+static void raster_##name(void *destbase, INT32 y, const voodoo_extent *extent, const void *extradata, int threadid) \
+	RASTERIZER_BODY(TMUS, FBZCOLORPATH, FBZMODE, ALPHAMODE, FOGMODE, TEXMODE0, TEXMODE1)
+
+
+#define RASTERIZER_BODY(TMUS, FBZCOLORPATH, FBZMODE, ALPHAMODE, FOGMODE, TEXMODE0, TEXMODE1) \
 {                                                                               \
 	const poly_extra_data *extra = (const poly_extra_data *)extradata;          \
 	voodoo_state *v = extra->state;                                             \
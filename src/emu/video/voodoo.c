@@ -145,11 +145,12 @@ bits(7:4) and bit(24)), X, and Y:
 #define EXPAND_RASTERIZERS
 
 #include "emu.h"
-#include "video/poly.h"
+#include "video/polynew.h"
 #include "video/rgbutil.h"
 #include "voodoo.h"
 #include "vooddefs.h"
 #include "devlegcy.h"
+#include "dlcapture.h"
 
 
 /*************************************
@@ -165,16 +166,24 @@ bits(7:4) and bit(24)), X, and Y:
 #define LOG_FIFO            (0)
 #define LOG_FIFO_VERBOSE    (0)
 #define LOG_REGISTERS       (0)
-#define LOG_WAITS           (0)
 #define LOG_LFB             (0)
 #define LOG_TEXTURE_RAM     (0)
 #define LOG_RASTERIZERS     (0)
+#define TIME_RASTERIZERS    (LOG_RASTERIZERS)
 #define LOG_CMDFIFO         (0)
 #define LOG_CMDFIFO_VERBOSE (0)
 #define LOG_BANSHEE_2D      (0)
 
 #define MODIFY_PIXEL(VV)
 
+/* use mode-specialized rasterizers instead of the fully generic ones */
+#define USE_SPECIALIZED_RASTERIZERS (1)
+
+/* capture this many frames of display lists to voodoo<n>.dlc for replay */
+/* with the dlreplay tool, starting after the given number of swaps */
+#define CAPTURE_FRAMES      (0)
+#define CAPTURE_START_SWAP  (0)
+
 
 
 
@@ -202,6 +211,7 @@ UINT32 voodoo_reciplog[(2 << RECIPLOG_LOOKUP_BITS) + 2];
  *************************************/
 
 static void init_fbi(voodoo_state *v, fbi_state *f, void *memory, int fbmem);
+static void init_static_lookups(void);
 static void init_tmu_shared(tmu_shared_state *s);
 static void init_tmu(voodoo_state *v, tmu_state *t, voodoo_reg *reg, void *memory, int tmem);
 static void soft_reset(voodoo_state *v);
@@ -218,6 +228,7 @@ static INT32 banshee_2d_w(voodoo_state *v, offs_t offset, UINT32 data);
 
 /* command handlers */
 static INT32 fastfill(voodoo_state *v);
+static UINT32 fastfill_render(voodoo_state *v, UINT16 *drawbuf, int sx, int ex, int sy, int ey, const UINT16 *dithermatrix);
 static INT32 swapbuffer(voodoo_state *v, UINT32 data);
 static INT32 triangle(voodoo_state *v);
 static INT32 begin_triangle(voodoo_state *v);
@@ -227,16 +238,28 @@ static INT32 draw_triangle(voodoo_state *v);
 static INT32 setup_and_draw_triangle(voodoo_state *v);
 static INT32 triangle_create_work_item(voodoo_state *v, UINT16 *drawbuf, int texcount);
 
+/* display list capture */
+static void capture_swap(voodoo_state *v);
+static void capture_stop(voodoo_state *v);
+static void capture_fastfill(voodoo_state *v, UINT16 *drawbuf, int sx, int ex, int sy, int ey, const UINT16 *dither);
+static void capture_triangle(voodoo_state *v, UINT16 *drawbuf, int texcount, const voodoo_renderer::vertex_t *vert, const poly_extra_data *extra);
+
+/* display list replay */
+static void replay_set_lookup(voodoo_state *v, tmu_state *t, UINT32 source);
+static void replay_span(const void *object, INT32 scanline, INT32 startx, INT32 stopx, int threadid);
+static void replay_no_draw(void *dest, INT32 scanline, const voodoo_extent *extent, const void *extradata, int threadid);
+
 /* rasterizer management */
 static raster_info *add_rasterizer(voodoo_state *v, const raster_info *cinfo);
 static raster_info *find_rasterizer(voodoo_state *v, int texcount);
 static void dump_rasterizer_stats(voodoo_state *v);
 
 /* generic rasterizers */
-static void raster_fastfill(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
-static void raster_generic_0tmu(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
-static void raster_generic_1tmu(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
-static void raster_generic_2tmu(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
+static void raster_fastfill(void *dest, INT32 scanline, const voodoo_extent *extent, const void *extradata, int threadid);
+static void raster_generic_0tmu(void *dest, INT32 scanline, const voodoo_extent *extent, const void *extradata, int threadid);
+static void raster_generic_1tmu(void *dest, INT32 scanline, const voodoo_extent *extent, const void *extradata, int threadid);
+static void raster_generic_2tmu(void *dest, INT32 scanline, const voodoo_extent *extent, const void *extradata, int threadid);
+static void raster_timed(void *dest, INT32 scanline, const voodoo_extent *extent, const void *extradata, int threadid);
 
 
 
@@ -274,6 +297,89 @@ static const raster_info predef_raster_table[] =
 
 
 
+/*************************************
+ *
+ *  Specialized rasterizers
+ *
+ *************************************/
+
+/*-------------------------------------------------
+    specialized rasterizers - generic rasterizers
+    with the bits that enable whole pipeline stages
+    fixed at compile time, so unlisted modes skip
+    the disabled stages entirely
+-------------------------------------------------*/
+
+#define SPECIALIZE_DEPTHBUF     0x01
+#define SPECIALIZE_DITHERING    0x02
+#define SPECIALIZE_ALPHATEST    0x04
+#define SPECIALIZE_ALPHABLEND   0x08
+#define SPECIALIZE_FOG          0x10
+#define SPECIALIZE_COUNT        0x20
+
+#define SPECIALIZED_FBZMODE(FLAGS) \
+	((v->reg[fbzMode].u & ~((1 << 4) | (1 << 8))) | \
+		(((FLAGS) & SPECIALIZE_DEPTHBUF) ? (1 << 4) : 0) | \
+		(((FLAGS) & SPECIALIZE_DITHERING) ? (1 << 8) : 0))
+#define SPECIALIZED_ALPHAMODE(FLAGS) \
+	((v->reg[alphaMode].u & ~((1 << 0) | (1 << 4))) | \
+		(((FLAGS) & SPECIALIZE_ALPHATEST) ? (1 << 0) : 0) | \
+		(((FLAGS) & SPECIALIZE_ALPHABLEND) ? (1 << 4) : 0))
+#define SPECIALIZED_FOGMODE(FLAGS) \
+	((v->reg[fogMode].u & ~(1 << 0)) | \
+		(((FLAGS) & SPECIALIZE_FOG) ? (1 << 0) : 0))
+
+template<int _TMUs, int _Flags>
+static void raster_specialized(void *destbase, INT32 y, const voodoo_extent *extent, const void *extradata, int threadid)
+	RASTERIZER_BODY(_TMUs, v->reg[fbzColorPath].u, SPECIALIZED_FBZMODE(_Flags), SPECIALIZED_ALPHAMODE(_Flags),
+			SPECIALIZED_FOGMODE(_Flags), (_TMUs >= 1) ? v->tmu[0].reg[textureMode].u : 0, (_TMUs >= 2) ? v->tmu[1].reg[textureMode].u : 0)
+
+#define SPECIALIZED_ROW(TMUS) \
+	{ \
+		raster_specialized<TMUS, 0x00>, raster_specialized<TMUS, 0x01>, raster_specialized<TMUS, 0x02>, raster_specialized<TMUS, 0x03>, \
+		raster_specialized<TMUS, 0x04>, raster_specialized<TMUS, 0x05>, raster_specialized<TMUS, 0x06>, raster_specialized<TMUS, 0x07>, \
+		raster_specialized<TMUS, 0x08>, raster_specialized<TMUS, 0x09>, raster_specialized<TMUS, 0x0a>, raster_specialized<TMUS, 0x0b>, \
+		raster_specialized<TMUS, 0x0c>, raster_specialized<TMUS, 0x0d>, raster_specialized<TMUS, 0x0e>, raster_specialized<TMUS, 0x0f>, \
+		raster_specialized<TMUS, 0x10>, raster_specialized<TMUS, 0x11>, raster_specialized<TMUS, 0x12>, raster_specialized<TMUS, 0x13>, \
+		raster_specialized<TMUS, 0x14>, raster_specialized<TMUS, 0x15>, raster_specialized<TMUS, 0x16>, raster_specialized<TMUS, 0x17>, \
+		raster_specialized<TMUS, 0x18>, raster_specialized<TMUS, 0x19>, raster_specialized<TMUS, 0x1a>, raster_specialized<TMUS, 0x1b>, \
+		raster_specialized<TMUS, 0x1c>, raster_specialized<TMUS, 0x1d>, raster_specialized<TMUS, 0x1e>, raster_specialized<TMUS, 0x1f>  \
+	}
+
+static const voodoo_raster_func specialized_rasterizer[3][SPECIALIZE_COUNT] =
+{
+	SPECIALIZED_ROW(0),
+	SPECIALIZED_ROW(1),
+	SPECIALIZED_ROW(2)
+};
+
+
+/*-------------------------------------------------
+    get_specialized_rasterizer - return the
+    specialized rasterizer matching the current
+    state of the stage enable bits
+-------------------------------------------------*/
+
+static voodoo_raster_func get_specialized_rasterizer(voodoo_state *v, int texcount)
+{
+	int flags = 0;
+
+	if (FBZMODE_ENABLE_DEPTHBUF(v->reg[fbzMode].u))
+		flags |= SPECIALIZE_DEPTHBUF;
+	if (FBZMODE_ENABLE_DITHERING(v->reg[fbzMode].u))
+		flags |= SPECIALIZE_DITHERING;
+	if (ALPHAMODE_ALPHATEST(v->reg[alphaMode].u))
+		flags |= SPECIALIZE_ALPHATEST;
+	if (ALPHAMODE_ALPHABLEND(v->reg[alphaMode].u))
+		flags |= SPECIALIZE_ALPHABLEND;
+	if (FOGMODE_ENABLE_FOG(v->reg[fogMode].u))
+		flags |= SPECIALIZE_FOG;
+
+	return specialized_rasterizer[texcount][flags];
+}
+
+
+
 /***************************************************************************
     INLINE FUNCTIONS
 ***************************************************************************/
@@ -509,6 +615,41 @@ static void init_fbi(voodoo_state *v, fbi_state *f, void *memory, int fbmem)
 }
 
 
+static void init_static_lookups(void)
+{
+	int val;
+
+	/* create a table of precomputed 1/n and log2(n) values */
+	/* n ranges from 1.0000 to 2.0000 */
+	for (val = 0; val <= (1 << RECIPLOG_LOOKUP_BITS); val++)
+	{
+		UINT32 value = (1 << RECIPLOG_LOOKUP_BITS) + val;
+		voodoo_reciplog[val*2 + 0] = (1 << (RECIPLOG_LOOKUP_PREC + RECIPLOG_LOOKUP_BITS)) / value;
+		voodoo_reciplog[val*2 + 1] = (UINT32)(LOGB2((double)value / (double)(1 << RECIPLOG_LOOKUP_BITS)) * (double)(1 << RECIPLOG_LOOKUP_PREC));
+	}
+
+	/* create dithering tables */
+	for (val = 0; val < 256*16*2; val++)
+	{
+		int g = (val >> 0) & 1;
+		int x = (val >> 1) & 3;
+		int color = (val >> 3) & 0xff;
+		int y = (val >> 11) & 3;
+
+		if (!g)
+		{
+			dither4_lookup[val] = DITHER_RB(color, dither_matrix_4x4[y * 4 + x]) >> 3;
+			dither2_lookup[val] = DITHER_RB(color, dither_matrix_2x2[y * 4 + x]) >> 3;
+		}
+		else
+		{
+			dither4_lookup[val] = DITHER_G(color, dither_matrix_4x4[y * 4 + x]) >> 2;
+			dither2_lookup[val] = DITHER_G(color, dither_matrix_2x2[y * 4 + x]) >> 2;
+		}
+	}
+}
+
+
 static void init_tmu_shared(tmu_shared_state *s)
 {
 	int val;
@@ -844,6 +985,10 @@ static void swap_buffers(voodoo_state *v)
 
 	if (LOG_VBLANK_SWAP) logerror("--- swap_buffers @ %d\n", v->screen->vpos());
 
+	/* end the captured frame, or start capturing */
+	if (CAPTURE_FRAMES)
+		capture_swap(v);
+
 	/* force a partial update */
 	v->screen->update_partial(v->screen->vpos());
 	v->fbi.video_changed = TRUE;
@@ -2459,21 +2604,21 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 
 		/* mask off invalid bits for different cards */
 		case fbzColorPath:
-			poly_wait(v->poly, v->regnames[regnum]);
+			v->poly->wait(v->regnames[regnum]);
 			if (v->type < TYPE_VOODOO_2)
 				data &= 0x0fffffff;
 			if (chips & 1) v->reg[fbzColorPath].u = data;
 			break;
 
 		case fbzMode:
-			poly_wait(v->poly, v->regnames[regnum]);
+			v->poly->wait(v->regnames[regnum]);
 			if (v->type < TYPE_VOODOO_2)
 				data &= 0x001fffff;
 			if (chips & 1) v->reg[fbzMode].u = data;
 			break;
 
 		case fogMode:
-			poly_wait(v->poly, v->regnames[regnum]);
+			v->poly->wait(v->regnames[regnum]);
 			if (v->type < TYPE_VOODOO_2)
 				data &= 0x0000003f;
 			if (chips & 1) v->reg[fogMode].u = data;
@@ -2502,7 +2647,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 
 		/* other commands */
 		case nopCMD:
-			poly_wait(v->poly, v->regnames[regnum]);
+			v->poly->wait(v->regnames[regnum]);
 			if (data & 1)
 				reset_counters(v);
 			if (data & 2)
@@ -2514,12 +2659,12 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 			break;
 
 		case swapbufferCMD:
-			poly_wait(v->poly, v->regnames[regnum]);
+			v->poly->wait(v->regnames[regnum]);
 			cycles = swapbuffer(v, data);
 			break;
 
 		case userIntrCMD:
-			poly_wait(v->poly, v->regnames[regnum]);
+			v->poly->wait(v->regnames[regnum]);
 			//fatalerror("userIntrCMD\n");
 
 			v->reg[intrCtrl].u |= 0x1800;
@@ -2534,7 +2679,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 		case clutData:
 			if (v->type <= TYPE_VOODOO_2 && (chips & 1))
 			{
-				poly_wait(v->poly, v->regnames[regnum]);
+				v->poly->wait(v->regnames[regnum]);
 				if (!FBIINIT1_VIDEO_TIMING_RESET(v->reg[fbiInit1].u))
 				{
 					int index = data >> 24;
@@ -2553,7 +2698,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 		case dacData:
 			if (v->type <= TYPE_VOODOO_2 && (chips & 1))
 			{
-				poly_wait(v->poly, v->regnames[regnum]);
+				v->poly->wait(v->regnames[regnum]);
 				if (!(data & 0x800))
 					dacdata_w(&v->dac, (data >> 8) & 7, data & 0xff);
 				else
@@ -2568,7 +2713,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 		case videoDimensions:
 			if (v->type <= TYPE_VOODOO_2 && (chips & 1))
 			{
-				poly_wait(v->poly, v->regnames[regnum]);
+				v->poly->wait(v->regnames[regnum]);
 				v->reg[regnum].u = data;
 				if (v->reg[hSync].u != 0 && v->reg[vSync].u != 0 && v->reg[videoDimensions].u != 0)
 				{
@@ -2657,7 +2802,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 
 		/* fbiInit0 can only be written if initEnable says we can -- Voodoo/Voodoo2 only */
 		case fbiInit0:
-			poly_wait(v->poly, v->regnames[regnum]);
+			v->poly->wait(v->regnames[regnum]);
 			if (v->type <= TYPE_VOODOO_2 && (chips & 1) && INITEN_ENABLE_HW_INIT(v->pci.init_enable))
 			{
 				v->reg[fbiInit0].u = data;
@@ -2681,7 +2826,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 		case fbiInit1:
 		case fbiInit2:
 		case fbiInit4:
-			poly_wait(v->poly, v->regnames[regnum]);
+			v->poly->wait(v->regnames[regnum]);
 			if (v->type <= TYPE_VOODOO_2 && (chips & 1) && INITEN_ENABLE_HW_INIT(v->pci.init_enable))
 			{
 				v->reg[regnum].u = data;
@@ -2691,7 +2836,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 			break;
 
 		case fbiInit3:
-			poly_wait(v->poly, v->regnames[regnum]);
+			v->poly->wait(v->regnames[regnum]);
 			if (v->type <= TYPE_VOODOO_2 && (chips & 1) && INITEN_ENABLE_HW_INIT(v->pci.init_enable))
 			{
 				v->reg[regnum].u = data;
@@ -2705,7 +2850,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 /*      case swapPending: -- Banshee */
 			if (v->type == TYPE_VOODOO_2 && (chips & 1) && INITEN_ENABLE_HW_INIT(v->pci.init_enable))
 			{
-				poly_wait(v->poly, v->regnames[regnum]);
+				v->poly->wait(v->regnames[regnum]);
 				v->reg[regnum].u = data;
 				v->fbi.cmdfifo[0].enable = FBIINIT7_CMDFIFO_ENABLE(data);
 				v->fbi.cmdfifo[0].count_holes = !FBIINIT7_DISABLE_CMDFIFO_HOLES(data);
@@ -2718,7 +2863,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 		case cmdFifoBaseAddr:
 			if (v->type == TYPE_VOODOO_2 && (chips & 1))
 			{
-				poly_wait(v->poly, v->regnames[regnum]);
+				v->poly->wait(v->regnames[regnum]);
 				v->reg[regnum].u = data;
 				v->fbi.cmdfifo[0].base = (data & 0x3ff) << 12;
 				v->fbi.cmdfifo[0].end = (((data >> 16) & 0x3ff) + 1) << 12;
@@ -2794,7 +2939,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 		case nccTable+9:
 		case nccTable+10:
 		case nccTable+11:
-			poly_wait(v->poly, v->regnames[regnum]);
+			v->poly->wait(v->regnames[regnum]);
 			if (chips & 2) ncc_table_write(&v->tmu[0].ncc[0], regnum - nccTable, data);
 			if (chips & 4) ncc_table_write(&v->tmu[1].ncc[0], regnum - nccTable, data);
 			break;
@@ -2811,7 +2956,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 		case nccTable+21:
 		case nccTable+22:
 		case nccTable+23:
-			poly_wait(v->poly, v->regnames[regnum]);
+			v->poly->wait(v->regnames[regnum]);
 			if (chips & 2) ncc_table_write(&v->tmu[0].ncc[1], regnum - (nccTable+12), data);
 			if (chips & 4) ncc_table_write(&v->tmu[1].ncc[1], regnum - (nccTable+12), data);
 			break;
@@ -2849,7 +2994,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 		case fogTable+29:
 		case fogTable+30:
 		case fogTable+31:
-			poly_wait(v->poly, v->regnames[regnum]);
+			v->poly->wait(v->regnames[regnum]);
 			if (chips & 1)
 			{
 				int base = 2 * (regnum - fogTable);
@@ -2868,7 +3013,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 		case texBaseAddr_1:
 		case texBaseAddr_2:
 		case texBaseAddr_3_8:
-			poly_wait(v->poly, v->regnames[regnum]);
+			v->poly->wait(v->regnames[regnum]);
 			if (chips & 2)
 			{
 				v->tmu[0].reg[regnum].u = data;
@@ -2892,7 +3037,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 		case color0:
 		case clipLowYHighY:
 		case clipLeftRight:
-			poly_wait(v->poly, v->regnames[regnum]);
+			v->poly->wait(v->regnames[regnum]);
 			/* fall through to default implementation */
 
 		/* by default, just feed the data to the chips */
@@ -3155,7 +3300,7 @@ static INT32 lfb_w(voodoo_state *v, offs_t offset, UINT32 data, UINT32 mem_mask,
 	depthmax = (v->fbi.mask + 1 - v->fbi.auxoffs) / 2;
 
 	/* wait for any outstanding work to finish */
-	poly_wait(v->poly, "LFB Write");
+	v->poly->wait("LFB Write");
 
 	/* simple case: no pipeline */
 	if (!LFBMODE_ENABLE_PIXEL_PIPELINE(v->reg[lfbMode].u))
@@ -3310,7 +3455,7 @@ static INT32 texture_w(voodoo_state *v, offs_t offset, UINT32 data)
 		fatalerror("Texture direct write!\n");
 
 	/* wait for any outstanding work to finish */
-	poly_wait(v->poly, "Texture write");
+	v->poly->wait("Texture write");
 
 	/* update texture info if dirty */
 	if (t->regdirty)
@@ -3361,6 +3506,8 @@ static INT32 texture_w(voodoo_state *v, offs_t offset, UINT32 data)
 		/* write the four bytes in little-endian order */
 		dest = t->ram;
 		tbaseaddr &= t->mask;
+		if (CAPTURE_FRAMES && v->capture.writer != NULL)
+			v->capture.tmudirty[tmunum][tbaseaddr >> 12] = TRUE;
 		dest[BYTE4_XOR_LE(tbaseaddr + 0)] = (data >> 0) & 0xff;
 		dest[BYTE4_XOR_LE(tbaseaddr + 1)] = (data >> 8) & 0xff;
 		dest[BYTE4_XOR_LE(tbaseaddr + 2)] = (data >> 16) & 0xff;
@@ -3401,6 +3548,8 @@ static INT32 texture_w(voodoo_state *v, offs_t offset, UINT32 data)
 		/* write the two words in little-endian order */
 		dest = (UINT16 *)t->ram;
 		tbaseaddr &= t->mask;
+		if (CAPTURE_FRAMES && v->capture.writer != NULL)
+			v->capture.tmudirty[tmunum][tbaseaddr >> 12] = TRUE;
 		tbaseaddr >>= 1;
 		dest[BYTE_XOR_LE(tbaseaddr + 0)] = (data >> 0) & 0xffff;
 		dest[BYTE_XOR_LE(tbaseaddr + 1)] = (data >> 16) & 0xffff;
@@ -3954,7 +4103,7 @@ static UINT32 lfb_r(voodoo_state *v, offs_t offset, int forcefront)
 		return 0xffffffff;
 
 	/* wait for any outstanding work to finish */
-	poly_wait(v->poly, "LFB read");
+	v->poly->wait("LFB read");
 
 	/* compute the data */
 	data = buffer[bufoffs + 0] | (buffer[bufoffs + 1] << 16);
@@ -4861,7 +5010,6 @@ static void common_start_voodoo(device_t *device, UINT8 type)
 	const raster_info *info;
 	void *fbmem, *tmumem[2];
 	UINT32 tmumem0;
-	int val;
 
 	/* validate configuration */
 	assert(config->screen != NULL);
@@ -4878,37 +5026,11 @@ static void common_start_voodoo(device_t *device, UINT8 type)
 	v->pci.stall_callback.resolve(config->stall,*device);
 
 	/* create a multiprocessor work queue */
-	v->poly = poly_alloc(device->machine(), 64, sizeof(poly_extra_data), 0);
+	v->poly = auto_alloc(device->machine(), voodoo_renderer(device->machine()));
 	v->thread_stats = auto_alloc_array(device->machine(), stats_block, WORK_MAX_THREADS);
 
-	/* create a table of precomputed 1/n and log2(n) values */
-	/* n ranges from 1.0000 to 2.0000 */
-	for (val = 0; val <= (1 << RECIPLOG_LOOKUP_BITS); val++)
-	{
-		UINT32 value = (1 << RECIPLOG_LOOKUP_BITS) + val;
-		voodoo_reciplog[val*2 + 0] = (1 << (RECIPLOG_LOOKUP_PREC + RECIPLOG_LOOKUP_BITS)) / value;
-		voodoo_reciplog[val*2 + 1] = (UINT32)(LOGB2((double)value / (double)(1 << RECIPLOG_LOOKUP_BITS)) * (double)(1 << RECIPLOG_LOOKUP_PREC));
-	}
-
-	/* create dithering tables */
-	for (val = 0; val < 256*16*2; val++)
-	{
-		int g = (val >> 0) & 1;
-		int x = (val >> 1) & 3;
-		int color = (val >> 3) & 0xff;
-		int y = (val >> 11) & 3;
-
-		if (!g)
-		{
-			dither4_lookup[val] = DITHER_RB(color, dither_matrix_4x4[y * 4 + x]) >> 3;
-			dither2_lookup[val] = DITHER_RB(color, dither_matrix_2x2[y * 4 + x]) >> 3;
-		}
-		else
-		{
-			dither4_lookup[val] = DITHER_G(color, dither_matrix_4x4[y * 4 + x]) >> 2;
-			dither2_lookup[val] = DITHER_G(color, dither_matrix_2x2[y * 4 + x]) >> 2;
-		}
-	}
+	/* create the reciprocal/log and dithering tables */
+	init_static_lookups();
 
 	/* configure type-specific values */
 	switch (v->type)
@@ -5059,9 +5181,13 @@ static DEVICE_STOP( voodoo )
 {
 	voodoo_state *v = get_safe_token(device);
 
-	/* release the work queue, ensuring all work is finished */
+	/* ensure all work is finished */
 	if (v->poly != NULL)
-		poly_free(v->poly);
+		v->poly->wait("Device stop");
+
+	/* close any capture in progress */
+	if (v->capture.writer != NULL)
+		capture_stop(v);
 }
 
 
@@ -5075,6 +5201,762 @@ static DEVICE_RESET( voodoo )
 	soft_reset(v);
 }
 
+/***************************************************************************
+    DISPLAY LIST CAPTURE
+***************************************************************************/
+
+/*-------------------------------------------------
+    capture_lookup_source - identify which table
+    a TMU's current texel lookup points to
+-------------------------------------------------*/
+
+static UINT32 capture_lookup_source(voodoo_state *v, tmu_state *t)
+{
+	if (t->lookup == v->tmushare.rgb332) return VOODOO_LOOKUP_RGB332;
+	if (t->lookup == v->tmushare.alpha8) return VOODOO_LOOKUP_ALPHA8;
+	if (t->lookup == v->tmushare.int8) return VOODOO_LOOKUP_INT8;
+	if (t->lookup == v->tmushare.ai44) return VOODOO_LOOKUP_AI44;
+	if (t->lookup == v->tmushare.rgb565) return VOODOO_LOOKUP_RGB565;
+	if (t->lookup == v->tmushare.argb1555) return VOODOO_LOOKUP_ARGB1555;
+	if (t->lookup == v->tmushare.argb4444) return VOODOO_LOOKUP_ARGB4444;
+	if (t->lookup == t->palette) return VOODOO_LOOKUP_PALETTE;
+	if (t->lookup == t->palettea) return VOODOO_LOOKUP_PALETTEA;
+	if (t->lookup == t->ncc[0].texel) return VOODOO_LOOKUP_NCC0;
+	if (t->lookup == t->ncc[1].texel) return VOODOO_LOOKUP_NCC1;
+	return VOODOO_LOOKUP_NONE;
+}
+
+
+/*-------------------------------------------------
+    capture_sync - write whatever state has
+    changed since the last record; if force is
+    set, write everything
+-------------------------------------------------*/
+
+static void capture_sync(voodoo_state *v, int texcount, int force)
+{
+	capture_state *c = &v->capture;
+	voodoo_capture_reg regs[ARRAY_LENGTH(v->reg)];
+	voodoo_capture_fbi fbi;
+	int index, count = 0;
+	int tmunum;
+
+	/* registers that changed */
+	for (index = 0; index < ARRAY_LENGTH(v->reg); index++)
+		if (force || v->reg[index].u != c->reg[index].u)
+		{
+			regs[count].index = index;
+			regs[count].value = v->reg[index].u;
+			c->reg[index] = v->reg[index];
+			count++;
+		}
+	if (count != 0)
+		c->writer->write(VOODOO_CAPTURE_REGS, regs, count * sizeof(regs[0]));
+
+	/* derived FBI state */
+	memset(&fbi, 0, sizeof(fbi));
+	fbi.rowpixels = v->fbi.rowpixels;
+	fbi.auxoffs = v->fbi.auxoffs;
+	fbi.yorigin = v->fbi.yorigin;
+	memcpy(fbi.fogblend, v->fbi.fogblend, sizeof(fbi.fogblend));
+	memcpy(fbi.fogdelta, v->fbi.fogdelta, sizeof(fbi.fogdelta));
+	fbi.fogdelta_mask = v->fbi.fogdelta_mask;
+	if (force || memcmp(&fbi, &c->fbi, sizeof(fbi)) != 0)
+	{
+		c->fbi = fbi;
+		c->writer->write(VOODOO_CAPTURE_FBI, &fbi, sizeof(fbi));
+	}
+
+	/* texture RAM and derived state for each TMU in use */
+	for (tmunum = 0; tmunum < texcount; tmunum++)
+	{
+		tmu_state *t = &v->tmu[tmunum];
+		voodoo_capture_tmu tmu;
+		voodoo_capture_memory mem;
+		UINT32 page;
+
+		for (page = 0; page < (t->mask + 1) >> 12; page++)
+			if (c->tmudirty[tmunum][page])
+			{
+				mem.region = VOODOO_CAPTURE_TMURAM + tmunum;
+				mem.offset = page << 12;
+				c->writer->write(VOODOO_CAPTURE_MEMORY, &mem, sizeof(mem), t->ram + mem.offset, 1 << 12);
+				c->tmudirty[tmunum][page] = FALSE;
+			}
+
+		memset(&tmu, 0, sizeof(tmu));
+		tmu.which = tmunum;
+		tmu.lookup = capture_lookup_source(v, t);
+		tmu.lodmin = t->lodmin;
+		tmu.lodmax = t->lodmax;
+		tmu.lodbias = t->lodbias;
+		tmu.lodmask = t->lodmask;
+		memcpy(tmu.lodoffset, t->lodoffset, sizeof(tmu.lodoffset));
+		tmu.detailmax = t->detailmax;
+		tmu.detailbias = t->detailbias;
+		tmu.detailscale = t->detailscale;
+		tmu.wmask = t->wmask;
+		tmu.hmask = t->hmask;
+		tmu.bilinear_mask = t->bilinear_mask;
+		memcpy(tmu.palette, t->palette, sizeof(tmu.palette));
+		memcpy(tmu.palettea, t->palettea, sizeof(tmu.palettea));
+		memcpy(tmu.ncc[0], t->ncc[0].texel, sizeof(tmu.ncc[0]));
+		memcpy(tmu.ncc[1], t->ncc[1].texel, sizeof(tmu.ncc[1]));
+		if (force || memcmp(&tmu, &c->tmu[tmunum], sizeof(tmu)) != 0)
+		{
+			c->tmu[tmunum] = tmu;
+			c->writer->write(VOODOO_CAPTURE_TMU, &tmu, sizeof(tmu));
+		}
+	}
+}
+
+
+/*-------------------------------------------------
+    capture_start - open the capture file and
+    write a snapshot of the current state
+-------------------------------------------------*/
+
+static void capture_start(voodoo_state *v)
+{
+	capture_state *c = &v->capture;
+	voodoo_capture_setup setup;
+	voodoo_capture_memory mem;
+	char filename[20];
+	int tmunum;
+
+	/* Banshee and later keep textures in frame buffer RAM, which we don't track */
+	if (v->type >= TYPE_VOODOO_BANSHEE)
+	{
+		logerror("VOODOO.%d: display list capture requires separate texture RAM\n", v->index);
+		return;
+	}
+
+	sprintf(filename, "voodoo%d.dlc", v->index);
+	c->writer = global_alloc(display_list_writer);
+	if (c->writer->open(filename, "voodoo", VOODOO_CAPTURE_VERSION) != FILERR_NONE)
+	{
+		logerror("VOODOO.%d: unable to create %s\n", v->index, filename);
+		global_free(c->writer);
+		c->writer = NULL;
+		return;
+	}
+	c->frames = CAPTURE_FRAMES;
+
+	/* let outstanding rendering finish so the memory snapshot is consistent */
+	v->poly->wait("Capture start");
+
+	/* describe the board */
+	memset(&setup, 0, sizeof(setup));
+	setup.type = v->type;
+	setup.fbmem = v->fbi.mask + 1;
+	for (tmunum = 0; tmunum < MAX_TMU; tmunum++)
+		if (v->chipmask & (2 << tmunum))
+		{
+			setup.tmus = tmunum + 1;
+			setup.tmumem[tmunum] = v->tmu[tmunum].mask + 1;
+		}
+	c->writer->write(VOODOO_CAPTURE_SETUP, &setup, sizeof(setup));
+
+	/* snapshot all memory */
+	mem.region = VOODOO_CAPTURE_FBRAM;
+	mem.offset = 0;
+	c->writer->write(VOODOO_CAPTURE_MEMORY, &mem, sizeof(mem), v->fbi.ram, setup.fbmem);
+	for (tmunum = 0; tmunum < setup.tmus; tmunum++)
+	{
+		mem.region = VOODOO_CAPTURE_TMURAM + tmunum;
+		c->writer->write(VOODOO_CAPTURE_MEMORY, &mem, sizeof(mem), v->tmu[tmunum].ram, setup.tmumem[tmunum]);
+		if (c->tmudirty[tmunum] == NULL)
+			c->tmudirty[tmunum] = auto_alloc_array(v->device->machine(), UINT8, setup.tmumem[tmunum] >> 12);
+		memset(c->tmudirty[tmunum], 0, setup.tmumem[tmunum] >> 12);
+	}
+
+	/* and all derived state */
+	capture_sync(v, setup.tmus, TRUE);
+	logerror("VOODOO.%d: capturing %d frames to %s\n", v->index, c->frames, filename);
+}
+
+
+/*-------------------------------------------------
+    capture_stop - close the capture file
+-------------------------------------------------*/
+
+static void capture_stop(voodoo_state *v)
+{
+	capture_state *c = &v->capture;
+
+	logerror("VOODOO.%d: capture complete, %d bytes\n", v->index, (UINT32)c->writer->bytes_written());
+	global_free(c->writer);
+	c->writer = NULL;
+}
+
+
+/*-------------------------------------------------
+    capture_swap - mark the end of a frame,
+    starting or stopping the capture as needed
+-------------------------------------------------*/
+
+static void capture_swap(voodoo_state *v)
+{
+	capture_state *c = &v->capture;
+
+	if (c->writer == NULL)
+	{
+		if (c->swaps++ == CAPTURE_START_SWAP)
+			capture_start(v);
+		return;
+	}
+
+	c->writer->write(VOODOO_CAPTURE_SWAP, NULL, 0);
+	if (--c->frames == 0)
+		capture_stop(v);
+}
+
+
+/*-------------------------------------------------
+    capture_fastfill - record a fastfill command
+-------------------------------------------------*/
+
+static void capture_fastfill(voodoo_state *v, UINT16 *drawbuf, int sx, int ex, int sy, int ey, const UINT16 *dither)
+{
+	voodoo_capture_fastfill fill;
+
+	capture_sync(v, 0, FALSE);
+
+	fill.drawoffs = (drawbuf != NULL) ? (UINT8 *)drawbuf - v->fbi.ram : ~0;
+	fill.sx = sx;
+	fill.ex = ex;
+	fill.sy = sy;
+	fill.ey = ey;
+	memcpy(fill.dither, dither, sizeof(fill.dither));
+	v->capture.writer->write(VOODOO_CAPTURE_FASTFILL, &fill, sizeof(fill));
+}
+
+
+/*-------------------------------------------------
+    capture_triangle - record a triangle along
+    with its fully set up parameters
+-------------------------------------------------*/
+
+static void capture_triangle(voodoo_state *v, UINT16 *drawbuf, int texcount, const voodoo_renderer::vertex_t *vert, const poly_extra_data *extra)
+{
+	voodoo_capture_triangle tri;
+	int vnum;
+
+	capture_sync(v, texcount, FALSE);
+
+	tri.drawoffs = (UINT8 *)drawbuf - v->fbi.ram;
+	tri.texcount = texcount;
+	for (vnum = 0; vnum < 3; vnum++)
+	{
+		tri.x[vnum] = vert[vnum].x;
+		tri.y[vnum] = vert[vnum].y;
+	}
+	v->capture.writer->write(VOODOO_CAPTURE_TRIANGLE, &tri, sizeof(tri), extra, sizeof(*extra));
+}
+
+
+
+/***************************************************************************
+    DISPLAY LIST REPLAY
+***************************************************************************/
+
+/*-------------------------------------------------
+    replay_set_lookup - point a TMU at the texel
+    lookup named in a capture
+-------------------------------------------------*/
+
+static void replay_set_lookup(voodoo_state *v, tmu_state *t, UINT32 source)
+{
+	switch (source)
+	{
+		case VOODOO_LOOKUP_RGB332:      t->lookup = v->tmushare.rgb332;     break;
+		case VOODOO_LOOKUP_ALPHA8:      t->lookup = v->tmushare.alpha8;     break;
+		case VOODOO_LOOKUP_INT8:        t->lookup = v->tmushare.int8;       break;
+		case VOODOO_LOOKUP_AI44:        t->lookup = v->tmushare.ai44;       break;
+		case VOODOO_LOOKUP_RGB565:      t->lookup = v->tmushare.rgb565;     break;
+		case VOODOO_LOOKUP_ARGB1555:    t->lookup = v->tmushare.argb1555;   break;
+		case VOODOO_LOOKUP_ARGB4444:    t->lookup = v->tmushare.argb4444;   break;
+		case VOODOO_LOOKUP_PALETTE:     t->lookup = t->palette;             break;
+		case VOODOO_LOOKUP_PALETTEA:    t->lookup = t->palettea;            break;
+		case VOODOO_LOOKUP_NCC0:        t->lookup = t->ncc[0].texel;        break;
+		case VOODOO_LOOKUP_NCC1:        t->lookup = t->ncc[1].texel;        break;
+		default:                        t->lookup = NULL;                   break;
+	}
+}
+
+
+/*-------------------------------------------------
+    replay_register_waits - return TRUE if a new
+    value in a register can change the output of
+    queued work; only the triangle setup
+    registers, which are copied into the extra
+    data of each triangle, cannot
+-------------------------------------------------*/
+
+INLINE int replay_register_waits(UINT32 index)
+{
+	index &= 0xff;
+	if (index >= vertexAx && index <= ftriangleCMD)
+		return FALSE;
+	if (index >= sSetupMode && index <= sBeginTriCMD)
+		return FALSE;
+	return TRUE;
+}
+
+
+/*-------------------------------------------------
+    replay_span - render one span queued through
+    a replay renderer with the device rasterizer
+-------------------------------------------------*/
+
+static void replay_span(const void *object, INT32 scanline, INT32 startx, INT32 stopx, int threadid)
+{
+	const voodoo_poly_data *obj = (const voodoo_poly_data *)object;
+	voodoo_extent extent;
+
+	/* the rasterizers only look at the extent's X range */
+	extent.startx = startx;
+	extent.stopx = stopx;
+	(*obj->callback)(obj->dest, scanline, &extent, &obj->extra, threadid);
+}
+
+
+/*-------------------------------------------------
+    replay_no_draw - rasterizer that does
+    nothing, so replays can time setup alone
+-------------------------------------------------*/
+
+static void replay_no_draw(void *dest, INT32 scanline, const voodoo_extent *extent, const void *extradata, int threadid)
+{
+}
+
+
+/*-------------------------------------------------
+    replay_wait - wait for queued work in
+    whichever polygon manager is replaying
+-------------------------------------------------*/
+
+INLINE void replay_wait(voodoo_state *v, voodoo_replay_renderer *renderer, const char *debug_reason)
+{
+	if (renderer != NULL)
+		renderer->wait(debug_reason);
+	else
+		v->poly->wait(debug_reason);
+}
+
+
+/*-------------------------------------------------
+    replay_object_alloc - object data for the next
+    polygon, with the rasterizer filled in
+-------------------------------------------------*/
+
+static voodoo_poly_data *replay_object_alloc(voodoo_state *v, voodoo_replay_renderer *renderer, voodoo_raster_func callback, void *dest)
+{
+	voodoo_poly_data *obj = (renderer != NULL) ? (voodoo_poly_data *)renderer->object_alloc() : &v->poly->object_data_alloc();
+	obj->dest = dest;
+	obj->callback = (v->replay_flags & VOODOO_REPLAY_NO_DRAW) ? replay_no_draw : callback;
+	return obj;
+}
+
+
+/*-------------------------------------------------
+    voodoo_replay_alloc - build a voodoo_state
+    with no device around it, matching the setup
+    record of a capture
+-------------------------------------------------*/
+
+voodoo_state *voodoo_replay_alloc(display_list_reader &reader, UINT32 flags)
+{
+	const voodoo_capture_setup *setup;
+	const raster_info *info;
+	const UINT8 *payload;
+	UINT32 type, length;
+	voodoo_state *v;
+	int tmunum;
+
+	/* the setup record always comes first */
+	if (sizeof(voodoo_poly_data) > VOODOO_REPLAY_OBJECT_SIZE)
+		return NULL;
+	if (strcmp(reader.device(), "voodoo") != 0 || reader.version() != VOODOO_CAPTURE_VERSION)
+		return NULL;
+	reader.rewind();
+	if (!reader.next(type, payload, length) || type != VOODOO_CAPTURE_SETUP || length != sizeof(*setup))
+		return NULL;
+	setup = (const voodoo_capture_setup *)payload;
+	if (setup->tmus > MAX_TMU || setup->fbmem == 0 || (setup->fbmem & (setup->fbmem - 1)) != 0)
+		return NULL;
+	for (tmunum = 0; tmunum < setup->tmus; tmunum++)
+		if (setup->tmumem[tmunum] < 0x1000 || (setup->tmumem[tmunum] & (setup->tmumem[tmunum] - 1)) != 0)
+			return NULL;
+
+	/* by default rendering goes through the same polygon manager as on the device */
+	v = global_alloc_clear(voodoo_state);
+	v->type = setup->type;
+	v->replay_flags = flags;
+	v->poly = global_alloc(voodoo_renderer((flags & VOODOO_REPLAY_TILES) ? POLYFLAG_TILE_BINNING : 0));
+	v->thread_stats = global_alloc_array_clear(stats_block, WORK_MAX_THREADS);
+
+	/* memory */
+	v->fbi.ram = global_alloc_array_clear(UINT8, setup->fbmem);
+	v->fbi.mask = setup->fbmem - 1;
+	for (tmunum = 0; tmunum < setup->tmus; tmunum++)
+	{
+		tmu_state *t = &v->tmu[tmunum];
+		t->ram = global_alloc_array_clear(UINT8, setup->tmumem[tmunum]);
+		t->mask = setup->tmumem[tmunum] - 1;
+		t->reg = &v->reg[0x100 * (tmunum + 1)];
+	}
+
+	/* static tables and the rasterizers the device starts with */
+	init_static_lookups();
+	init_tmu_shared(&v->tmushare);
+	for (info = predef_raster_table; info->callback; info++)
+		add_rasterizer(v, info);
+	return v;
+}
+
+
+/*-------------------------------------------------
+    voodoo_replay_free - release a voodoo_state
+    built by voodoo_replay_alloc
+-------------------------------------------------*/
+
+void voodoo_replay_free(voodoo_state *v)
+{
+	int tmunum;
+
+	global_free(v->poly);
+	for (tmunum = 0; tmunum < MAX_TMU; tmunum++)
+		if (v->tmu[tmunum].ram != NULL)
+			global_free(v->tmu[tmunum].ram);
+	global_free(v->fbi.ram);
+	global_free(v->thread_stats);
+	global_free(v);
+}
+
+
+/*-------------------------------------------------
+    voodoo_replay_write_test - write a synthetic
+    capture, so the replay renderers can be
+    compared without a real one; it mixes
+    fastfills with untextured and textured,
+    depth tested and alpha blended triangles of
+    every size, in an order the output depends on
+-------------------------------------------------*/
+
+file_error voodoo_replay_write_test(const char *filename, int frames)
+{
+	display_list_writer writer;
+	voodoo_capture_setup setup;
+	voodoo_capture_memory mem;
+	voodoo_capture_fbi fbi;
+	voodoo_capture_tmu tmu;
+	UINT32 seed = 0x12345678;
+	file_error filerr;
+	UINT16 *texture;
+	int frame, trinum, i;
+
+	filerr = writer.open(filename, "voodoo", VOODOO_CAPTURE_VERSION);
+	if (filerr != FILERR_NONE)
+		return filerr;
+
+	/* a Voodoo 1 with one TMU and a 640x480 screen */
+	memset(&setup, 0, sizeof(setup));
+	setup.type = TYPE_VOODOO_1;
+	setup.tmus = 1;
+	setup.fbmem = 2 << 20;
+	setup.tmumem[0] = 1 << 20;
+	writer.write(VOODOO_CAPTURE_SETUP, &setup, sizeof(setup));
+
+	/* a 256x256 RGB565 texture */
+	texture = global_alloc_array(UINT16, 256 * 256);
+	for (i = 0; i < 256 * 256; i++)
+		texture[i] = ((i >> 3) & 0x1f) << 11 | ((i >> 10) & 0x3f) << 5 | ((i ^ (i >> 8)) & 0x1f);
+	mem.region = VOODOO_CAPTURE_TMURAM;
+	mem.offset = 0;
+	writer.write(VOODOO_CAPTURE_MEMORY, &mem, sizeof(mem), texture, 256 * 256 * sizeof(UINT16));
+	global_free(texture);
+
+	memset(&fbi, 0, sizeof(fbi));
+	fbi.rowpixels = 640;
+	fbi.auxoffs = 1 << 20;
+	fbi.fogdelta_mask = 0xff;
+	writer.write(VOODOO_CAPTURE_FBI, &fbi, sizeof(fbi));
+
+	memset(&tmu, 0, sizeof(tmu));
+	tmu.lookup = VOODOO_LOOKUP_RGB565;
+	tmu.lodmax = 8 << 8;
+	tmu.lodmask = 0x1ff;
+	tmu.wmask = tmu.hmask = 0xff;
+	tmu.bilinear_mask = 0xf0;
+	writer.write(VOODOO_CAPTURE_TMU, &tmu, sizeof(tmu));
+
+	for (frame = 0; frame < frames; frame++)
+	{
+		voodoo_capture_fastfill fill;
+
+		/* clear color and depth with clipping, dithering and the depth buffer on */
+		voodoo_capture_reg fillregs[] =
+		{
+			{ fbzMode, (1 << 0) | (1 << 4) | (1 << 5) | (1 << 8) | (1 << 9) | (1 << 10) },
+			{ clipLeftRight, 640 },
+			{ clipLowYHighY, 480 },
+			{ fbzColorPath, (1 << 0) | (1 << 27) },
+			{ 0x100 + textureMode, 0x0a00 },
+			{ alphaMode, 0 },
+			{ zaColor, 0xffff }
+		};
+		writer.write(VOODOO_CAPTURE_REGS, fillregs, sizeof(fillregs));
+
+		memset(&fill, 0, sizeof(fill));
+		fill.sx = 0;
+		fill.ex = 640;
+		fill.sy = 0;
+		fill.ey = 480;
+		for (i = 0; i < 16; i++)
+			fill.dither[i] = 0x1000 + frame * 0x111 + i;
+		writer.write(VOODOO_CAPTURE_FASTFILL, &fill, sizeof(fill));
+
+		for (trinum = 0; trinum < 1000; trinum++)
+		{
+			voodoo_capture_triangle tri;
+			poly_extra_data extra;
+			float size;
+
+			/* switch between opaque and blended every 100 triangles, which makes the replay wait */
+			if (trinum % 100 == 0)
+			{
+				voodoo_capture_reg blend;
+				blend.index = alphaMode;
+				blend.value = ((trinum / 100) & 1) ? ((1 << 4) | (1 << 8) | (5 << 12)) : 0;
+				writer.write(VOODOO_CAPTURE_REGS, &blend, sizeof(blend));
+			}
+
+			/* mostly small triangles, with the occasional big one */
+			seed = seed * 1103515245 + 12345;
+			size = ((seed >> 16) % 31 == 0) ? 400.0f : (float)(4 + (seed >> 16) % 60);
+			tri.drawoffs = 0;
+			tri.texcount = (seed >> 8) & 1;
+			for (i = 0; i < 3; i++)
+			{
+				seed = seed * 1103515245 + 12345;
+				tri.x[i] = (float)((seed >> 8) % 640) + (float)((seed >> 4) & 15) / 16.0f;
+				tri.y[i] = (float)((seed >> 18) % 480);
+				if (i > 0)
+				{
+					tri.x[i] = tri.x[0] + (tri.x[i] - 320.0f) * size / 640.0f;
+					tri.y[i] = tri.y[0] + (tri.y[i] - 240.0f) * size / 480.0f;
+				}
+			}
+
+			memset(&extra, 0, sizeof(extra));
+			extra.ax = (INT16)(tri.x[0] * 16.0f);
+			extra.ay = (INT16)(tri.y[0] * 16.0f);
+			extra.startr = (seed & 0xff) << 12;
+			extra.startg = ((seed >> 8) & 0xff) << 12;
+			extra.startb = ((seed >> 16) & 0xff) << 12;
+			extra.starta = 0x80 << 12;
+			extra.drdx = 1 << 10;
+			extra.dgdy = 1 << 10;
+			extra.dadx = 1 << 9;
+			extra.startz = (trinum * 61) << 12;
+			extra.startw = (INT64)1 << 32;
+			extra.startw0 = 1 << 30;
+			extra.ds0dx = 1 << 18;
+			extra.dt0dy = 1 << 18;
+			writer.write(VOODOO_CAPTURE_TRIANGLE, &tri, sizeof(tri), &extra, sizeof(extra));
+		}
+		writer.write(VOODOO_CAPTURE_SWAP, NULL, 0);
+	}
+	writer.close();
+	return FILERR_NONE;
+}
+
+
+/*-------------------------------------------------
+    voodoo_replay_frame - replay the records of a
+    capture up to the next buffer swap, through
+    the given renderer or the device's own
+    polygon manager if NULL;
+    returns 1 for a frame, 0 at the end of the
+    capture or -1 if the capture is corrupt
+-------------------------------------------------*/
+
+int voodoo_replay_frame(voodoo_state *v, display_list_reader &reader, voodoo_replay_stats &stats, voodoo_replay_renderer *renderer)
+{
+	osd_ticks_t start = osd_ticks();
+	const UINT8 *payload;
+	UINT32 type, length;
+
+	memset(&stats, 0, sizeof(stats));
+	while (reader.next(type, payload, length))
+		switch (type)
+		{
+			case VOODOO_CAPTURE_SETUP:
+				break;
+
+			case VOODOO_CAPTURE_MEMORY:
+			{
+				const voodoo_capture_memory *mem = (const voodoo_capture_memory *)payload;
+				UINT32 bytes = length - sizeof(*mem);
+				UINT8 *base;
+				UINT32 size;
+
+				if (length < sizeof(*mem) || mem->region > VOODOO_CAPTURE_TMURAM + MAX_TMU - 1)
+					return -1;
+				if (mem->region == VOODOO_CAPTURE_FBRAM)
+					base = v->fbi.ram, size = v->fbi.mask + 1;
+				else
+					base = v->tmu[mem->region - VOODOO_CAPTURE_TMURAM].ram, size = v->tmu[mem->region - VOODOO_CAPTURE_TMURAM].mask + 1;
+				if (base == NULL || mem->offset > size || bytes > size - mem->offset)
+					return -1;
+				replay_wait(v, renderer, "Replay memory");
+				memcpy(base + mem->offset, mem + 1, bytes);
+				break;
+			}
+
+			case VOODOO_CAPTURE_REGS:
+			{
+				const voodoo_capture_reg *reg = (const voodoo_capture_reg *)payload;
+				int waited = FALSE;
+
+				for (UINT32 count = length / sizeof(*reg); count != 0; count--, reg++)
+				{
+					UINT32 index = reg->index & 0x3ff;
+					if (!waited && v->reg[index].u != reg->value && replay_register_waits(index))
+					{
+						replay_wait(v, renderer, "Replay registers");
+						waited = TRUE;
+					}
+					v->reg[index].u = reg->value;
+				}
+				break;
+			}
+
+			case VOODOO_CAPTURE_FBI:
+			{
+				const voodoo_capture_fbi *fbi = (const voodoo_capture_fbi *)payload;
+
+				if (length != sizeof(*fbi))
+					return -1;
+				replay_wait(v, renderer, "Replay FBI state");
+				v->fbi.rowpixels = fbi->rowpixels;
+				v->fbi.auxoffs = fbi->auxoffs;
+				v->fbi.yorigin = fbi->yorigin;
+				memcpy(v->fbi.fogblend, fbi->fogblend, sizeof(v->fbi.fogblend));
+				memcpy(v->fbi.fogdelta, fbi->fogdelta, sizeof(v->fbi.fogdelta));
+				v->fbi.fogdelta_mask = fbi->fogdelta_mask;
+				break;
+			}
+
+			case VOODOO_CAPTURE_TMU:
+			{
+				const voodoo_capture_tmu *tmu = (const voodoo_capture_tmu *)payload;
+				tmu_state *t;
+
+				if (length != sizeof(*tmu) || tmu->which >= MAX_TMU)
+					return -1;
+				replay_wait(v, renderer, "Replay TMU state");
+				t = &v->tmu[tmu->which];
+				t->lodmin = tmu->lodmin;
+				t->lodmax = tmu->lodmax;
+				t->lodbias = tmu->lodbias;
+				t->lodmask = tmu->lodmask;
+				memcpy(t->lodoffset, tmu->lodoffset, sizeof(t->lodoffset));
+				t->detailmax = tmu->detailmax;
+				t->detailbias = tmu->detailbias;
+				t->detailscale = tmu->detailscale;
+				t->wmask = tmu->wmask;
+				t->hmask = tmu->hmask;
+				t->bilinear_mask = tmu->bilinear_mask;
+				memcpy(t->palette, tmu->palette, sizeof(t->palette));
+				memcpy(t->palettea, tmu->palettea, sizeof(t->palettea));
+				memcpy(t->ncc[0].texel, tmu->ncc[0], sizeof(t->ncc[0].texel));
+				memcpy(t->ncc[1].texel, tmu->ncc[1], sizeof(t->ncc[1].texel));
+				replay_set_lookup(v, t, tmu->lookup);
+				break;
+			}
+
+			case VOODOO_CAPTURE_FASTFILL:
+			{
+				const voodoo_capture_fastfill *fill = (const voodoo_capture_fastfill *)payload;
+				UINT16 *drawbuf = NULL;
+				voodoo_poly_data *obj;
+
+				if (length != sizeof(*fill))
+					return -1;
+				if (fill->drawoffs != ~0)
+				{
+					if (fill->drawoffs > v->fbi.mask)
+						return -1;
+					drawbuf = (UINT16 *)(v->fbi.ram + fill->drawoffs);
+				}
+				obj = replay_object_alloc(v, renderer, raster_fastfill, drawbuf);
+				obj->extra.state = v;
+				memcpy(obj->extra.dither, fill->dither, sizeof(obj->extra.dither));
+				if (renderer != NULL)
+					renderer->render_block(global_cliprect, replay_span, fill->sx, fill->ex, fill->sy, fill->ey);
+				else
+					v->poly->draw_block(global_cliprect, fill->sx, fill->ex, fill->sy, fill->ey);
+				stats.fills++;
+				break;
+			}
+
+			case VOODOO_CAPTURE_TRIANGLE:
+			{
+				const voodoo_capture_triangle *tri = (const voodoo_capture_triangle *)payload;
+				voodoo_poly_data *obj;
+				raster_info *info;
+				voodoo_renderer::vertex_t vert[3];
+				int vnum;
+
+				if (length != sizeof(*tri) + sizeof(obj->extra) || tri->texcount > MAX_TMU || tri->drawoffs > v->fbi.mask)
+					return -1;
+
+				/* the extra data was captured fully set up; only the pointers need fixing */
+				info = find_rasterizer(v, tri->texcount);
+				obj = replay_object_alloc(v, renderer, TIME_RASTERIZERS ? raster_timed : info->callback, v->fbi.ram + tri->drawoffs);
+				memcpy(&obj->extra, tri + 1, sizeof(obj->extra));
+				obj->extra.state = v;
+				obj->extra.info = info;
+
+				info->polys++;
+				UINT32 pixels;
+				if (renderer != NULL)
+					pixels = renderer->render_triangle(global_cliprect, replay_span, tri->x, tri->y);
+				else
+				{
+					for (vnum = 0; vnum < 3; vnum++)
+					{
+						vert[vnum].x = tri->x[vnum];
+						vert[vnum].y = tri->y[vnum];
+					}
+					pixels = v->poly->draw_triangle(global_cliprect, vert);
+				}
+				info->hits += pixels;
+				stats.pixels += pixels;
+				stats.triangles++;
+				break;
+			}
+
+			case VOODOO_CAPTURE_SWAP:
+				/* the frame is done once everything queued for it is */
+				replay_wait(v, renderer, "Replay swap");
+				stats.ticks = osd_ticks() - start;
+				stats.crc = crc32_creator::simple(v->fbi.ram, v->fbi.mask + 1);
+				return 1;
+
+			default:
+				return -1;
+		}
+
+	/* a partial frame at the end is finished but not reported */
+	replay_wait(v, renderer, "Replay end");
+	return 0;
+}
+
+
+
 /***************************************************************************
     COMMAND HANDLERS
 ***************************************************************************/
@@ -5090,11 +5972,9 @@ static INT32 fastfill(voodoo_state *v)
 	int ex = (v->reg[clipLeftRight].u >> 0) & 0x3ff;
 	int sy = (v->reg[clipLowYHighY].u >> 16) & 0x3ff;
 	int ey = (v->reg[clipLowYHighY].u >> 0) & 0x3ff;
-	poly_extent extents[64];
 	UINT16 dithermatrix[16];
 	UINT16 *drawbuf = NULL;
-	UINT32 pixels = 0;
-	int extnum, x, y;
+	int x, y;
 
 	/* if we're not clearing either, take no time */
 	if (!FBZMODE_RGB_BUFFER_MASK(v->reg[fbzMode].u) && !FBZMODE_AUX_BUFFER_MASK(v->reg[fbzMode].u))
@@ -5136,26 +6016,30 @@ static INT32 fastfill(voodoo_state *v)
 		}
 	}
 
-	/* fill in a block of extents */
-	extents[0].startx = sx;
-	extents[0].stopx = ex;
-	for (extnum = 1; extnum < ARRAY_LENGTH(extents); extnum++)
-		extents[extnum] = extents[0];
+	/* record the fill for replay */
+	if (CAPTURE_FRAMES && v->capture.writer != NULL)
+		capture_fastfill(v, drawbuf, sx, ex, sy, ey, dithermatrix);
 
-	/* iterate over blocks of extents */
-	for (y = sy; y < ey; y += ARRAY_LENGTH(extents))
-	{
-		poly_extra_data *extra = (poly_extra_data *)poly_get_extra_data(v->poly);
-		int count = MIN(ey - y, ARRAY_LENGTH(extents));
+	/* 2 pixels per clock */
+	return fastfill_render(v, drawbuf, sx, ex, sy, ey, dithermatrix) / 2;
+}
 
-		extra->state = v;
-		memcpy(extra->dither, dithermatrix, sizeof(extra->dither));
 
-		pixels += poly_render_triangle_custom(v->poly, drawbuf, global_cliprect, raster_fastfill, y, count, extents);
-	}
+/*-------------------------------------------------
+    fastfill_render - queue the scanlines of a
+    fastfill; returns the number of pixels
+-------------------------------------------------*/
 
-	/* 2 pixels per clock */
-	return pixels / 2;
+static UINT32 fastfill_render(voodoo_state *v, UINT16 *drawbuf, int sx, int ex, int sy, int ey, const UINT16 *dithermatrix)
+{
+	voodoo_poly_data &object = v->poly->object_data_alloc();
+
+	/* every block of scanlines shares the same object data */
+	object.dest = drawbuf;
+	object.callback = raster_fastfill;
+	object.extra.state = v;
+	memcpy(object.extra.dither, dithermatrix, sizeof(object.extra.dither));
+	return v->poly->draw_block(global_cliprect, sx, ex, sy, ey);
 }
 
 
@@ -5239,7 +6123,7 @@ static INT32 triangle(voodoo_state *v)
 	}
 
 	/* wait for any outstanding work to finish */
-//  poly_wait(v->poly, "triangle");
+//  v->poly->wait("triangle");
 
 	/* determine the draw buffer */
 	destbuf = (v->type >= TYPE_VOODOO_BANSHEE) ? 1 : FBZMODE_DRAW_BUFFER(v->reg[fbzMode].u);
@@ -5486,9 +6370,11 @@ static INT32 setup_and_draw_triangle(voodoo_state *v)
 
 static INT32 triangle_create_work_item(voodoo_state *v, UINT16 *drawbuf, int texcount)
 {
-	poly_extra_data *extra = (poly_extra_data *)poly_get_extra_data(v->poly);
+	voodoo_poly_data &object = v->poly->object_data_alloc();
+	poly_extra_data *extra = &object.extra;
 	raster_info *info = find_rasterizer(v, texcount);
-	poly_vertex vert[3];
+	voodoo_renderer::vertex_t vert[3];
+	INT32 pixels;
 
 	/* fill in the vertex data */
 	vert[0].x = (float)v->fbi.ax * (1.0f / 16.0f);
@@ -5498,7 +6384,9 @@ static INT32 triangle_create_work_item(voodoo_state *v, UINT16 *drawbuf, int tex
 	vert[2].x = (float)v->fbi.cx * (1.0f / 16.0f);
 	vert[2].y = (float)v->fbi.cy * (1.0f / 16.0f);
 
-	/* fill in the extra data */
+	/* fill in the object data */
+	object.dest = drawbuf;
+	object.callback = TIME_RASTERIZERS ? raster_timed : info->callback;
 	extra->state = v;
 	extra->info = info;
 
@@ -5556,9 +6444,15 @@ static INT32 triangle_create_work_item(voodoo_state *v, UINT16 *drawbuf, int tex
 		}
 	}
 
+	/* record the triangle for replay */
+	if (CAPTURE_FRAMES && v->capture.writer != NULL)
+		capture_triangle(v, drawbuf, texcount, vert, extra);
+
 	/* farm the rasterization out to other threads */
 	info->polys++;
-	return poly_render_triangle(v->poly, drawbuf, global_cliprect, info->callback, 0, &vert[0], &vert[1], &vert[2]);
+	pixels = v->poly->draw_triangle(global_cliprect, vert);
+	info->hits += pixels;
+	return pixels;
 }
 
 
@@ -5585,6 +6479,7 @@ static raster_info *add_rasterizer(voodoo_state *v, const raster_info *cinfo)
 	/* fill in the data */
 	info->hits = 0;
 	info->polys = 0;
+	info->ticks = 0;
 
 	/* hook us into the hash table */
 	info->next = v->raster_hash[hash];
@@ -5644,12 +6539,17 @@ static raster_info *find_rasterizer(voodoo_state *v, int texcount)
 			return info;
 		}
 
-	/* generate a new one using the generic entry */
-	curinfo.callback = (texcount == 0) ? raster_generic_0tmu : (texcount == 1) ? raster_generic_1tmu : raster_generic_2tmu;
+	/* generate a new one using the specialized or generic entry */
+	if (USE_SPECIALIZED_RASTERIZERS)
+		curinfo.callback = get_specialized_rasterizer(v, texcount);
+	else
+		curinfo.callback = (texcount == 0) ? raster_generic_0tmu : (texcount == 1) ? raster_generic_1tmu : raster_generic_2tmu;
 	curinfo.is_generic = TRUE;
+	curinfo.is_specialized = USE_SPECIALIZED_RASTERIZERS;
 	curinfo.display = 0;
 	curinfo.polys = 0;
 	curinfo.hits = 0;
+	curinfo.ticks = 0;
 	curinfo.next = 0;
 
 	return add_rasterizer(v, &curinfo);
@@ -5685,8 +6585,8 @@ static void dump_rasterizer_stats(voodoo_state *v)
 		if (best == NULL || best->hits == 0)
 			break;
 
-		/* print it */
-		printf("RASTERIZER_ENTRY( 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X ) /* %c %8d %10d */\n",
+		/* print it; '*' marks modes not in the table, '+' those handled by a specialized rasterizer */
+		printf("RASTERIZER_ENTRY( 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X ) /* %c%c %8d %10d",
 			best->eff_color_path,
 			best->eff_alpha_mode,
 			best->eff_fog_mode,
@@ -5694,8 +6594,12 @@ static void dump_rasterizer_stats(voodoo_state *v)
 			best->eff_tex_mode_0,
 			best->eff_tex_mode_1,
 			best->is_generic ? '*' : ' ',
+			best->is_specialized ? '+' : ' ',
 			best->polys,
 			best->hits);
+		if (TIME_RASTERIZERS && best->ticks != 0)
+			printf(" %10.0f pix/s", (double)best->hits * (double)osd_ticks_per_second() / (double)best->ticks);
+		printf(" */\n");
 
 		/* reset */
 		best->display = display_index;
@@ -5815,7 +6719,7 @@ void voodoo_3_device::device_start()
     implementation of the 'fastfill' command
 -------------------------------------------------*/
 
-static void raster_fastfill(void *destbase, INT32 y, const poly_extent *extent, const void *extradata, int threadid)
+static void raster_fastfill(void *destbase, INT32 y, const voodoo_extent *extent, const void *extradata, int threadid)
 {
 	const poly_extra_data *extra = (const poly_extra_data *)extradata;
 	voodoo_state *v = extra->state;
@@ -5886,6 +6790,30 @@ RASTERIZER(generic_2tmu, 2, v->reg[fbzColorPath].u, v->reg[fbzMode].u, v->reg[al
 			v->reg[fogMode].u, v->tmu[0].reg[textureMode].u, v->tmu[1].reg[textureMode].u)
 
 
+/*-------------------------------------------------
+    raster_timed - wrapper that accumulates the
+    time spent in each rasterizer for the stats
+    dump
+-------------------------------------------------*/
+
+static void raster_timed(void *destbase, INT32 y, const voodoo_extent *extent, const void *extradata, int threadid)
+{
+	const poly_extra_data *extra = (const poly_extra_data *)extradata;
+	raster_info *info = extra->info;
+	osd_ticks_t start = osd_ticks();
+	INT64 delta, oldval;
+
+	(*info->callback)(destbase, y, extent, extradata, threadid);
+
+	/* accumulate atomically; several threads may share a rasterizer */
+	delta = osd_ticks() - start;
+	do
+	{
+		oldval = info->ticks;
+	} while (compare_exchange64(&info->ticks, oldval, oldval + delta) != oldval);
+}
+
+
 #else
 
 
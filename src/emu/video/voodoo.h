@@ -49,6 +49,17 @@ struct voodoo_config
 };
 
 
+/* statistics for one frame of a replayed display list capture */
+struct voodoo_replay_stats
+{
+	UINT32              triangles;              /* triangles rendered */
+	UINT32              fills;                  /* fastfills rendered */
+	UINT64              pixels;                 /* pixels covered by triangles */
+	osd_ticks_t         ticks;                  /* time to replay and render the frame */
+	UINT32              crc;                    /* CRC of video memory after the frame */
+};
+
+
 
 /***************************************************************************
     DEVICE CONFIGURATION MACROS
@@ -90,6 +101,43 @@ DECLARE_READ32_DEVICE_HANDLER( banshee_io_r );
 DECLARE_WRITE32_DEVICE_HANDLER( banshee_io_w );
 DECLARE_READ32_DEVICE_HANDLER( banshee_rom_r );
 
+/* ----- display list replay, for the dlreplay tool ----- */
+
+struct voodoo_state;
+class display_list_reader;
+
+/* largest object data a replay renderer must hold per polygon */
+#define VOODOO_REPLAY_OBJECT_SIZE   512
+
+/* replay flags */
+#define VOODOO_REPLAY_NO_DRAW       0x01        /* queue every polygon but skip the rasterizers */
+#define VOODOO_REPLAY_TILES         0x02        /* bin the device's own polygons into screen tiles */
+
+/* renders one span of a replayed polygon from the renderer's copy of its object data */
+typedef void (*voodoo_replay_span_func)(const void *object, INT32 scanline, INT32 startx, INT32 stopx, int threadid);
+
+/* a polygon manager to replay through in place of the device's own one */
+class voodoo_replay_renderer
+{
+public:
+	virtual ~voodoo_replay_renderer() { }
+
+	/* object data for the next polygon, VOODOO_REPLAY_OBJECT_SIZE bytes, kept until it is rendered */
+	virtual void *object_alloc() = 0;
+
+	/* queue polygons using the last object data allocated; both return the pixel count */
+	virtual UINT32 render_triangle(const rectangle &cliprect, voodoo_replay_span_func span, const float *x, const float *y) = 0;
+	virtual UINT32 render_block(const rectangle &cliprect, voodoo_replay_span_func span, INT32 startx, INT32 stopx, INT32 starty, INT32 stopy) = 0;
+
+	/* wait for everything queued to be rendered */
+	virtual void wait(const char *debug_reason) = 0;
+};
+
+voodoo_state *voodoo_replay_alloc(display_list_reader &reader, UINT32 flags);
+int voodoo_replay_frame(voodoo_state *v, display_list_reader &reader, voodoo_replay_stats &stats, voodoo_replay_renderer *renderer);
+void voodoo_replay_free(voodoo_state *v);
+file_error voodoo_replay_write_test(const char *filename, int frames);
+
 
 /* ----- device interface ----- */
 
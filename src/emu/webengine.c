@@ -6,6 +6,34 @@
 
     Handle MAME internal web server.
 
+****************************************************************************
+
+    A websocket opened on /stream receives the first screen and the final
+    sound mix as binary messages made of little-endian 32-bit words:
+
+        'F' number width height dropped key ops...      for each frame
+        'A' samplerate count samples...                 for each audio block
+
+    Audio samples are 16-bit, interleaved left and right. A frame is
+    coded against the previous one sent, or against black when key is
+    set; each op word holds a code in its top two bits and a pixel count
+    below it:
+
+        0  count pixels are unchanged
+        1  count pixels take the RGB value in the next word
+        2  count pixels follow, one RGB word each
+
+    The emulation thread only copies frames and audio into a small queue;
+    a separate thread codes and sends them. When the clients fall behind
+    new frames are dropped and the oldest audio is overwritten, so the
+    emulation never waits on the network.
+
+    Text messages sent on the same websocket are input events, applied
+    at the next frame:
+
+        input <port> <mask> <0|1>       press or release port bits
+        key <text>                      type text on the natural keyboard
+
 ***************************************************************************/
 
 #include "web/mongoose.h"
@@ -16,11 +44,54 @@
 #include "webengine.h"
 
 
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+#define STREAM_URI              "/stream"
+#define STREAM_INPUT_LIMIT      4096            // pending input text before events are dropped
+
+enum
+{
+	STREAM_OP_COPY = 0,
+	STREAM_OP_FILL,
+	STREAM_OP_LITERAL
+};
+
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  put_word - store a little-endian 32-bit word
+//  and advance the pointer
+//-------------------------------------------------
+
+static inline void put_word(UINT32 *&dest, UINT32 value)
+{
+	*dest++ = LITTLE_ENDIANIZE_INT32(value);
+}
+
+
+
 //**************************************************************************
 //  WEB ENGINE
 //**************************************************************************
 
 void web_engine::websocket_ready_handler(struct mg_connection *conn) {
+	if (is_stream(conn))
+	{
+		// new clients need a key frame before any deltas
+		osd_lock_acquire(m_stream_lock);
+		m_streams.append(*global_alloc(simple_list_wrapper<mg_connection>(conn)));
+		m_stream_clients = m_streams.count();
+		m_stream_keyframe = true;
+		osd_lock_release(m_stream_lock);
+		return;
+	}
+
 	static const char *message = "update_machine";
 	mg_websocket_write(conn, WEBSOCKET_OPCODE_TEXT, message, strlen(message));
 	m_websockets.append(*global_alloc(simple_list_wrapper<mg_connection>(conn)));
@@ -33,6 +104,22 @@ void web_engine::websocket_ready_handler(struct mg_connection *conn) {
 int web_engine::websocket_data_handler(struct mg_connection *conn, int flags,
 									char *data, size_t data_len)
 {
+	if (is_stream(conn))
+	{
+		if (data_len >= 4 && memcmp(data, "exit", 4) == 0)
+			return 0;
+
+		// queue input events for the emulation thread
+		if ((flags & 0x0f) == WEBSOCKET_OPCODE_TEXT)
+		{
+			osd_lock_acquire(m_queue_lock);
+			if (m_input.len() + data_len < STREAM_INPUT_LIMIT)
+				m_input.cat(data, data_len).cat("\n");
+			osd_lock_release(m_queue_lock);
+		}
+		return 1;
+	}
+
 	// just Echo example for now
 	if ((flags & 0x0f) == WEBSOCKET_OPCODE_TEXT)
 		mg_websocket_write(conn, WEBSOCKET_OPCODE_TEXT, data, data_len);
@@ -310,6 +397,328 @@ void *web_engine::websocket_keepalive()
 	return NULL;
 }
 
+// Called when a request, including a whole websocket conversation, is finished.
+void web_engine::end_request_handler(const struct mg_connection *conn)
+{
+	if (!is_stream(conn))
+		return;
+
+	osd_lock_acquire(m_stream_lock);
+	for (simple_list_wrapper<mg_connection> *curitem = m_streams.first(); curitem != NULL; curitem = curitem->next())
+		if (curitem->object() == conn)
+		{
+			m_streams.remove(*curitem);
+			break;
+		}
+	m_stream_clients = m_streams.count();
+	osd_lock_release(m_stream_lock);
+}
+
+//-------------------------------------------------
+//  is_stream - is this connection on the
+//  streaming websocket?
+//-------------------------------------------------
+
+bool web_engine::is_stream(const struct mg_connection *conn)
+{
+	const struct mg_request_info *request_info = mg_get_request_info(const_cast<struct mg_connection *>(conn));
+	return (request_info->uri != NULL && strcmp(request_info->uri, STREAM_URI) == 0);
+}
+
+//-------------------------------------------------
+//  set_machine - attach to a new machine; the
+//  streaming is hooked in once it starts
+//-------------------------------------------------
+
+void web_engine::set_machine(running_machine &machine)
+{
+	m_machine = &machine;
+	if (!m_options.http())
+		return;
+
+	// half a second of audio may wait for the sender
+	osd_lock_acquire(m_queue_lock);
+	m_sample_rate = machine.sample_rate();
+	m_audio.resize((m_sample_rate + 1) & ~1);
+	m_audio_start = m_audio_count = 0;
+	m_input.reset();
+	osd_lock_release(m_queue_lock);
+
+	machine.set_init_callback(machine_notify_delegate(FUNC(web_engine::machine_init), this));
+}
+
+//-------------------------------------------------
+//  machine_init - hook the streaming into the
+//  machine during its init phase
+//-------------------------------------------------
+
+void web_engine::machine_init()
+{
+	m_audio_attached = false;
+	machine().add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(FUNC(web_engine::stream_frame_update), this));
+}
+
+//-------------------------------------------------
+//  stream_frame_update - apply input events and
+//  queue the new frame, unless the queue is full
+//-------------------------------------------------
+
+void web_engine::stream_frame_update()
+{
+	stream_input();
+	if (m_stream_clients == 0)
+		return;
+
+	// the sound manager only exists once the machine is running
+	if (!m_audio_attached)
+	{
+		machine().sound().set_output_callback(sound_output_delegate(FUNC(web_engine::stream_audio), this));
+		m_audio_attached = true;
+	}
+
+	screen_device_iterator iter(machine().root_device());
+	screen_device *screen = iter.first();
+	if (screen == NULL)
+		return;
+
+	// the sender only touches queued frames, so the next slot is ours
+	osd_lock_acquire(m_queue_lock);
+	bool full = (m_frame_count == STREAM_QUEUE_FRAMES);
+	stream_frame &frame = m_frames[(m_frame_head + m_frame_count) % STREAM_QUEUE_FRAMES];
+	if (full)
+		m_frames_dropped++;
+	else
+	{
+		frame.dropped = m_frames_dropped;
+		m_frames_dropped = 0;
+	}
+	osd_lock_release(m_queue_lock);
+	if (full)
+		return;
+
+	frame.width = screen->visible_area().width();
+	frame.height = screen->visible_area().height();
+	frame.number = screen->frame_number();
+	frame.pixels.resize(frame.width * frame.height);
+	if (frame.pixels.count() != 0)
+		screen->pixels(&frame.pixels[0]);
+
+	osd_lock_acquire(m_queue_lock);
+	m_frame_count++;
+	osd_lock_release(m_queue_lock);
+}
+
+//-------------------------------------------------
+//  stream_audio - add a block of the final mix
+//  to the ring, overwriting the oldest samples
+//-------------------------------------------------
+
+void web_engine::stream_audio(const INT16 *samples, int count)
+{
+	if (m_stream_clients == 0)
+		return;
+
+	osd_lock_acquire(m_queue_lock);
+	int size = m_audio.count();
+	// no ring when the sample rate is 0
+	if (size == 0)
+	{
+		osd_lock_release(m_queue_lock);
+		return;
+	}
+	for (int index = 0; index < count * 2; index++)
+	{
+		m_audio[(m_audio_start + m_audio_count) % size] = samples[index];
+		if (m_audio_count == size)
+			m_audio_start = (m_audio_start + 1) % size;
+		else
+			m_audio_count++;
+	}
+	osd_lock_release(m_queue_lock);
+}
+
+//-------------------------------------------------
+//  stream_input - apply the input events the
+//  clients sent since the last frame
+//-------------------------------------------------
+
+void web_engine::stream_input()
+{
+	osd_lock_acquire(m_queue_lock);
+	if (m_input.len() == 0)
+	{
+		osd_lock_release(m_queue_lock);
+		return;
+	}
+	astring input(m_input);
+	m_input.reset();
+	osd_lock_release(m_queue_lock);
+
+	for (int start = 0, end; start < input.len(); start = end + 1)
+	{
+		end = input.chr(start, '\n');
+		astring line(input, start, end - start);
+		if (line.find(0, "input ") == 0)
+		{
+			char tag[64], mask[64];
+			int pressed;
+			if (sscanf(line, "input %63s %63s %d", tag, mask, &pressed) != 3)
+				continue;
+			ioport_port *port = machine().root_device().ioport(tag);
+			if (port != NULL)
+				port->set_scripted(strtoul(mask, NULL, 0), pressed != 0);
+		}
+		else if (line.find(0, "key ") == 0)
+			machine().ioport().natkeyboard().post_utf8(line.cstr() + 4);
+		else
+			mame_printf_verbose("Ignoring stream input '%s'\n", line.cstr());
+	}
+}
+
+//-------------------------------------------------
+//  stream_sender - thread sending queued frames
+//  and audio to the streaming clients
+//-------------------------------------------------
+
+void *web_engine::stream_sender()
+{
+	while (!m_exiting_core)
+	{
+		bool sent = send_frame();
+		sent |= send_audio();
+		if (!sent)
+			osd_sleep(osd_ticks_per_second() / 200);
+	}
+	atomic_exchange32(&m_stream_running, 0);
+	return NULL;
+}
+
+//-------------------------------------------------
+//  send_frame - code and send the oldest queued
+//  frame; returns false if there was none
+//-------------------------------------------------
+
+bool web_engine::send_frame()
+{
+	osd_lock_acquire(m_queue_lock);
+	bool queued = (m_frame_count != 0);
+	osd_lock_release(m_queue_lock);
+	if (!queued)
+		return false;
+
+	// code the frame under the client lock, so a client joining between the
+	// coding and the sending cannot miss its key frame
+	osd_lock_acquire(m_stream_lock);
+	const stream_frame &frame = m_frames[m_frame_head];
+	int pixels = frame.width * frame.height;
+	bool key = (m_stream_keyframe || frame.width != m_reference_width || frame.height != m_reference_height);
+	m_stream_keyframe = false;
+	if (key)
+	{
+		m_reference.resize(pixels);
+		if (pixels != 0)
+			memset(&m_reference[0], 0, pixels * sizeof(m_reference[0]));
+		m_reference_width = frame.width;
+		m_reference_height = frame.height;
+	}
+
+	// worst case is an op word for every pixel plus the pixel itself
+	m_packet.resize((6 + pixels * 2) * sizeof(UINT32));
+	UINT32 *dest = reinterpret_cast<UINT32 *>(&m_packet[0]);
+	put_word(dest, 'F');
+	put_word(dest, frame.number);
+	put_word(dest, frame.width);
+	put_word(dest, frame.height);
+	put_word(dest, frame.dropped);
+	put_word(dest, key ? 1 : 0);
+
+	const UINT32 *cur = (pixels != 0) ? &frame.pixels[0] : NULL;
+	UINT32 *ref = (pixels != 0) ? &m_reference[0] : NULL;
+	for (int index = 0; index < pixels; )
+	{
+		int start = index;
+
+		// unchanged pixels
+		if (cur[index] == ref[index])
+		{
+			while (index < pixels && cur[index] == ref[index])
+				index++;
+			put_word(dest, (STREAM_OP_COPY << 30) | (index - start));
+			continue;
+		}
+
+		// runs of three or more of one colour
+		while (index < pixels && cur[index] == cur[start])
+			index++;
+		if (index - start >= 3)
+		{
+			put_word(dest, (STREAM_OP_FILL << 30) | (index - start));
+			put_word(dest, cur[start]);
+			continue;
+		}
+
+		// anything else, up to the next run or unchanged pixel
+		index = start;
+		while (index < pixels && cur[index] != ref[index] && !(index + 2 < pixels && cur[index + 1] == cur[index] && cur[index + 2] == cur[index]))
+			index++;
+		put_word(dest, (STREAM_OP_LITERAL << 30) | (index - start));
+		for (int literal = start; literal < index; literal++)
+			put_word(dest, cur[literal]);
+	}
+	if (pixels != 0)
+		memcpy(ref, cur, pixels * sizeof(*ref));
+
+	// the slot can be reused once the frame is coded
+	osd_lock_acquire(m_queue_lock);
+	m_frame_head = (m_frame_head + 1) % STREAM_QUEUE_FRAMES;
+	m_frame_count--;
+	osd_lock_release(m_queue_lock);
+
+	send_stream(&m_packet[0], reinterpret_cast<UINT8 *>(dest) - &m_packet[0]);
+	osd_lock_release(m_stream_lock);
+	return true;
+}
+
+//-------------------------------------------------
+//  send_audio - send the audio gathered since the
+//  last call; returns false if there was none
+//-------------------------------------------------
+
+bool web_engine::send_audio()
+{
+	osd_lock_acquire(m_queue_lock);
+	int count = m_audio_count;
+	m_packet.resize(3 * sizeof(UINT32) + count * sizeof(INT16));
+	UINT32 *header = reinterpret_cast<UINT32 *>(&m_packet[0]);
+	put_word(header, 'A');
+	put_word(header, m_sample_rate);
+	put_word(header, count / 2);
+	INT16 *dest = reinterpret_cast<INT16 *>(header);
+	for (int index = 0; index < count; index++)
+		*dest++ = LITTLE_ENDIANIZE_INT16(m_audio[(m_audio_start + index) % m_audio.count()]);
+	m_audio_start = m_audio_count = 0;
+	osd_lock_release(m_queue_lock);
+	if (count == 0)
+		return false;
+
+	osd_lock_acquire(m_stream_lock);
+	send_stream(&m_packet[0], m_packet.count());
+	osd_lock_release(m_stream_lock);
+	return true;
+}
+
+//-------------------------------------------------
+//  send_stream - send a binary message to all
+//  streaming clients; the caller holds the lock
+//-------------------------------------------------
+
+void web_engine::send_stream(const void *data, int length)
+{
+	// clients that went away are removed when their request ends
+	for (simple_list_wrapper<mg_connection> *curitem = m_streams.first(); curitem != NULL; curitem = curitem->next())
+		mg_websocket_write(curitem->object(), WEBSOCKET_OPCODE_BINARY, (const char *)data, length);
+}
+
 //-------------------------------------------------
 //  static callbacks
 //-------------------------------------------------
@@ -354,12 +763,25 @@ static int begin_http_error_handler_static(struct mg_connection *conn, int statu
 	return 1;
 }
 
+static void end_request_handler_static(const struct mg_connection *conn, int reply_status_code)
+{
+	const struct mg_request_info *request_info = mg_get_request_info(const_cast<struct mg_connection *>(conn));
+	web_engine *engine = static_cast<web_engine *>(request_info->user_data);
+	engine->end_request_handler(conn);
+}
+
 static void *websocket_keepalive_static(void *thread_func_param)
 {
 	web_engine *engine = static_cast<web_engine *>(thread_func_param);
 	return engine->websocket_keepalive();
 }
 
+static void *stream_sender_static(void *thread_func_param)
+{
+	web_engine *engine = static_cast<web_engine *>(thread_func_param);
+	return engine->stream_sender();
+}
+
 //-------------------------------------------------
 //  web_engine - constructor
 //-------------------------------------------------
@@ -369,8 +791,21 @@ web_engine::web_engine(emu_options &options)
 		m_machine(NULL),
 		m_ctx(NULL),
 		m_lastupdatetime(0),
-		m_exiting_core(false)
-
+		m_exiting_core(false),
+		m_stream_lock(osd_lock_alloc()),
+		m_stream_clients(0),
+		m_stream_running(0),
+		m_stream_keyframe(true),
+		m_queue_lock(osd_lock_alloc()),
+		m_frame_head(0),
+		m_frame_count(0),
+		m_frames_dropped(0),
+		m_audio_start(0),
+		m_audio_count(0),
+		m_sample_rate(0),
+		m_audio_attached(false),
+		m_reference_width(0),
+		m_reference_height(0)
 {
 	struct mg_callbacks callbacks;
 
@@ -387,12 +822,17 @@ web_engine::web_engine(emu_options &options)
 	callbacks.websocket_ready = websocket_ready_handler_static;
 	callbacks.websocket_data = websocket_data_handler_static;
 	callbacks.http_error = begin_http_error_handler_static;
+	callbacks.end_request = end_request_handler_static;
 
 	// Start the web server.
 	if (m_options.http()) {
 		m_ctx = mg_start(&callbacks, this, web_options);
 
 		mg_start_thread(websocket_keepalive_static, this);
+
+		m_stream_running = 1;
+		if (mg_start_thread(stream_sender_static, this) != 0)
+			m_stream_running = 0;
 	}
 
 }
@@ -405,6 +845,8 @@ web_engine::~web_engine()
 {
 	if (m_options.http())
 		close();
+	osd_lock_free(m_queue_lock);
+	osd_lock_free(m_stream_lock);
 }
 
 //-------------------------------------------------
@@ -419,8 +861,17 @@ void web_engine::close()
 	{
 		mg_websocket_write(curitem->object(), WEBSOCKET_OPCODE_CONNECTION_CLOSE, NULL, 0);
 	}
+	// streaming clients too, or mg_stop waits for them to time out
+	osd_lock_acquire(m_stream_lock);
+	for (simple_list_wrapper<mg_connection> *curitem = m_streams.first(); curitem != NULL; curitem = curitem->next())
+		mg_websocket_write(curitem->object(), WEBSOCKET_OPCODE_CONNECTION_CLOSE, NULL, 0);
+	osd_lock_release(m_stream_lock);
 	// Stop the server.
 	mg_stop(m_ctx);
+
+	// the stream sender uses the locks, so let it finish first
+	while (m_stream_running)
+		osd_sleep(osd_ticks_per_second()/100);
 }
 
 
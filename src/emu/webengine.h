@@ -26,19 +26,45 @@ public:
 	void push_message(const char *message);
 	void close();
 
-	void set_machine(running_machine &machine) { m_machine = &machine; }
+	void set_machine(running_machine &machine);
 
 	void websocket_ready_handler(struct mg_connection *conn);
 	int websocket_data_handler(struct mg_connection *conn, int flags, char *data, size_t data_len);
 	int begin_request_handler(struct mg_connection *conn);
 	int begin_http_error_handler(struct mg_connection *conn, int status);
+	void end_request_handler(const struct mg_connection *conn);
 	void *websocket_keepalive();
+	void *stream_sender();
 protected:
 	// getters
 	running_machine &machine() const { return *m_machine; }
 
 	int json_game_handler(struct mg_connection *conn);
 	int json_slider_handler(struct mg_connection *conn);
+
+	// frames that may wait for the stream sender before new ones are dropped
+	static const int STREAM_QUEUE_FRAMES = 3;
+
+	// a captured frame waiting to be sent
+	struct stream_frame
+	{
+		dynamic_array<UINT32>   pixels;
+		int                     width;
+		int                     height;
+		UINT32                  number;
+		UINT32                  dropped;            // frames dropped just before this one
+	};
+
+	// streaming helpers; the first four run on the emulation thread
+	void machine_init();
+	void stream_frame_update();
+	void stream_audio(const INT16 *samples, int count);
+	void stream_input();
+	bool send_frame();
+	bool send_audio();
+	void send_stream(const void *data, int length);
+	static bool is_stream(const struct mg_connection *conn);
+
 private:
 	// internal state
 	emu_options &       m_options;
@@ -47,6 +73,32 @@ private:
 	osd_ticks_t         m_lastupdatetime;
 	bool                m_exiting_core;
 	simple_list<simple_list_wrapper<mg_connection> > m_websockets;
+
+	// screen and audio streaming clients; the lock is held while sending
+	osd_lock *          m_stream_lock;
+	simple_list<simple_list_wrapper<mg_connection> > m_streams;
+	volatile INT32      m_stream_clients;
+	volatile INT32      m_stream_running;
+	bool                m_stream_keyframe;
+
+	// frames, audio and input events passed between the emulation and sender threads
+	osd_lock *          m_queue_lock;
+	stream_frame        m_frames[STREAM_QUEUE_FRAMES];
+	int                 m_frame_head;
+	int                 m_frame_count;
+	UINT32              m_frames_dropped;
+	dynamic_array<INT16> m_audio;               // ring of interleaved stereo samples
+	int                 m_audio_start;
+	int                 m_audio_count;
+	int                 m_sample_rate;
+	bool                m_audio_attached;
+	astring             m_input;                // input commands, one per line
+
+	// sender state
+	dynamic_array<UINT32> m_reference;          // last frame sent, for delta coding
+	int                 m_reference_width;
+	int                 m_reference_height;
+	dynamic_buffer      m_packet;
 };
 
 #endif  /* __web_engine_H__ */
@@ -0,0 +1,208 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    workpool.c
+
+    Run a list of independent items on the work queue threads and
+    collect their results in list order.
+
+****************************************************************************
+
+    The listing, auditing, validation and identification commands all
+    do the same thing: process every item of a list independently and
+    report the results in list order. Rather than queueing one work
+    item per entry, a worker per thread is queued and each one claims
+    the next unprocessed entry until there are none left, so per-worker
+    state (driver enumerators and their cached machine configs, for
+    instance) is created once per thread rather than once per entry.
+
+    Workers never let an exception escape; it is recorded against the
+    item that raised it and the owner decides what to do with it once
+    it reaches that item.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "workpool.h"
+
+
+
+//**************************************************************************
+//  ORDERED WORK POOL
+//**************************************************************************
+
+//-------------------------------------------------
+//  ordered_work_pool - constructor
+//-------------------------------------------------
+
+ordered_work_pool::ordered_work_pool(ordered_work_client &client)
+	: m_client(client),
+		m_queue(NULL),
+		m_items(NULL),
+		m_count(0),
+		m_claimed(0)
+{
+}
+
+
+//-------------------------------------------------
+//  ~ordered_work_pool - destructor
+//-------------------------------------------------
+
+ordered_work_pool::~ordered_work_pool()
+{
+	finish();
+	global_free(m_items);
+}
+
+
+//-------------------------------------------------
+//  start - set the workers going on a new list
+//  of items; with no queue, nothing happens
+//  until the first wait()
+//-------------------------------------------------
+
+void ordered_work_pool::start(int count)
+{
+	// make sure the previous list is done with
+	finish();
+	global_free(m_items);
+	m_items = global_alloc_array(item, count);
+	m_count = count;
+	m_claimed = 0;
+
+	// one worker per thread is plenty, since each keeps going until the list is empty
+	m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	if (m_queue != NULL)
+		for (int workernum = 0; workernum < m_count && workernum < WORK_MAX_THREADS; workernum++)
+			osd_work_item_queue(m_queue, work_static, this, WORK_ITEM_FLAG_AUTO_RELEASE);
+}
+
+
+//-------------------------------------------------
+//  wait - wait for an item to be finished,
+//  processing it here if no worker has claimed
+//  it yet; returns false if it raised an
+//  exception
+//-------------------------------------------------
+
+bool ordered_work_pool::wait(int index)
+{
+	assert(index >= 0 && index < m_count);
+	item &cur = m_items[index];
+
+	// take anything up to this item the workers have not got to yet; this
+	// must not use osd_work_queue_wait(), which can have this thread run an
+	// unstarted worker that would then keep going to the end of the list
+	work(m_inline, index + 1);
+	while (cur.done == 0)
+		osd_sleep(osd_ticks_per_second() / 1000);
+
+	// only finish() can leave an item unprocessed
+	assert(cur.done != 0);
+	return (cur.done != 0 && !cur.failed);
+}
+
+
+//-------------------------------------------------
+//  finish - stop handing out items and wait for
+//  every worker to finish its current one and
+//  fold in its state
+//-------------------------------------------------
+
+void ordered_work_pool::finish()
+{
+	atomic_exchange32(&m_claimed, m_count);
+	if (m_queue != NULL)
+	{
+		while (!osd_work_queue_wait(m_queue, osd_ticks_per_second())) ;
+		osd_work_queue_free(m_queue);
+		m_queue = NULL;
+	}
+	end(m_inline);
+}
+
+
+//-------------------------------------------------
+//  work_static - body of each queued worker
+//-------------------------------------------------
+
+void *ordered_work_pool::work_static(void *param, int threadid)
+{
+	ordered_work_pool &pool = *reinterpret_cast<ordered_work_pool *>(param);
+	worker state;
+	pool.work(state, pool.m_count);
+	pool.end(state);
+	return NULL;
+}
+
+
+//-------------------------------------------------
+//  work - claim and process items until there
+//  are none left below the limit
+//-------------------------------------------------
+
+void ordered_work_pool::work(worker &state, int limit)
+{
+	while (m_claimed < limit)
+	{
+		int index = atomic_increment32(&m_claimed) - 1;
+		if (index >= m_count)
+			break;
+
+		item &cur = m_items[index];
+		try
+		{
+			if (!state.begun)
+			{
+				state.context = m_client.work_begin();
+				state.begun = true;
+			}
+			m_client.work_item(state.context, index);
+		}
+		catch (emu_fatalerror &err)
+		{
+			cur.failed = true;
+			cur.error.cpy(err.string());
+			cur.exitcode = err.exitcode();
+		}
+		catch (std::exception &err)
+		{
+			cur.failed = true;
+			cur.error.printf("Exception: %s\n", err.what());
+			cur.exitcode = MAMERR_FATALERROR;
+		}
+		catch (...)
+		{
+			cur.failed = true;
+			cur.error.cpy("Unknown exception\n");
+			cur.exitcode = MAMERR_FATALERROR;
+		}
+		atomic_exchange32(&cur.done, 1);
+	}
+}
+
+
+//-------------------------------------------------
+//  end - let the client fold in and free a
+//  worker's state
+//-------------------------------------------------
+
+void ordered_work_pool::end(worker &state)
+{
+	if (!state.begun)
+		return;
+	state.begun = false;
+
+	// nothing is left to report this against, so just say so
+	try
+	{
+		m_client.work_end(state.context);
+	}
+	catch (...)
+	{
+		mame_printf_error("Exception while finishing a worker\n");
+	}
+	state.context = NULL;
+}
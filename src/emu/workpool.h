@@ -0,0 +1,103 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    workpool.h
+
+    Run a list of independent items on the work queue threads and
+    collect their results in list order.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __WORKPOOL_H__
+#define __WORKPOOL_H__
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> ordered_work_client
+
+// implemented by the owner of an ordered_work_pool to do the actual work
+class ordered_work_client
+{
+public:
+	virtual ~ordered_work_client() { }
+
+	// called on a worker thread before its first item; returns state private to that worker
+	virtual void *work_begin() { return NULL; }
+
+	// process one item
+	virtual void work_item(void *context, int index) = 0;
+
+	// called on the worker thread after its last item to fold in and free its state
+	virtual void work_end(void *context) { }
+};
+
+
+// ======================> ordered_work_pool
+
+// hands items 0..count-1 to a pool of workers, each pulling the next
+// unclaimed item until there are none left; items that wait() reaches
+// before any worker has claimed them are processed on the caller's thread
+class ordered_work_pool
+{
+public:
+	// construction/destruction
+	ordered_work_pool(ordered_work_client &client);
+	~ordered_work_pool();
+
+	// start the workers on a new list of items
+	void start(int count);
+
+	// wait for an item to be finished; returns false if it raised an exception
+	bool wait(int index);
+
+	// the exception raised by a failed item, as an emu_fatalerror would report it
+	const char *error(int index) const { return m_items[index].error; }
+	int exitcode(int index) const { return m_items[index].exitcode; }
+
+	// stop handing out items and wait for the workers to finish theirs
+	void finish();
+
+private:
+	// per-item state
+	struct item
+	{
+		item() : failed(false), exitcode(0), done(0) { }
+
+		bool                    failed;             // true if processing raised an exception
+		astring                 error;              // message from that exception
+		int                     exitcode;           // exit code for that exception
+		volatile INT32          done;               // set once the item is finished
+	};
+
+	// per-worker state
+	struct worker
+	{
+		worker() : context(NULL), begun(false) { }
+
+		void *                  context;            // the client's state for this worker
+		bool                    begun;              // true once work_begin has been called
+	};
+
+	// internal helpers
+	static void *work_static(void *param, int threadid);
+	void work(worker &state, int limit);
+	void end(worker &state);
+
+	// internal state
+	ordered_work_client &       m_client;
+	osd_work_queue *            m_queue;
+	item *                      m_items;
+	int                         m_count;
+	volatile INT32              m_claimed;
+	worker                      m_inline;           // state for items processed by the caller
+};
+
+
+#endif  /* __WORKPOOL_H__ */
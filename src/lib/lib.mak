@@ -44,6 +44,7 @@ UTILOBJS = \
 	$(LIBOBJ)/util/corefile.o \
 	$(LIBOBJ)/util/corestr.o \
 	$(LIBOBJ)/util/coreutil.o \
+	$(LIBOBJ)/util/dlcapture.o \
 	$(LIBOBJ)/util/flac.o \
 	$(LIBOBJ)/util/harddisk.o \
 	$(LIBOBJ)/util/hashing.o \
@@ -172,9 +172,20 @@ inline void chd_file::file_read(UINT64 offset, void *dest, UINT32 length)
 	if (m_file == NULL)
 		throw CHDERR_NOT_OPEN;
 
-	// seek and read
+	// mapped data is just a copy, and safe from any thread
+	if (m_map != NULL && offset + length <= m_maplength)
+	{
+		memcpy(dest, m_map + offset, length);
+		return;
+	}
+
+	// seek and read; the lock is only present while read-ahead is possible
+	if (m_file_lock != NULL)
+		osd_lock_acquire(m_file_lock);
 	core_fseek(m_file, offset, SEEK_SET);
 	UINT32 count = core_fread(m_file, dest, length);
+	if (m_file_lock != NULL)
+		osd_lock_release(m_file_lock);
 	if (count != length)
 		throw CHDERR_READ_ERROR;
 }
@@ -268,10 +279,19 @@ inline UINT8 chd_file::bits_for_value(UINT64 value)
 
 chd_file::chd_file()
 	: m_file(NULL),
-		m_owns_file(false)
+		m_owns_file(false),
+		m_readahead_queue(NULL),
+		m_readahead_item(NULL),
+		m_readahead_count(0),
+		m_readahead_ticks(0),
+		m_parallel_queue(NULL),
+		m_file_lock(NULL)
 {
 	// reset state
 	memset(m_decompressor, 0, sizeof(m_decompressor));
+	memset(m_readahead_decompressor, 0, sizeof(m_readahead_decompressor));
+	memset(m_parallel_decompressor, 0, sizeof(m_parallel_decompressor));
+	memset(m_parallel_ticks, 0, sizeof(m_parallel_ticks));
 	close();
 }
 
@@ -458,6 +478,27 @@ chd_error chd_file::hunk_info(UINT32 hunknum, chd_codec_type &compressor, UINT32
 }
 
 
+//-------------------------------------------------
+//  hunk_pointer - return a pointer directly into
+//  the mapped file for a hunk stored as-is in an
+//  uncompressed CHD, or NULL if the caller must
+//  read it instead
+//-------------------------------------------------
+
+const void *chd_file::hunk_pointer(UINT32 hunknum)
+{
+	// only uncompressed v5 files store hunks verbatim without a CRC to check
+	if (m_map == NULL || compressed() || m_version < 5 || hunknum >= m_hunkcount)
+		return NULL;
+
+	// unallocated hunks come from the parent or are zero; hunks appended since opening aren't mapped
+	UINT64 blockoffs = UINT64(be_read(m_rawmap + hunknum * 4, 4)) * UINT64(m_hunkbytes);
+	if (blockoffs == 0 || blockoffs + m_hunkbytes > m_maplength)
+		return NULL;
+	return m_map + blockoffs;
+}
+
+
 //-------------------------------------------------
 //  set_raw_sha1 - set our SHA1 values
 //-------------------------------------------------
@@ -668,6 +709,10 @@ chd_error chd_file::open(core_file &file, bool writeable, chd_file *parent)
 
 void chd_file::close()
 {
+	// stop any read-ahead and release the hunk cache before the file goes away
+	hunk_cache_free();
+	memset(&m_cache_stats, 0, sizeof(m_cache_stats));
+
 	// reset file characteristics
 	if (m_owns_file && m_file != NULL)
 		core_fclose(m_file);
@@ -675,6 +720,8 @@ void chd_file::close()
 	m_owns_file = false;
 	m_allow_reads = false;
 	m_allow_writes = false;
+	m_map = NULL;
+	m_maplength = 0;
 
 	// reset core parameters from the header
 	m_version = HEADER_VERSION;
@@ -719,6 +766,79 @@ void chd_file::close()
 //-------------------------------------------------
 
 chd_error chd_file::read_hunk(UINT32 hunknum, void *buffer)
+{
+	// a NULL buffer is used to feed codecs with side effects, so never cache those
+	if (m_hunkcache.count() == 0 || buffer == NULL)
+		return hunk_read_direct(hunknum, buffer);
+
+	chd_error err;
+	const UINT8 *data = hunk_cache_lookup(hunknum, err);
+	if (data == NULL)
+		return err;
+	memcpy(buffer, data, m_hunkbytes);
+	return CHDERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  set_cache_size - configure the multi-hunk
+//  cache used by read-only compressed files;
+//  a size of 0 disables it
+//-------------------------------------------------
+
+chd_error chd_file::set_cache_size(UINT32 hunks, UINT32 readahead)
+{
+	// punt if no file
+	if (m_file == NULL)
+		return CHDERR_NOT_OPEN;
+
+	// only read-only compressed files are cached; the rest are served by the single-hunk cache
+	if (m_allow_writes || !compressed())
+		return CHDERR_NOT_SUPPORTED;
+
+	// throw away the old cache
+	hunk_cache_free();
+	if (hunks == 0)
+		return CHDERR_NONE;
+
+	// need enough slots that a nested self-reference can always find a victim
+	hunks = MAX(hunks, 4);
+	readahead = MIN(readahead, MIN(hunks / 4, MAX_READAHEAD_HUNKS));
+
+	// allocate the entries
+	m_hunkcache_data.resize(hunks * m_hunkbytes);
+	m_hunkcache.resize(hunks);
+	for (UINT32 entnum = 0; entnum < hunks; entnum++)
+	{
+		cache_entry &entry = m_hunkcache[entnum];
+		entry.m_hunknum = ~0;
+		entry.m_lastuse = 0;
+		entry.m_state = CACHE_EMPTY;
+		entry.m_readahead = false;
+		entry.m_readahead_ok = false;
+		entry.m_data = &m_hunkcache_data[entnum * m_hunkbytes];
+	}
+	m_hunkcache_clock = 0;
+	m_hunkcache_last = ~0;
+
+	// file access is shared with read-ahead and parallel reads from here on
+	m_file_lock = osd_lock_alloc();
+	if (m_file_lock == NULL)
+		readahead = 0;
+
+	// the read-ahead queue and codecs are created by the first sequential run
+	m_readahead_hunks = readahead;
+	return CHDERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  hunk_read_direct - read and decompress a
+//  single hunk from the file, bypassing the
+//  multi-hunk cache
+//-------------------------------------------------
+
+chd_error chd_file::hunk_read_direct(UINT32 hunknum, void *buffer)
 {
 	// wrap this for clean reporting
 	try
@@ -956,11 +1076,33 @@ chd_error chd_file::read_bytes(UINT64 offset, void *buffer, UINT32 bytes)
 		UINT32 startoffs = (curhunk == first_hunk) ? (offset % m_hunkbytes) : 0;
 		UINT32 endoffs = (curhunk == last_hunk) ? ((offset + bytes - 1) % m_hunkbytes) : (m_hunkbytes - 1);
 
-		// if it's a full block, just read directly from disk unless it's the cached hunk
+		// long runs of whole hunks are decompressed in parallel when the cache is active
 		chd_error err = CHDERR_NONE;
+		UINT32 full_last = (((offset + bytes) % m_hunkbytes) == 0) ? last_hunk : last_hunk - 1;
+		if (startoffs == 0 && m_hunkcache.count() != 0 && m_file_lock != NULL && curhunk <= full_last && full_last - curhunk + 1 >= PARALLEL_MIN_HUNKS)
+		{
+			UINT32 count = full_last - curhunk + 1;
+			err = read_hunks_parallel(curhunk, count, dest);
+			if (err != CHDERR_NONE)
+				return err;
+			dest += count * m_hunkbytes;
+			curhunk += count - 1;
+			continue;
+		}
+
+		// if it's a full block, just read directly from disk unless it's the cached hunk
 		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && curhunk != m_cachehunk)
 			err = read_hunk(curhunk, dest);
 
+		// partial hunks come straight out of the hunk cache when we have one
+		else if (m_hunkcache.count() != 0)
+		{
+			const UINT8 *data = hunk_cache_lookup(curhunk, err);
+			if (data == NULL)
+				return err;
+			memcpy(dest, &data[startoffs], endoffs + 1 - startoffs);
+		}
+
 		// otherwise, read from the cache
 		else
 		{
@@ -1326,6 +1468,9 @@ chd_error chd_file::codec_configure(chd_codec_type codec, int param, void *confi
 	// wrap this for clean reporting
 	try
 	{
+		// configured codecs carry state the cache can't reproduce, so stop caching
+		hunk_cache_free();
+
 		// find the codec and call its configuration
 		for (int codecnum = 0; codecnum < ARRAY_LENGTH(m_compression); codecnum++)
 			if (m_compression[codecnum] == codec)
@@ -2043,8 +2188,18 @@ chd_error chd_file::open_common(bool writeable)
 		else if (m_parent != NULL)
 			throw CHDERR_INVALID_PARAMETER;
 
+		// map the file if the OSD can, so reads of stored data skip the file layer
+		m_map = reinterpret_cast<const UINT8 *>(core_fmap(m_file, &m_maplength));
+
 		// finish opening the file
 		create_open_common();
+
+		// read-only compressed files get a multi-hunk cache with read-ahead
+		if (!m_allow_writes && compressed())
+		{
+			UINT32 hunks = MIN(MAX(DEFAULT_CACHE_BYTES / m_hunkbytes, 4), MAX_CACHE_HUNKS);
+			set_cache_size(hunks, hunks / 4);
+		}
 		return CHDERR_NONE;
 	}
 
@@ -2295,6 +2450,469 @@ int CLIB_DECL chd_file::metadata_hash_compare(const void *elem1, const void *ele
 }
 
 
+//-------------------------------------------------
+//  hunk_cache_find - return the cache entry
+//  holding the given hunk, if any
+//-------------------------------------------------
+
+chd_file::cache_entry *chd_file::hunk_cache_find(UINT32 hunknum)
+{
+	for (int entnum = 0; entnum < m_hunkcache.count(); entnum++)
+		if (m_hunkcache[entnum].m_hunknum == hunknum && m_hunkcache[entnum].m_state != CACHE_EMPTY)
+			return &m_hunkcache[entnum];
+	return NULL;
+}
+
+
+//-------------------------------------------------
+//  hunk_cache_victim - pick the least recently
+//  used entry that is not busy
+//-------------------------------------------------
+
+chd_file::cache_entry *chd_file::hunk_cache_victim()
+{
+	cache_entry *best = NULL;
+	for (int entnum = 0; entnum < m_hunkcache.count(); entnum++)
+	{
+		cache_entry &entry = m_hunkcache[entnum];
+		if (entry.m_state == CACHE_EMPTY)
+			return &entry;
+		if (entry.m_state == CACHE_VALID && (best == NULL || m_hunkcache_clock - entry.m_lastuse > m_hunkcache_clock - best->m_lastuse))
+			best = &entry;
+	}
+	return best;
+}
+
+
+//-------------------------------------------------
+//  hunk_cache_lookup - return a pointer to the
+//  decompressed data for a hunk, decompressing
+//  it into the cache if needed; returns NULL and
+//  sets err on failure
+//-------------------------------------------------
+
+const UINT8 *chd_file::hunk_cache_lookup(UINT32 hunknum, chd_error &err)
+{
+	// return an error if out of range
+	if (hunknum >= m_hunkcount)
+	{
+		err = CHDERR_HUNK_OUT_OF_RANGE;
+		return NULL;
+	}
+
+	// note whether this continues a sequential run
+	bool sequential = (hunknum == m_hunkcache_last + 1);
+	m_hunkcache_last = hunknum;
+	m_hunkcache_clock++;
+
+	// if the hunk is still being read ahead, wait for it; it may come back empty
+	cache_entry *entry = hunk_cache_find(hunknum);
+	if (entry != NULL && entry->m_state == CACHE_PENDING)
+	{
+		readahead_wait();
+		entry = hunk_cache_find(hunknum);
+	}
+
+	// hits just bump the LRU stamp
+	if (entry != NULL && entry->m_state == CACHE_VALID)
+	{
+		m_cache_stats.hits++;
+		if (entry->m_readahead)
+			m_cache_stats.readahead_hits++;
+		entry->m_readahead = false;
+		entry->m_lastuse = m_hunkcache_clock;
+		if (sequential)
+			readahead_issue(hunknum + 1);
+		err = CHDERR_NONE;
+		return entry->m_data;
+	}
+
+	// find a victim; if everything is busy, let the read-ahead finish first
+	m_cache_stats.misses++;
+	entry = hunk_cache_victim();
+	if (entry == NULL)
+	{
+		readahead_wait();
+		entry = hunk_cache_victim();
+		if (entry == NULL)
+		{
+			err = CHDERR_OUT_OF_MEMORY;
+			return NULL;
+		}
+	}
+
+	// mark it loading so nested self-references don't pick it, then decompress
+	entry->m_hunknum = hunknum;
+	entry->m_state = CACHE_LOADING;
+	entry->m_readahead = false;
+	osd_ticks_t start = osd_ticks();
+	err = hunk_read_direct(hunknum, entry->m_data);
+	m_cache_stats.decompress_ticks += osd_ticks() - start;
+	if (err != CHDERR_NONE)
+	{
+		entry->m_hunknum = ~0;
+		entry->m_state = CACHE_EMPTY;
+		return NULL;
+	}
+	entry->m_state = CACHE_VALID;
+	entry->m_lastuse = m_hunkcache_clock;
+
+	// keep the stream going if this is a sequential reader
+	if (sequential)
+		readahead_issue(hunknum + 1);
+	return entry->m_data;
+}
+
+
+//-------------------------------------------------
+//  hunk_cache_free - stop read-ahead and release
+//  the multi-hunk cache
+//-------------------------------------------------
+
+void chd_file::hunk_cache_free()
+{
+	// nothing may be in flight when we tear things down
+	readahead_wait();
+
+	m_hunkcache.reset();
+	m_hunkcache_data.reset();
+	m_hunkcache_clock = 0;
+	m_hunkcache_last = ~0;
+	m_readahead_hunks = 0;
+	m_readahead_ticks = 0;
+
+	for (int decompnum = 0; decompnum < ARRAY_LENGTH(m_readahead_decompressor); decompnum++)
+	{
+		delete m_readahead_decompressor[decompnum];
+		m_readahead_decompressor[decompnum] = NULL;
+	}
+	m_readahead_compressed.reset();
+
+	if (m_readahead_queue != NULL)
+		osd_work_queue_free(m_readahead_queue);
+	m_readahead_queue = NULL;
+
+	// the parallel readers go with it
+	if (m_parallel_queue != NULL)
+		osd_work_queue_free(m_parallel_queue);
+	m_parallel_queue = NULL;
+	for (int threadnum = 0; threadnum < WORK_MAX_THREADS; threadnum++)
+	{
+		for (int decompnum = 0; decompnum < ARRAY_LENGTH(m_parallel_decompressor[threadnum]); decompnum++)
+		{
+			delete m_parallel_decompressor[threadnum][decompnum];
+			m_parallel_decompressor[threadnum][decompnum] = NULL;
+		}
+		m_parallel_compressed[threadnum].reset();
+		m_parallel_ticks[threadnum] = 0;
+	}
+	m_parallel_job.reset();
+	m_parallel_ok.reset();
+
+	if (m_file_lock != NULL)
+		osd_lock_free(m_file_lock);
+	m_file_lock = NULL;
+}
+
+
+//-------------------------------------------------
+//  readahead_issue - claim cache entries for the
+//  hunks following a sequential read and queue
+//  their decompression
+//-------------------------------------------------
+
+void chd_file::readahead_issue(UINT32 hunknum)
+{
+	// only one batch in flight at a time
+	if (m_readahead_hunks == 0 || m_readahead_item != NULL)
+		return;
+
+	// first sequential run: read-ahead gets its own codecs so it never shares state with the caller's thread
+	if (m_readahead_queue == NULL)
+	{
+		m_readahead_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+		if (m_readahead_queue == NULL)
+		{
+			m_readahead_hunks = 0;
+			return;
+		}
+		for (int decompnum = 0; decompnum < ARRAY_LENGTH(m_compression); decompnum++)
+			m_readahead_decompressor[decompnum] = chd_codec_list::new_decompressor(m_compression[decompnum], *this);
+		m_readahead_compressed.resize(m_hunkbytes);
+	}
+
+	// claim entries for anything not already cached
+	m_readahead_count = 0;
+	for (UINT32 curhunk = hunknum; curhunk < hunknum + m_readahead_hunks && curhunk < m_hunkcount; curhunk++)
+	{
+		if (hunk_cache_find(curhunk) != NULL)
+			continue;
+
+		// references to other hunks or the parent are resolved on the caller's thread
+		UINT8 type = (m_version >= 5) ? m_rawmap[m_mapentrybytes * curhunk] : (m_rawmap[16 * curhunk + 15] & V34_MAP_ENTRY_FLAG_TYPE_MASK);
+		if ((m_version >= 5 && type > COMPRESSION_NONE) || (m_version < 5 && type > V34_MAP_ENTRY_TYPE_MINI))
+			continue;
+
+		cache_entry *entry = hunk_cache_victim();
+		if (entry == NULL)
+			break;
+		entry->m_hunknum = curhunk;
+		entry->m_state = CACHE_PENDING;
+		entry->m_readahead = true;
+		entry->m_readahead_ok = false;
+		entry->m_lastuse = m_hunkcache_clock;
+		m_readahead_entry[m_readahead_count++] = entry;
+	}
+
+	// queue the work
+	if (m_readahead_count == 0)
+		return;
+	m_cache_stats.readahead_issued += m_readahead_count;
+	m_readahead_item = osd_work_item_queue(m_readahead_queue, readahead_static, this, 0);
+
+	// if we couldn't queue it, do the work now
+	if (m_readahead_item == NULL)
+	{
+		readahead_process();
+		readahead_wait();
+	}
+}
+
+
+//-------------------------------------------------
+//  readahead_wait - wait for any read-ahead in
+//  flight and publish its results
+//-------------------------------------------------
+
+void chd_file::readahead_wait()
+{
+	if (m_readahead_item != NULL)
+	{
+		while (!osd_work_item_wait(m_readahead_item, 10 * osd_ticks_per_second())) ;
+		osd_work_item_release(m_readahead_item);
+		m_readahead_item = NULL;
+	}
+
+	// entries the worker could not fill are simply dropped
+	for (UINT32 entnum = 0; entnum < m_readahead_count; entnum++)
+	{
+		cache_entry &entry = *m_readahead_entry[entnum];
+		if (entry.m_readahead_ok)
+			entry.m_state = CACHE_VALID;
+		else
+		{
+			entry.m_hunknum = ~0;
+			entry.m_state = CACHE_EMPTY;
+			entry.m_readahead = false;
+		}
+	}
+	m_readahead_count = 0;
+	m_cache_stats.decompress_ticks += m_readahead_ticks;
+	m_readahead_ticks = 0;
+}
+
+
+//-------------------------------------------------
+//  readahead_static - work item callback for
+//  read-ahead
+//-------------------------------------------------
+
+void *chd_file::readahead_static(void *param, int threadid)
+{
+	reinterpret_cast<chd_file *>(param)->readahead_process();
+	return NULL;
+}
+
+
+//-------------------------------------------------
+//  readahead_process - decompress the claimed
+//  entries; runs on the read-ahead thread and
+//  touches nothing but those entries and its
+//  own codecs
+//-------------------------------------------------
+
+void chd_file::readahead_process()
+{
+	osd_ticks_t start = osd_ticks();
+	for (UINT32 entnum = 0; entnum < m_readahead_count; entnum++)
+	{
+		cache_entry &entry = *m_readahead_entry[entnum];
+		entry.m_readahead_ok = hunk_decode_unshared(entry.m_hunknum, entry.m_data, m_readahead_decompressor, m_readahead_compressed);
+	}
+	m_readahead_ticks += osd_ticks() - start;
+}
+
+
+//-------------------------------------------------
+//  read_hunks_parallel - decompress a run of
+//  whole hunks across the work queue threads
+//-------------------------------------------------
+
+chd_error chd_file::read_hunks_parallel(UINT32 hunknum, UINT32 count, UINT8 *dest)
+{
+	// create the queue the first time through; fall back to serial reads if we can't
+	if (m_parallel_queue == NULL)
+		m_parallel_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	if (m_parallel_queue == NULL)
+	{
+		for (UINT32 index = 0; index < count; index++)
+		{
+			chd_error err = read_hunk(hunknum + index, dest + index * m_hunkbytes);
+			if (err != CHDERR_NONE)
+				return err;
+		}
+		return CHDERR_NONE;
+	}
+
+	// carve the run into small batches so the threads stay evenly loaded
+	UINT32 numjobs = (count + PARALLEL_BATCH_HUNKS - 1) / PARALLEL_BATCH_HUNKS;
+	m_parallel_job.resize(numjobs);
+	m_parallel_ok.resize(count);
+	memset(m_parallel_ok, 0, count);
+	for (UINT32 jobnum = 0; jobnum < numjobs; jobnum++)
+	{
+		parallel_job &job = m_parallel_job[jobnum];
+		job.m_chd = this;
+		job.m_hunknum = hunknum + jobnum * PARALLEL_BATCH_HUNKS;
+		job.m_count = MIN(PARALLEL_BATCH_HUNKS, count - jobnum * PARALLEL_BATCH_HUNKS);
+		job.m_dest = dest + jobnum * PARALLEL_BATCH_HUNKS * m_hunkbytes;
+		job.m_ok = &m_parallel_ok[jobnum * PARALLEL_BATCH_HUNKS];
+	}
+
+	// queue them all and wait
+	osd_work_item_queue_multiple(m_parallel_queue, parallel_decode_static, numjobs, &m_parallel_job[0], sizeof(m_parallel_job[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	while (!osd_work_queue_wait(m_parallel_queue, 10 * osd_ticks_per_second())) ;
+	m_cache_stats.parallel_hunks += count;
+	for (int threadnum = 0; threadnum < WORK_MAX_THREADS; threadnum++)
+	{
+		m_cache_stats.decompress_ticks += m_parallel_ticks[threadnum];
+		m_parallel_ticks[threadnum] = 0;
+	}
+
+	// mop up anything the threads left behind on this thread; this also reports errors
+	for (UINT32 index = 0; index < count; index++)
+		if (!m_parallel_ok[index])
+		{
+			chd_error err = read_hunk(hunknum + index, dest + index * m_hunkbytes);
+			if (err != CHDERR_NONE)
+				return err;
+		}
+	return CHDERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  parallel_decode_static - work item callback
+//  for parallel reads; each thread gets its own
+//  codecs, created on first use
+//-------------------------------------------------
+
+void *chd_file::parallel_decode_static(void *param, int threadid)
+{
+	parallel_job &job = *reinterpret_cast<parallel_job *>(param);
+	chd_file &chd = *job.m_chd;
+	assert(threadid >= 0 && threadid < WORK_MAX_THREADS);
+
+	// set up this thread's codecs
+	chd_decompressor **decompressor = chd.m_parallel_decompressor[threadid];
+	if (chd.m_parallel_compressed[threadid].count() == 0)
+	{
+		for (int decompnum = 0; decompnum < ARRAY_LENGTH(chd.m_compression); decompnum++)
+			decompressor[decompnum] = chd_codec_list::new_decompressor(chd.m_compression[decompnum], chd);
+		chd.m_parallel_compressed[threadid].resize(chd.m_hunkbytes);
+	}
+
+	// decode the batch
+	osd_ticks_t start = osd_ticks();
+	for (UINT32 index = 0; index < job.m_count; index++)
+		job.m_ok[index] = chd.hunk_decode_unshared(job.m_hunknum + index, job.m_dest + index * chd.m_hunkbytes, decompressor, chd.m_parallel_compressed[threadid]);
+	chd.m_parallel_ticks[threadid] += osd_ticks() - start;
+	return NULL;
+}
+
+
+//-------------------------------------------------
+//  hunk_decode_unshared - decompress a single
+//  hunk with a private set of codecs and buffer,
+//  for use off the caller's thread; hunks that
+//  reference other hunks or a parent are left to
+//  the caller's thread
+//-------------------------------------------------
+
+bool chd_file::hunk_decode_unshared(UINT32 hunknum, UINT8 *dest, chd_decompressor **decompressor, UINT8 *compressed)
+{
+	try
+	{
+		UINT8 *rawmap;
+		UINT64 blockoffs;
+		UINT32 blocklen;
+		UINT32 blockcrc;
+		switch (m_version)
+		{
+			// v3/v4 map entries
+			case 3:
+			case 4:
+				rawmap = m_rawmap + 16 * hunknum;
+				blockoffs = be_read(&rawmap[0], 8);
+				blockcrc = be_read(&rawmap[8], 4);
+				switch (rawmap[15] & V34_MAP_ENTRY_FLAG_TYPE_MASK)
+				{
+					case V34_MAP_ENTRY_TYPE_COMPRESSED:
+						blocklen = be_read(&rawmap[12], 2) + (rawmap[14] << 16);
+						file_read(blockoffs, compressed, blocklen);
+						decompressor[0]->decompress(compressed, blocklen, dest, m_hunkbytes);
+						break;
+
+					case V34_MAP_ENTRY_TYPE_UNCOMPRESSED:
+						file_read(blockoffs, dest, m_hunkbytes);
+						break;
+
+					case V34_MAP_ENTRY_TYPE_MINI:
+						be_write(dest, blockoffs, 8);
+						for (UINT32 bytes = 8; bytes < m_hunkbytes; bytes++)
+							dest[bytes] = dest[bytes - 8];
+						break;
+
+					default:
+						return false;
+				}
+				return (rawmap[15] & V34_MAP_ENTRY_FLAG_NO_CRC) || crc32_creator::simple(dest, m_hunkbytes) == blockcrc;
+
+			// v5 map entries; only compressed files are cached
+			case 5:
+				rawmap = m_rawmap + m_mapentrybytes * hunknum;
+				blocklen = be_read(&rawmap[1], 3);
+				blockoffs = be_read(&rawmap[4], 6);
+				blockcrc = be_read(&rawmap[10], 2);
+				switch (rawmap[0])
+				{
+					case COMPRESSION_TYPE_0:
+					case COMPRESSION_TYPE_1:
+					case COMPRESSION_TYPE_2:
+					case COMPRESSION_TYPE_3:
+						file_read(blockoffs, compressed, blocklen);
+						decompressor[rawmap[0]]->decompress(compressed, blocklen, dest, m_hunkbytes);
+						if (decompressor[rawmap[0]]->lossy())
+							return crc16_creator::simple(compressed, blocklen) == blockcrc;
+						return crc16_creator::simple(dest, m_hunkbytes) == blockcrc;
+
+					case COMPRESSION_NONE:
+						file_read(blockoffs, dest, m_hunkbytes);
+						return crc16_creator::simple(dest, m_hunkbytes) == blockcrc;
+				}
+				return false;
+		}
+		return false;
+	}
+
+	// failures are retried on the caller's thread, which reports the error
+	catch (chd_error &)
+	{
+		return false;
+	}
+}
+
+
 
 //**************************************************************************
 //  CHD COMPRESSOR
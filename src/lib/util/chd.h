@@ -281,6 +281,20 @@ enum chd_error
 class chd_codec;
 
 
+// ======================> chd_cache_stats
+
+// counters for the decompressed hunk cache
+struct chd_cache_stats
+{
+	UINT64                  hits;               // reads satisfied from the cache
+	UINT64                  misses;             // reads that had to decompress
+	UINT64                  readahead_issued;   // hunks queued for read-ahead
+	UINT64                  readahead_hits;     // hits on hunks that were read ahead
+	UINT64                  parallel_hunks;     // hunks decompressed by bulk parallel reads
+	osd_ticks_t             decompress_ticks;   // time spent decompressing, all threads
+};
+
+
 // ======================> chd_file
 
 // core file class
@@ -296,6 +310,15 @@ class chd_file
 	static const UINT32 V5_HEADER_SIZE = 124;
 	static const UINT32 MAX_HEADER_SIZE = V5_HEADER_SIZE;
 
+	// hunk cache defaults for read-only compressed files
+	static const UINT32 DEFAULT_CACHE_BYTES = 4 * 1024 * 1024;
+	static const UINT32 MAX_CACHE_HUNKS = 64;
+	static const UINT32 MAX_READAHEAD_HUNKS = 8;
+
+	// bulk reads of this many whole hunks or more are decompressed in parallel
+	static const UINT32 PARALLEL_MIN_HUNKS = 16;
+	static const UINT32 PARALLEL_BATCH_HUNKS = 4;
+
 public:
 	// construction/destruction
 	chd_file();
@@ -319,10 +342,13 @@ public:
 	sha1_t raw_sha1();
 	sha1_t parent_sha1();
 	chd_error hunk_info(UINT32 hunknum, chd_codec_type &compressor, UINT32 &compbytes);
+	const void *hunk_pointer(UINT32 hunknum);
+	const chd_cache_stats &cache_stats() const { return m_cache_stats; }
 
 	// setters
 	void set_raw_sha1(sha1_t rawdata);
 	void set_parent_sha1(sha1_t parent);
+	chd_error set_cache_size(UINT32 hunks, UINT32 readahead);
 
 	// file create
 	chd_error create(const char *filename, UINT64 logicalbytes, UINT32 hunkbytes, UINT32 unitbytes, chd_codec_type compression[4]);
@@ -369,6 +395,28 @@ private:
 	struct metadata_entry;
 	struct metadata_hash;
 
+	// an entry in the decompressed hunk cache
+	struct cache_entry
+	{
+		UINT32              m_hunknum;          // hunk held here, or ~0 if none
+		UINT32              m_lastuse;          // LRU stamp
+		UINT8               m_state;            // CACHE_* state
+		bool                m_readahead;        // filled by read-ahead and not yet used?
+		bool                m_readahead_ok;     // set by the read-ahead thread on success
+		UINT8 *             m_data;             // decompressed data
+	};
+	enum { CACHE_EMPTY, CACHE_LOADING, CACHE_PENDING, CACHE_VALID };
+
+	// a batch of hunks for a parallel read
+	struct parallel_job
+	{
+		chd_file *          m_chd;              // file being read
+		UINT32              m_hunknum;          // first hunk in the batch
+		UINT32              m_count;            // number of hunks
+		UINT8 *             m_dest;             // destination for the first hunk
+		UINT8 *             m_ok;               // per-hunk success flags
+	};
+
 	// inline helpers
 	UINT64 be_read(const UINT8 *base, int numbytes);
 	void be_write(UINT8 *base, UINT64 value, int numbytes);
@@ -397,6 +445,18 @@ private:
 	void metadata_set_previous_next(UINT64 prevoffset, UINT64 nextoffset);
 	void metadata_update_hash();
 	static int CLIB_DECL metadata_hash_compare(const void *elem1, const void *elem2);
+	chd_error hunk_read_direct(UINT32 hunknum, void *buffer);
+	const UINT8 *hunk_cache_lookup(UINT32 hunknum, chd_error &err);
+	cache_entry *hunk_cache_find(UINT32 hunknum);
+	cache_entry *hunk_cache_victim();
+	void hunk_cache_free();
+	void readahead_issue(UINT32 hunknum);
+	void readahead_wait();
+	bool hunk_decode_unshared(UINT32 hunknum, UINT8 *dest, chd_decompressor **decompressor, UINT8 *compressed);
+	static void *readahead_static(void *param, int threadid);
+	void readahead_process();
+	chd_error read_hunks_parallel(UINT32 hunknum, UINT32 count, UINT8 *dest);
+	static void *parallel_decode_static(void *param, int threadid);
 
 	// file characteristics
 	core_file *             m_file;             // handle to the open core file
@@ -432,9 +492,39 @@ private:
 	chd_decompressor *      m_decompressor[4];  // array of decompression codecs
 	dynamic_buffer          m_compressed;       // temporary buffer for compressed data
 
+	// memory-mapped access
+	const UINT8 *           m_map;              // read-only mapping of the file, or NULL
+	UINT64                  m_maplength;        // length of the mapping
+
 	// caching
 	dynamic_buffer          m_cache;            // single-hunk cache for partial reads/writes
 	UINT32                  m_cachehunk;        // which hunk is in the cache?
+
+	// multi-hunk cache for read-only compressed files
+	dynamic_array<cache_entry> m_hunkcache;     // LRU hunk cache entries
+	dynamic_buffer          m_hunkcache_data;   // backing store for the entries
+	UINT32                  m_hunkcache_clock;  // LRU counter
+	UINT32                  m_hunkcache_last;   // last hunk looked up, for spotting sequential reads
+	chd_cache_stats         m_cache_stats;      // hit/miss counters
+
+	// read-ahead
+	UINT32                  m_readahead_hunks;  // number of hunks to read ahead
+	osd_work_queue *        m_readahead_queue;  // queue running the read-ahead
+	osd_work_item *         m_readahead_item;   // read-ahead in flight, if any
+	cache_entry *           m_readahead_entry[MAX_READAHEAD_HUNKS]; // entries claimed by the read-ahead in flight
+	UINT32                  m_readahead_count;  // number of entries claimed
+	chd_decompressor *      m_readahead_decompressor[4]; // codecs private to the read-ahead thread
+	dynamic_buffer          m_readahead_compressed; // compressed data buffer for the read-ahead thread
+	osd_ticks_t             m_readahead_ticks;  // decompression time on the read-ahead thread
+
+	// parallel bulk reads
+	osd_work_queue *        m_parallel_queue;   // queue for parallel decompression
+	chd_decompressor *      m_parallel_decompressor[WORK_MAX_THREADS][4]; // codecs for each thread
+	dynamic_buffer          m_parallel_compressed[WORK_MAX_THREADS]; // compressed data buffer for each thread
+	osd_ticks_t             m_parallel_ticks[WORK_MAX_THREADS]; // decompression time on each thread
+	dynamic_array<parallel_job> m_parallel_job; // batches for the current read
+	dynamic_buffer          m_parallel_ok;      // per-hunk success flags for the current read
+	osd_lock *              m_file_lock;        // serializes file access with the read-ahead thread
 };
 
 
@@ -234,6 +234,43 @@ private:
 };
 
 
+// ======================> chd_lzfast_compressor
+
+// fast LZ compressor; byte-oriented so decompression is little more
+// than a series of memory copies
+class chd_lzfast_compressor : public chd_compressor
+{
+public:
+	// construction/destruction
+	chd_lzfast_compressor(chd_file &chd, UINT32 hunkbytes, bool lossy);
+
+	// core functionality
+	virtual UINT32 compress(const UINT8 *src, UINT32 srclen, UINT8 *dest);
+
+private:
+	// internal helpers
+	static UINT8 *write_length(UINT8 *dest, UINT32 length);
+
+	// internal state
+	static const int HASH_BITS = 14;
+	UINT32                  m_hash[1 << HASH_BITS];
+};
+
+
+// ======================> chd_lzfast_decompressor
+
+// fast LZ decompressor
+class chd_lzfast_decompressor : public chd_decompressor
+{
+public:
+	// construction/destruction
+	chd_lzfast_decompressor(chd_file &chd, UINT32 hunkbytes, bool lossy);
+
+	// core functionality
+	virtual void decompress(const UINT8 *src, UINT32 complen, UINT8 *dest, UINT32 destlen);
+};
+
+
 // ======================> chd_cd_flac_compressor
 
 // CD/FLAC compressor
@@ -466,11 +503,13 @@ const chd_codec_list::codec_entry chd_codec_list::s_codec_list[] =
 	{ CHD_CODEC_LZMA,       false,  "LZMA",                 &chd_codec_list::construct_compressor<chd_lzma_compressor>,     &chd_codec_list::construct_decompressor<chd_lzma_decompressor> },
 	{ CHD_CODEC_HUFFMAN,    false,  "Huffman",              &chd_codec_list::construct_compressor<chd_huffman_compressor>,  &chd_codec_list::construct_decompressor<chd_huffman_decompressor> },
 	{ CHD_CODEC_FLAC,       false,  "FLAC",                 &chd_codec_list::construct_compressor<chd_flac_compressor>,     &chd_codec_list::construct_decompressor<chd_flac_decompressor> },
+	{ CHD_CODEC_LZFAST,     false,  "Fast LZ",              &chd_codec_list::construct_compressor<chd_lzfast_compressor>,   &chd_codec_list::construct_decompressor<chd_lzfast_decompressor> },
 
 	// general codecs with CD frontend
 	{ CHD_CODEC_CD_ZLIB,    false,  "CD Deflate",           &chd_codec_list::construct_compressor<chd_cd_compressor<chd_zlib_compressor, chd_zlib_compressor> >,        &chd_codec_list::construct_decompressor<chd_cd_decompressor<chd_zlib_decompressor, chd_zlib_decompressor> > },
 	{ CHD_CODEC_CD_LZMA,    false,  "CD LZMA",              &chd_codec_list::construct_compressor<chd_cd_compressor<chd_lzma_compressor, chd_zlib_compressor> >,        &chd_codec_list::construct_decompressor<chd_cd_decompressor<chd_lzma_decompressor, chd_zlib_decompressor> > },
 	{ CHD_CODEC_CD_FLAC,    false,  "CD FLAC",              &chd_codec_list::construct_compressor<chd_cd_flac_compressor>,  &chd_codec_list::construct_decompressor<chd_cd_flac_decompressor> },
+	{ CHD_CODEC_CD_LZFAST,  false,  "CD Fast LZ",           &chd_codec_list::construct_compressor<chd_cd_compressor<chd_lzfast_compressor, chd_zlib_compressor> >,      &chd_codec_list::construct_decompressor<chd_cd_decompressor<chd_lzfast_decompressor, chd_zlib_decompressor> > },
 
 	// A/V codecs
 	{ CHD_CODEC_AVHUFF,     false,  "A/V Huffman",          &chd_codec_list::construct_compressor<chd_avhuff_compressor>,   &chd_codec_list::construct_decompressor<chd_avhuff_decompressor> },
@@ -555,10 +594,15 @@ chd_decompressor::chd_decompressor(chd_file &chd, UINT32 hunkbytes, bool lossy)
 //-------------------------------------------------
 
 chd_compressor *chd_codec_list::new_compressor(chd_codec_type type, chd_file &chd)
+{
+	return new_compressor(type, chd, chd.hunk_bytes());
+}
+
+chd_compressor *chd_codec_list::new_compressor(chd_codec_type type, chd_file &chd, UINT32 hunkbytes)
 {
 	// find in the list and construct the class
 	const codec_entry *entry = find_in_list(type);
-	return (entry == NULL) ? NULL : (*entry->m_construct_compressor)(chd, chd.hunk_bytes(), entry->m_lossy);
+	return (entry == NULL) ? NULL : (*entry->m_construct_compressor)(chd, hunkbytes, entry->m_lossy);
 }
 
 
@@ -568,10 +612,15 @@ chd_compressor *chd_codec_list::new_compressor(chd_codec_type type, chd_file &ch
 //-------------------------------------------------
 
 chd_decompressor *chd_codec_list::new_decompressor(chd_codec_type type, chd_file &chd)
+{
+	return new_decompressor(type, chd, chd.hunk_bytes());
+}
+
+chd_decompressor *chd_codec_list::new_decompressor(chd_codec_type type, chd_file &chd, UINT32 hunkbytes)
 {
 	// find in the list and construct the class
 	const codec_entry *entry = find_in_list(type);
-	return (entry == NULL) ? NULL : (*entry->m_construct_decompressor)(chd, chd.hunk_bytes(), entry->m_lossy);
+	return (entry == NULL) ? NULL : (*entry->m_construct_decompressor)(chd, hunkbytes, entry->m_lossy);
 }
 
 
@@ -1355,6 +1404,236 @@ void chd_flac_decompressor::decompress(const UINT8 *src, UINT32 complen, UINT8 *
 
 
 
+//**************************************************************************
+//  FAST LZ COMPRESSOR
+//**************************************************************************
+
+/*
+    The fast LZ stream is a series of sequences, each made of:
+
+        token byte: upper nibble = literal count, lower nibble = match
+                    length minus MIN_MATCH; a nibble of 15 means more
+                    length bytes follow (each adds up to 255; a byte
+                    below 255 terminates)
+        literal bytes
+        16-bit little-endian match offset (1-65535)
+
+    The final sequence carries only literals and ends the stream
+    exactly at the end of the compressed data. Matches never start
+    within the last LZFAST_END_LITERALS bytes of the hunk so the
+    decoder never needs to special-case a trailing match.
+*/
+
+static const UINT32 LZFAST_MIN_MATCH = 4;
+static const UINT32 LZFAST_MAX_OFFSET = 65535;
+static const UINT32 LZFAST_END_LITERALS = 5;
+static const UINT32 LZFAST_MIN_INPUT = 13;
+
+inline UINT32 lzfast_read32(const UINT8 *src)
+{
+	return src[0] | (src[1] << 8) | (src[2] << 16) | (src[3] << 24);
+}
+
+
+//-------------------------------------------------
+//  chd_lzfast_compressor - constructor
+//-------------------------------------------------
+
+chd_lzfast_compressor::chd_lzfast_compressor(chd_file &chd, UINT32 hunkbytes, bool lossy)
+	: chd_compressor(chd, hunkbytes, lossy)
+{
+}
+
+
+//-------------------------------------------------
+//  write_length - write the extension bytes for
+//  a length whose nibble was saturated
+//-------------------------------------------------
+
+UINT8 *chd_lzfast_compressor::write_length(UINT8 *dest, UINT32 length)
+{
+	for ( ; length >= 255; length -= 255)
+		*dest++ = 255;
+	*dest++ = length;
+	return dest;
+}
+
+
+//-------------------------------------------------
+//  compress - compress data using the fast LZ
+//  codec
+//-------------------------------------------------
+
+UINT32 chd_lzfast_compressor::compress(const UINT8 *src, UINT32 srclen, UINT8 *dest)
+{
+	const UINT8 *srcend = src + srclen;
+	const UINT8 *anchor = src;
+	UINT8 *destptr = dest;
+	UINT8 *destend = dest + srclen;
+
+	// greedy parse using a single-entry hash of the next four bytes
+	if (srclen >= LZFAST_MIN_INPUT)
+	{
+		const UINT8 *matchlimit = srcend - LZFAST_END_LITERALS;
+		const UINT8 *searchlimit = srcend - LZFAST_MIN_INPUT + 1;
+		memset(m_hash, 0, sizeof(m_hash));
+
+		const UINT8 *cur = src + 1;
+		while (cur < searchlimit)
+		{
+			// look up and replace the hash entry
+			UINT32 seq = lzfast_read32(cur);
+			UINT32 hash = (seq * 2654435761U) >> (32 - HASH_BITS);
+			const UINT8 *ref = src + m_hash[hash];
+			m_hash[hash] = cur - src;
+
+			// no match: skip ahead faster the longer we go without one
+			if (ref >= cur || cur - ref > LZFAST_MAX_OFFSET || lzfast_read32(ref) != seq)
+			{
+				cur += 1 + ((cur - anchor) >> 6);
+				continue;
+			}
+
+			// extend backwards into the pending literals, then forwards
+			while (cur > anchor && ref > src && cur[-1] == ref[-1])
+				cur--, ref--;
+			const UINT8 *matchend = cur + LZFAST_MIN_MATCH;
+			for (const UINT8 *refend = ref + LZFAST_MIN_MATCH; matchend < matchlimit && *matchend == *refend; matchend++, refend++) ;
+
+			// make sure the worst-case encoding fits
+			UINT32 literals = cur - anchor;
+			UINT32 matchlen = matchend - cur - LZFAST_MIN_MATCH;
+			if (destptr + 1 + literals / 255 + 1 + literals + 2 + matchlen / 255 + 1 > destend)
+				throw CHDERR_COMPRESSION_ERROR;
+
+			// emit the sequence
+			UINT8 *token = destptr++;
+			*token = (MIN(literals, 15) << 4) | MIN(matchlen, 15);
+			if (literals >= 15)
+				destptr = write_length(destptr, literals - 15);
+			memcpy(destptr, anchor, literals);
+			destptr += literals;
+			UINT32 offset = cur - ref;
+			*destptr++ = offset;
+			*destptr++ = offset >> 8;
+			if (matchlen >= 15)
+				destptr = write_length(destptr, matchlen - 15);
+
+			// seed the hash table from inside the match to help the next search
+			anchor = cur = matchend;
+			if (cur - 2 + 4 <= srcend)
+				m_hash[(lzfast_read32(cur - 2) * 2654435761U) >> (32 - HASH_BITS)] = cur - 2 - src;
+		}
+	}
+
+	// emit the final literals
+	UINT32 literals = srcend - anchor;
+	if (destptr + 1 + literals / 255 + 1 + literals >= destend)
+		throw CHDERR_COMPRESSION_ERROR;
+	*destptr++ = MIN(literals, 15) << 4;
+	if (literals >= 15)
+		destptr = write_length(destptr, literals - 15);
+	memcpy(destptr, anchor, literals);
+	destptr += literals;
+	return destptr - dest;
+}
+
+
+
+//**************************************************************************
+//  FAST LZ DECOMPRESSOR
+//**************************************************************************
+
+//-------------------------------------------------
+//  chd_lzfast_decompressor - constructor
+//-------------------------------------------------
+
+chd_lzfast_decompressor::chd_lzfast_decompressor(chd_file &chd, UINT32 hunkbytes, bool lossy)
+	: chd_decompressor(chd, hunkbytes, lossy)
+{
+}
+
+
+//-------------------------------------------------
+//  decompress - decompress data using the fast LZ
+//  codec
+//-------------------------------------------------
+
+void chd_lzfast_decompressor::decompress(const UINT8 *src, UINT32 complen, UINT8 *dest, UINT32 destlen)
+{
+	const UINT8 *srcend = src + complen;
+	UINT8 *destptr = dest;
+	UINT8 *destend = dest + destlen;
+
+	while (1)
+	{
+		// fetch the token and literal count
+		if (src >= srcend)
+			throw CHDERR_DECOMPRESSION_ERROR;
+		UINT32 token = *src++;
+		UINT32 literals = token >> 4;
+		if (literals == 15)
+		{
+			UINT8 extra;
+			do
+			{
+				if (src >= srcend)
+					throw CHDERR_DECOMPRESSION_ERROR;
+				extra = *src++;
+				literals += extra;
+			} while (extra == 255);
+		}
+
+		// copy the literals
+		if (literals > UINT32(srcend - src) || literals > UINT32(destend - destptr))
+			throw CHDERR_DECOMPRESSION_ERROR;
+		memcpy(destptr, src, literals);
+		destptr += literals;
+		src += literals;
+
+		// the last sequence has no match
+		if (src == srcend)
+			break;
+
+		// fetch the offset and match length
+		if (srcend - src < 2)
+			throw CHDERR_DECOMPRESSION_ERROR;
+		UINT32 offset = src[0] | (src[1] << 8);
+		src += 2;
+		UINT32 matchlen = token & 15;
+		if (matchlen == 15)
+		{
+			UINT8 extra;
+			do
+			{
+				if (src >= srcend)
+					throw CHDERR_DECOMPRESSION_ERROR;
+				extra = *src++;
+				matchlen += extra;
+			} while (extra == 255);
+		}
+		matchlen += LZFAST_MIN_MATCH;
+		if (offset == 0 || offset > UINT32(destptr - dest) || matchlen > UINT32(destend - destptr))
+			throw CHDERR_DECOMPRESSION_ERROR;
+
+		// copy the match; overlapping matches must go byte by byte
+		const UINT8 *ref = destptr - offset;
+		if (offset >= matchlen)
+			memcpy(destptr, ref, matchlen);
+		else if (offset == 1)
+			memset(destptr, ref[0], matchlen);
+		else
+			for (UINT32 index = 0; index < matchlen; index++)
+				destptr[index] = ref[index];
+		destptr += matchlen;
+	}
+
+	if (destptr != destend)
+		throw CHDERR_DECOMPRESSION_ERROR;
+}
+
+
+
 //**************************************************************************
 //  CD FLAC COMPRESSOR
 //**************************************************************************
@@ -70,6 +70,8 @@ struct core_file
 	UINT8 *         data;                       /* file data, if RAM-based */
 	UINT64          offset;                     /* current file offset */
 	UINT64          length;                     /* total file length */
+	const void *    map;                        /* read-only mapping of the file, if any */
+	UINT64          maplength;                  /* length of the mapping */
 	text_file_type  text_type;                  /* text output format */
 	char            back_chars[UTF8_CHAR_MAX];  /* buffer to hold characters for ungetc */
 	int             back_char_head;             /* head of ungetc buffer */
@@ -210,6 +212,8 @@ void core_fclose(core_file *file)
 	/* close files and free memory */
 	if (file->zdata != NULL)
 		core_fcompress(file, FCOMPRESS_NONE);
+	if (file->map != NULL)
+		osd_unmap(file->file, file->map, file->maplength);
 	if (file->file != NULL)
 		osd_close(file->file);
 	if (file->data != NULL && file->data_allocated)
@@ -676,12 +680,50 @@ const void *core_fbuffer(core_file *file)
 	}
 
 	/* close the file because we don't need it anymore */
+	if (file->map != NULL)
+		osd_unmap(file->file, file->map, file->maplength);
+	file->map = NULL;
 	osd_close(file->file);
 	file->file = NULL;
 	return file->data;
 }
 
 
+/*-------------------------------------------------
+    core_fmap - return a read-only pointer to the
+    file contents without copying them, mapping
+    the file on first use; returns NULL if the
+    file can't be mapped
+-------------------------------------------------*/
+
+const void *core_fmap(core_file *file, UINT64 *length)
+{
+	/* RAM-based files are already in memory */
+	if (file->data != NULL)
+	{
+		*length = file->length;
+		return file->data;
+	}
+
+	/* compressed streams have nothing meaningful to map */
+	if (file->zdata != NULL || file->file == NULL || file->length == 0)
+		return NULL;
+
+	/* map on first use; the mapping lives until the file is closed */
+	if (file->map == NULL)
+	{
+		if (osd_map(file->file, file->length, &file->map) != FILERR_NONE)
+		{
+			file->map = NULL;
+			return NULL;
+		}
+		file->maplength = file->length;
+	}
+	*length = file->maplength;
+	return file->map;
+}
+
+
 /*-------------------------------------------------
     core_fload - open a file with the specified
     filename, read it into memory, and return a
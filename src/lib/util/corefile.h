@@ -99,6 +99,10 @@ char *core_fgets(char *s, int n, core_file *file);
 /* this function may cause the full file data to be read */
 const void *core_fbuffer(core_file *file);
 
+/* get a read-only pointer to the file data without copying it, if the OSD can map it */
+/* the mapping does not grow if the file is extended after this call */
+const void *core_fmap(core_file *file, UINT64 *length);
+
 /* open a file with the specified filename, read it into memory, and return a pointer */
 file_error core_fload(const char *filename, void **data, UINT32 *length);
 file_error core_fload(const char *filename, dynamic_buffer &data);
@@ -0,0 +1,219 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    dlcapture.c
+
+    Display list capture files for offline replay of 3D hardware.
+
+***************************************************************************/
+
+#include "dlcapture.h"
+#include <string.h>
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+// file header: magic, device version, device name
+static const char DLCAPTURE_MAGIC[8] = { 'M','A','M','E','D','L','C','\0' };
+static const UINT32 DLCAPTURE_HEADER_SIZE = 8 + 4 + DLCAPTURE_DEVICE_LENGTH;
+static const UINT32 DLCAPTURE_RECORD_SIZE = 8;
+
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+static inline void put_u32le(UINT8 *dest, UINT32 value)
+{
+	dest[0] = value >> 0;
+	dest[1] = value >> 8;
+	dest[2] = value >> 16;
+	dest[3] = value >> 24;
+}
+
+static inline UINT32 get_u32le(const UINT8 *base)
+{
+	return base[0] | (base[1] << 8) | (base[2] << 16) | (base[3] << 24);
+}
+
+
+
+//**************************************************************************
+//  DISPLAY LIST WRITER
+//**************************************************************************
+
+//-------------------------------------------------
+//  display_list_writer - constructor
+//-------------------------------------------------
+
+display_list_writer::display_list_writer()
+	: m_file(NULL),
+		m_bytes(0)
+{
+}
+
+
+//-------------------------------------------------
+//  ~display_list_writer - destructor
+//-------------------------------------------------
+
+display_list_writer::~display_list_writer()
+{
+	close();
+}
+
+
+//-------------------------------------------------
+//  open - create a new capture file and write
+//  its header
+//-------------------------------------------------
+
+file_error display_list_writer::open(const char *filename, const char *device, UINT32 version)
+{
+	close();
+
+	file_error filerr = core_fopen(filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, &m_file);
+	if (filerr != FILERR_NONE)
+		return filerr;
+
+	// build the header
+	UINT8 header[DLCAPTURE_HEADER_SIZE];
+	memset(header, 0, sizeof(header));
+	memcpy(&header[0], DLCAPTURE_MAGIC, sizeof(DLCAPTURE_MAGIC));
+	put_u32le(&header[8], version);
+	memcpy(&header[12], device, MIN(strlen(device), DLCAPTURE_DEVICE_LENGTH));
+
+	if (core_fwrite(m_file, header, sizeof(header)) != sizeof(header))
+	{
+		close();
+		return FILERR_FAILURE;
+	}
+	m_bytes = sizeof(header);
+	return FILERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  close - close the capture file
+//-------------------------------------------------
+
+void display_list_writer::close()
+{
+	if (m_file != NULL)
+		core_fclose(m_file);
+	m_file = NULL;
+}
+
+
+//-------------------------------------------------
+//  write - append a record whose payload is the
+//  concatenation of a header and a data block
+//-------------------------------------------------
+
+void display_list_writer::write(UINT32 type, const void *header, UINT32 hlength, const void *data, UINT32 dlength)
+{
+	if (m_file == NULL)
+		return;
+
+	UINT8 record[DLCAPTURE_RECORD_SIZE];
+	put_u32le(&record[0], type);
+	put_u32le(&record[4], hlength + dlength);
+
+	core_fwrite(m_file, record, sizeof(record));
+	if (hlength != 0)
+		core_fwrite(m_file, header, hlength);
+	if (dlength != 0)
+		core_fwrite(m_file, data, dlength);
+	m_bytes += sizeof(record) + hlength + dlength;
+}
+
+
+
+//**************************************************************************
+//  DISPLAY LIST READER
+//**************************************************************************
+
+//-------------------------------------------------
+//  display_list_reader - constructor
+//-------------------------------------------------
+
+display_list_reader::display_list_reader()
+	: m_start(0),
+		m_offset(0),
+		m_version(0)
+{
+	m_device[0] = 0;
+}
+
+
+//-------------------------------------------------
+//  ~display_list_reader - destructor; kept out of
+//  line so the buffer is freed by the allocator
+//  that created it
+//-------------------------------------------------
+
+display_list_reader::~display_list_reader()
+{
+}
+
+
+//-------------------------------------------------
+//  open - load a capture file into memory and
+//  validate its header
+//-------------------------------------------------
+
+file_error display_list_reader::open(const char *filename)
+{
+	core_file *file;
+	file_error filerr = core_fopen(filename, OPEN_FLAG_READ, &file);
+	if (filerr != FILERR_NONE)
+		return filerr;
+
+	// the whole file is kept in memory so replays are not bound by I/O
+	UINT64 size = core_fsize(file);
+	if (size < DLCAPTURE_HEADER_SIZE || size > 0x7fffffff)
+	{
+		core_fclose(file);
+		return FILERR_INVALID_DATA;
+	}
+	m_data.resize(size);
+	UINT32 actual = core_fread(file, m_data, size);
+	core_fclose(file);
+	if (actual != size || memcmp(&m_data[0], DLCAPTURE_MAGIC, sizeof(DLCAPTURE_MAGIC)) != 0)
+		return FILERR_INVALID_DATA;
+
+	// pull out the header fields
+	m_version = get_u32le(&m_data[8]);
+	memcpy(m_device, &m_data[12], DLCAPTURE_DEVICE_LENGTH);
+	m_device[DLCAPTURE_DEVICE_LENGTH] = 0;
+	m_start = m_offset = DLCAPTURE_HEADER_SIZE;
+	return FILERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  next - return the next record; returns false
+//  at the end of the file or on a truncated
+//  record
+//-------------------------------------------------
+
+bool display_list_reader::next(UINT32 &type, const UINT8 *&payload, UINT32 &length)
+{
+	if (m_offset + DLCAPTURE_RECORD_SIZE > m_data.count())
+		return false;
+
+	const UINT8 *record = (const UINT8 *)m_data + m_offset;
+	type = get_u32le(&record[0]);
+	length = get_u32le(&record[4]);
+	if (length > m_data.count() - m_offset - DLCAPTURE_RECORD_SIZE)
+		return false;
+
+	payload = (const UINT8 *)m_data + m_offset + DLCAPTURE_RECORD_SIZE;
+	m_offset += DLCAPTURE_RECORD_SIZE + length;
+	return true;
+}
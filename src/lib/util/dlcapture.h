@@ -0,0 +1,100 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    dlcapture.h
+
+    Display list capture files for offline replay of 3D hardware.
+
+****************************************************************************
+
+    A capture file is a small header followed by a stream of records.
+    Each record is a 32-bit type and a 32-bit payload length followed
+    by the payload itself. Record types and payload layouts belong to
+    the device that wrote the file; the header carries the device name
+    and a device-specific version so a replayer can reject files it
+    does not understand.
+
+    Header and record framing are little-endian. Payloads are written
+    in host format and are only expected to be replayed by a build of
+    the same source tree on the same kind of host.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __DLCAPTURE_H__
+#define __DLCAPTURE_H__
+
+#include "osdcore.h"
+#include "corefile.h"
+#include "coretmpl.h"
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+#define DLCAPTURE_DEVICE_LENGTH     24
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+// ======================> display_list_writer
+
+class display_list_writer
+{
+public:
+	// construction/destruction
+	display_list_writer();
+	~display_list_writer();
+
+	// getters
+	bool is_open() const { return (m_file != NULL); }
+	UINT64 bytes_written() const { return m_bytes; }
+
+	// operations
+	file_error open(const char *filename, const char *device, UINT32 version);
+	void close();
+	void write(UINT32 type, const void *data, UINT32 length) { write(type, data, length, NULL, 0); }
+	void write(UINT32 type, const void *header, UINT32 hlength, const void *data, UINT32 dlength);
+
+private:
+	// internal state
+	core_file *         m_file;
+	UINT64              m_bytes;
+};
+
+
+// ======================> display_list_reader
+
+class display_list_reader
+{
+public:
+	// construction/destruction
+	display_list_reader();
+	~display_list_reader();
+
+	// getters
+	const char *device() const { return m_device; }
+	UINT32 version() const { return m_version; }
+
+	// operations
+	file_error open(const char *filename);
+	void rewind() { m_offset = m_start; }
+	bool next(UINT32 &type, const UINT8 *&payload, UINT32 &length);
+
+private:
+	// internal state
+	dynamic_buffer      m_data;
+	UINT32              m_start;
+	UINT32              m_offset;
+	UINT32              m_version;
+	char                m_device[DLCAPTURE_DEVICE_LENGTH + 1];
+};
+
+
+#endif
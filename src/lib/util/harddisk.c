@@ -123,3 +123,19 @@ UINT32 hard_disk_write(hard_disk_file *file, UINT32 lbasector, const void *buffe
 	chd_error err = file->chd->write_units(lbasector, buffer);
 	return (err == CHDERR_NONE);
 }
+
+
+/*-------------------------------------------------
+    hard_disk_sector_pointer - return a read-only
+    pointer to a sector's data without copying it,
+    or NULL if hard_disk_read must be used; the
+    pointer stays valid until the disk is closed
+-------------------------------------------------*/
+
+const void *hard_disk_sector_pointer(hard_disk_file *file, UINT32 lbasector)
+{
+	UINT64 offset = UINT64(lbasector) * file->info.sectorbytes;
+	UINT32 hunkbytes = file->chd->hunk_bytes();
+	const UINT8 *hunk = reinterpret_cast<const UINT8 *>(file->chd->hunk_pointer(offset / hunkbytes));
+	return (hunk != NULL) ? hunk + offset % hunkbytes : NULL;
+}
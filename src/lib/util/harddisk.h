@@ -45,5 +45,6 @@ hard_disk_info *hard_disk_get_info(hard_disk_file *file);
 
 UINT32 hard_disk_read(hard_disk_file *file, UINT32 lbasector, void *buffer);
 UINT32 hard_disk_write(hard_disk_file *file, UINT32 lbasector, const void *buffer);
+const void *hard_disk_sector_pointer(hard_disk_file *file, UINT32 lbasector);
 
 #endif  /* __HARDDISK_H__ */
@@ -11,6 +11,15 @@
 #include "hashing.h"
 #include "zlib.h"
 
+// the x86 backends need per-function target attributes for their intrinsics
+#if (defined(__i386__) || defined(__x86_64__)) && (defined(__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define HASHING_X86     1
+#include <cpuid.h>
+#include <immintrin.h>
+#else
+#define HASHING_X86     0
+#endif
+
 
 //**************************************************************************
 //  CONSTANTS
@@ -45,6 +54,460 @@ inline int char_to_hex(char c)
 
 
 
+//**************************************************************************
+//  PORTABLE BACKENDS
+//**************************************************************************
+
+//-------------------------------------------------
+//  crc32_zlib - CRC-32 via zlib
+//-------------------------------------------------
+
+static UINT32 crc32_zlib(UINT32 crc, const UINT8 *data, UINT32 length)
+{
+	return crc32(crc, reinterpret_cast<const Bytef *>(data), length);
+}
+
+
+
+#if HASHING_X86
+
+//**************************************************************************
+//  X86 BACKENDS
+//**************************************************************************
+
+//-------------------------------------------------
+//  cpu_features - return the relevant CPUID bits
+//-------------------------------------------------
+
+enum
+{
+	CPU_SSE41   = 0x01,
+	CPU_PCLMUL  = 0x02,
+	CPU_SHA     = 0x04
+};
+
+static UINT32 cpu_features()
+{
+	unsigned int eax, ebx, ecx, edx;
+	UINT32 result = 0;
+	if (__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+	{
+		if (ecx & (1 << 19)) result |= CPU_SSE41;
+		if (ecx & (1 << 1)) result |= CPU_PCLMUL;
+	}
+	if (__get_cpuid_max(0, NULL) >= 7)
+	{
+		__cpuid_count(7, 0, eax, ebx, ecx, edx);
+		if (ebx & (1 << 29)) result |= CPU_SHA;
+	}
+	return result;
+}
+
+
+//-------------------------------------------------
+//  crc32_pclmul - CRC-32 by folding 64 bytes at
+//  a time with carry-less multiplies, then a
+//  Barrett reduction; constants are for the
+//  reflected gzip polynomial
+//-------------------------------------------------
+
+__attribute__((target("pclmul,sse4.1")))
+static UINT32 crc32_pclmul(UINT32 crc, const UINT8 *data, UINT32 length)
+{
+	// short or trailing data is left to zlib
+	if (length < 64)
+		return crc32_zlib(crc, data, length);
+	UINT32 tail = length & 15;
+	length -= tail;
+
+	const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596LL, 0x0154442bd4LL);
+	const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009eLL, 0x01751997d0LL);
+	const __m128i k5k0 = _mm_set_epi64x(0, 0x0163cd6124LL);
+	const __m128i poly = _mm_set_epi64x(0x01f7011641LL, 0x01db710641LL);
+	const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+	// load the first 64 bytes and fold in the starting CRC
+	__m128i x1 = _mm_loadu_si128((const __m128i *)(data + 0x00));
+	__m128i x2 = _mm_loadu_si128((const __m128i *)(data + 0x10));
+	__m128i x3 = _mm_loadu_si128((const __m128i *)(data + 0x20));
+	__m128i x4 = _mm_loadu_si128((const __m128i *)(data + 0x30));
+	x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(~crc));
+	data += 64;
+	length -= 64;
+
+	// fold 64 bytes at a time
+	while (length >= 64)
+	{
+		__m128i x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+		__m128i x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+		__m128i x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+		__m128i x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+		x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+		x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+		x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i *)(data + 0x00)));
+		x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i *)(data + 0x10)));
+		x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i *)(data + 0x20)));
+		x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i *)(data + 0x30)));
+		data += 64;
+		length -= 64;
+	}
+
+	// fold the four lanes down into one, then any remaining 16-byte blocks
+	x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), _mm_clmulepi64_si128(x1, k3k4, 0x00)), x2);
+	x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), _mm_clmulepi64_si128(x1, k3k4, 0x00)), x3);
+	x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), _mm_clmulepi64_si128(x1, k3k4, 0x00)), x4);
+	while (length >= 16)
+	{
+		x2 = _mm_loadu_si128((const __m128i *)data);
+		x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), _mm_clmulepi64_si128(x1, k3k4, 0x00)), x2);
+		data += 16;
+		length -= 16;
+	}
+
+	// fold 128 bits to 64
+	x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+	x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+	x2 = _mm_srli_si128(x1, 4);
+	x1 = _mm_and_si128(x1, mask32);
+	x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k5k0, 0x00), x2);
+
+	// Barrett reduce to 32 bits
+	x2 = _mm_and_si128(x1, mask32);
+	x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+	x2 = _mm_and_si128(x2, mask32);
+	x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+	crc = ~UINT32(_mm_extract_epi32(x1, 1));
+
+	return (tail != 0) ? crc32_zlib(crc, data, tail) : crc;
+}
+
+
+//-------------------------------------------------
+//  sha1_shani - SHA-1 using the SHA extensions
+//-------------------------------------------------
+
+__attribute__((target("sha,sse4.1")))
+static void sha1_shani(UINT32 *digest, const UINT8 *data, unsigned blocks)
+{
+	const __m128i mask = _mm_set_epi64x(0x0001020304050607LL, 0x08090a0b0c0d0e0fLL);
+	__m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)digest), 0x1b);
+	__m128i e0 = _mm_set_epi32(digest[4], 0, 0, 0);
+	__m128i e1, msg0, msg1, msg2, msg3;
+
+	for ( ; blocks != 0; blocks--, data += 64)
+	{
+		__m128i abcd_save = abcd;
+		__m128i e0_save = e0;
+
+		// rounds 0-3
+		msg0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 0)), mask);
+		e0 = _mm_add_epi32(e0, msg0);
+		e1 = abcd;
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+		// rounds 4-7
+		msg1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 16)), mask);
+		e1 = _mm_sha1nexte_epu32(e1, msg1);
+		e0 = abcd;
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+		msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+
+		// rounds 8-11
+		msg2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 32)), mask);
+		e0 = _mm_sha1nexte_epu32(e0, msg2);
+		e1 = abcd;
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+		msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+		msg0 = _mm_xor_si128(msg0, msg2);
+
+		// rounds 12-15
+		msg3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 48)), mask);
+		e1 = _mm_sha1nexte_epu32(e1, msg3);
+		e0 = abcd;
+		msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+		msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+		msg1 = _mm_xor_si128(msg1, msg3);
+
+		// rounds 16-19
+		e0 = _mm_sha1nexte_epu32(e0, msg0);
+		e1 = abcd;
+		msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+		msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+		msg2 = _mm_xor_si128(msg2, msg0);
+
+		// rounds 20-23
+		e1 = _mm_sha1nexte_epu32(e1, msg1);
+		e0 = abcd;
+		msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+		msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+		msg3 = _mm_xor_si128(msg3, msg1);
+
+		// rounds 24-27
+		e0 = _mm_sha1nexte_epu32(e0, msg2);
+		e1 = abcd;
+		msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 1);
+		msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+		msg0 = _mm_xor_si128(msg0, msg2);
+
+		// rounds 28-31
+		e1 = _mm_sha1nexte_epu32(e1, msg3);
+		e0 = abcd;
+		msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+		msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+		msg1 = _mm_xor_si128(msg1, msg3);
+
+		// rounds 32-35
+		e0 = _mm_sha1nexte_epu32(e0, msg0);
+		e1 = abcd;
+		msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 1);
+		msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+		msg2 = _mm_xor_si128(msg2, msg0);
+
+		// rounds 36-39
+		e1 = _mm_sha1nexte_epu32(e1, msg1);
+		e0 = abcd;
+		msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+		msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+		msg3 = _mm_xor_si128(msg3, msg1);
+
+		// rounds 40-43
+		e0 = _mm_sha1nexte_epu32(e0, msg2);
+		e1 = abcd;
+		msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+		msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+		msg0 = _mm_xor_si128(msg0, msg2);
+
+		// rounds 44-47
+		e1 = _mm_sha1nexte_epu32(e1, msg3);
+		e0 = abcd;
+		msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 2);
+		msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+		msg1 = _mm_xor_si128(msg1, msg3);
+
+		// rounds 48-51
+		e0 = _mm_sha1nexte_epu32(e0, msg0);
+		e1 = abcd;
+		msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+		msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+		msg2 = _mm_xor_si128(msg2, msg0);
+
+		// rounds 52-55
+		e1 = _mm_sha1nexte_epu32(e1, msg1);
+		e0 = abcd;
+		msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 2);
+		msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+		msg3 = _mm_xor_si128(msg3, msg1);
+
+		// rounds 56-59
+		e0 = _mm_sha1nexte_epu32(e0, msg2);
+		e1 = abcd;
+		msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+		msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+		msg0 = _mm_xor_si128(msg0, msg2);
+
+		// rounds 60-63
+		e1 = _mm_sha1nexte_epu32(e1, msg3);
+		e0 = abcd;
+		msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+		msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+		msg1 = _mm_xor_si128(msg1, msg3);
+
+		// rounds 64-67
+		e0 = _mm_sha1nexte_epu32(e0, msg0);
+		e1 = abcd;
+		msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+		msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+		msg2 = _mm_xor_si128(msg2, msg0);
+
+		// rounds 68-71
+		e1 = _mm_sha1nexte_epu32(e1, msg1);
+		e0 = abcd;
+		msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+		msg3 = _mm_xor_si128(msg3, msg1);
+
+		// rounds 72-75
+		e0 = _mm_sha1nexte_epu32(e0, msg2);
+		e1 = abcd;
+		msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+
+		// rounds 76-79
+		e1 = _mm_sha1nexte_epu32(e1, msg3);
+		e0 = abcd;
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+		// combine state
+		e0 = _mm_sha1nexte_epu32(e0, e0_save);
+		abcd = _mm_add_epi32(abcd, abcd_save);
+	}
+
+	_mm_storeu_si128((__m128i *)digest, _mm_shuffle_epi32(abcd, 0x1b));
+	digest[4] = _mm_extract_epi32(e0, 3);
+}
+
+#endif
+
+
+
+//**************************************************************************
+//  BACKEND SELECTION
+//**************************************************************************
+
+typedef UINT32 (*crc32_func)(UINT32 crc, const UINT8 *data, UINT32 length);
+
+struct hashing_backend_entry
+{
+	const char *    name;               // name for display
+	UINT32          features;           // CPU features required
+	void *          func;               // implementation; NULL for SHA-1 means portable
+};
+
+#if !HASHING_X86
+enum { CPU_SSE41 = 0, CPU_PCLMUL = 0, CPU_SHA = 0 };
+static UINT32 cpu_features() { return 0; }
+#endif
+
+// backends in order from portable to fastest; each one's features are
+// checked on their own, since a faster one need not have a superset of
+// the features of a slower one
+static const hashing_backend_entry s_crc32_backends[] =
+{
+	{ "zlib",       0,                      (void *)crc32_zlib },
+#if HASHING_X86
+	{ "pclmulqdq",  CPU_PCLMUL | CPU_SSE41, (void *)crc32_pclmul },
+#endif
+};
+
+static const hashing_backend_entry s_sha1_backends[] =
+{
+	{ "portable",   0,                      NULL },
+#if HASHING_X86
+	{ "sha-ni",     CPU_SHA | CPU_SSE41,    (void *)sha1_shani },
+#endif
+};
+
+// the CRC-32 backend starts out portable so that it works even during static initialization
+static crc32_func s_crc32 = crc32_zlib;
+static int s_current[2] = { 0, 0 };
+
+
+//-------------------------------------------------
+//  backend_list - return the list of backends
+//  for an algorithm
+//-------------------------------------------------
+
+static const hashing_backend_entry *backend_list(hashing_backend::algorithm alg, int &count)
+{
+	if (alg == hashing_backend::ALGORITHM_CRC32)
+	{
+		count = ARRAY_LENGTH(s_crc32_backends);
+		return s_crc32_backends;
+	}
+	count = ARRAY_LENGTH(s_sha1_backends);
+	return s_sha1_backends;
+}
+
+
+//-------------------------------------------------
+//  supported_backend - return the given backend
+//  among those whose required CPU features are
+//  all present, or NULL
+//-------------------------------------------------
+
+static const hashing_backend_entry *supported_backend(hashing_backend::algorithm alg, int index)
+{
+	int total;
+	const hashing_backend_entry *list = backend_list(alg, total);
+	UINT32 features = cpu_features();
+	for (int entry = 0; entry < total && index >= 0; entry++)
+		if ((list[entry].features & ~features) == 0 && index-- == 0)
+			return &list[entry];
+	return NULL;
+}
+
+
+//-------------------------------------------------
+//  count - return the number of backends this
+//  CPU supports
+//-------------------------------------------------
+
+int hashing_backend::count(algorithm alg)
+{
+	int result = 0;
+	while (supported_backend(alg, result) != NULL)
+		result++;
+	return result;
+}
+
+
+//-------------------------------------------------
+//  name - return the name of a backend
+//-------------------------------------------------
+
+const char *hashing_backend::name(algorithm alg, int index)
+{
+	const hashing_backend_entry *entry = supported_backend(alg, index);
+	return (entry != NULL) ? entry->name : NULL;
+}
+
+
+//-------------------------------------------------
+//  current - return the backend in use
+//-------------------------------------------------
+
+int hashing_backend::current(algorithm alg)
+{
+	return s_current[alg];
+}
+
+
+//-------------------------------------------------
+//  select - switch to a different backend; not
+//  to be done while anything is being hashed
+//-------------------------------------------------
+
+void hashing_backend::select(algorithm alg, int index)
+{
+	const hashing_backend_entry *entry = supported_backend(alg, index);
+	if (entry == NULL)
+		return;
+	s_current[alg] = index;
+	if (alg == ALGORITHM_CRC32)
+		s_crc32 = (crc32_func)entry->func;
+	else
+		sha1_set_blocks_func((sha1_blocks_func)entry->func);
+}
+
+
+// pick the fastest backends at startup
+static struct hashing_backend_init
+{
+	hashing_backend_init()
+	{
+		hashing_backend::select(hashing_backend::ALGORITHM_CRC32, hashing_backend::count(hashing_backend::ALGORITHM_CRC32) - 1);
+		hashing_backend::select(hashing_backend::ALGORITHM_SHA1, hashing_backend::count(hashing_backend::ALGORITHM_SHA1) - 1);
+	}
+} s_hashing_backend_init;
+
+
+
 //**************************************************************************
 //  SHA-1 HELPERS
 //**************************************************************************
@@ -179,7 +642,7 @@ const char *crc32_t::as_string(astring &buffer) const
 
 void crc32_creator::append(const void *data, UINT32 length)
 {
-	m_accum.m_raw = crc32(m_accum, reinterpret_cast<const Bytef *>(data), length);
+	m_accum.m_raw = (*s_crc32)(m_accum, reinterpret_cast<const UINT8 *>(data), length);
 }
 
 
@@ -216,4 +216,29 @@ protected:
 };
 
 
+
+// ======================> hashing_backend
+
+// CRC-32 and SHA-1 have alternate implementations using CPU extensions;
+// the fastest one the CPU supports is selected at startup
+class hashing_backend
+{
+public:
+	// the algorithms with selectable backends
+	enum algorithm
+	{
+		ALGORITHM_CRC32,
+		ALGORITHM_SHA1
+	};
+
+	// backends supported by this CPU, numbered from 0 (portable) up to the fastest
+	static int count(algorithm alg);
+	static const char *name(algorithm alg, int index);
+
+	// the backend in use
+	static int current(algorithm alg);
+	static void select(algorithm alg, int index);
+};
+
+
 #endif // __HASHING_H__
@@ -6,6 +6,25 @@
 
     PNG reading functions.
 
+****************************************************************************
+
+    When writing, each row gets the filter whose output has the lowest
+    byte entropy. Palettized images are left unfiltered, as the PNG
+    specification recommends, and so are RGB images of 256 colours or
+    fewer, which covers most 2D games; their repeated tiles make longer
+    matches unfiltered.
+
+    Filtered rows are mostly small residuals, which run-length matching
+    compresses about as well as a full match search in a fraction of the
+    time. They are deflated with Z_RLE at every level but the smallest,
+    which is left to search for longer matches for as long as it takes.
+
+    Large images are split into bands of rows that are deflated
+    independently and joined into one zlib stream. Each band is primed
+    with the last 32k of the one before it, so the output is within a
+    fraction of a percent of a single stream. When the caller supplies a
+    work queue the bands are filtered and deflated in parallel.
+
 ***************************************************************************/
 
 #include <math.h>
@@ -17,6 +36,16 @@
 #include <new>
 
 
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+#define MAX_WRITE_BANDS     8           /* most bands an image is split into */
+#define MIN_BAND_BYTES      65536       /* smallest band worth a separate thread */
+#define WINDOW_BYTES        32768       /* deflate window, primed from the previous band */
+
+
+
 /***************************************************************************
     TYPE DEFINITIONS
 ***************************************************************************/
@@ -39,6 +68,26 @@ struct png_private
 };
 
 
+struct png_write_band
+{
+	const UINT8 *       image;          /* unfiltered image, with a filter byte per row */
+	UINT8 *             filtered;       /* filtered image, same layout */
+	UINT32              rowbytes;
+	int                 bpp;
+	int                 choose_filter;  /* pick a filter per row, or leave them unfiltered */
+	const double *      entropy;        /* -count * log2(count / rowbytes), by count */
+	int                 level;
+	int                 strategy;       /* zlib strategy for the level and filtering */
+	UINT32              startrow;       /* rows in this band */
+	UINT32              rows;
+	int                 last;           /* is this the final band? */
+	UINT8 *             output;         /* raw deflate data, allocated */
+	UINT32              outlength;
+	UINT32              adler;          /* adler32 of the filtered band */
+	png_error           error;
+};
+
+
 
 /***************************************************************************
     GLOBAL VARIABLES
@@ -778,88 +827,314 @@ static png_error write_chunk(core_file *fp, const UINT8 *data, UINT32 type, UINT
 
 
 /*-------------------------------------------------
-    write_deflated_chunk - write an in-memory
-    chunk to the given file by deflating it
+    filter_band - choose and apply a filter to
+    each row of a band
 -------------------------------------------------*/
 
-static png_error write_deflated_chunk(core_file *fp, UINT8 *data, UINT32 type, UINT32 length)
+static void *filter_band(void *param, int threadid)
 {
-	UINT64 lengthpos = core_ftell(fp);
-	UINT8 tempbuff[8192];
-	UINT32 zlength = 0;
+	png_write_band *band = (png_write_band *)param;
+	UINT32 stride = band->rowbytes + 1;
+	UINT32 y;
+	int x;
+
+	for (y = band->startrow; y < band->startrow + band->rows; y++)
+	{
+		const UINT8 *src = band->image + y * stride + 1;
+		const UINT8 *prev = (y == 0) ? NULL : src - stride;
+		UINT8 *dst = band->filtered + y * stride;
+		int type = PNG_PF_None;
+
+		/* score every filter by the entropy of its output */
+		if (band->choose_filter)
+		{
+			UINT32 histogram[5][256];
+			double best = 0;
+			int filter;
+
+			memset(histogram, 0, sizeof(histogram));
+			for (x = 0; x < band->rowbytes; x++)
+			{
+				INT32 a = (x < band->bpp) ? 0 : src[x - band->bpp];
+				INT32 b = (prev == NULL) ? 0 : prev[x];
+				INT32 c = (x < band->bpp || prev == NULL) ? 0 : prev[x - band->bpp];
+				INT32 prediction = a + b - c;
+				INT32 da = abs(prediction - a);
+				INT32 db = abs(prediction - b);
+				INT32 dc = abs(prediction - c);
+				INT32 paeth = (da <= db && da <= dc) ? a : (db <= dc) ? b : c;
+
+				histogram[PNG_PF_None][src[x]]++;
+				histogram[PNG_PF_Sub][(UINT8)(src[x] - a)]++;
+				histogram[PNG_PF_Up][(UINT8)(src[x] - b)]++;
+				histogram[PNG_PF_Average][(UINT8)(src[x] - (a + b) / 2)]++;
+				histogram[PNG_PF_Paeth][(UINT8)(src[x] - paeth)]++;
+			}
+			for (filter = PNG_PF_None; filter <= PNG_PF_Paeth; filter++)
+			{
+				double cost = 0;
+				for (x = 0; x < 256; x++)
+					cost += band->entropy[histogram[filter][x]];
+				if (filter == PNG_PF_None || cost < best)
+				{
+					best = cost;
+					type = filter;
+				}
+			}
+		}
+
+		/* then apply the winner */
+		*dst++ = type;
+		for (x = 0; x < band->rowbytes; x++)
+		{
+			INT32 a = (x < band->bpp) ? 0 : src[x - band->bpp];
+			INT32 b = (prev == NULL) ? 0 : prev[x];
+			INT32 c = (x < band->bpp || prev == NULL) ? 0 : prev[x - band->bpp];
+			switch (type)
+			{
+				case PNG_PF_None:       *dst++ = src[x];                    break;
+				case PNG_PF_Sub:        *dst++ = src[x] - a;                break;
+				case PNG_PF_Up:         *dst++ = src[x] - b;                break;
+				case PNG_PF_Average:    *dst++ = src[x] - (a + b) / 2;      break;
+				case PNG_PF_Paeth:
+				{
+					INT32 prediction = a + b - c;
+					INT32 da = abs(prediction - a);
+					INT32 db = abs(prediction - b);
+					INT32 dc = abs(prediction - c);
+					*dst++ = src[x] - ((da <= db && da <= dc) ? a : (db <= dc) ? b : c);
+					break;
+				}
+			}
+		}
+	}
+	return NULL;
+}
+
+
+/*-------------------------------------------------
+    deflate_band - compress a filtered band to
+    raw deflate data, ending on a byte boundary
+    so the bands can be joined
+-------------------------------------------------*/
+
+static void *deflate_band(void *param, int threadid)
+{
+	png_write_band *band = (png_write_band *)param;
+	UINT32 stride = band->rowbytes + 1;
+	UINT8 *data = band->filtered + band->startrow * stride;
+	UINT32 length = band->rows * stride;
+	UINT32 bound;
 	z_stream stream;
-	UINT32 crc;
 	int zerr;
 
-	/* stuff the length/type into the buffer */
-	put_32bit(tempbuff + 0, length);
-	put_32bit(tempbuff + 4, type);
-	crc = crc32(0, tempbuff + 4, 4);
+	/* initialize a raw stream, primed with the end of the previous band */
+	memset(&stream, 0, sizeof(stream));
+	if (deflateInit2(&stream, band->level, Z_DEFLATED, -MAX_WBITS, 8, band->strategy) != Z_OK)
+	{
+		band->error = PNGERR_COMPRESS_ERROR;
+		return NULL;
+	}
+	if (band->startrow != 0)
+	{
+		UINT32 dictlength = MIN(band->startrow * stride, WINDOW_BYTES);
+		deflateSetDictionary(&stream, data - dictlength, dictlength);
+	}
 
-	/* write that data */
-	if (core_fwrite(fp, tempbuff, 8) != 8)
-		return PNGERR_FILE_ERROR;
+	/* leave room for the flush marker */
+	bound = deflateBound(&stream, length) + 16;
+	band->output = (UINT8 *)malloc(bound);
+	if (band->output == NULL)
+	{
+		deflateEnd(&stream);
+		band->error = PNGERR_OUT_OF_MEMORY;
+		return NULL;
+	}
 
-	/* initialize the stream */
-	memset(&stream, 0, sizeof(stream));
+	/* compress it all at once; only the last band ends the stream */
 	stream.next_in = data;
 	stream.avail_in = length;
-	zerr = deflateInit(&stream, Z_DEFAULT_COMPRESSION);
-	if (zerr != Z_OK)
-		return PNGERR_COMPRESS_ERROR;
+	stream.next_out = band->output;
+	stream.avail_out = bound;
+	zerr = deflate(&stream, band->last ? Z_FINISH : Z_SYNC_FLUSH);
+	if (band->last ? (zerr != Z_STREAM_END) : (zerr != Z_OK || stream.avail_in != 0 || stream.avail_out == 0))
+		band->error = PNGERR_COMPRESS_ERROR;
+	band->outlength = bound - stream.avail_out;
+	deflateEnd(&stream);
+
+	band->adler = adler32(adler32(0, Z_NULL, 0), data, length);
+	return NULL;
+}
 
-	/* now loop until we run out of data */
-	for ( ; ; )
-	{
-		/* compress this chunk */
-		stream.next_out = tempbuff;
-		stream.avail_out = sizeof(tempbuff);
-		zerr = deflate(&stream, Z_FINISH);
 
-		/* if there's data to write, do it */
-		if (stream.avail_out < sizeof(tempbuff))
+/*-------------------------------------------------
+    has_few_colors - does an 8-bit RGB or RGBA
+    image use 256 colours or fewer?
+-------------------------------------------------*/
+
+static int has_few_colors(const png_info *pnginfo)
+{
+	UINT32 rowbytes = compute_rowbytes(pnginfo);
+	int bpp = compute_bpp(pnginfo);
+	UINT32 color[1024];
+	UINT8 used[1024];
+	int colors = 0;
+	UINT32 x, y;
+
+	memset(used, 0, sizeof(used));
+	for (y = 0; y < pnginfo->height; y++)
+	{
+		const UINT8 *src = pnginfo->image + y * (rowbytes + 1) + 1;
+		for (x = 0; x < rowbytes; x += bpp)
 		{
-			int bytes = sizeof(tempbuff) - stream.avail_out;
-			if (core_fwrite(fp, tempbuff, bytes) != bytes)
+			UINT32 value = (src[x] << 16) | (src[x + 1] << 8) | src[x + 2] | ((bpp == 4) ? (src[x + 3] << 24) : 0);
+			UINT32 hash = (value * 2654435761U) >> 22;
+
+			/* find it or add it, with linear probing */
+			while (used[hash] && color[hash] != value)
+				hash = (hash + 1) & 1023;
+			if (!used[hash])
 			{
-				deflateEnd(&stream);
-				return PNGERR_FILE_ERROR;
+				if (++colors > 256)
+					return FALSE;
+				used[hash] = 1;
+				color[hash] = value;
 			}
-			crc = crc32(crc, tempbuff, bytes);
-			zlength += bytes;
 		}
+	}
+	return TRUE;
+}
 
-		/* stop at the end of the stream */
-		if (zerr == Z_STREAM_END)
-			break;
 
-		/* other errors are fatal */
-		if (zerr != Z_OK)
+/*-------------------------------------------------
+    run_bands - call a function for each band,
+    on the work queue if there is one
+-------------------------------------------------*/
+
+static void run_bands(osd_work_queue *queue, png_write_band *band, int bands, osd_work_callback callback)
+{
+	osd_work_item *item[MAX_WRITE_BANDS];
+	int bandnum;
+
+	for (bandnum = 0; bandnum < bands; bandnum++)
+	{
+		item[bandnum] = (queue != NULL && bands > 1) ? osd_work_item_queue(queue, callback, &band[bandnum], 0) : NULL;
+		if (item[bandnum] == NULL)
+			(*callback)(&band[bandnum], 0);
+	}
+
+	for (bandnum = 0; bandnum < bands; bandnum++)
+		if (item[bandnum] != NULL)
 		{
-			deflateEnd(&stream);
-			return PNGERR_COMPRESS_ERROR;
+			while (!osd_work_item_wait(item[bandnum], osd_ticks_per_second()))
+				;
+			osd_work_item_release(item[bandnum]);
 		}
+}
+
+
+/*-------------------------------------------------
+    write_image_chunk - filter and deflate the
+    image and write it as a single IDAT chunk
+-------------------------------------------------*/
+
+static png_error write_image_chunk(core_file *fp, png_info *pnginfo)
+{
+	png_write_band band[MAX_WRITE_BANDS];
+	UINT32 rowbytes = compute_rowbytes(pnginfo);
+	UINT32 length = pnginfo->height * (rowbytes + 1);
+	int level = (pnginfo->level == PNG_LEVEL_DEFAULT) ? Z_DEFAULT_COMPRESSION : MIN(MAX(pnginfo->level, PNG_LEVEL_FASTEST), PNG_LEVEL_SMALLEST);
+	png_error error = PNGERR_NONE;
+	UINT8 *filtered, *data;
+	double *entropy;
+	UINT32 zlength, adler;
+	int bands, bandnum;
+	int choose_filter;
+	UINT32 row, count;
+
+	/* images with few colours compress better unfiltered, like palettized ones */
+	choose_filter = (pnginfo->color_type != 3 && pnginfo->bit_depth == 8 && !has_few_colors(pnginfo));
+
+	/* split large images into bands if we can compress them in parallel */
+	bands = 1;
+	if (pnginfo->workqueue != NULL)
+		bands = MAX(MIN(length / MIN_BAND_BYTES, MIN(pnginfo->height, MAX_WRITE_BANDS)), 1);
+
+	filtered = (UINT8 *)malloc(length + 1);
+	entropy = (double *)malloc((rowbytes + 1) * sizeof(*entropy));
+	if (filtered == NULL || entropy == NULL)
+	{
+		free(filtered);
+		free(entropy);
+		return PNGERR_OUT_OF_MEMORY;
 	}
 
-	/* clean up deflater(maus) */
-	zerr = deflateEnd(&stream);
-	if (zerr != Z_OK)
-		return PNGERR_COMPRESS_ERROR;
+	/* the cost of a residue that occurs count times in a row */
+	entropy[0] = 0;
+	for (count = 1; count <= rowbytes; count++)
+		entropy[count] = (double)count * log((double)rowbytes / (double)count) / log(2.0);
 
-	/* write the CRC */
-	put_32bit(tempbuff, crc);
-	if (core_fwrite(fp, tempbuff, 4) != 4)
-		return PNGERR_FILE_ERROR;
+	/* divide up the rows */
+	memset(band, 0, sizeof(band));
+	for (bandnum = 0, row = 0; bandnum < bands; bandnum++)
+	{
+		band[bandnum].image = pnginfo->image;
+		band[bandnum].filtered = filtered;
+		band[bandnum].rowbytes = rowbytes;
+		band[bandnum].bpp = MAX(compute_bpp(pnginfo), 1);
+		band[bandnum].choose_filter = choose_filter;
+		band[bandnum].entropy = entropy;
+		band[bandnum].level = level;
+		band[bandnum].strategy = (choose_filter && level != PNG_LEVEL_SMALLEST) ? Z_RLE : Z_DEFAULT_STRATEGY;
+		band[bandnum].startrow = row;
+		band[bandnum].rows = pnginfo->height / bands + ((UINT32)bandnum < pnginfo->height % bands);
+		band[bandnum].last = (bandnum == bands - 1);
+		row += band[bandnum].rows;
+	}
 
-	/* seek back and update the length */
-	core_fseek(fp, lengthpos, SEEK_SET);
-	put_32bit(tempbuff + 0, zlength);
-	if (core_fwrite(fp, tempbuff, 4) != 4)
-		return PNGERR_FILE_ERROR;
+	/* filter everything first, since each band's dictionary comes from the one before */
+	run_bands(pnginfo->workqueue, band, bands, filter_band);
+	run_bands(pnginfo->workqueue, band, bands, deflate_band);
 
-	/* return to the end */
-	core_fseek(fp, lengthpos + 8 + zlength + 4, SEEK_SET);
-	return PNGERR_NONE;
+	/* join the bands into a zlib stream: header, deflate data, combined adler32 */
+	zlength = 2 + 4;
+	for (bandnum = 0; bandnum < bands; bandnum++)
+	{
+		if (band[bandnum].error != PNGERR_NONE)
+			error = band[bandnum].error;
+		zlength += band[bandnum].outlength;
+	}
+	data = (error == PNGERR_NONE) ? (UINT8 *)malloc(zlength) : NULL;
+	if (error == PNGERR_NONE && data == NULL)
+		error = PNGERR_OUT_OF_MEMORY;
+	if (error == PNGERR_NONE)
+	{
+		int flevel = (level == Z_DEFAULT_COMPRESSION || level == 6) ? 2 : (level < 2) ? 0 : (level < 6) ? 1 : 3;
+		UINT8 *dst = data;
+
+		*dst++ = 0x78;
+		*dst++ = (flevel << 6) + 31 - (((0x78 << 8) + (flevel << 6)) % 31);
+		adler = band[0].adler;
+		for (bandnum = 0; bandnum < bands; bandnum++)
+		{
+			memcpy(dst, band[bandnum].output, band[bandnum].outlength);
+			dst += band[bandnum].outlength;
+			if (bandnum != 0)
+				adler = adler32_combine(adler, band[bandnum].adler, band[bandnum].rows * (rowbytes + 1));
+		}
+		put_32bit(dst, adler);
+
+		error = write_chunk(fp, data, PNG_CN_IDAT, zlength);
+		free(data);
+	}
+
+	/* free everything */
+	for (bandnum = 0; bandnum < bands; bandnum++)
+		if (band[bandnum].output != NULL)
+			free(band[bandnum].output);
+	free(entropy);
+	free(filtered);
+	return error;
 }
 
 
@@ -1019,8 +1294,6 @@ static png_error write_png_stream(core_file *fp, png_info *pnginfo, const bitmap
 	if (error != PNGERR_NONE)
 		goto handle_error;
 
-	/* if we wanted to get clever and do filtering, we would do it here */
-
 	/* write the IHDR chunk */
 	put_32bit(tempbuff + 0, pnginfo->width);
 	put_32bit(tempbuff + 4, pnginfo->height);
@@ -1040,7 +1313,7 @@ static png_error write_png_stream(core_file *fp, png_info *pnginfo, const bitmap
 		goto handle_error;
 
 	/* write a single IDAT chunk */
-	error = write_deflated_chunk(fp, pnginfo->image, PNG_CN_IDAT, pnginfo->height * (compute_rowbytes(pnginfo) + 1));
+	error = write_image_chunk(fp, pnginfo);
 	if (error != PNGERR_NONE)
 		goto handle_error;
 
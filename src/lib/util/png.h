@@ -50,6 +50,11 @@
 #define MNG_CN_TERM         0x5445524DL
 #define MNG_CN_BACK         0x4241434BL
 
+/* Compression levels for writing */
+#define PNG_LEVEL_DEFAULT   0       /* zlib's default, currently 6 */
+#define PNG_LEVEL_FASTEST   1
+#define PNG_LEVEL_SMALLEST  9
+
 /* Prediction filters */
 #define PNG_PF_None         0
 #define PNG_PF_Sub          1
@@ -109,6 +114,10 @@ struct png_info
 	UINT32          num_trans;
 
 	png_text *      textlist;
+
+	/* writing options; zero gives the defaults */
+	int             level;          /* PNG_LEVEL_FASTEST to PNG_LEVEL_SMALLEST, or PNG_LEVEL_DEFAULT */
+	osd_work_queue *workqueue;      /* if set, large images are compressed in parallel bands */
 };
 
 
@@ -248,6 +248,15 @@ sha1_transform(UINT32 *state, UINT32 *data)
 	state[4] += E;
 }
 
+/* Replacement block function, if one has been installed */
+static sha1_blocks_func sha1_blocks = NULL;
+
+void
+sha1_set_blocks_func(sha1_blocks_func func)
+{
+	sha1_blocks = func;
+}
+
 static void
 sha1_block(struct sha1_ctx *ctx, const UINT8 *block)
 {
@@ -286,6 +295,16 @@ sha1_update(struct sha1_ctx *ctx,
 		length -= left;
 	}
 	}
+	if (sha1_blocks != NULL && length >= SHA1_DATA_SIZE)
+	{ /* Hand all the whole blocks over at once */
+		unsigned blocks = length / SHA1_DATA_SIZE;
+		ctx->count_low += blocks;
+		if (ctx->count_low < blocks)
+	++ctx->count_high;
+		sha1_blocks(ctx->digest, buffer, blocks);
+		buffer += blocks * SHA1_DATA_SIZE;
+		length -= blocks * SHA1_DATA_SIZE;
+	}
 	while (length >= SHA1_DATA_SIZE)
 	{
 		sha1_block(ctx, buffer);
@@ -58,4 +58,11 @@ sha1_digest(const struct sha1_ctx *ctx,
 		unsigned length,
 		UINT8 *digest);
 
+/* Optional replacement for the block function, called with whole
+   64-byte blocks straight from the input; NULL restores the default */
+typedef void (*sha1_blocks_func)(UINT32 *digest, const UINT8 *data, unsigned blocks);
+
+void
+sha1_set_blocks_func(sha1_blocks_func func);
+
 #endif /* NETTLE_SHA1_H_INCLUDED */
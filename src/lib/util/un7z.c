@@ -168,6 +168,9 @@ void FileOutStream_CreateVTable(CFileOutStream *p)
 
 static _7z_file *_7z_cache[_7Z_CACHE_SIZE];
 
+/* the cache may be used from several threads at once */
+static osd_lock *_7z_cache_lock = osd_lock_alloc();
+
 /***************************************************************************
     FUNCTION PROTOTYPES
 ***************************************************************************/
@@ -291,6 +294,7 @@ _7z_error _7z_file_open(const char *filename, _7z_file **_7z)
 	*_7z = NULL;
 
 	/* see if we are in the cache, and reopen if so */
+	osd_lock_acquire(_7z_cache_lock);
 	for (cachenum = 0; cachenum < ARRAY_LENGTH(_7z_cache); cachenum++)
 	{
 		_7z_file *cached = _7z_cache[cachenum];
@@ -300,9 +304,11 @@ _7z_error _7z_file_open(const char *filename, _7z_file **_7z)
 		{
 			*_7z = cached;
 			_7z_cache[cachenum] = NULL;
+			osd_lock_release(_7z_cache_lock);
 			return _7ZERR_NONE;
 		}
 	}
+	osd_lock_release(_7z_cache_lock);
 
 	/* allocate memory for the _7z_file structure */
 	new_7z = (_7z_file *)malloc(sizeof(*new_7z));
@@ -386,6 +392,7 @@ void _7z_file_close(_7z_file *_7z)
 	_7z->archiveStream.file._7z_osdfile = NULL;
 
 	/* find the first NULL entry in the cache */
+	osd_lock_acquire(_7z_cache_lock);
 	for (cachenum = 0; cachenum < ARRAY_LENGTH(_7z_cache); cachenum++)
 		if (_7z_cache[cachenum] == NULL)
 			break;
@@ -398,6 +405,7 @@ void _7z_file_close(_7z_file *_7z)
 	if (cachenum != 0)
 		memmove(&_7z_cache[1], &_7z_cache[0], cachenum * sizeof(_7z_cache[0]));
 	_7z_cache[0] = _7z;
+	osd_lock_release(_7z_cache_lock);
 }
 
 
@@ -411,12 +419,14 @@ void _7z_file_cache_clear(void)
 	int cachenum;
 
 	/* clear call cache entries */
+	osd_lock_acquire(_7z_cache_lock);
 	for (cachenum = 0; cachenum < ARRAY_LENGTH(_7z_cache); cachenum++)
 		if (_7z_cache[cachenum] != NULL)
 		{
 			free__7z_file(_7z_cache[cachenum]);
 			_7z_cache[cachenum] = NULL;
 		}
+	osd_lock_release(_7z_cache_lock);
 }
 
 
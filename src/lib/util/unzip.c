@@ -10,6 +10,7 @@
 
 #include "osdcore.h"
 #include "unzip.h"
+#include "corestr.h"
 
 #include <ctype.h>
 #include <stdlib.h>
@@ -21,8 +22,11 @@
     CONSTANTS
 ***************************************************************************/
 
-/* number of open files to cache */
-#define ZIP_CACHE_SIZE  8
+/* number of open files to cache by default */
+#define ZIP_CACHE_SIZE  64
+
+/* marks the end of an index chain */
+#define ZIP_INDEX_NONE  0xffffffff
 
 /* offsets in end of central directory structure */
 #define ZIPESIG         0x00
@@ -87,13 +91,34 @@ INLINE UINT32 read_dword(UINT8 *buf)
 	return (buf[3] << 24) | (buf[2] << 16) | (buf[1] << 8) | buf[0];
 }
 
+/* FNV-1a over a string, optionally lowercased */
+INLINE UINT32 hash_string(const char *string, int lower)
+{
+	UINT32 hash = 2166136261U;
+	for ( ; *string != 0; string++)
+		hash = (hash ^ (UINT8)(lower ? tolower((UINT8)*string) : *string)) * 16777619U;
+	return hash;
+}
+
+/* hash of the final component of a member name, ignoring case */
+INLINE UINT32 hash_member_name(const char *filename)
+{
+	const char *slash = strrchr(filename, '/');
+	return hash_string((slash != NULL) ? slash + 1 : filename, TRUE);
+}
+
 
 
 /***************************************************************************
     GLOBAL VARIABLES
 ***************************************************************************/
 
-static zip_file *zip_cache[ZIP_CACHE_SIZE];
+static zip_file *zip_cache_default[ZIP_CACHE_SIZE];
+static zip_file **zip_cache = zip_cache_default;
+static int zip_cache_size = ZIP_CACHE_SIZE;
+
+/* the cache may be used from several threads at once */
+static osd_lock *zip_cache_lock = osd_lock_alloc();
 
 
 
@@ -106,6 +131,7 @@ static void free_zip_file(zip_file *zip);
 
 /* ZIP file parsing */
 static zip_error read_ecd(zip_file *zip);
+static zip_error build_index(zip_file *zip);
 static zip_error get_compressed_data_offset(zip_file *zip, UINT64 *offset);
 
 /* decompression interfaces */
@@ -129,24 +155,28 @@ zip_error zip_file_open(const char *filename, zip_file **zip)
 	UINT32 read_length;
 	zip_file *newzip;
 	char *string;
+	UINT32 filename_hash = hash_string(filename, FALSE);
 	int cachenum;
 
 	/* ensure we start with a NULL result */
 	*zip = NULL;
 
 	/* see if we are in the cache, and reopen if so */
-	for (cachenum = 0; cachenum < ARRAY_LENGTH(zip_cache); cachenum++)
+	osd_lock_acquire(zip_cache_lock);
+	for (cachenum = 0; cachenum < zip_cache_size; cachenum++)
 	{
 		zip_file *cached = zip_cache[cachenum];
 
 		/* if we have a valid entry and it matches our filename, use it and remove from the cache */
-		if (cached != NULL && cached->filename != NULL && strcmp(filename, cached->filename) == 0)
+		if (cached != NULL && cached->filename_hash == filename_hash && cached->filename != NULL && strcmp(filename, cached->filename) == 0)
 		{
 			*zip = cached;
 			zip_cache[cachenum] = NULL;
+			osd_lock_release(zip_cache_lock);
 			return ZIPERR_NONE;
 		}
 	}
+	osd_lock_release(zip_cache_lock);
 
 	/* allocate memory for the zip_file structure */
 	newzip = (zip_file *)malloc(sizeof(*newzip));
@@ -190,6 +220,11 @@ zip_error zip_file_open(const char *filename, zip_file **zip)
 		goto error;
 	}
 
+	/* index the members so lookups don't have to walk the directory */
+	ziperr = build_index(newzip);
+	if (ziperr != ZIPERR_NONE)
+		goto error;
+
 	/* make a copy of the filename for caching purposes */
 	string = (char *)malloc(strlen(filename) + 1);
 	if (string == NULL)
@@ -199,6 +234,7 @@ zip_error zip_file_open(const char *filename, zip_file **zip)
 	}
 	strcpy(string, filename);
 	newzip->filename = string;
+	newzip->filename_hash = filename_hash;
 	*zip = newzip;
 	return ZIPERR_NONE;
 
@@ -223,18 +259,20 @@ void zip_file_close(zip_file *zip)
 	zip->file = NULL;
 
 	/* find the first NULL entry in the cache */
-	for (cachenum = 0; cachenum < ARRAY_LENGTH(zip_cache); cachenum++)
+	osd_lock_acquire(zip_cache_lock);
+	for (cachenum = 0; cachenum < zip_cache_size; cachenum++)
 		if (zip_cache[cachenum] == NULL)
 			break;
 
 	/* if no room left in the cache, free the bottommost entry */
-	if (cachenum == ARRAY_LENGTH(zip_cache))
+	if (cachenum == zip_cache_size)
 		free_zip_file(zip_cache[--cachenum]);
 
 	/* move everyone else down and place us at the top */
 	if (cachenum != 0)
 		memmove(&zip_cache[1], &zip_cache[0], cachenum * sizeof(zip_cache[0]));
 	zip_cache[0] = zip;
+	osd_lock_release(zip_cache_lock);
 }
 
 
@@ -248,12 +286,48 @@ void zip_file_cache_clear(void)
 	int cachenum;
 
 	/* clear call cache entries */
-	for (cachenum = 0; cachenum < ARRAY_LENGTH(zip_cache); cachenum++)
+	osd_lock_acquire(zip_cache_lock);
+	for (cachenum = 0; cachenum < zip_cache_size; cachenum++)
 		if (zip_cache[cachenum] != NULL)
 		{
 			free_zip_file(zip_cache[cachenum]);
 			zip_cache[cachenum] = NULL;
 		}
+
+	/* drop back to the default size */
+	if (zip_cache != zip_cache_default)
+		free(zip_cache);
+	zip_cache = zip_cache_default;
+	zip_cache_size = ZIP_CACHE_SIZE;
+	osd_lock_release(zip_cache_lock);
+}
+
+
+/*-------------------------------------------------
+    zip_file_cache_reserve - grow the cache to
+    hold at least the given number of files
+-------------------------------------------------*/
+
+void zip_file_cache_reserve(int entries)
+{
+	zip_file **newcache;
+
+	osd_lock_acquire(zip_cache_lock);
+	if (entries > zip_cache_size)
+	{
+		/* copy the existing entries to the top of a larger array */
+		newcache = (zip_file **)malloc(entries * sizeof(newcache[0]));
+		if (newcache != NULL)
+		{
+			memcpy(newcache, zip_cache, zip_cache_size * sizeof(newcache[0]));
+			memset(&newcache[zip_cache_size], 0, (entries - zip_cache_size) * sizeof(newcache[0]));
+			if (zip_cache != zip_cache_default)
+				free(zip_cache);
+			zip_cache = newcache;
+			zip_cache_size = entries;
+		}
+	}
+	osd_lock_release(zip_cache_lock);
 }
 
 
@@ -332,6 +406,101 @@ const zip_file_header *zip_file_next_file(zip_file *zip)
 }
 
 
+/*-------------------------------------------------
+    read_indexed_header - extract the header of
+    an indexed member
+-------------------------------------------------*/
+
+static const zip_file_header *read_indexed_header(zip_file *zip, UINT32 entry)
+{
+	zip->cd_pos = zip->index[entry].offset;
+	return zip_file_next_file(zip);
+}
+
+
+/*-------------------------------------------------
+    zip_file_first_name_match - return the first
+    file whose name matches, ignoring case and
+    any directory
+-------------------------------------------------*/
+
+const zip_file_header *zip_file_first_name_match(zip_file *zip, const char *filename)
+{
+	const char *slash = strrchr(filename, '/');
+
+	/* start at the head of the chain for this name */
+	zip->search_name = (slash != NULL) ? slash + 1 : filename;
+	zip->search_hash = hash_member_name(filename);
+	zip->search_entry = zip->index_buckets[zip->search_hash & zip->index_mask];
+	return zip_file_next_name_match(zip);
+}
+
+
+/*-------------------------------------------------
+    zip_file_next_name_match - return the next
+    file whose name matches
+-------------------------------------------------*/
+
+const zip_file_header *zip_file_next_name_match(zip_file *zip)
+{
+	while (zip->search_entry != ZIP_INDEX_NONE)
+	{
+		UINT32 entry = zip->search_entry;
+		zip->search_entry = zip->index[entry].name_next;
+
+		/* weed out hash collisions before extracting the header */
+		if (zip->index[entry].name_hash == zip->search_hash)
+		{
+			const zip_file_header *header = read_indexed_header(zip, entry);
+			const char *slash;
+			if (header == NULL)
+				continue;
+			slash = strrchr(header->filename, '/');
+			if (core_stricmp((slash != NULL) ? slash + 1 : header->filename, zip->search_name) == 0)
+				return header;
+		}
+	}
+	return NULL;
+}
+
+
+/*-------------------------------------------------
+    zip_file_first_crc_match - return the first
+    file with the given CRC
+-------------------------------------------------*/
+
+const zip_file_header *zip_file_first_crc_match(zip_file *zip, UINT32 crc)
+{
+	/* start at the head of the chain for this CRC */
+	zip->search_name = NULL;
+	zip->search_hash = crc;
+	zip->search_entry = zip->index_buckets[zip->index_mask + 1 + (crc & zip->index_mask)];
+	return zip_file_next_crc_match(zip);
+}
+
+
+/*-------------------------------------------------
+    zip_file_next_crc_match - return the next
+    file with the given CRC
+-------------------------------------------------*/
+
+const zip_file_header *zip_file_next_crc_match(zip_file *zip)
+{
+	while (zip->search_entry != ZIP_INDEX_NONE)
+	{
+		UINT32 entry = zip->search_entry;
+		zip->search_entry = zip->index[entry].crc_next;
+		if (zip->index[entry].crc == zip->search_hash)
+		{
+			const zip_file_header *header = read_indexed_header(zip, entry);
+			if (header != NULL)
+				return header;
+		}
+	}
+	return NULL;
+}
+
+
 /*-------------------------------------------------
     zip_file_decompress - decompress a file
     from a ZIP into the target buffer
@@ -396,6 +565,10 @@ static void free_zip_file(zip_file *zip)
 			free(zip->ecd.raw);
 		if (zip->cd != NULL)
 			free(zip->cd);
+		if (zip->index_buckets != NULL)
+			free(zip->index_buckets);
+		if (zip->index != NULL)
+			free(zip->index);
 		free(zip);
 	}
 }
@@ -479,6 +652,54 @@ static zip_error read_ecd(zip_file *zip)
 }
 
 
+/*-------------------------------------------------
+    build_index - hash every member of the
+    central directory by name and by CRC
+-------------------------------------------------*/
+
+static zip_error build_index(zip_file *zip)
+{
+	const zip_file_header *header;
+	UINT32 buckets, entry;
+
+	/* size the tables from the directory; there may turn out to be fewer members */
+	for (buckets = 16; buckets < zip->ecd.cd_total_entries; buckets *= 2) ;
+	zip->index_mask = buckets - 1;
+	zip->index_buckets = (UINT32 *)malloc(2 * buckets * sizeof(zip->index_buckets[0]));
+	zip->index = (zip_index_entry *)malloc((zip->ecd.cd_total_entries + 1) * sizeof(zip->index[0]));
+	if (zip->index_buckets == NULL || zip->index == NULL)
+		return ZIPERR_OUT_OF_MEMORY;
+
+	/* record each member in directory order */
+	zip->index_entries = 0;
+	zip->cd_pos = 0;
+	while (zip->index_entries < zip->ecd.cd_total_entries)
+	{
+		UINT32 offset = zip->cd_pos;
+		header = zip_file_next_file(zip);
+		if (header == NULL)
+			break;
+		zip->index[zip->index_entries].offset = offset;
+		zip->index[zip->index_entries].name_hash = hash_member_name(header->filename);
+		zip->index[zip->index_entries].crc = header->crc;
+		zip->index_entries++;
+	}
+
+	/* chain them in reverse so each chain comes out in directory order */
+	memset(zip->index_buckets, 0xff, 2 * buckets * sizeof(zip->index_buckets[0]));
+	for (entry = zip->index_entries; entry-- > 0; )
+	{
+		UINT32 *namehead = &zip->index_buckets[zip->index[entry].name_hash & zip->index_mask];
+		UINT32 *crchead = &zip->index_buckets[buckets + (zip->index[entry].crc & zip->index_mask)];
+		zip->index[entry].name_next = *namehead;
+		zip->index[entry].crc_next = *crchead;
+		*namehead = *crchead = entry;
+	}
+	zip->cd_pos = 0;
+	return ZIPERR_NONE;
+}
+
+
 /*-------------------------------------------------
     get_compressed_data_offset - return the
     offset of the compressed data
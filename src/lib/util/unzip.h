@@ -88,10 +88,22 @@ struct zip_ecd
 };
 
 
+/* one member of the hashed index of a ZIP */
+struct zip_index_entry
+{
+	UINT32          offset;                 /* offset of the header in the central directory */
+	UINT32          name_hash;              /* hash of the lowercased name, ignoring directories */
+	UINT32          crc;                    /* crc-32 */
+	UINT32          name_next;              /* next entry with the same name hash bucket */
+	UINT32          crc_next;               /* next entry with the same CRC bucket */
+};
+
+
 /* describes an open ZIP file */
 struct zip_file
 {
 	const char *    filename;               /* copy of ZIP filename (for caching) */
+	UINT32          filename_hash;          /* hash of the filename (for caching) */
 	osd_file *      file;                   /* OSD file handle */
 	UINT64          length;                 /* length of zip file */
 
@@ -101,6 +113,14 @@ struct zip_file
 	UINT32          cd_pos;                 /* position in central directory */
 	zip_file_header header;                 /* current file header */
 
+	UINT32          index_entries;          /* number of members in the index */
+	UINT32          index_mask;             /* mask for index hash buckets */
+	UINT32 *        index_buckets;          /* first entry for each name hash, then each CRC */
+	zip_index_entry *index;                 /* hashed index of members by name and CRC */
+	UINT32          search_entry;           /* next index entry to examine in a search */
+	UINT32          search_hash;            /* name hash or CRC being searched for */
+	const char *    search_name;            /* name being searched for, or NULL for CRC */
+
 	UINT8           buffer[ZIP_DECOMPRESS_BUFSIZE]; /* buffer for decompression */
 };
 
@@ -122,6 +142,9 @@ void zip_file_close(zip_file *zip);
 /* clear out all open ZIP files from the cache */
 void zip_file_cache_clear(void);
 
+/* grow the cache so it can hold at least this many ZIP files until it is next cleared */
+void zip_file_cache_reserve(int entries);
+
 
 /* ----- contained file access ----- */
 
@@ -131,6 +154,15 @@ const zip_file_header *zip_file_first_file(zip_file *zip);
 /* find the next file in the ZIP */
 const zip_file_header *zip_file_next_file(zip_file *zip);
 
+/* find the first/next file whose name matches, ignoring case and any directory;
+   the name must stay valid for the whole search */
+const zip_file_header *zip_file_first_name_match(zip_file *zip, const char *filename);
+const zip_file_header *zip_file_next_name_match(zip_file *zip);
+
+/* find the first/next file with the given CRC */
+const zip_file_header *zip_file_first_crc_match(zip_file *zip, UINT32 crc);
+const zip_file_header *zip_file_next_crc_match(zip_file *zip);
+
 /* decompress the most recently found file in the ZIP */
 zip_error zip_file_decompress(zip_file *zip, void *buffer, UINT32 length);
 
@@ -1225,7 +1225,7 @@ Notes:
 
 #include "emu.h"
 #include <float.h>
-#include "video/poly.h"
+#include "video/polynew.h"
 #include "cpu/mips/mips3.h"
 #include "cpu/h83002/h8.h"
 #include "cpu/sh2/sh2.h"
@@ -1271,20 +1271,32 @@ struct namcos23_render_data
 {
 	running_machine *machine;
 	const pen_t *pens;
+	bitmap_rgb32 *bitmap;
 	UINT32 (*texture_lookup)(running_machine &machine, const pen_t *pens, float x, float y);
 };
 
+enum { RENDER_MAX_ENTRIES = 1000, POLY_MAX_ENTRIES = 10000 };
+
+class namcos23_renderer : public poly_manager<float, namcos23_render_data, 4, POLY_MAX_ENTRIES>
+{
+public:
+	namcos23_renderer(running_machine &machine)
+		: poly_manager<float, namcos23_render_data, 4, POLY_MAX_ENTRIES>(machine)
+	{
+	}
+
+	void render_scanline(INT32 scanline, const extent_t &extent, const namcos23_render_data &rd, int threadid);
+};
+
 struct namcos23_poly_entry
 {
 	namcos23_render_data rd;
 	float zkey;
 	int front;
 	int vertex_count;
-	poly_vertex pv[16];
+	namcos23_renderer::vertex_t pv[16];
 };
 
-enum { RENDER_MAX_ENTRIES = 1000, POLY_MAX_ENTRIES = 10000 };
-
 
 struct c417_t
 {
@@ -1331,7 +1343,7 @@ struct c404_t
 
 struct render_t
 {
-	poly_manager *polymgr;
+	namcos23_renderer *polymgr;
 	int cur;
 	int poly_count;
 	int count[2];
@@ -1504,9 +1516,9 @@ public:
 	void p3d_render(const UINT16 *p, int size, bool use_scaling);
 	void p3d_flush(const UINT16 *p, int size);
 	void p3d_dma(address_space &space, UINT32 adr, UINT32 size);
-	void render_apply_transform(INT32 xi, INT32 yi, INT32 zi, const namcos23_render_entry *re, poly_vertex &pv);
+	void render_apply_transform(INT32 xi, INT32 yi, INT32 zi, const namcos23_render_entry *re, namcos23_renderer::vertex_t &pv);
 	void render_apply_matrot(INT32 xi, INT32 yi, INT32 zi, const namcos23_render_entry *re, INT32 &x, INT32 &y, INT32 &z);
-	void render_project(poly_vertex &pv);
+	void render_project(namcos23_renderer::vertex_t &pv);
 	void render_one_model(const namcos23_render_entry *re);
 	void render_flush(bitmap_rgb32 &bitmap);
 	void render_run(bitmap_rgb32 &bitmap);
@@ -1833,25 +1845,22 @@ WRITE32_MEMBER(namcos23_state::p3d_w)
 
 
 
-static void render_scanline(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid)
+void namcos23_renderer::render_scanline(INT32 scanline, const extent_t &extent, const namcos23_render_data &rd, int threadid)
 {
-	const namcos23_render_data *rd = (const namcos23_render_data *)extradata;
-
-	float w = extent->param[0].start;
-	float u = extent->param[1].start;
-	float v = extent->param[2].start;
-	float l = extent->param[3].start;
-	float dw = extent->param[0].dpdx;
-	float du = extent->param[1].dpdx;
-	float dv = extent->param[2].dpdx;
-	float dl = extent->param[3].dpdx;
-	bitmap_rgb32 *bitmap = (bitmap_rgb32 *)dest;
-	UINT32 *img = &bitmap->pix32(scanline, extent->startx);
-
-	for(int x = extent->startx; x < extent->stopx; x++)
+	float w = extent.param[0].start;
+	float u = extent.param[1].start;
+	float v = extent.param[2].start;
+	float l = extent.param[3].start;
+	float dw = extent.param[0].dpdx;
+	float du = extent.param[1].dpdx;
+	float dv = extent.param[2].dpdx;
+	float dl = extent.param[3].dpdx;
+	UINT32 *img = &rd.bitmap->pix32(scanline, extent.startx);
+
+	for(int x = extent.startx; x < extent.stopx; x++)
 	{
 		float z = w ? 1/w : 0;
-		UINT32 pcol = rd->texture_lookup(*rd->machine, rd->pens, u*z, v*z);
+		UINT32 pcol = rd.texture_lookup(*rd.machine, rd.pens, u*z, v*z);
 		float ll = l*z;
 		*img = (light(pcol >> 16, ll) << 16) | (light(pcol >> 8, ll) << 8) | light(pcol, ll);
 
@@ -1863,7 +1872,7 @@ static void render_scanline(void *dest, INT32 scanline, const poly_extent *exten
 	}
 }
 
-void namcos23_state::render_apply_transform(INT32 xi, INT32 yi, INT32 zi, const namcos23_render_entry *re, poly_vertex &pv)
+void namcos23_state::render_apply_transform(INT32 xi, INT32 yi, INT32 zi, const namcos23_render_entry *re, namcos23_renderer::vertex_t &pv)
 {
 	pv.x =    (INT32((re->model.m[0]*INT64(xi) + re->model.m[3]*INT64(yi) + re->model.m[6]*INT64(zi)) >> 14)*re->model.scaling + re->model.v[0])/16384.0;
 	pv.y =    (INT32((re->model.m[1]*INT64(xi) + re->model.m[4]*INT64(yi) + re->model.m[7]*INT64(zi)) >> 14)*re->model.scaling + re->model.v[1])/16384.0;
@@ -1877,7 +1886,7 @@ void namcos23_state::render_apply_matrot(INT32 xi, INT32 yi, INT32 zi, const nam
 	z = (re->model.m[2]*xi + re->model.m[5]*yi + re->model.m[8]*zi) >> 14;
 }
 
-void namcos23_state::render_project(poly_vertex &pv)
+void namcos23_state::render_project(namcos23_renderer::vertex_t &pv)
 {
 	// 768 validated by the title screen size on tc2:
 	// texture is 640x480, x range is 3.125, y range is 2.34375, z is 3.75
@@ -1921,7 +1930,7 @@ void namcos23_state::render_one_model(const namcos23_render_entry *re)
 
 	while(adr < m_ptrom_limit)
 	{
-		poly_vertex pv[15];
+		namcos23_renderer::vertex_t pv[15];
 
 		UINT32 type = m_ptrom[adr++];
 		UINT32 h    = m_ptrom[adr++];
@@ -1995,7 +2004,7 @@ void namcos23_state::render_one_model(const namcos23_render_entry *re)
 
 		namcos23_poly_entry *p = render.polys + render.poly_count;
 
-		p->vertex_count = poly_zclip_if_less(ne, pv, p->pv, 4, 0.001f);
+		p->vertex_count = render.polymgr->zclip_if_less(ne, pv, p->pv, 4, 0.001f);
 
 		if(p->vertex_count >= 3)
 		{
@@ -2048,9 +2057,10 @@ void namcos23_state::render_flush(bitmap_rgb32 &bitmap)
 	for(int i=0; i<render.poly_count; i++)
 	{
 		const namcos23_poly_entry *p = render.poly_order[i];
-		namcos23_render_data *rd = (namcos23_render_data *)poly_get_extra_data(render.polymgr);
-		*rd = p->rd;
-		poly_render_triangle_fan(render.polymgr, &bitmap, scissor, render_scanline, 4, p->vertex_count, p->pv);
+		namcos23_render_data &rd = render.polymgr->object_data_alloc();
+		rd = p->rd;
+		rd.bitmap = &bitmap;
+		render.polymgr->render_triangle_fan(scissor, namcos23_renderer::render_delegate(FUNC(namcos23_renderer::render_scanline), render.polymgr), 4, p->vertex_count, p->pv);
 	}
 	render.poly_count = 0;
 }
@@ -2076,7 +2086,7 @@ void namcos23_state::render_run(bitmap_rgb32 &bitmap)
 	}
 	render_flush(bitmap);
 
-	poly_wait(render.polymgr, "render_run");
+	render.polymgr->wait("render_run");
 }
 
 
@@ -2149,7 +2159,7 @@ VIDEO_START_MEMBER(namcos23_state,s23)
 	m_bgtilemap = &machine().tilemap().create(tilemap_get_info_delegate(FUNC(namcos23_state::TextTilemapGetInfo),this), TILEMAP_SCAN_ROWS, 16, 16, 64, 64);
 	m_bgtilemap->set_transparent_pen(0xf);
 	m_bgtilemap->set_scrolldx(860, 860);
-	m_render.polymgr = poly_alloc(machine(), 10000, sizeof(namcos23_render_data), 0);
+	m_render.polymgr = auto_alloc(machine(), namcos23_renderer(machine()));
 }
 
 
@@ -1,4 +1,4 @@
-#include "video/poly.h"
+#include "video/polynew.h"
 #include "machine/scsibus.h"
 #include "machine/53c810.h"
 #include "audio/dsbz80.h"
@@ -14,6 +14,36 @@ struct PLANE {
 
 struct cached_texture;
 
+struct m3_polydata
+{
+	cached_texture *texture;
+	UINT32 color;
+	UINT8 texture_param;
+	int polygon_transparency;
+	int polygon_intensity;
+};
+
+class model3_renderer : public poly_manager<float, m3_polydata, 3, 4000>
+{
+public:
+	model3_renderer(running_machine &machine, bitmap_ind16 &fb, bitmap_ind32 &zb)
+		: poly_manager<float, m3_polydata, 3, 4000>(machine),
+			m_fb(fb),
+			m_zb(zb)
+	{
+	}
+
+	void draw_scanline_normal(INT32 scanline, const extent_t &extent, const m3_polydata &extradata, int threadid);
+	void draw_scanline_trans(INT32 scanline, const extent_t &extent, const m3_polydata &extradata, int threadid);
+	void draw_scanline_alpha(INT32 scanline, const extent_t &extent, const m3_polydata &extradata, int threadid);
+	void draw_scanline_alpha_test(INT32 scanline, const extent_t &extent, const m3_polydata &extradata, int threadid);
+	void draw_scanline_color(INT32 scanline, const extent_t &extent, const m3_polydata &extradata, int threadid);
+
+private:
+	bitmap_ind16 &m_fb;
+	bitmap_ind32 &m_zb;
+};
+
 class model3_state : public driver_device
 {
 public:
@@ -100,7 +130,7 @@ public:
 	VECTOR3 m_parallel_light;
 	float m_parallel_light_intensity;
 	float m_ambient_light_intensity;
-	poly_manager *m_poly;
+	model3_renderer *m_renderer;
 	int m_list_depth;
 	int m_tick;
 	int m_debug_layer_disable;
@@ -15,7 +15,7 @@ class taitojc_renderer : public poly_manager<float, taitojc_polydata, 6, 10000>
 {
 public:
 	taitojc_renderer(running_machine &machine, bitmap_ind16 *fb, bitmap_ind16 *zb, const UINT8 *texture_ram)
-		: poly_manager<float, taitojc_polydata, 6, 10000>(machine)
+		: poly_manager<float, taitojc_polydata, 6, 10000>(machine, POLYFLAG_TILE_BINNING)
 	{
 		m_framebuffer = fb;
 		m_zbuffer = zb;
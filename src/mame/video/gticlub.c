@@ -3,7 +3,7 @@
 #include "cpu/sharc/sharc.h"
 #include "machine/konppc.h"
 #include "video/voodoo.h"
-#include "video/poly.h"
+#include "video/polynew.h"
 #include "video/k001604.h"
 #include "video/gticlub.h"
 
@@ -35,8 +35,9 @@
 static int count = 0;
 #endif
 
-struct poly_extra_data
+struct gticlub_polydata
 {
+	bitmap_rgb32 *destmap;
 	UINT32 color;
 	int texture_x, texture_y;
 	int texture_width, texture_height;
@@ -50,6 +51,23 @@ struct poly_extra_data
 	UINT32 flags;
 };
 
+class gticlub_renderer : public poly_manager<float, gticlub_polydata, 6, 10000>
+{
+public:
+	gticlub_renderer(running_machine &machine)
+		: poly_manager<float, gticlub_polydata, 6, 10000>(machine)
+	{
+	}
+
+	void draw_scanline_2d(INT32 scanline, const extent_t &extent, const gticlub_polydata &extradata, int threadid);
+	void draw_scanline_2d_tex(INT32 scanline, const extent_t &extent, const gticlub_polydata &extradata, int threadid);
+	void draw_scanline(INT32 scanline, const extent_t &extent, const gticlub_polydata &extradata, int threadid);
+	void draw_scanline_tex(INT32 scanline, const extent_t &extent, const gticlub_polydata &extradata, int threadid);
+	void draw_scanline_gouraud_blend(INT32 scanline, const extent_t &extent, const gticlub_polydata &extradata, int threadid);
+};
+
+typedef gticlub_renderer::vertex_t poly_vertex;
+
 
 
 /*****************************************************************************/
@@ -211,7 +229,7 @@ static int *tex_mirror_table[2][8];
 
 static int K001005_bitmap_page = 0;
 
-static poly_manager *poly;
+static gticlub_renderer *poly;
 static poly_vertex prev_v[4];
 
 static UINT32 fog_r, fog_g, fog_b;
@@ -224,11 +242,6 @@ static float fog_density = 1.5f;
 
 static UINT8 *gfxrom;
 
-static void K001005_exit(running_machine &machine)
-{
-	poly_free(poly);
-}
-
 void K001005_init(running_machine &machine)
 {
 	int i,k;
@@ -251,8 +264,7 @@ void K001005_init(running_machine &machine)
 
 	K001005_3d_fifo = auto_alloc_array(machine, UINT32, 0x10000);
 
-	poly = poly_alloc(machine, 10000, sizeof(poly_extra_data), POLYFLAG_ALLOW_QUADS);
-	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(K001005_exit), &machine));
+	poly = auto_alloc(machine, gticlub_renderer(machine));
 
 	for (k=0; k < 8; k++)
 	{
@@ -275,7 +287,11 @@ void K001005_init(running_machine &machine)
 	K001005_3d_fifo_ptr = 0;
 	K001005_bitmap_page = 0;
 
-	memset(prev_v, 0, sizeof(poly_vertex)*4);
+	for (i = 0; i < 4; i++)
+	{
+		prev_v[i].x = prev_v[i].y = 0;
+		memset(prev_v[i].p, 0, sizeof(prev_v[i].p));
+	}
 }
 
 // rearranges the texture data to a more practical order
@@ -510,7 +526,7 @@ WRITE32_HANDLER( K001005_w )
 				if (K001005_3d_fifo_ptr > 0)
 				{
 					render_polygons(space.machine());
-					poly_wait(poly, "render_polygons");
+					poly->wait("render_polygons");
 
 #if LOG_POLY_FIFO
 					count = 0;
@@ -552,16 +568,15 @@ WRITE32_HANDLER( K001005_w )
 
 }
 
-static void draw_scanline_2d(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid)
+void gticlub_renderer::draw_scanline_2d(INT32 scanline, const extent_t &extent, const gticlub_polydata &extradata, int threadid)
 {
-	const poly_extra_data *extra = (const poly_extra_data *)extradata;
-	bitmap_rgb32 *destmap = (bitmap_rgb32 *)dest;
+	bitmap_rgb32 *destmap = extradata.destmap;
 	UINT32 *fb = &destmap->pix32(scanline);
 	float *zb = (float*)&K001005_zbuffer->pix32(scanline);
-	UINT32 color = extra->color;
+	UINT32 color = extradata.color;
 	int x;
 
-	for (x = extent->startx; x < extent->stopx; x++)
+	for (x = extent.startx; x < extent.stopx; x++)
 	{
 		if (color & 0xff000000)
 		{
@@ -571,32 +586,31 @@ static void draw_scanline_2d(void *dest, INT32 scanline, const poly_extent *exte
 	}
 }
 
-static void draw_scanline_2d_tex(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid)
+void gticlub_renderer::draw_scanline_2d_tex(INT32 scanline, const extent_t &extent, const gticlub_polydata &extradata, int threadid)
 {
-	const poly_extra_data *extra = (const poly_extra_data *)extradata;
-	bitmap_rgb32 *destmap = (bitmap_rgb32 *)dest;
-	UINT8 *texrom = gfxrom + (extra->texture_page * 0x40000);
-	int pal_chip = (extra->texture_palette & 0x8) ? 1 : 0;
-	int palette_index = (extra->texture_palette & 0x7) * 256;
-	float u = extent->param[POLY_U].start;
-	float v = extent->param[POLY_V].start;
-	float du = extent->param[POLY_U].dpdx;
-	float dv = extent->param[POLY_V].dpdx;
+	bitmap_rgb32 *destmap = extradata.destmap;
+	UINT8 *texrom = gfxrom + (extradata.texture_page * 0x40000);
+	int pal_chip = (extradata.texture_palette & 0x8) ? 1 : 0;
+	int palette_index = (extradata.texture_palette & 0x7) * 256;
+	float u = extent.param[POLY_U].start;
+	float v = extent.param[POLY_V].start;
+	float du = extent.param[POLY_U].dpdx;
+	float dv = extent.param[POLY_V].dpdx;
 	UINT32 *fb = &destmap->pix32(scanline);
 	float *zb = (float*)&K001005_zbuffer->pix32(scanline);
-	UINT32 color = extra->color;
-	int texture_mirror_x = extra->texture_mirror_x;
-	int texture_mirror_y = extra->texture_mirror_y;
-	int texture_x = extra->texture_x;
-	int texture_y = extra->texture_y;
-	int texture_width = extra->texture_width;
-	int texture_height = extra->texture_height;
+	UINT32 color = extradata.color;
+	int texture_mirror_x = extradata.texture_mirror_x;
+	int texture_mirror_y = extradata.texture_mirror_y;
+	int texture_x = extradata.texture_x;
+	int texture_y = extradata.texture_y;
+	int texture_width = extradata.texture_width;
+	int texture_height = extradata.texture_height;
 	int x;
 
 	int *x_mirror_table = tex_mirror_table[texture_mirror_x][texture_width];
 	int *y_mirror_table = tex_mirror_table[texture_mirror_y][texture_height];
 
-	for (x = extent->startx; x < extent->stopx; x++)
+	for (x = extent.startx; x < extent.stopx; x++)
 	{
 		int iu = (int)(u * 0.0625f);
 		int iv = (int)(v * 0.0625f);
@@ -619,32 +633,31 @@ static void draw_scanline_2d_tex(void *dest, INT32 scanline, const poly_extent *
 	}
 }
 
-static void draw_scanline(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid)
+void gticlub_renderer::draw_scanline(INT32 scanline, const extent_t &extent, const gticlub_polydata &extradata, int threadid)
 {
-	const poly_extra_data *extra = (const poly_extra_data *)extradata;
-	bitmap_rgb32 *destmap = (bitmap_rgb32 *)dest;
-	float z = extent->param[POLY_Z].start;
-	float dz = extent->param[POLY_Z].dpdx;
-	float bri = extent->param[POLY_BRI].start;
-	float dbri = extent->param[POLY_BRI].dpdx;
-	float fog = extent->param[POLY_FOG].start;
-	float dfog = extent->param[POLY_FOG].dpdx;
+	bitmap_rgb32 *destmap = extradata.destmap;
+	float z = extent.param[POLY_Z].start;
+	float dz = extent.param[POLY_Z].dpdx;
+	float bri = extent.param[POLY_BRI].start;
+	float dbri = extent.param[POLY_BRI].dpdx;
+	float fog = extent.param[POLY_FOG].start;
+	float dfog = extent.param[POLY_FOG].dpdx;
 	UINT32 *fb = &destmap->pix32(scanline);
 	float *zb = (float*)&K001005_zbuffer->pix32(scanline);
-	UINT32 color = extra->color;
+	UINT32 color = extradata.color;
 	int x;
 
-	int poly_light_r = extra->light_r + extra->ambient_r;
-	int poly_light_g = extra->light_g + extra->ambient_g;
-	int poly_light_b = extra->light_b + extra->ambient_b;
+	int poly_light_r = extradata.light_r + extradata.ambient_r;
+	int poly_light_g = extradata.light_g + extradata.ambient_g;
+	int poly_light_b = extradata.light_b + extradata.ambient_b;
 	if (poly_light_r > 255) poly_light_r = 255;
 	if (poly_light_g > 255) poly_light_g = 255;
 	if (poly_light_b > 255) poly_light_b = 255;
-	int poly_fog_r = extra->fog_r;
-	int poly_fog_g = extra->fog_g;
-	int poly_fog_b = extra->fog_b;
+	int poly_fog_r = extradata.fog_r;
+	int poly_fog_g = extradata.fog_g;
+	int poly_fog_b = extradata.fog_b;
 
-	for (x = extent->startx; x < extent->stopx; x++)
+	for (x = extent.startx; x < extent.stopx; x++)
 	{
 		int ibri = (int)(bri);
 		int ifog = (int)(fog);
@@ -679,49 +692,48 @@ static void draw_scanline(void *dest, INT32 scanline, const poly_extent *extent,
 	}
 }
 
-static void draw_scanline_tex(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid)
+void gticlub_renderer::draw_scanline_tex(INT32 scanline, const extent_t &extent, const gticlub_polydata &extradata, int threadid)
 {
-	const poly_extra_data *extra = (const poly_extra_data *)extradata;
-	bitmap_rgb32 *destmap = (bitmap_rgb32 *)dest;
-	UINT8 *texrom = gfxrom + (extra->texture_page * 0x40000);
-	int pal_chip = (extra->texture_palette & 0x8) ? 1 : 0;
-	int palette_index = (extra->texture_palette & 0x7) * 256;
-	float z = extent->param[POLY_Z].start;
-	float u = extent->param[POLY_U].start;
-	float v = extent->param[POLY_V].start;
-	float w = extent->param[POLY_W].start;
-	float dz = extent->param[POLY_Z].dpdx;
-	float du = extent->param[POLY_U].dpdx;
-	float dv = extent->param[POLY_V].dpdx;
-	float dw = extent->param[POLY_W].dpdx;
-	float bri = extent->param[POLY_BRI].start;
-	float dbri = extent->param[POLY_BRI].dpdx;
-	float fog = extent->param[POLY_FOG].start;
-	float dfog = extent->param[POLY_FOG].dpdx;
-	int texture_mirror_x = extra->texture_mirror_x;
-	int texture_mirror_y = extra->texture_mirror_y;
-	int texture_x = extra->texture_x;
-	int texture_y = extra->texture_y;
-	int texture_width = extra->texture_width;
-	int texture_height = extra->texture_height;
+	bitmap_rgb32 *destmap = extradata.destmap;
+	UINT8 *texrom = gfxrom + (extradata.texture_page * 0x40000);
+	int pal_chip = (extradata.texture_palette & 0x8) ? 1 : 0;
+	int palette_index = (extradata.texture_palette & 0x7) * 256;
+	float z = extent.param[POLY_Z].start;
+	float u = extent.param[POLY_U].start;
+	float v = extent.param[POLY_V].start;
+	float w = extent.param[POLY_W].start;
+	float dz = extent.param[POLY_Z].dpdx;
+	float du = extent.param[POLY_U].dpdx;
+	float dv = extent.param[POLY_V].dpdx;
+	float dw = extent.param[POLY_W].dpdx;
+	float bri = extent.param[POLY_BRI].start;
+	float dbri = extent.param[POLY_BRI].dpdx;
+	float fog = extent.param[POLY_FOG].start;
+	float dfog = extent.param[POLY_FOG].dpdx;
+	int texture_mirror_x = extradata.texture_mirror_x;
+	int texture_mirror_y = extradata.texture_mirror_y;
+	int texture_x = extradata.texture_x;
+	int texture_y = extradata.texture_y;
+	int texture_width = extradata.texture_width;
+	int texture_height = extradata.texture_height;
 	int x;
 
-	int poly_light_r = extra->light_r + extra->ambient_r;
-	int poly_light_g = extra->light_g + extra->ambient_g;
-	int poly_light_b = extra->light_b + extra->ambient_b;
+	int poly_light_r = extradata.light_r + extradata.ambient_r;
+	int poly_light_g = extradata.light_g + extradata.ambient_g;
+	int poly_light_b = extradata.light_b + extradata.ambient_b;
 	if (poly_light_r > 255) poly_light_r = 255;
 	if (poly_light_g > 255) poly_light_g = 255;
 	if (poly_light_b > 255) poly_light_b = 255;
-	int poly_fog_r = extra->fog_r;
-	int poly_fog_g = extra->fog_g;
-	int poly_fog_b = extra->fog_b;
+	int poly_fog_r = extradata.fog_r;
+	int poly_fog_g = extradata.fog_g;
+	int poly_fog_b = extradata.fog_b;
 
 	UINT32 *fb = &destmap->pix32(scanline);
 	float *zb = (float*)&K001005_zbuffer->pix32(scanline);
 	int *x_mirror_table = tex_mirror_table[texture_mirror_x][texture_width];
 	int *y_mirror_table = tex_mirror_table[texture_mirror_y][texture_height];
 
-	for (x = extent->startx; x < extent->stopx; x++)
+	for (x = extent.startx; x < extent.stopx; x++)
 	{
 		int ibri = (int)(bri);
 		int ifog = (int)(fog);
@@ -773,24 +785,24 @@ static void draw_scanline_tex(void *dest, INT32 scanline, const poly_extent *ext
 	}
 }
 
-static void draw_scanline_gouraud_blend(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid)
+void gticlub_renderer::draw_scanline_gouraud_blend(INT32 scanline, const extent_t &extent, const gticlub_polydata &extradata, int threadid)
 {
-	bitmap_rgb32 *destmap = (bitmap_rgb32 *)dest;
-	float z = extent->param[POLY_Z].start;
-	float dz = extent->param[POLY_Z].dpdx;
-	float r = extent->param[POLY_R].start;
-	float dr = extent->param[POLY_R].dpdx;
-	float g = extent->param[POLY_G].start;
-	float dg = extent->param[POLY_G].dpdx;
-	float b = extent->param[POLY_B].start;
-	float db = extent->param[POLY_B].dpdx;
-	float a = extent->param[POLY_A].start;
-	float da = extent->param[POLY_A].dpdx;
+	bitmap_rgb32 *destmap = extradata.destmap;
+	float z = extent.param[POLY_Z].start;
+	float dz = extent.param[POLY_Z].dpdx;
+	float r = extent.param[POLY_R].start;
+	float dr = extent.param[POLY_R].dpdx;
+	float g = extent.param[POLY_G].start;
+	float dg = extent.param[POLY_G].dpdx;
+	float b = extent.param[POLY_B].start;
+	float db = extent.param[POLY_B].dpdx;
+	float a = extent.param[POLY_A].start;
+	float da = extent.param[POLY_A].dpdx;
 	UINT32 *fb = &destmap->pix32(scanline);
 	float *zb = (float*)&K001005_zbuffer->pix32(scanline);
 	int x;
 
-	for (x = extent->startx; x < extent->stopx; x++)
+	for (x = extent.startx; x < extent.stopx; x++)
 	{
 		if (z <= zb[x])
 		{
@@ -832,6 +844,11 @@ static void draw_scanline_gouraud_blend(void *dest, INT32 scanline, const poly_e
 static void render_polygons(running_machine &machine)
 {
 	const rectangle& visarea = machine.primary_screen->visible_area();
+	gticlub_renderer::render_delegate rd_scan_2d = gticlub_renderer::render_delegate(FUNC(gticlub_renderer::draw_scanline_2d), poly);
+	gticlub_renderer::render_delegate rd_scan_2d_tex = gticlub_renderer::render_delegate(FUNC(gticlub_renderer::draw_scanline_2d_tex), poly);
+	gticlub_renderer::render_delegate rd_scan = gticlub_renderer::render_delegate(FUNC(gticlub_renderer::draw_scanline), poly);
+	gticlub_renderer::render_delegate rd_scan_tex = gticlub_renderer::render_delegate(FUNC(gticlub_renderer::draw_scanline_tex), poly);
+	gticlub_renderer::render_delegate rd_scan_gouraud_blend = gticlub_renderer::render_delegate(FUNC(gticlub_renderer::draw_scanline_gouraud_blend), poly);
 	poly_vertex v[4];
 	int poly_type;
 	int brightness;
@@ -880,7 +897,8 @@ static void render_polygons(running_machine &machine)
 
 			int tex_x, tex_y;
 			UINT32 color = 0;
-			poly_extra_data *extra = (poly_extra_data *)poly_get_extra_data(poly);
+			gticlub_polydata &extra = poly->object_data_alloc();
+			extra.destmap = K001005_bitmap[K001005_bitmap_page];
 
 			UINT32 header = fifo[index++];
 
@@ -942,19 +960,19 @@ static void render_polygons(running_machine &machine)
 					((header & 0x008) >> 2) |
 					((header & 0x002) >> 1);
 
-			extra->texture_x = tex_x * 8;
-			extra->texture_y = tex_y * 8;
-			extra->texture_width = (header >> 23) & 0x7;
-			extra->texture_height = (header >> 20) & 0x7;
-			extra->texture_page = (header >> 12) & 0x1f;
-			extra->texture_palette = (header >> 28) & 0xf;
-			extra->texture_mirror_x = ((cmd & 0x10) ? 0x1 : 0);
-			extra->texture_mirror_y = ((cmd & 0x10) ? 0x1 : 0);
-			extra->color = color;
-			extra->light_r = light_r;       extra->light_g = light_g;       extra->light_b = light_b;
-			extra->ambient_r = ambient_r;   extra->ambient_g = ambient_g;   extra->ambient_b = ambient_b;
-			extra->fog_r = fog_r;           extra->fog_g = fog_g;           extra->fog_b = fog_b;
-			extra->flags = cmd;
+			extra.texture_x = tex_x * 8;
+			extra.texture_y = tex_y * 8;
+			extra.texture_width = (header >> 23) & 0x7;
+			extra.texture_height = (header >> 20) & 0x7;
+			extra.texture_page = (header >> 12) & 0x1f;
+			extra.texture_palette = (header >> 28) & 0xf;
+			extra.texture_mirror_x = ((cmd & 0x10) ? 0x1 : 0);
+			extra.texture_mirror_y = ((cmd & 0x10) ? 0x1 : 0);
+			extra.color = color;
+			extra.light_r = light_r;       extra.light_g = light_g;       extra.light_b = light_b;
+			extra.ambient_r = ambient_r;   extra.ambient_g = ambient_g;   extra.ambient_b = ambient_b;
+			extra.fog_r = fog_r;           extra.fog_g = fog_g;           extra.fog_b = fog_b;
+			extra.flags = cmd;
 
 			if ((cmd & 0x20) == 0)      // possibly enable flag for gouraud shading (fixes some shading errors)
 			{
@@ -983,7 +1001,7 @@ static void render_polygons(running_machine &machine)
 					vertex3 = &v[2];
 				}
 
-				poly_render_triangle(poly, K001005_bitmap[K001005_bitmap_page], visarea, draw_scanline_tex, 6, vertex1, vertex2, vertex3);
+				poly->render_triangle(visarea, rd_scan_tex, 6, *vertex1, *vertex2, *vertex3);
 
 				memcpy(&prev_v[1], vertex1, sizeof(poly_vertex));
 				memcpy(&prev_v[2], vertex2, sizeof(poly_vertex));
@@ -1020,8 +1038,8 @@ static void render_polygons(running_machine &machine)
 					vertex4 = &v[3];
 				}
 
-				poly_render_triangle(poly, K001005_bitmap[K001005_bitmap_page], visarea, draw_scanline_tex, 6, vertex1, vertex2, vertex3);
-				poly_render_triangle(poly, K001005_bitmap[K001005_bitmap_page], visarea, draw_scanline_tex, 6, vertex3, vertex4, vertex1);
+				poly->render_triangle(visarea, rd_scan_tex, 6, *vertex1, *vertex2, *vertex3);
+				poly->render_triangle(visarea, rd_scan_tex, 6, *vertex3, *vertex4, *vertex1);
 
 				memcpy(&prev_v[0], vertex1, sizeof(poly_vertex));
 				memcpy(&prev_v[1], vertex2, sizeof(poly_vertex));
@@ -1031,7 +1049,8 @@ static void render_polygons(running_machine &machine)
 
 			while ((fifo[index] & 0xffffff00) != 0x80000000 && index < K001005_3d_fifo_ptr)
 			{
-				poly_extra_data *extra = (poly_extra_data *)poly_get_extra_data(poly);
+				gticlub_polydata &extra = poly->object_data_alloc();
+				extra.destmap = K001005_bitmap[K001005_bitmap_page];
 				int new_verts = 0;
 
 				memcpy(&v[0], &prev_v[2], sizeof(poly_vertex));
@@ -1083,22 +1102,22 @@ static void render_polygons(running_machine &machine)
 				}
 				while (!last_vertex);
 
-				extra->texture_x = tex_x * 8;
-				extra->texture_y = tex_y * 8;
-				extra->texture_width = (header >> 23) & 0x7;
-				extra->texture_height = (header >> 20) & 0x7;
+				extra.texture_x = tex_x * 8;
+				extra.texture_y = tex_y * 8;
+				extra.texture_width = (header >> 23) & 0x7;
+				extra.texture_height = (header >> 20) & 0x7;
 
-				extra->texture_page = (header >> 12) & 0x1f;
-				extra->texture_palette = (header >> 28) & 0xf;
+				extra.texture_page = (header >> 12) & 0x1f;
+				extra.texture_palette = (header >> 28) & 0xf;
 
-				extra->texture_mirror_x = ((cmd & 0x10) ? 0x1 : 0);// & ((header & 0x00400000) ? 0x1 : 0);
-				extra->texture_mirror_y = ((cmd & 0x10) ? 0x1 : 0);// & ((header & 0x00400000) ? 0x1 : 0);
+				extra.texture_mirror_x = ((cmd & 0x10) ? 0x1 : 0);// & ((header & 0x00400000) ? 0x1 : 0);
+				extra.texture_mirror_y = ((cmd & 0x10) ? 0x1 : 0);// & ((header & 0x00400000) ? 0x1 : 0);
 
-				extra->color = color;
-				extra->light_r = light_r;       extra->light_g = light_g;       extra->light_b = light_b;
-				extra->ambient_r = ambient_r;   extra->ambient_g = ambient_g;   extra->ambient_b = ambient_b;
-				extra->fog_r = fog_r;           extra->fog_g = fog_g;           extra->fog_b = fog_b;
-				extra->flags = cmd;
+				extra.color = color;
+				extra.light_r = light_r;       extra.light_g = light_g;       extra.light_b = light_b;
+				extra.ambient_r = ambient_r;   extra.ambient_g = ambient_g;   extra.ambient_b = ambient_b;
+				extra.fog_r = fog_r;           extra.fog_g = fog_g;           extra.fog_b = fog_b;
+				extra.flags = cmd;
 
 				if ((cmd & 0x20) == 0)      // possibly enable flag for gouraud shading (fixes some shading errors)
 				{
@@ -1108,7 +1127,7 @@ static void render_polygons(running_machine &machine)
 
 				if (new_verts == 1)
 				{
-					poly_render_triangle(poly, K001005_bitmap[K001005_bitmap_page], visarea, draw_scanline_tex, 6, &v[0], &v[1], &v[2]);
+					poly->render_triangle(visarea, rd_scan_tex, 6, v[0], v[1], v[2]);
 
 					memcpy(&prev_v[1], &v[0], sizeof(poly_vertex));
 					memcpy(&prev_v[2], &v[1], sizeof(poly_vertex));
@@ -1116,8 +1135,8 @@ static void render_polygons(running_machine &machine)
 				}
 				else if (new_verts == 2)
 				{
-					poly_render_triangle(poly, K001005_bitmap[K001005_bitmap_page], visarea, draw_scanline_tex, 6, &v[0], &v[1], &v[2]);
-					poly_render_triangle(poly, K001005_bitmap[K001005_bitmap_page], visarea, draw_scanline_tex, 6, &v[2], &v[3], &v[0]);
+					poly->render_triangle(visarea, rd_scan_tex, 6, v[0], v[1], v[2]);
+					poly->render_triangle(visarea, rd_scan_tex, 6, v[2], v[3], v[0]);
 
 					memcpy(&prev_v[0], &v[0], sizeof(poly_vertex));
 					memcpy(&prev_v[1], &v[1], sizeof(poly_vertex));
@@ -1130,7 +1149,8 @@ static void render_polygons(running_machine &machine)
 		{
 			// no texture, Z
 
-			poly_extra_data *extra = (poly_extra_data *)poly_get_extra_data(poly);
+			gticlub_polydata &extra = poly->object_data_alloc();
+			extra.destmap = K001005_bitmap[K001005_bitmap_page];
 			UINT32 color;
 			int r, g, b, a;
 
@@ -1172,11 +1192,11 @@ static void render_polygons(running_machine &machine)
 			color = (a << 24) | (r << 16) | (g << 8) | (b);
 			index++;
 
-			extra->color = color;
-			extra->light_r = light_r;       extra->light_g = light_g;       extra->light_b = light_b;
-			extra->ambient_r = ambient_r;   extra->ambient_g = ambient_g;   extra->ambient_b = ambient_b;
-			extra->fog_r = fog_r;           extra->fog_g = fog_g;           extra->fog_b = fog_b;
-			extra->flags = cmd;
+			extra.color = color;
+			extra.light_r = light_r;       extra.light_g = light_g;       extra.light_b = light_b;
+			extra.ambient_r = ambient_r;   extra.ambient_g = ambient_g;   extra.ambient_b = ambient_b;
+			extra.fog_r = fog_r;           extra.fog_g = fog_g;           extra.fog_b = fog_b;
+			extra.flags = cmd;
 
 			if ((cmd & 0x20) == 0)      // possibly enable flag for gouraud shading (fixes some shading errors)
 			{
@@ -1205,7 +1225,7 @@ static void render_polygons(running_machine &machine)
 					vertex3 = &v[2];
 				}
 
-				poly_render_triangle(poly, K001005_bitmap[K001005_bitmap_page], visarea, draw_scanline, 3, vertex1, vertex2, vertex3);
+				poly->render_triangle(visarea, rd_scan, 3, *vertex1, *vertex2, *vertex3);
 
 				memcpy(&prev_v[1], vertex1, sizeof(poly_vertex));
 				memcpy(&prev_v[2], vertex2, sizeof(poly_vertex));
@@ -1242,7 +1262,8 @@ static void render_polygons(running_machine &machine)
 					vertex4 = &v[3];
 				}
 
-				poly_render_quad(poly, K001005_bitmap[K001005_bitmap_page], visarea, draw_scanline, 3, vertex1, vertex2, vertex3, vertex4);
+				poly_vertex quad[4] = { *vertex1, *vertex2, *vertex3, *vertex4 };
+				poly->render_polygon<4>(visarea, rd_scan, 3, quad);
 
 				memcpy(&prev_v[0], vertex1, sizeof(poly_vertex));
 				memcpy(&prev_v[1], vertex2, sizeof(poly_vertex));
@@ -1297,11 +1318,11 @@ static void render_polygons(running_machine &machine)
 				color = (a << 24) | (r << 16) | (g << 8) | (b);
 				index++;
 
-				extra->color = color;
-				extra->light_r = light_r;       extra->light_g = light_g;       extra->light_b = light_b;
-				extra->ambient_r = ambient_r;   extra->ambient_g = ambient_g;   extra->ambient_b = ambient_b;
-				extra->fog_r = fog_r;           extra->fog_g = fog_g;           extra->fog_b = fog_b;
-				extra->flags = cmd;
+				extra.color = color;
+				extra.light_r = light_r;       extra.light_g = light_g;       extra.light_b = light_b;
+				extra.ambient_r = ambient_r;   extra.ambient_g = ambient_g;   extra.ambient_b = ambient_b;
+				extra.fog_r = fog_r;           extra.fog_g = fog_g;           extra.fog_b = fog_b;
+				extra.flags = cmd;
 
 				if ((cmd & 0x20) == 0)      // possibly enable flag for gouraud shading (fixes some shading errors)
 				{
@@ -1311,7 +1332,7 @@ static void render_polygons(running_machine &machine)
 
 				if (new_verts == 1)
 				{
-					poly_render_triangle(poly, K001005_bitmap[K001005_bitmap_page], visarea, draw_scanline, 3, &v[0], &v[1], &v[2]);
+					poly->render_triangle(visarea, rd_scan, 3, v[0], v[1], v[2]);
 
 					memcpy(&prev_v[1], &v[0], sizeof(poly_vertex));
 					memcpy(&prev_v[2], &v[1], sizeof(poly_vertex));
@@ -1319,7 +1340,7 @@ static void render_polygons(running_machine &machine)
 				}
 				else if (new_verts == 2)
 				{
-					poly_render_quad(poly, K001005_bitmap[K001005_bitmap_page], visarea, draw_scanline, 3, &v[0], &v[1], &v[2], &v[3]);
+					poly->render_polygon<4>(visarea, rd_scan, 3, v);
 
 					memcpy(&prev_v[0], &v[0], sizeof(poly_vertex));
 					memcpy(&prev_v[1], &v[1], sizeof(poly_vertex));
@@ -1332,7 +1353,8 @@ static void render_polygons(running_machine &machine)
 		{
 			// no texture, no Z
 
-			poly_extra_data *extra = (poly_extra_data *)poly_get_extra_data(poly);
+			gticlub_polydata &extra = poly->object_data_alloc();
+			extra.destmap = K001005_bitmap[K001005_bitmap_page];
 			int r, g, b, a;
 			UINT32 color;
 
@@ -1367,16 +1389,16 @@ static void render_polygons(running_machine &machine)
 			color = (a << 24) | (r << 16) | (g << 8) | (b);
 			index++;
 
-			extra->color = color;
-			extra->flags = cmd;
+			extra.color = color;
+			extra.flags = cmd;
 
 			if (poly_type == 0)
 			{
-				poly_render_triangle(poly, K001005_bitmap[K001005_bitmap_page], visarea, draw_scanline_2d, 0, &v[0], &v[1], &v[2]);
+				poly->render_triangle(visarea, rd_scan_2d, 0, v[0], v[1], v[2]);
 			}
 			else
 			{
-				poly_render_quad(poly, K001005_bitmap[K001005_bitmap_page], visarea, draw_scanline_2d, 0, &v[0], &v[1], &v[2], &v[3]);
+				poly->render_polygon<4>(visarea, rd_scan_2d, 0, v);
 			}
 		}
 		else if (cmd == 0x8000008b)
@@ -1384,7 +1406,8 @@ static void render_polygons(running_machine &machine)
 			// texture, no Z
 
 			int tex_x, tex_y;
-			poly_extra_data *extra = (poly_extra_data *)poly_get_extra_data(poly);
+			gticlub_polydata &extra = poly->object_data_alloc();
+			extra.destmap = K001005_bitmap[K001005_bitmap_page];
 			int r, g, b, a;
 			UINT32 color = 0;
 
@@ -1430,8 +1453,8 @@ static void render_polygons(running_machine &machine)
 			g = (color >>  8) & 0xff;
 			b = (color >> 16) & 0xff;
 			a = (color >> 24) & 0xff;
-			extra->color = (a << 24) | (r << 16) | (g << 8) | (b);
-			extra->flags = cmd;
+			extra.color = (a << 24) | (r << 16) | (g << 8) | (b);
+			extra.flags = cmd;
 
 			tex_y = ((header & 0x400) >> 5) |
 					((header & 0x100) >> 4) |
@@ -1447,31 +1470,32 @@ static void render_polygons(running_machine &machine)
 					((header & 0x008) >> 2) |
 					((header & 0x002) >> 1);
 
-			extra->texture_x = tex_x * 8;
-			extra->texture_y = tex_y * 8;
-			extra->texture_width = (header >> 23) & 0x7;
-			extra->texture_height = (header >> 20) & 0x7;
+			extra.texture_x = tex_x * 8;
+			extra.texture_y = tex_y * 8;
+			extra.texture_width = (header >> 23) & 0x7;
+			extra.texture_height = (header >> 20) & 0x7;
 
-			extra->texture_page = (header >> 12) & 0x1f;
-			extra->texture_palette = (header >> 28) & 0xf;
+			extra.texture_page = (header >> 12) & 0x1f;
+			extra.texture_palette = (header >> 28) & 0xf;
 
-			extra->texture_mirror_x = ((cmd & 0x10) ? 0x1 : 0);
-			extra->texture_mirror_y = ((cmd & 0x10) ? 0x1 : 0);
+			extra.texture_mirror_x = ((cmd & 0x10) ? 0x1 : 0);
+			extra.texture_mirror_y = ((cmd & 0x10) ? 0x1 : 0);
 
 			if (poly_type == 0)
 			{
-				poly_render_triangle(poly, K001005_bitmap[K001005_bitmap_page], visarea, draw_scanline_2d_tex, 5, &v[0], &v[1], &v[2]);
+				poly->render_triangle(visarea, rd_scan_2d_tex, 5, v[0], v[1], v[2]);
 			}
 			else
 			{
-				poly_render_quad(poly, K001005_bitmap[K001005_bitmap_page], visarea, draw_scanline_2d_tex, 5, &v[0], &v[1], &v[2], &v[3]);
+				poly->render_polygon<4>(visarea, rd_scan_2d_tex, 5, v);
 			}
 		}
 		else if (cmd == 0x80000121 || cmd == 0x80000126)
 		{
 			// no texture, color gouraud, Z
 
-			poly_extra_data *extra = (poly_extra_data *)poly_get_extra_data(poly);
+			gticlub_polydata &extra = poly->object_data_alloc();
+			extra.destmap = K001005_bitmap[K001005_bitmap_page];
 			UINT32 color;
 
 			int last_vertex = 0;
@@ -1507,16 +1531,16 @@ static void render_polygons(running_machine &machine)
 			}
 			while (!last_vertex);
 
-			extra->color = color;
-			extra->flags = cmd;
+			extra.color = color;
+			extra.flags = cmd;
 
 			if (poly_type == 0)
 			{
-				poly_render_triangle(poly, K001005_bitmap[K001005_bitmap_page], visarea, draw_scanline_gouraud_blend, 6, &v[0], &v[1], &v[2]);
+				poly->render_triangle(visarea, rd_scan_gouraud_blend, 6, v[0], v[1], v[2]);
 			}
 			else
 			{
-				poly_render_quad(poly, K001005_bitmap[K001005_bitmap_page], visarea, draw_scanline_gouraud_blend, 6, &v[0], &v[1], &v[2], &v[3]);
+				poly->render_polygon<4>(visarea, rd_scan_gouraud_blend, 6, v);
 			}
 
 			// TODO: can this poly type form strips?
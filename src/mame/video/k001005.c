@@ -14,17 +14,6 @@
 /***************************************************************************/
 
 
-struct poly_extra_data
-{
-	UINT32 color;
-	int texture_x, texture_y;
-	int texture_page;
-	int texture_palette;
-	int texture_mirror_x;
-	int texture_mirror_y;
-};
-
-
 const device_type K001005 = &device_creator<k001005_device>;
 
 k001005_device::k001005_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock)
@@ -119,7 +108,7 @@ void k001005_device::device_start()
 
 	m_3d_fifo = auto_alloc_array(machine(), UINT32, 0x10000);
 
-	m_poly = poly_alloc(machine(), 4000, sizeof(poly_extra_data), POLYFLAG_ALLOW_QUADS);
+	m_poly = auto_alloc(machine(), k001005_renderer(*m_screen));
 
 	for (i = 0; i < 128; i++)
 	{
@@ -162,7 +151,11 @@ void k001005_device::device_reset()
 	m_3d_fifo_ptr = 0;
 	m_bitmap_page = 0;
 
-	memset(m_prev_v, 0, sizeof(m_prev_v));
+	for (int i = 0; i < 4; i++)
+	{
+		m_prev_v[i].x = m_prev_v[i].y = 0;
+		memset(m_prev_v[i].p, 0, sizeof(m_prev_v[i].p));
+	}
 	m_prev_poly_type = 0;
 }
 
@@ -172,7 +165,6 @@ void k001005_device::device_reset()
 
 void k001005_device::device_stop()
 {
-	poly_free(m_poly);
 }
 
 
@@ -376,7 +368,7 @@ WRITE32_MEMBER( k001005_device::write )
 			{
 				swap_buffers();
 				render_polygons();
-				poly_wait(m_poly, "render_polygons");
+				m_poly->wait("render_polygons");
 				m_3d_fifo_ptr = 0;
 			}
 			break;
@@ -408,21 +400,20 @@ WRITE32_MEMBER( k001005_device::write )
 
 }
 
-/* emu/video/poly.c cannot handle atm callbacks passing a device parameter */
+/* the scanline functions are still unfinished (k001006 palette lookup, vertex setup) */
 
 #if POLY_DEVICE
-void k001005_device::draw_scanline( void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid )
+void k001005_device::draw_scanline(INT32 scanline, const k001005_renderer::extent_t &extent, const k001005_polydata &extradata, int threadid)
 {
-	const poly_extra_data *extra = (const poly_extra_data *)extradata;
-	bitmap_ind16 *destmap = (bitmap_ind16 *)dest;
-	float z = extent->param[0].start;
-	float dz = extent->param[0].dpdx;
+	bitmap_rgb32 *destmap = extradata.destmap;
+	float z = extent.param[0].start;
+	float dz = extent.param[0].dpdx;
 	UINT32 *fb = &destmap->pix32(scanline);
 	UINT32 *zb = &m_zbuffer->pix32(scanline);
-	UINT32 color = extra->color;
+	UINT32 color = extradata.color;
 	int x;
 
-	for (x = extent->startx; x < extent->stopx; x++)
+	for (x = extent.startx; x < extent.stopx; x++)
 	{
 		UINT32 iz = (UINT32)z >> 16;
 
@@ -441,32 +432,30 @@ void k001005_device::draw_scanline( void *dest, INT32 scanline, const poly_exten
 #endif
 
 #if POLY_DEVICE
-void k001005_device::draw_scanline_tex( device_t *device, void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid )
+void k001005_device::draw_scanline_tex(INT32 scanline, const k001005_renderer::extent_t &extent, const k001005_polydata &extradata, int threadid)
 {
-	k001005_state *k001005 = k001005_get_safe_token(device);
-	const poly_extra_data *extra = (const poly_extra_data *)extradata;
-	bitmap_ind16 *destmap = (bitmap_ind16 *)dest;
-	UINT8 *texrom = m_gfxrom + (extra->texture_page * 0x40000);
-	device_t *pal_device = (extra->texture_palette & 0x8) ? m_k001006_2 : m_k001006_1;
-	int palette_index = (extra->texture_palette & 0x7) * 256;
-	float z = extent->param[0].start;
-	float u = extent->param[1].start;
-	float v = extent->param[2].start;
-	float w = extent->param[3].start;
-	float dz = extent->param[0].dpdx;
-	float du = extent->param[1].dpdx;
-	float dv = extent->param[2].dpdx;
-	float dw = extent->param[3].dpdx;
-	int texture_mirror_x = extra->texture_mirror_x;
-	int texture_mirror_y = extra->texture_mirror_y;
-	int texture_x = extra->texture_x;
-	int texture_y = extra->texture_y;
+	bitmap_rgb32 *destmap = extradata.destmap;
+	UINT8 *texrom = m_gfxrom + (extradata.texture_page * 0x40000);
+	device_t *pal_device = (extradata.texture_palette & 0x8) ? m_k001006_2 : m_k001006_1;
+	int palette_index = (extradata.texture_palette & 0x7) * 256;
+	float z = extent.param[0].start;
+	float u = extent.param[1].start;
+	float v = extent.param[2].start;
+	float w = extent.param[3].start;
+	float dz = extent.param[0].dpdx;
+	float du = extent.param[1].dpdx;
+	float dv = extent.param[2].dpdx;
+	float dw = extent.param[3].dpdx;
+	int texture_mirror_x = extradata.texture_mirror_x;
+	int texture_mirror_y = extradata.texture_mirror_y;
+	int texture_x = extradata.texture_x;
+	int texture_y = extradata.texture_y;
 	int x;
 
 	UINT32 *fb = &destmap->pix32(scanline);
 	UINT32 *zb = &m_zbuffer->pix32(scanline);
 
-	for (x = extent->startx; x < extent->stopx; x++)
+	for (x = extent.startx; x < extent.stopx; x++)
 	{
 		UINT32 iz = (UINT32)z >> 16;
 		//int iu = u >> 16;
@@ -507,7 +496,9 @@ void k001005_device::render_polygons( )
 {
 	int i, j;
 #if POLY_DEVICE
-	const rectangle &visarea = visible_area();
+	const rectangle &visarea = m_screen->visible_area();
+	k001005_renderer::render_delegate rd_scanline = k001005_renderer::render_delegate(FUNC(k001005_device::draw_scanline), this);
+	k001005_renderer::render_delegate rd_scanline_tex = k001005_renderer::render_delegate(FUNC(k001005_device::draw_scanline_tex), this);
 #endif
 
 //  mame_printf_debug("m_fifo_ptr = %08X\n", m_3d_fifo_ptr);
@@ -516,7 +507,8 @@ void k001005_device::render_polygons( )
 	{
 		if (m_3d_fifo[i] == 0x80000003)
 		{
-			poly_extra_data *extra = (poly_extra_data *)poly_get_extra_data(m_poly);
+			k001005_polydata &extra = m_poly->object_data_alloc();
+			extra.destmap = m_bitmap[m_bitmap_page];
 //          poly_vertex v[4];
 			int r, g, b, a;
 			UINT32 color;
@@ -549,11 +541,11 @@ void k001005_device::render_polygons( )
 			color = (a << 24) | (r << 16) | (g << 8) | (b);
 			++index;
 
-			extra->color = color;
+			extra.color = color;
 #if POLY_DEVICE
-			poly_render_triangle(m_poly, m_bitmap[m_bitmap_page], &visarea, draw_scanline, 1, &v[0], &v[1], &v[2]);
-			poly_render_triangle(m_poly, m_bitmap[m_bitmap_page], &visarea, draw_scanline, 1, &v[0], &v[2], &v[3]);
-//          poly_render_polygon(m_poly, m_bitmap[m_bitmap_page],  &visarea, draw_scanline, 1, 4, v);
+			m_poly->render_triangle(visarea, rd_scanline, 1, v[0], v[1], v[2]);
+			m_poly->render_triangle(visarea, rd_scanline, 1, v[0], v[2], v[3]);
+//          m_poly->render_polygon<4>(visarea, rd_scanline, 1, v);
 #endif
 			i = index - 1;
 		}
@@ -571,7 +563,8 @@ void k001005_device::render_polygons( )
 			// 0x01: -------- -------- ----x-x- x-x-x-x-    Texture X / 8
 			// 0x01: -------- -------- -----x-x -x-x-x-x    Texture Y / 8
 
-			poly_extra_data *extra = (poly_extra_data *)poly_get_extra_data(m_poly);
+			k001005_polydata &extra = m_poly->object_data_alloc();
+			extra.destmap = m_bitmap[m_bitmap_page];
 			poly_vertex v[4];
 			int tx, ty;
 			UINT32 color = 0;
@@ -645,27 +638,27 @@ void k001005_device::render_polygons( )
 					((header & 0x008) >> 2) |
 					((header & 0x002) >> 1);
 
-			extra->texture_x = tx * 8;
-			extra->texture_y = ty * 8;
+			extra.texture_x = tx * 8;
+			extra.texture_y = ty * 8;
 
-			extra->texture_page = (header >> 12) & 0x1f;
-			extra->texture_palette = (header >> 28) & 0xf;
+			extra.texture_page = (header >> 12) & 0x1f;
+			extra.texture_palette = (header >> 28) & 0xf;
 
-			extra->texture_mirror_x = ((command & 0x10) ? 0x2 : 0) | ((header & 0x00400000) ? 0x1 : 0);
-			extra->texture_mirror_y = ((command & 0x10) ? 0x2 : 0) | ((header & 0x00400000) ? 0x1 : 0);
+			extra.texture_mirror_x = ((command & 0x10) ? 0x2 : 0) | ((header & 0x00400000) ? 0x1 : 0);
+			extra.texture_mirror_y = ((command & 0x10) ? 0x2 : 0) | ((header & 0x00400000) ? 0x1 : 0);
 
-			extra->color = color;
+			extra.color = color;
 
 			if (num_verts < 3)
 			{
 #if POLY_DEVICE
-				poly_render_triangle(m_poly, m_bitmap[m_bitmap_page], &visarea, draw_scanline_tex, 4, &m_prev_v[2], &v[0], &v[1]);
+				m_poly->render_triangle(visarea, rd_scanline_tex, 4, m_prev_v[2], v[0], v[1]);
 				if (m_prev_poly_type)
-					poly_render_triangle(m_poly, m_bitmap[m_bitmap_page], &visarea, draw_scanline_tex, 4, &m_prev_v[2], &m_prev_v[3], &v[0]);
+					m_poly->render_triangle(visarea, rd_scanline_tex, 4, m_prev_v[2], m_prev_v[3], v[0]);
 //              if (m_prev_poly_type)
-//                  poly_render_quad(m_poly, m_bitmap[m_bitmap_page], &visarea, draw_scanline_tex, 4, &m_prev_v[2], &m_prev_v[3], &v[0], &v[1]);
+//                  { poly_vertex quad[4] = { m_prev_v[2], m_prev_v[3], v[0], v[1] }; m_poly->render_polygon<4>(visarea, rd_scanline_tex, 4, quad); }
 //              else
-//                  poly_render_triangle(m_poly, m_bitmap[m_bitmap_page], &visarea, draw_scanline_tex, 4, &m_prev_v[2], &v[0], &v[1]);
+//                  m_poly->render_triangle(visarea, rd_scanline_tex, 4, m_prev_v[2], v[0], v[1]);
 #endif
 				memcpy(&m_prev_v[0], &m_prev_v[2], sizeof(poly_vertex));
 				memcpy(&m_prev_v[1], &m_prev_v[3], sizeof(poly_vertex));
@@ -675,10 +668,10 @@ void k001005_device::render_polygons( )
 			else
 			{
 #if POLY_DEVICE
-				poly_render_triangle(m_poly, m_bitmap[m_bitmap_page], &visarea, draw_scanline_tex, 4, &v[0], &v[1], &v[2]);
+				m_poly->render_triangle(visarea, rd_scanline_tex, 4, v[0], v[1], v[2]);
 				if (num_verts > 3)
-					poly_render_triangle(m_poly, m_bitmap[m_bitmap_page], &visarea, draw_scanline_tex, 4, &v[2], &v[3], &v[0]);
-//              poly_render_polygon(m_poly, m_bitmap[m_bitmap_page], &visarea, draw_scanline_tex, 4, num_verts, v);
+					m_poly->render_triangle(visarea, rd_scanline_tex, 4, v[2], v[3], v[0]);
+//              m_poly->render_polygon<4>(visarea, rd_scanline_tex, 4, v);
 #endif
 				memcpy(m_prev_v, v, sizeof(poly_vertex) * 4);
 			}
@@ -687,7 +680,8 @@ void k001005_device::render_polygons( )
 
 			while ((m_3d_fifo[index] & 0xffffff00) != 0x80000000 && index < m_3d_fifo_ptr)
 			{
-				poly_extra_data *extra = (poly_extra_data *)poly_get_extra_data(m_poly);
+				k001005_polydata &extra = m_poly->object_data_alloc();
+				extra.destmap = m_bitmap[m_bitmap_page];
 #if POLY_DEVICE
 				int new_verts = 0;
 #endif
@@ -751,22 +745,22 @@ void k001005_device::render_polygons( )
 						break;
 				}
 
-				extra->texture_x = tx * 8;
-				extra->texture_y = ty * 8;
+				extra.texture_x = tx * 8;
+				extra.texture_y = ty * 8;
 
-				extra->texture_page = (header >> 12) & 0x1f;
-				extra->texture_palette = (header >> 28) & 0xf;
+				extra.texture_page = (header >> 12) & 0x1f;
+				extra.texture_palette = (header >> 28) & 0xf;
 
-				extra->texture_mirror_x = ((command & 0x10) ? 0x2 : 0) | ((header & 0x00400000) ? 0x1 : 0);
-				extra->texture_mirror_y = ((command & 0x10) ? 0x2 : 0) | ((header & 0x00400000) ? 0x1 : 0);
+				extra.texture_mirror_x = ((command & 0x10) ? 0x2 : 0) | ((header & 0x00400000) ? 0x1 : 0);
+				extra.texture_mirror_y = ((command & 0x10) ? 0x2 : 0) | ((header & 0x00400000) ? 0x1 : 0);
 
-				extra->color = color;
+				extra.color = color;
 
 #if POLY_DEVICE
-				poly_render_triangle(m_poly, m_bitmap[m_bitmap_page], &visarea, draw_scanline_tex, 4, &v[0], &v[1], &v[2]);
+				m_poly->render_triangle(visarea, rd_scanline_tex, 4, v[0], v[1], v[2]);
 				if (new_verts > 1)
-					poly_render_triangle(m_poly, m_bitmap[m_bitmap_page], &visarea, draw_scanline_tex, 4, &v[2], &v[3], &v[0]);
-//              poly_render_polygon(m_poly, m_bitmap[m_bitmap_page], &visarea, draw_scanline_tex, 4, new_verts + 2, v);
+					m_poly->render_triangle(visarea, rd_scanline_tex, 4, v[2], v[3], v[0]);
+//              m_poly->render_polygon<4>(visarea, rd_scanline_tex, 4, v);
 #endif
 				memcpy(m_prev_v, v, sizeof(poly_vertex) * 4);
 			};
@@ -776,7 +770,8 @@ void k001005_device::render_polygons( )
 		else if (m_3d_fifo[i] == 0x80000006 || m_3d_fifo[i] == 0x80000026 ||
 					m_3d_fifo[i] == 0x80000020 || m_3d_fifo[i] == 0x80000022)
 		{
-			poly_extra_data *extra = (poly_extra_data *)poly_get_extra_data(m_poly);
+			k001005_polydata &extra = m_poly->object_data_alloc();
+			extra.destmap = m_bitmap[m_bitmap_page];
 			poly_vertex v[4];
 			int r, g, b, a;
 			UINT32 color;
@@ -820,19 +815,20 @@ void k001005_device::render_polygons( )
 			color = (a << 24) | (r << 16) | (g << 8) | (b);
 			index++;
 
-			extra->color = color;
+			extra.color = color;
 
 #if POLY_DEVICE
-			poly_render_triangle(m_poly, m_bitmap[m_bitmap_page], &visarea, draw_scanline, 1, &v[0], &v[1], &v[2]);
+			m_poly->render_triangle(visarea, rd_scanline, 1, v[0], v[1], v[2]);
 			if (num_verts > 3)
-				poly_render_triangle(m_poly, m_bitmap[m_bitmap_page], &visarea, draw_scanline, 1, &v[2], &v[3], &v[0]);
-//          poly_render_polygon(m_poly, m_bitmap[m_bitmap_page], &visarea, draw_scanline, 1, num_verts, v);
+				m_poly->render_triangle(visarea, rd_scanline, 1, v[2], v[3], v[0]);
+//          m_poly->render_polygon<4>(visarea, rd_scanline, 1, v);
 #endif
 			memcpy(m_prev_v, v, sizeof(poly_vertex) * 4);
 
 			while ((m_3d_fifo[index] & 0xffffff00) != 0x80000000 && index < m_3d_fifo_ptr)
 			{
-				poly_extra_data *extra = (poly_extra_data *)poly_get_extra_data(m_poly);
+				k001005_polydata &extra = m_poly->object_data_alloc();
+				extra.destmap = m_bitmap[m_bitmap_page];
 				int new_verts = 0;
 
 				if (poly_type)
@@ -880,13 +876,13 @@ void k001005_device::render_polygons( )
 				color = (a << 24) | (r << 16) | (g << 8) | (b);
 				index++;
 
-				extra->color = color;
+				extra.color = color;
 
 #if POLY_DEVICE
-				poly_render_triangle(m_poly, m_bitmap[m_bitmap_page], &visarea, draw_scanline, 1, &v[0], &v[1], &v[2]);
+				m_poly->render_triangle(visarea, rd_scanline, 1, v[0], v[1], v[2]);
 				if (new_verts > 1)
-					poly_render_triangle(m_poly, m_bitmap[m_bitmap_page], &visarea, draw_scanline, 1, &v[0], &v[2], &v[3]);
-//              poly_render_polygon(m_poly, m_bitmap[m_bitmap_page], &visarea, draw_scanline, 1, new_verts + 2, v);
+					m_poly->render_triangle(visarea, rd_scanline, 1, v[0], v[2], v[3]);
+//              m_poly->render_polygon<4>(visarea, rd_scanline, 1, v);
 #endif
 				memcpy(m_prev_v, v, sizeof(poly_vertex) * 4);
 			};
@@ -2,11 +2,25 @@
 #ifndef __K001005_H__
 #define __K001005_H__
 
-#include "video/poly.h"
+#include "video/polynew.h"
 #include "cpu/sharc/sharc.h"
 
 #define POLY_DEVICE 0
 
+struct k001005_polydata
+{
+	bitmap_rgb32 *destmap;
+	UINT32 color;
+	int texture_x, texture_y;
+	int texture_page;
+	int texture_palette;
+	int texture_mirror_x;
+	int texture_mirror_y;
+};
+
+typedef poly_manager<float, k001005_polydata, 4, 4000> k001005_renderer;
+typedef k001005_renderer::vertex_t poly_vertex;
+
 struct k001005_interface
 {
 	const char     *m_cpu_tag;
@@ -34,8 +48,8 @@ public:
 
 	#if POLY_DEVICE
 
-	void draw_scanline( void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid );
-	void draw_scanline_tex( void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid );
+	void draw_scanline(INT32 scanline, const k001005_renderer::extent_t &extent, const k001005_polydata &extradata, int threadid);
+	void draw_scanline_tex(INT32 scanline, const k001005_renderer::extent_t &extent, const k001005_polydata &extradata, int threadid);
 
 
 	#endif
@@ -75,7 +89,7 @@ private:
 
 	int m_bitmap_page;
 
-	poly_manager *m_poly;
+	k001005_renderer *m_poly;
 	poly_vertex m_prev_v[4];
 	int m_prev_poly_type;
 
@@ -8,7 +8,7 @@
 
 #include "emu.h"
 #include "includes/midzeus.h"
-#include "video/poly.h"
+#include "video/polynew.h"
 #include "video/rgbutil.h"
 
 
@@ -35,7 +35,7 @@
  *
  *************************************/
 
-struct poly_extra_data
+struct mz_poly_extra_data
 {
 	const void *    palbase;
 	const void *    texbase;
@@ -50,6 +50,21 @@ struct poly_extra_data
 };
 
 
+class midzeus_renderer : public poly_manager<float, mz_poly_extra_data, 4, 10000>
+{
+public:
+	midzeus_renderer(running_machine &machine)
+		: poly_manager<float, mz_poly_extra_data, 4, 10000>(machine)
+	{
+	}
+
+	void render_poly_texture(INT32 scanline, const extent_t &extent, const mz_poly_extra_data &extra, int threadid);
+	void render_poly_shade(INT32 scanline, const extent_t &extent, const mz_poly_extra_data &extra, int threadid);
+	void render_poly_solid(INT32 scanline, const extent_t &extent, const mz_poly_extra_data &extra, int threadid);
+	void render_poly_solid_fixedz(INT32 scanline, const extent_t &extent, const mz_poly_extra_data &extra, int threadid);
+};
+
+
 
 /*************************************
  *
@@ -57,7 +72,7 @@ struct poly_extra_data
  *
  *************************************/
 
-static poly_manager *poly;
+static midzeus_renderer *poly;
 static UINT8 log_fifo;
 
 static UINT32 zeus_fifo[20];
@@ -97,11 +112,6 @@ INLINE UINT8 get_texel_alt_4bit(const void *base, int y, int x, int width);
 INLINE UINT8 get_texel_8bit(const void *base, int y, int x, int width);
 INLINE UINT8 get_texel_alt_8bit(const void *base, int y, int x, int width);
 
-static void render_poly_texture(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
-static void render_poly_shade(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
-static void render_poly_solid(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
-static void render_poly_solid_fixedz(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
-
 static void log_fifo_command(const UINT32 *data, int numwords, const char *suffix);
 static void log_waveram(UINT32 length_and_base);
 
@@ -272,7 +282,7 @@ VIDEO_START_MEMBER(midzeus_state,midzeus)
 		palette_set_color_rgb(machine(), i, pal5bit(i >> 10), pal5bit(i >> 5), pal5bit(i >> 0));
 
 	/* initialize polygon engine */
-	poly = poly_alloc(machine(), 10000, sizeof(poly_extra_data), POLYFLAG_ALLOW_QUADS);
+	poly = auto_alloc(machine(), midzeus_renderer(machine()));
 
 	/* we need to cleanup on exit */
 	machine().add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(midzeus_state::exit_handler), this));
@@ -317,8 +327,6 @@ void midzeus_state::exit_handler()
 	}
 	fclose(f);
 #endif
-
-	poly_free(poly);
 }
 
 
@@ -333,7 +341,7 @@ UINT32 midzeus_state::screen_update_midzeus(screen_device &screen, bitmap_ind16
 {
 	int x, y;
 
-	poly_wait(poly, "VIDEO_UPDATE");
+	poly->wait("VIDEO_UPDATE");
 
 	/* normal update case */
 	if (!machine().input().code_pressed(KEYCODE_W))
@@ -641,8 +649,8 @@ static void zeus_register_update(running_machine &machine, offs_t offset)
 					// state->m_zeusbase[0x46] = ??? = 0x00000000
 					// state->m_zeusbase[0x4c] = ??? = 0x00808080 (brightness?)
 					// state->m_zeusbase[0x4e] = ??? = 0x00808080 (brightness?)
-					poly_extra_data *extra = (poly_extra_data *)poly_get_extra_data(poly);
-					poly_vertex vert[4];
+					mz_poly_extra_data &extra = poly->object_data_alloc();
+					midzeus_renderer::vertex_t vert[4];
 
 					vert[0].x = (INT16)state->m_zeusbase[0x08];
 					vert[0].y = (INT16)(state->m_zeusbase[0x08] >> 16);
@@ -653,11 +661,11 @@ static void zeus_register_update(running_machine &machine, offs_t offset)
 					vert[3].x = (INT16)state->m_zeusbase[0x0e];
 					vert[3].y = (INT16)(state->m_zeusbase[0x0e] >> 16);
 
-					extra->solidcolor = state->m_zeusbase[0x00];
-					extra->zoffset = 0x7fff;
+					extra.solidcolor = state->m_zeusbase[0x00];
+					extra.zoffset = 0x7fff;
 
-					poly_render_quad(poly, NULL, zeus_cliprect, render_poly_solid_fixedz, 0, &vert[0], &vert[1], &vert[2], &vert[3]);
-					poly_wait(poly, "Normal");
+					poly->render_polygon<4>(zeus_cliprect, midzeus_renderer::render_delegate(FUNC(midzeus_renderer::render_poly_solid_fixedz), poly), 0, vert);
+					poly->wait("Normal");
 				}
 				else
 					logerror("Execute unknown command\n");
@@ -730,7 +738,7 @@ static void zeus_register_update(running_machine &machine, offs_t offset)
 				else
 					src = (const UINT32 *)waveram0_ptr_from_expanded_addr(state->m_zeusbase[0xb4]);
 
-				poly_wait(poly, "vram_read");
+				poly->wait("vram_read");
 				state->m_zeusbase[0xb0] = WAVERAM_READ32(src, 0);
 				state->m_zeusbase[0xb2] = WAVERAM_READ32(src, 1);
 			}
@@ -1105,10 +1113,9 @@ static void zeus_draw_model(running_machine &machine, UINT32 texdata, int logit)
 static void zeus_draw_quad(running_machine &machine, int long_fmt, const UINT32 *databuffer, UINT32 texdata, int logit)
 {
 	midzeus_state *state = machine.driver_data<midzeus_state>();
-	poly_draw_scanline_func callback;
-	poly_extra_data *extra;
-	poly_vertex clipvert[8];
-	poly_vertex vert[4];
+	midzeus_renderer::render_delegate callback;
+	midzeus_renderer::vertex_t clipvert[8];
+	midzeus_renderer::vertex_t vert[4];
 	float uscale, vscale;
 	float maxy, maxx;
 	int val2, texbase, texwshift;
@@ -1207,7 +1214,7 @@ static void zeus_draw_quad(running_machine &machine, int long_fmt, const UINT32
 		}
 	}
 
-	numverts = poly_zclip_if_less(4, &vert[0], &clipvert[0], 4, 512.0f);
+	numverts = poly->zclip_if_less(4, &vert[0], &clipvert[0], 4, 512.0f);
 	if (numverts < 3)
 		return;
 
@@ -1234,32 +1241,32 @@ static void zeus_draw_quad(running_machine &machine, int long_fmt, const UINT32
 			clipvert[i].y += 0.0005f;
 	}
 
-	extra = (poly_extra_data *)poly_get_extra_data(poly);
+	mz_poly_extra_data &extra = poly->object_data_alloc();
 
 	if ((ctrl_word & 0x000c0000) == 0x000c0000)
 	{
-		callback = render_poly_solid;
+		callback = midzeus_renderer::render_delegate(FUNC(midzeus_renderer::render_poly_solid), poly);
 	}
 	else if (val2 == 0x182)
 	{
-		callback = render_poly_shade;
+		callback = midzeus_renderer::render_delegate(FUNC(midzeus_renderer::render_poly_shade), poly);
 	}
 	else if (ctrl_word & 0x01000000)
 	{
 		int tex_type = val2 & 3;
 
-		callback = render_poly_texture;
-		extra->texwidth = 512 >> texwshift;
-		extra->voffset = ctrl_word & 0xffff;
-		extra->texbase = waveram0_ptr_from_texture_addr(texbase, extra->texwidth);
+		callback = midzeus_renderer::render_delegate(FUNC(midzeus_renderer::render_poly_texture), poly);
+		extra.texwidth = 512 >> texwshift;
+		extra.voffset = ctrl_word & 0xffff;
+		extra.texbase = waveram0_ptr_from_texture_addr(texbase, extra.texwidth);
 
 		if (tex_type == 1)
 		{
-			extra->get_texel = (val2 & 0x20) ? get_texel_8bit : get_texel_4bit;
+			extra.get_texel = (val2 & 0x20) ? get_texel_8bit : get_texel_4bit;
 		}
 		else if (tex_type == 2)
 		{
-			extra->get_texel = (val2 & 0x20) ? get_texel_alt_8bit : get_texel_alt_4bit;
+			extra.get_texel = (val2 & 0x20) ? get_texel_alt_8bit : get_texel_alt_4bit;
 		}
 		else
 		{
@@ -1272,13 +1279,19 @@ static void zeus_draw_quad(running_machine &machine, int long_fmt, const UINT32
 		printf("Unknown draw mode: %.8x\n", ctrl_word);
 		return;
 	}
-	extra->solidcolor = state->m_zeusbase[0x00] & 0x7fff;
-	extra->zoffset = state->m_zeusbase[0x7e] >> 16;
-	extra->alpha = state->m_zeusbase[0x4e];
-	extra->transcolor = ((ctrl_word >> 16) & 1) ? 0 : 0x100;
-	extra->palbase = waveram0_ptr_from_block_addr(zeus_palbase);
-
-	poly_render_quad_fan(poly, NULL, zeus_cliprect, callback, 4, numverts, &clipvert[0]);
+	extra.solidcolor = state->m_zeusbase[0x00] & 0x7fff;
+	extra.zoffset = state->m_zeusbase[0x7e] >> 16;
+	extra.alpha = state->m_zeusbase[0x4e];
+	extra.transcolor = ((ctrl_word >> 16) & 1) ? 0 : 0x100;
+	extra.palbase = waveram0_ptr_from_block_addr(zeus_palbase);
+
+	/* a quad clipped against the near plane is still a single convex polygon */
+	if (numverts == 3)
+		poly->render_triangle(zeus_cliprect, callback, 4, clipvert[0], clipvert[1], clipvert[2]);
+	else if (numverts == 4)
+		poly->render_polygon<4>(zeus_cliprect, callback, 4, clipvert);
+	else
+		poly->render_polygon<5>(zeus_cliprect, callback, 4, clipvert);
 }
 
 
@@ -1289,38 +1302,37 @@ static void zeus_draw_quad(running_machine &machine, int long_fmt, const UINT32
  *
  *************************************/
 
-static void render_poly_texture(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid)
+void midzeus_renderer::render_poly_texture(INT32 scanline, const extent_t &extent, const mz_poly_extra_data &extra, int threadid)
 {
-	const poly_extra_data *extra = (const poly_extra_data *)extradata;
-	INT32 curz = extent->param[0].start;
-	INT32 curu = extent->param[1].start;
-	INT32 curv = extent->param[2].start;
-	//INT32 curi = extent->param[3].start;
-	INT32 dzdx = extent->param[0].dpdx;
-	INT32 dudx = extent->param[1].dpdx;
-	INT32 dvdx = extent->param[2].dpdx;
-	//INT32 didx = extent->param[3].dpdx;
-	const void *texbase = extra->texbase;
-	const void *palbase = extra->palbase;
-	UINT16 transcolor = extra->transcolor;
-	int texwidth = extra->texwidth;
+	INT32 curz = extent.param[0].start;
+	INT32 curu = extent.param[1].start;
+	INT32 curv = extent.param[2].start;
+	//INT32 curi = extent.param[3].start;
+	INT32 dzdx = extent.param[0].dpdx;
+	INT32 dudx = extent.param[1].dpdx;
+	INT32 dvdx = extent.param[2].dpdx;
+	//INT32 didx = extent.param[3].dpdx;
+	const void *texbase = extra.texbase;
+	const void *palbase = extra.palbase;
+	UINT16 transcolor = extra.transcolor;
+	int texwidth = extra.texwidth;
 	int x;
 
-	for (x = extent->startx; x < extent->stopx; x++)
+	for (x = extent.startx; x < extent.stopx; x++)
 	{
 		UINT16 *depthptr = WAVERAM_PTRDEPTH(zeus_renderbase, scanline, x);
-		INT32 depth = (curz >> 16) + extra->zoffset;
+		INT32 depth = (curz >> 16) + extra.zoffset;
 		if (depth > 0x7fff) depth = 0x7fff;
 		if (depth >= 0 && depth <= *depthptr)
 		{
 			int u0 = (curu >> 8);
-			int v0 = (curv >> 8) + extra->voffset;
+			int v0 = (curv >> 8) + extra.voffset;
 			int u1 = (u0 + 1);
 			int v1 = (v0 + 1);
-			UINT8 texel0 = extra->get_texel(texbase, v0, u0, texwidth);
-			UINT8 texel1 = extra->get_texel(texbase, v0, u1, texwidth);
-			UINT8 texel2 = extra->get_texel(texbase, v1, u0, texwidth);
-			UINT8 texel3 = extra->get_texel(texbase, v1, u1, texwidth);
+			UINT8 texel0 = extra.get_texel(texbase, v0, u0, texwidth);
+			UINT8 texel1 = extra.get_texel(texbase, v0, u1, texwidth);
+			UINT8 texel2 = extra.get_texel(texbase, v1, u0, texwidth);
+			UINT8 texel3 = extra.get_texel(texbase, v1, u1, texwidth);
 			if (texel0 != transcolor)
 			{
 				rgb_t color0 = WAVERAM_READ16(palbase, texel0);
@@ -1345,23 +1357,22 @@ static void render_poly_texture(void *dest, INT32 scanline, const poly_extent *e
 	}
 }
 
-static void render_poly_shade(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid)
+void midzeus_renderer::render_poly_shade(INT32 scanline, const extent_t &extent, const mz_poly_extra_data &extra, int threadid)
 {
-	const poly_extra_data *extra = (const poly_extra_data *)extradata;
 	int x;
 
-	for (x = extent->startx; x < extent->stopx; x++)
+	for (x = extent.startx; x < extent.stopx; x++)
 	{
 		if (x >= 0 && x < 400)
 		{
-			if (extra->alpha <= 0x80)
+			if (extra.alpha <= 0x80)
 			{
 				UINT16 *ptr = WAVERAM_PTRPIX(zeus_renderbase, scanline, x);
 				UINT16 pix = *ptr;
 
-				*ptr = ((((pix & 0x7c00) * extra->alpha) >> 7) & 0x7c00) |
-						((((pix & 0x03e0) * extra->alpha) >> 7) & 0x03e0) |
-						((((pix & 0x001f) * extra->alpha) >> 7) & 0x001f);
+				*ptr = ((((pix & 0x7c00) * extra.alpha) >> 7) & 0x7c00) |
+						((((pix & 0x03e0) * extra.alpha) >> 7) & 0x03e0) |
+						((((pix & 0x001f) * extra.alpha) >> 7) & 0x001f);
 			}
 			else
 			{
@@ -1372,19 +1383,18 @@ static void render_poly_shade(void *dest, INT32 scanline, const poly_extent *ext
 }
 
 
-static void render_poly_solid(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid)
+void midzeus_renderer::render_poly_solid(INT32 scanline, const extent_t &extent, const mz_poly_extra_data &extra, int threadid)
 {
-	const poly_extra_data *extra = (const poly_extra_data *)extradata;
-	UINT16 color = extra->solidcolor;
-	INT32 curz = (INT32)(extent->param[0].start);
-	INT32 curv = extent->param[2].start;
-	INT32 dzdx = (INT32)(extent->param[0].dpdx);
-	INT32 dvdx = extent->param[2].dpdx;
+	UINT16 color = extra.solidcolor;
+	INT32 curz = (INT32)(extent.param[0].start);
+	INT32 curv = extent.param[2].start;
+	INT32 dzdx = (INT32)(extent.param[0].dpdx);
+	INT32 dvdx = extent.param[2].dpdx;
 	int x;
 
-	for (x = extent->startx; x < extent->stopx; x++)
+	for (x = extent.startx; x < extent.stopx; x++)
 	{
-		INT32 depth = (curz >> 16) + extra->zoffset;
+		INT32 depth = (curz >> 16) + extra.zoffset;
 		if (depth > 0x7fff) depth = 0x7fff;
 		if (depth >= 0)
 		{
@@ -1398,14 +1408,13 @@ static void render_poly_solid(void *dest, INT32 scanline, const poly_extent *ext
 }
 
 
-static void render_poly_solid_fixedz(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid)
+void midzeus_renderer::render_poly_solid_fixedz(INT32 scanline, const extent_t &extent, const mz_poly_extra_data &extra, int threadid)
 {
-	const poly_extra_data *extra = (const poly_extra_data *)extradata;
-	UINT16 color = extra->solidcolor;
-	UINT16 depth = extra->zoffset;
+	UINT16 color = extra.solidcolor;
+	UINT16 depth = extra.zoffset;
 	int x;
 
-	for (x = extent->startx; x < extent->stopx; x++)
+	for (x = extent.startx; x < extent.stopx; x++)
 		waveram_plot_depth(scanline, x, color, depth);
 }
 
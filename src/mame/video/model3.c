@@ -1,5 +1,4 @@
 #include "emu.h"
-#include "video/poly.h"
 #include "video/rgbutil.h"
 #include "includes/model3.h"
 
@@ -14,7 +13,7 @@
 
 struct TRIANGLE
 {
-	poly_vertex v[3];
+	model3_renderer::vertex_t v[3];
 	UINT8 texture_x, texture_y;
 	UINT8 texture_width, texture_height;
 	UINT8 transparency;
@@ -33,16 +32,6 @@ struct cached_texture
 	rgb_t       data[1];
 };
 
-struct poly_extra_data
-{
-	cached_texture *texture;
-	bitmap_ind32 *zbuffer;
-	UINT32 color;
-	UINT8 texture_param;
-	int polygon_transparency;
-	int polygon_intensity;
-};
-
 #define TRI_PARAM_TEXTURE_PAGE          0x1
 #define TRI_PARAM_TEXTURE_MIRROR_U      0x2
 #define TRI_PARAM_TEXTURE_MIRROR_V      0x4
@@ -109,17 +98,17 @@ void model3_state::model3_exit()
 {
 	invalidate_texture(machine(), 0, 0, 0, 6, 5);
 	invalidate_texture(machine(), 1, 0, 0, 6, 5);
-	poly_free(m_poly);
 }
 
 void model3_state::video_start()
 {
-	m_poly = poly_alloc(machine(), 4000, sizeof(poly_extra_data), 0);
 	machine().add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(model3_state::model3_exit), this));
 
 	m_screen->register_screen_bitmap(m_bitmap3d);
 	m_screen->register_screen_bitmap(m_zbuffer);
 
+	m_renderer = auto_alloc(machine(), model3_renderer(machine(), m_bitmap3d, m_zbuffer));
+
 	m_m3_char_ram = auto_alloc_array_clear(machine(), UINT64, 0x100000/8);
 	m_m3_tile_ram = auto_alloc_array_clear(machine(), UINT64, 0x8000/8);
 
@@ -977,7 +966,7 @@ INLINE int is_point_inside(float x, float y, float z, PLANE cp)
 		return 0;
 }
 
-INLINE float line_plane_intersection(const poly_vertex *v1, const poly_vertex *v2, PLANE cp)
+INLINE float line_plane_intersection(const model3_renderer::vertex_t *v1, const model3_renderer::vertex_t *v2, PLANE cp)
 {
 	float x = v1->x - v2->x;
 	float y = v1->y - v2->y;
@@ -986,9 +975,9 @@ INLINE float line_plane_intersection(const poly_vertex *v1, const poly_vertex *v
 	return t;
 }
 
-static int clip_polygon(const poly_vertex *v, int num_vertices, PLANE cp, poly_vertex *vout)
+static int clip_polygon(const model3_renderer::vertex_t *v, int num_vertices, PLANE cp, model3_renderer::vertex_t *vout)
 {
-	poly_vertex clipv[10];
+	model3_renderer::vertex_t clipv[10];
 	int clip_verts = 0;
 	float t;
 	int i;
@@ -1041,16 +1030,17 @@ static int clip_polygon(const poly_vertex *v, int num_vertices, PLANE cp, poly_v
 static void render_one(running_machine &machine, TRIANGLE *tri)
 {
 	model3_state *state = machine.driver_data<model3_state>();
-	poly_extra_data *extra = (poly_extra_data *)poly_get_extra_data(state->m_poly);
-	poly_draw_scanline_func callback = NULL;
+	model3_renderer *renderer = state->m_renderer;
+	m3_polydata &extra = renderer->object_data_alloc();
 
 	tri->v[0].pz = 1.0f / tri->v[0].pz;
 	tri->v[1].pz = 1.0f / tri->v[1].pz;
 	tri->v[2].pz = 1.0f / tri->v[2].pz;
 
-	extra->zbuffer = &state->m_zbuffer;
 	if (tri->param & TRI_PARAM_TEXTURE_ENABLE)
 	{
+		model3_renderer::render_delegate callback;
+
 		tri->v[0].pu = tri->v[0].pu * tri->v[0].pz * 256.0f;
 		tri->v[0].pv = tri->v[0].pv * tri->v[0].pz * 256.0f;
 		tri->v[1].pu = tri->v[1].pu * tri->v[1].pz * 256.0f;
@@ -1058,26 +1048,28 @@ static void render_one(running_machine &machine, TRIANGLE *tri)
 		tri->v[2].pu = tri->v[2].pu * tri->v[2].pz * 256.0f;
 		tri->v[2].pv = tri->v[2].pv * tri->v[2].pz * 256.0f;
 
-		extra->texture = get_texture(machine, (tri->param & TRI_PARAM_TEXTURE_PAGE) ? 1 : 0, tri->texture_x, tri->texture_y, tri->texture_width, tri->texture_height, tri->texture_format);
-		extra->texture_param        = tri->param;
-		extra->polygon_transparency = tri->transparency;
-		extra->polygon_intensity    = tri->intensity;
+		extra.texture = get_texture(machine, (tri->param & TRI_PARAM_TEXTURE_PAGE) ? 1 : 0, tri->texture_x, tri->texture_y, tri->texture_width, tri->texture_height, tri->texture_format);
+		extra.texture_param        = tri->param;
+		extra.polygon_transparency = tri->transparency;
+		extra.polygon_intensity    = tri->intensity;
 
 		if (tri->param & TRI_PARAM_ALPHA_TEST)
-			callback = draw_scanline_alpha_test;
-		else if (extra->texture->alpha == 0xff)
-			callback = (tri->transparency >= 32) ? draw_scanline_normal : draw_scanline_trans;
+			callback = model3_renderer::render_delegate(FUNC(model3_renderer::draw_scanline_alpha_test), renderer);
+		else if (extra.texture->alpha != 0xff)
+			callback = model3_renderer::render_delegate(FUNC(model3_renderer::draw_scanline_alpha), renderer);
+		else if (tri->transparency >= 32)
+			callback = model3_renderer::render_delegate(FUNC(model3_renderer::draw_scanline_normal), renderer);
 		else
-			callback = draw_scanline_alpha;
-		poly_render_triangle(state->m_poly, &state->m_bitmap3d, state->m_clip3d, callback, 3, &tri->v[0], &tri->v[1], &tri->v[2]);
+			callback = model3_renderer::render_delegate(FUNC(model3_renderer::draw_scanline_trans), renderer);
+		renderer->render_triangle(state->m_clip3d, callback, 3, tri->v[0], tri->v[1], tri->v[2]);
 	}
 	else
 	{
-		extra->polygon_transparency = tri->transparency;
-		extra->polygon_intensity    = tri->intensity;
-		extra->color                = tri->color;
+		extra.polygon_transparency = tri->transparency;
+		extra.polygon_intensity    = tri->intensity;
+		extra.color                = tri->color;
 
-		poly_render_triangle(state->m_poly, &state->m_bitmap3d, state->m_clip3d, draw_scanline_color, 1, &tri->v[0], &tri->v[1], &tri->v[2]);
+		renderer->render_triangle(state->m_clip3d, model3_renderer::render_delegate(FUNC(model3_renderer::draw_scanline_color), renderer), 1, tri->v[0], tri->v[1], tri->v[2]);
 	}
 }
 
@@ -1091,9 +1083,9 @@ static void draw_model(running_machine &machine, UINT32 addr)
 	int num_vertices;
 	int i, v, vi;
 	float fixed_point_fraction;
-	poly_vertex vertex[4];
-	poly_vertex prev_vertex[4];
-	poly_vertex clip_vert[10];
+	model3_renderer::vertex_t vertex[4];
+	model3_renderer::vertex_t prev_vertex[4];
+	model3_renderer::vertex_t clip_vert[10];
 
 	MATRIX transform_matrix;
 	float center_x, center_y;
@@ -1110,7 +1102,11 @@ static void draw_model(running_machine &machine, UINT32 addr)
 	center_x = (float)(state->m_viewport_region_x + (state->m_viewport_region_width / 2));
 	center_y = (float)(state->m_viewport_region_y + (state->m_viewport_region_height / 2));
 
-	memset(prev_vertex, 0, sizeof(prev_vertex));
+	for (i = 0; i < 4; i++)
+	{
+		prev_vertex[i].x = prev_vertex[i].y = 0;
+		memset(prev_vertex[i].p, 0, sizeof(prev_vertex[i].p));
+	}
 
 	while (!last_polygon)
 	{
@@ -1209,7 +1205,7 @@ static void draw_model(running_machine &machine, UINT32 addr)
 		}
 
 		/* Copy current vertices as previous vertices */
-		memcpy(prev_vertex, vertex, sizeof(poly_vertex) * 4);
+		memcpy(prev_vertex, vertex, sizeof(model3_renderer::vertex_t) * 4);
 
 		color = (((header[4] >> 27) & 0x1f) << 10) | (((header[4] >> 19) & 0x1f) << 5) | ((header[4] >> 11) & 0x1f);
 		polygon_transparency =  (header[6] & 0x800000) ? 32 : ((header[6] >> 18) & 0x1f);
@@ -1298,9 +1294,9 @@ static void draw_model(running_machine &machine, UINT32 addr)
 
 			for (i=2; i < num_vertices; i++)
 			{
-				memcpy(&tri.v[0], &clip_vert[0], sizeof(poly_vertex));
-				memcpy(&tri.v[1], &clip_vert[i-1], sizeof(poly_vertex));
-				memcpy(&tri.v[2], &clip_vert[i], sizeof(poly_vertex));
+				memcpy(&tri.v[0], &clip_vert[0], sizeof(model3_renderer::vertex_t));
+				memcpy(&tri.v[1], &clip_vert[i-1], sizeof(model3_renderer::vertex_t));
+				memcpy(&tri.v[2], &clip_vert[i], sizeof(model3_renderer::vertex_t));
 				tri.texture_x               = ((header[4] & 0x1f) << 1) | ((header[5] >> 7) & 0x1);
 				tri.texture_y               = (header[5] & 0x1f);
 				tri.texture_width           = ((header[3] >> 3) & 0x7);
@@ -1543,5 +1539,5 @@ static void real3d_traverse_display_list(running_machine &machine)
 	for (pri = 0; pri < 4; pri++)
 		draw_viewport(machine, pri, 0x800000);
 
-	poly_wait(state->m_poly, "real3d_traverse_display_list");
+	state->m_renderer->wait("real3d_traverse_display_list");
 }
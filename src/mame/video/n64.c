@@ -23,12 +23,15 @@ TODO:
 *******************************************************************************/
 
 #include "emu.h"
+#include <zlib.h>
 #include "includes/n64.h"
 #include "video/n64.h"
 
 #define LOG_RDP_EXECUTION       0
+#define LOG_RDP_FRAME_CRCS      0
 
 static FILE *rdp_exec;
+static FILE *rdp_frames;
 
 UINT32 n64_rdp::s_special_9bit_clamptable[512];
 
@@ -73,7 +76,7 @@ void n64_rdp::GetAlphaCvg(UINT8 *comb_alpha, rdp_span_aux *userdata, const rdp_p
 	}
 	if (object.OtherModes.alpha_cvg_select)
 	{
-		temp = (OtherModes.cvg_times_alpha) ? (temp3 >> 3) : (temp2 << 5);
+		temp = (object.OtherModes.cvg_times_alpha) ? (temp3 >> 3) : (temp2 << 5);
 	}
 	if (temp > 0xff)
 	{
@@ -906,7 +909,7 @@ UINT32 n64_rdp::DZCompress(UINT32 value)
 	return j;
 }
 
-void n64_rdp::GetDitherValues(int x, int y, int* cdith, int* adith, const rdp_poly_state& object)
+void n64_rdp::GetDitherValues(int x, int y, int* cdith, int* adith, rdp_span_aux *userdata, const rdp_poly_state& object)
 {
 	int dithindex = ((y & 3) << 2) | (x & 3);
 	switch((object.OtherModes.rgb_dither_sel << 2) | object.OtherModes.alpha_dither_sel)
@@ -920,7 +923,7 @@ void n64_rdp::GetDitherValues(int x, int y, int* cdith, int* adith, const rdp_po
 		break;
 	case 2:
 		*cdith = s_magic_matrix[dithindex];
-		*adith = machine().rand() & 7;
+		*adith = rdp_span_noise(userdata) & 7;
 		break;
 	case 3:
 		*cdith = s_magic_matrix[dithindex];
@@ -935,26 +938,26 @@ void n64_rdp::GetDitherValues(int x, int y, int* cdith, int* adith, const rdp_po
 		break;
 	case 6:
 		*cdith = s_bayer_matrix[dithindex];
-		*adith = machine().rand() & 7;
+		*adith = rdp_span_noise(userdata) & 7;
 		break;
 	case 7:
 		*cdith = s_bayer_matrix[dithindex];
 		*adith = 0;
 		break;
 	case 8:
-		*cdith = machine().rand() & 7;
+		*cdith = rdp_span_noise(userdata) & 7;
 		*adith = s_magic_matrix[dithindex];
 		break;
 	case 9:
-		*cdith = machine().rand() & 7;
+		*cdith = rdp_span_noise(userdata) & 7;
 		*adith = (~s_magic_matrix[dithindex]) & 7;
 		break;
 	case 10:
-		*cdith = machine().rand() & 7;
+		*cdith = rdp_span_noise(userdata) & 7;
 		*adith = (*cdith + 17) & 7;
 		break;
 	case 11:
-		*cdith = machine().rand() & 7;
+		*cdith = rdp_span_noise(userdata) & 7;
 		*adith = 0;
 		break;
 	case 12:
@@ -967,7 +970,7 @@ void n64_rdp::GetDitherValues(int x, int y, int* cdith, int* adith, const rdp_po
 		break;
 	case 14:
 		*cdith = 0;
-		*adith = m_machine->rand() & 7;
+		*adith = rdp_span_noise(userdata) & 7;
 		break;
 	case 15:
 		*adith = *cdith = 0;
@@ -2685,6 +2688,67 @@ void n64_rdp::_Fill32Bit(UINT32 curpixel, const rdp_poly_state &object)
 	HWRITEADDR8((object.MiscState.FBAddress >> 1) + (curpixel << 1) + 1, (FillColor & 0x1) ? 3 : 0);
 }
 
+// fill count pixels from curpixel on; the colour and hidden bits are the same
+// as _Fill16Bit gives them, but whole RDRAM words are written at a time
+void n64_rdp::_FillRun16Bit(UINT32 curpixel, UINT32 count, const rdp_poly_state &object)
+{
+	UINT32 index = (object.MiscState.FBAddress >> 1) + curpixel;
+
+	// a run starting in the low half of a word gets its first pixel on its own
+	if (index & 1)
+	{
+		_Fill16Bit(curpixel, object);
+		curpixel++;
+		index++;
+		count--;
+	}
+
+	// each word then holds an even and an odd pixel, which take the high and
+	// low halves of FillColor; if the framebuffer does not start on a word
+	// boundary, the halves swap
+	UINT32 FillColor = object.FillColor;
+	UINT32 pair = (curpixel & 1) ? ((FillColor << 16) | (FillColor >> 16)) : FillColor;
+	UINT8 hidden_hi = (pair & 0x10000) ? 3 : 0;
+	UINT8 hidden_lo = (pair & 1) ? 3 : 0;
+
+	UINT32 words = count >> 1;
+	UINT32 *dst = &rdram[index >> 1];
+	for (UINT32 i = 0; i < words; i++)
+	{
+		dst[i] = pair;
+	}
+	for (UINT32 i = 0; i < words; i++)
+	{
+		HWRITEADDR8(index + (i << 1), hidden_hi);
+		HWRITEADDR8(index + (i << 1) + 1, hidden_lo);
+	}
+
+	if (count & 1)
+	{
+		_Fill16Bit(curpixel + (words << 1), object);
+	}
+}
+
+void n64_rdp::_FillRun32Bit(UINT32 curpixel, UINT32 count, const rdp_poly_state &object)
+{
+	UINT32 FillColor = object.FillColor;
+	UINT8 hidden_hi = (FillColor & 0x10000) ? 3 : 0;
+	UINT8 hidden_lo = (FillColor & 1) ? 3 : 0;
+
+	UINT32 *dst = &rdram[(object.MiscState.FBAddress >> 2) + curpixel];
+	for (UINT32 i = 0; i < count; i++)
+	{
+		dst[i] = FillColor;
+	}
+
+	UINT32 hidden = (object.MiscState.FBAddress >> 1) + (curpixel << 1);
+	for (UINT32 i = 0; i < count; i++)
+	{
+		HWRITEADDR8(hidden + (i << 1), hidden_hi);
+		HWRITEADDR8(hidden + (i << 1) + 1, hidden_lo);
+	}
+}
+
 ////////////////////////
 // RDP COMMANDS
 ////////////////////////
@@ -2874,7 +2938,8 @@ void n64_rdp::CmdSyncTile(UINT32 w1, UINT32 w2)
 
 void n64_rdp::CmdSyncFull(UINT32 w1, UINT32 w2)
 {
-	//wait("SyncFull");
+	// the CPU may read back anything rendered so far once it sees the interrupt
+	FlushPipe("SyncFull");
 	dp_full_sync(*m_machine);
 }
 
@@ -2897,7 +2962,7 @@ void n64_rdp::CmdSetFillColor32(UINT32 w1, UINT32 w2)
 
 void n64_rdp::CmdSetConvert(UINT32 w1, UINT32 w2)
 {
-	if(!m_pipe_clean) { m_pipe_clean = true; wait("SetConvert"); }
+	if(!m_pipe_clean) { FlushPipe("SetConvert"); }
 	INT32 k0 = (w1 >> 13) & 0xff;
 	INT32 k1 = (w1 >> 4) & 0xff;
 	INT32 k2 = ((w1 & 7) << 5) | ((w2 >> 27) & 0x1f);
@@ -2975,6 +3040,9 @@ void n64_rdp::CmdLoadTLUT(UINT32 w1, UINT32 w2)
 	//wait("LoadTLUT");
 	N64Tile* tile = m_tiles;
 
+	UINT32 tlut_rowbytes = (MiscState.TIWidth << MiscState.TISize) >> 1;
+	SyncRDRAMRead(MiscState.TIAddress + ((w1 & 0xfff) >> 2) * tlut_rowbytes, MiscState.TIAddress + (((w2 & 0xfff) >> 2) + 1) * tlut_rowbytes);
+
 	int tilenum = (w2 >> 24) & 0x7;
 	int sl = tile[tilenum].sl = ((w1 >> 12) & 0xfff);
 	int tl = tile[tilenum].tl =  w1 & 0xfff;
@@ -3057,6 +3125,9 @@ void n64_rdp::CmdLoadBlock(UINT32 w1, UINT32 w2)
 	{
 		width = (width & ~7) + 8;
 	}
+
+	UINT32 block_start = MiscState.TIAddress + tl * ((MiscState.TIWidth << MiscState.TISize) >> 1) + ((sl << MiscState.TISize) >> 1);
+	SyncRDRAMRead(block_start, block_start + width);
 	width >>= 3;
 
 	UINT32 tb = tile[tilenum].tmem << 2;
@@ -3217,6 +3288,9 @@ void n64_rdp::CmdLoadTile(UINT32 w1, UINT32 w2)
 
 	INT32 width = (sh - sl) + 1;
 	INT32 height = (th - tl) + 1;
+
+	UINT32 tile_rowbytes = (MiscState.TIWidth << MiscState.TISize) >> 1;
+	SyncRDRAMRead(MiscState.TIAddress + tl * tile_rowbytes, MiscState.TIAddress + (th + 1) * tile_rowbytes);
 /*
     int topad;
     if (MiscState.TISize < 3)
@@ -3677,6 +3751,10 @@ n64_rdp::n64_rdp(n64_state &state) : poly_manager<UINT32, rdp_poly_state, 8, 320
 	AuxBufPtr = 0;
 	AuxBuf = NULL;
 	m_pipe_clean = true;
+	m_inflight_start = ~0;
+	m_inflight_end = 0;
+	m_noise_frame = 0;
+	m_noise_prim = 0;
 
 	m_pending_mode_block = false;
 
@@ -3796,6 +3874,13 @@ void n64_state::video_start()
 	{
 		rdp_exec = fopen("rdp_execute.txt", "wt");
 	}
+
+	// src/regtests/n64rdp compares this log between runs with and without
+	// worker threads to check the threaded span renderer
+	if (LOG_RDP_FRAME_CRCS)
+	{
+		rdp_frames = fopen("rdp_frames.txt", "wt");
+	}
 }
 
 UINT32 n64_state::screen_update_n64(screen_device &screen, bitmap_rgb32 &bitmap, const rectangle &cliprect)
@@ -3841,7 +3926,7 @@ UINT32 n64_state::screen_update_n64(screen_device &screen, bitmap_rgb32 &bitmap,
 	}
 	*/
 
-	m_rdp->wait();
+	m_rdp->FlushPipe("Video update");
 	m_rdp->AuxBufPtr = 0;
 
 	if (n64->vi_blank)
@@ -3852,5 +3937,16 @@ UINT32 n64_state::screen_update_n64(screen_device &screen, bitmap_rgb32 &bitmap,
 
 	m_rdp->VideoUpdate(n64, bitmap);
 
+	// log a checksum of each frame, so that the output of the threaded span
+	// renderer can be compared against a known-good run of the same input
+	if (LOG_RDP_FRAME_CRCS)
+	{
+		UINT32 crc = 0;
+		for (int y = m_rdp->visarea.min_y; y <= m_rdp->visarea.max_y; y++)
+			crc = crc32(crc, (UINT8 *)&bitmap.pix32(y, m_rdp->visarea.min_x), m_rdp->visarea.width() * 4);
+		fprintf(rdp_frames, "%d %08X\n", (int)screen.frame_number(), crc);
+		fflush(rdp_frames);
+	}
+
 	return 0;
 }
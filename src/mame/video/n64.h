@@ -160,6 +160,21 @@ enum
 	BIT_DEPTH_COUNT
 };
 
+// shapes of the combiner equation (a - b) * c + d that a span can be
+// specialized for; all combiner inputs are 8-bit, so neither shortcut
+// can overflow or need clamping
+enum
+{
+	COMBINE_GENERIC = 0,
+	COMBINE_ADD,                // c is zero, giving d
+	COMBINE_MODULATE,           // b and d are zero, giving a * c
+
+	COMBINE_COUNT
+};
+
+// template argument for a specialized span part that is looked up per pixel
+#define SPAN_MODE_ANY           (-1)
+
 class SpanParam
 {
 	public:
@@ -369,8 +384,18 @@ struct rdp_span_aux
 	INT32               m_dzpix_enc;
 	UINT8               *m_tmem;                /* pointer to texture cache for this polygon */
 	bool                m_start_span;
+	UINT32              m_noise_seed;           /* noise generator state for this span */
 };
 
+// Noise is generated per span rather than from a shared generator, so that
+// spans can be drawn on any thread without contending for (or perturbing)
+// the machine's random number state
+INLINE UINT32 rdp_span_noise(rdp_span_aux *userdata)
+{
+	userdata->m_noise_seed = userdata->m_noise_seed * 1103515245 + 12345;
+	return userdata->m_noise_seed >> 16;
+}
+
 struct Rectangle
 {
 	UINT16 m_xl;    // 10.2 fixed-point
@@ -393,6 +418,7 @@ struct rdp_poly_state
 	int                 tilenum;                /* texture tile index */
 	bool                flip;                   /* left-major / right-major flip */
 	bool                rect;                   /* primitive is rectangle (vs. triangle) */
+	UINT32              NoiseSeed;              /* seed for the per-span noise generators */
 };
 
 //class n64_state;
@@ -458,6 +484,8 @@ class n64_rdp : public poly_manager<UINT32, rdp_poly_state, 8, 32000>
 		// Color Combiner
 		INT32       ColorCombinerEquation(INT32 a, INT32 b, INT32 c, INT32 d);
 		INT32       AlphaCombinerEquation(INT32 a, INT32 b, INT32 c, INT32 d);
+		template<int _Key> INT32 CombineRGB(INT32 a, INT32 b, INT32 c, INT32 d);
+		template<int _Key> INT32 CombineAlpha(INT32 a, INT32 b, INT32 c, INT32 d);
 		void        SetSubAInputRGB(UINT8 **input_r, UINT8 **input_g, UINT8 **input_b, int code, rdp_span_aux *userdata);
 		void        SetSubBInputRGB(UINT8 **input_r, UINT8 **input_g, UINT8 **input_b, int code, rdp_span_aux *userdata);
 		void        SetMulInputRGB(UINT8 **input_r, UINT8 **input_g, UINT8 **input_b, int code, rdp_span_aux *userdata);
@@ -492,11 +520,23 @@ class n64_rdp : public poly_manager<UINT32, rdp_poly_state, 8, 32000>
 		void    SpanDrawCopy(INT32 scanline, const extent_t &extent, const rdp_poly_state &object, int threadid);
 		void    SpanDrawFill(INT32 scanline, const extent_t &extent, const rdp_poly_state &object, int threadid);
 
+		// Spans specialized on their texture cycle, framebuffer read, blend
+		// mode and combiner equation shapes, picked once per span
+		typedef void (n64_rdp::*SpanDrawer)(INT32 scanline, const extent_t &extent, const rdp_poly_state &object);
+		template<int _TexCycle, int _ReadIndex, int _BlendIndex, int _CombineRGB, int _CombineAlpha>
+		void    SpanDraw1CycleT(INT32 scanline, const extent_t &extent, const rdp_poly_state &object);
+		template<int _TexCycle, int _ReadIndex, int _BlendIndex, int _CombineRGB0, int _CombineAlpha0, int _CombineRGB1, int _CombineAlpha1>
+		void    SpanDraw2CycleT(INT32 scanline, const extent_t &extent, const rdp_poly_state &object);
+		int     CombineKeyRGB(const rdp_span_aux *userdata, int cycle) const;
+		int     CombineKeyAlpha(const rdp_span_aux *userdata, int cycle) const;
+
 		// Render-related (move into eventual drawing-related classes?)
 		void            TCDiv(INT32 ss, INT32 st, INT32 sw, INT32* sss, INT32* sst);
 		void            TCDivNoPersp(INT32 ss, INT32 st, INT32 sw, INT32* sss, INT32* sst);
 		UINT32          GetLog2(UINT32 lod_clamp);
 		void            RenderSpans(int start, int end, int tilenum, bool flip, extent_t *Spans, bool rect, rdp_poly_state *object);
+		void            FlushPipe(const char *reason);
+		void            SyncRDRAMRead(UINT32 start, UINT32 end);
 		void            GetAlphaCvg(UINT8 *comb_alpha, rdp_span_aux *userdata, const rdp_poly_state &object);
 		const UINT8*    GetBayerMatrix() const { return s_bayer_matrix; }
 		const UINT8*    GetMagicMatrix() const { return s_magic_matrix; }
@@ -558,7 +598,7 @@ class n64_rdp : public poly_manager<UINT32, rdp_poly_state, 8, 32000>
 		UINT32      AddRightCvg(UINT32 x, UINT32 k);
 		UINT32      AddLeftCvg(UINT32 x, UINT32 k);
 
-		void        GetDitherValues(int x, int y, int* cdith, int* adith, const rdp_poly_state &object);
+		void        GetDitherValues(int x, int y, int* cdith, int* adith, rdp_span_aux *userdata, const rdp_poly_state &object);
 
 		UINT16 decompress_cvmask_frombyte(UINT8 x);
 		void lookup_cvmask_derivatives(UINT32 mask, UINT8* offx, UINT8* offy, rdp_span_aux *userdata);
@@ -614,6 +654,10 @@ class n64_rdp : public poly_manager<UINT32, rdp_poly_state, 8, 32000>
 		CombineModesT   m_combine;
 		bool            m_pending_mode_block;
 		bool            m_pipe_clean;
+		UINT32          m_inflight_start;       // lowest RDRAM address written by queued spans
+		UINT32          m_inflight_end;         // end of the RDRAM range written by queued spans
+		UINT32          m_noise_frame;          // frame the primitive counter below belongs to
+		UINT32          m_noise_prim;           // primitives queued so far this frame, seeds the noise
 
 		struct CVMASKDERIVATIVE
 		{
@@ -686,6 +730,17 @@ class n64_rdp : public poly_manager<UINT32, rdp_poly_state, 8, 32000>
 		void                _Copy32Bit(UINT32 curpixel, UINT32 r, UINT32 g, UINT32 b, int CurrentPixCvg, const rdp_poly_state &object);
 		void                _Fill16Bit(UINT32 curpixel, const rdp_poly_state &object);
 		void                _Fill32Bit(UINT32 curpixel, const rdp_poly_state &object);
+		void                _FillRun16Bit(UINT32 curpixel, UINT32 count, const rdp_poly_state &object);
+		void                _FillRun32Bit(UINT32 curpixel, UINT32 count, const rdp_poly_state &object);
+
+		// direct calls for the specialized spans, falling back to the tables above for SPAN_MODE_ANY
+		template<int _Cycle> void TexPipeCycle(int cycle, Color* TEX, Color* prev, INT32 SSS, INT32 SST, UINT32 tilenum, UINT32 num, rdp_span_aux *userdata, const rdp_poly_state& object, INT32 *m_clamp_s_diff, INT32 *m_clamp_t_diff);
+		template<int _Index> void ReadPixel(int index, UINT32 curpixel, rdp_span_aux *userdata, const rdp_poly_state &object);
+		template<int _Index> bool Blend1(int blend, int index, UINT32* fr, UINT32* fg, UINT32* fb, int dith, int adseed, int partialreject, int sel0, int acmode, rdp_span_aux *userdata, const rdp_poly_state& object);
+		template<int _Index> bool Blend2(int blend, int index, UINT32* fr, UINT32* fg, UINT32* fb, int dith, int adseed, int partialreject, int sel0, int sel1, int acmode, rdp_span_aux *userdata, const rdp_poly_state& object);
+
+		static const SpanDrawer s_span_1cycle[2][2][4];     // [bilinear][image read][combiner shapes]
+		static const SpanDrawer s_span_2cycle[2][2][4];
 
 		class ZDecompressEntry
 		{
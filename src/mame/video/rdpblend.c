@@ -329,17 +329,17 @@ void N64BlenderT::BlendEquationCycle1ForceSpecial(INT32* r, INT32* g, INT32* b,
 	BLEND_PIPE(1, 1, 0, 5);
 }
 
-bool N64BlenderT::AlphaCompareNone(UINT8 alpha, const rdp_span_aux *userdata, const rdp_poly_state& object)
+bool N64BlenderT::AlphaCompareNone(UINT8 alpha, rdp_span_aux *userdata, const rdp_poly_state& object)
 {
 	return false;
 }
 
-bool N64BlenderT::AlphaCompareNoDither(UINT8 alpha, const rdp_span_aux *userdata, const rdp_poly_state& object)
+bool N64BlenderT::AlphaCompareNoDither(UINT8 alpha, rdp_span_aux *userdata, const rdp_poly_state& object)
 {
 	return alpha < userdata->BlendColor.i.a;
 }
 
-bool N64BlenderT::AlphaCompareDither(UINT8 alpha, const rdp_span_aux *userdata, const rdp_poly_state& object)
+bool N64BlenderT::AlphaCompareDither(UINT8 alpha, rdp_span_aux *userdata, const rdp_poly_state& object)
 {
-	return alpha < (rand() & 0xff);
+	return alpha < (rdp_span_noise(userdata) & 0xff);
 }
@@ -29,7 +29,7 @@ class N64BlenderT
 		typedef bool (N64BlenderT::*Blender1)(UINT32* fr, UINT32* fg, UINT32* fb, int dith, int adseed, int partialreject, int sel0, int acmode, rdp_span_aux *userdata, const rdp_poly_state& object);
 		typedef bool (N64BlenderT::*Blender2)(UINT32* fr, UINT32* fg, UINT32* fb, int dith, int adseed, int partialreject, int sel0, int sel1, int acmode, rdp_span_aux *userdata, const rdp_poly_state& object);
 		typedef void (N64BlenderT::*BlendEquation)(INT32* r, INT32* g, INT32* b, rdp_span_aux *userdata, const rdp_poly_state& object);
-		typedef bool (N64BlenderT::*AlphaCompare)(UINT8 alpha, const rdp_span_aux *userdata, const rdp_poly_state& object);
+		typedef bool (N64BlenderT::*AlphaCompare)(UINT8 alpha, rdp_span_aux *userdata, const rdp_poly_state& object);
 
 		N64BlenderT();
 
@@ -42,6 +42,8 @@ class N64BlenderT
 		running_machine &machine() const { assert(m_machine != NULL); return *m_machine; }
 
 	private:
+		friend class n64_rdp;   // the specialized spans call the blenders directly
+
 		running_machine*    m_machine;
 		n64_rdp*            m_rdp;
 
@@ -77,9 +79,9 @@ class N64BlenderT
 		BlendEquation       cycle1[4];
 		AlphaCompare        compare[4];
 
-		bool                AlphaCompareNone(UINT8 alpha, const rdp_span_aux *userdata, const rdp_poly_state& object);
-		bool                AlphaCompareNoDither(UINT8 alpha, const rdp_span_aux *userdata, const rdp_poly_state& object);
-		bool                AlphaCompareDither(UINT8 alpha, const rdp_span_aux *userdata, const rdp_poly_state& object);
+		bool                AlphaCompareNone(UINT8 alpha, rdp_span_aux *userdata, const rdp_poly_state& object);
+		bool                AlphaCompareNoDither(UINT8 alpha, rdp_span_aux *userdata, const rdp_poly_state& object);
+		bool                AlphaCompareDither(UINT8 alpha, rdp_span_aux *userdata, const rdp_poly_state& object);
 
 		void                DitherRGB(INT32* r, INT32* g, INT32* b, int dith);
 		void                DitherA(UINT8* a, int dith);
@@ -58,6 +58,27 @@ void n64_rdp::RenderSpans(int start, int end, int tilenum, bool flip, extent_t *
 	object->FillColor = FillColor;
 	object->rect = rect;
 
+	// seed the noise from the frame and the primitive's place within it rather
+	// than from machine().rand(), so that a frame renders the same noise however
+	// the spans are scheduled and independently of anything else using the RNG
+	UINT32 frame = (UINT32)machine().primary_screen->frame_number();
+	if (frame != m_noise_frame)
+	{
+		m_noise_frame = frame;
+		m_noise_prim = 0;
+	}
+	object->NoiseSeed = (frame * 0x9e3779b9) ^ (m_noise_prim++ * 0x85ebca6b);
+
+	// remember which parts of RDRAM the queued spans may write, so that loads
+	// from those areas can wait for them (render-to-texture)
+	UINT32 fbstart = MiscState.FBAddress & 0x007fffff;
+	UINT32 fbend = fbstart + (((MiscState.FBWidth * clipy2) << MiscState.FBSize) >> 1);
+	UINT32 zbstart = MiscState.ZBAddress & 0x007fffff;
+	UINT32 zbend = zbstart + MiscState.FBWidth * clipy2 * 2;
+	m_inflight_start = MIN(m_inflight_start, MIN(fbstart, zbstart));
+	m_inflight_end = MAX(m_inflight_end, MAX(fbend, zbend));
+	m_pipe_clean = false;
+
 	switch(OtherModes.cycle_type)
 	{
 		case CYCLE_TYPE_1:
@@ -76,7 +97,28 @@ void n64_rdp::RenderSpans(int start, int end, int tilenum, bool flip, extent_t *
 			render_triangle_custom(visarea, render_delegate(FUNC(n64_rdp::SpanDrawFill), this), start, (end - start) + 1, Spans + offset);
 			break;
 	}
-	wait();
+
+	// spans carry their own copy of all render state, so there is no need
+	// to wait for them here; see FlushPipe and SyncRDRAMRead
+}
+
+void n64_rdp::FlushPipe(const char *reason)
+{
+	wait(reason);
+	m_pipe_clean = true;
+	m_inflight_start = ~0;
+	m_inflight_end = 0;
+}
+
+void n64_rdp::SyncRDRAMRead(UINT32 start, UINT32 end)
+{
+	UINT32 length = end - start;
+	start &= 0x007fffff;
+	end = start + length;
+	if (!m_pipe_clean && start < m_inflight_end && end > m_inflight_start)
+	{
+		FlushPipe("RDRAM read of rendered area");
+	}
 }
 
 void n64_rdp::RGBAZClip(int sr, int sg, int sb, int sa, int *sz, rdp_span_aux *userdata)
@@ -130,7 +172,136 @@ void n64_rdp::RGBAZCorrectTriangle(INT32 offx, INT32 offy, INT32* r, INT32* g, I
 	}
 }
 
-void n64_rdp::SpanDraw1Cycle(INT32 scanline, const extent_t &extent, const rdp_poly_state &object, int threadid)
+/*****************************************************************************
+    Specialized spans
+
+    Most 1- and 2-cycle primitives use one of a few texture filters and
+    blender modes, and a combiner that either modulates two inputs or
+    passes one through. Spans of those are drawn by instantiations of
+    SpanDraw1CycleT/SpanDraw2CycleT that call the texture pipe, blender
+    and framebuffer reader directly and skip the parts of the combiner
+    equation that are known to be zero. Everything else goes through the
+    SPAN_MODE_ANY/COMBINE_GENERIC instantiations, which look the same
+    functions up per pixel as before.
+*****************************************************************************/
+
+int n64_rdp::CombineKeyRGB(const rdp_span_aux *userdata, int cycle) const
+{
+	const ColorInputsT &in = userdata->ColorInputs;
+
+	if (in.combiner_rgbmul_r[cycle] == &ZeroColor.i.r && in.combiner_rgbmul_g[cycle] == &ZeroColor.i.g && in.combiner_rgbmul_b[cycle] == &ZeroColor.i.b)
+	{
+		return COMBINE_ADD;
+	}
+	if (in.combiner_rgbsub_b_r[cycle] == &ZeroColor.i.r && in.combiner_rgbsub_b_g[cycle] == &ZeroColor.i.g && in.combiner_rgbsub_b_b[cycle] == &ZeroColor.i.b &&
+		in.combiner_rgbadd_r[cycle] == &ZeroColor.i.r && in.combiner_rgbadd_g[cycle] == &ZeroColor.i.g && in.combiner_rgbadd_b[cycle] == &ZeroColor.i.b)
+	{
+		return COMBINE_MODULATE;
+	}
+	return COMBINE_GENERIC;
+}
+
+int n64_rdp::CombineKeyAlpha(const rdp_span_aux *userdata, int cycle) const
+{
+	const ColorInputsT &in = userdata->ColorInputs;
+
+	if (in.combiner_alphamul[cycle] == &ZeroColor.i.a)
+	{
+		return COMBINE_ADD;
+	}
+	if (in.combiner_alphasub_b[cycle] == &ZeroColor.i.a && in.combiner_alphaadd[cycle] == &ZeroColor.i.a)
+	{
+		return COMBINE_MODULATE;
+	}
+	return COMBINE_GENERIC;
+}
+
+// with 8-bit inputs, ColorCombinerEquation gives d when c is zero, and
+// (a * c + 0x80) >> 8 (at most 0xfe) when b and d are zero
+template<int _Key>
+inline INT32 n64_rdp::CombineRGB(INT32 a, INT32 b, INT32 c, INT32 d)
+{
+	switch (_Key)
+	{
+		case COMBINE_ADD:       return d;
+		case COMBINE_MODULATE:  return (a * c + 0x80) >> 8;
+		default:                return ColorCombinerEquation(a, b, c, d);
+	}
+}
+
+template<int _Key>
+inline INT32 n64_rdp::CombineAlpha(INT32 a, INT32 b, INT32 c, INT32 d)
+{
+	switch (_Key)
+	{
+		case COMBINE_ADD:       return d;
+		case COMBINE_MODULATE:  return (a * c + 0x80) >> 8;
+		default:                return AlphaCombinerEquation(a, b, c, d);
+	}
+}
+
+template<int _Cycle>
+inline void n64_rdp::TexPipeCycle(int cycle, Color* TEX, Color* prev, INT32 SSS, INT32 SST, UINT32 tilenum, UINT32 num, rdp_span_aux *userdata, const rdp_poly_state& object, INT32 *m_clamp_s_diff, INT32 *m_clamp_t_diff)
+{
+	switch (_Cycle)
+	{
+		case 0:     TexPipe.CycleNearest(TEX, prev, SSS, SST, tilenum, num, userdata, object, m_clamp_s_diff, m_clamp_t_diff); break;
+		case 1:     TexPipe.CycleNearestLerp(TEX, prev, SSS, SST, tilenum, num, userdata, object, m_clamp_s_diff, m_clamp_t_diff); break;
+		case 2:     TexPipe.CycleLinear(TEX, prev, SSS, SST, tilenum, num, userdata, object, m_clamp_s_diff, m_clamp_t_diff); break;
+		case 3:     TexPipe.CycleLinearLerp(TEX, prev, SSS, SST, tilenum, num, userdata, object, m_clamp_s_diff, m_clamp_t_diff); break;
+		default:    ((TexPipe).*(TexPipe.cycle[cycle]))(TEX, prev, SSS, SST, tilenum, num, userdata, object, m_clamp_s_diff, m_clamp_t_diff); break;
+	}
+}
+
+template<int _Index>
+inline void n64_rdp::ReadPixel(int index, UINT32 curpixel, rdp_span_aux *userdata, const rdp_poly_state &object)
+{
+	switch (_Index)
+	{
+		case 0:     _Read16Bit_ImgRead0(curpixel, userdata, object); break;
+		case 1:     _Read16Bit_ImgRead1(curpixel, userdata, object); break;
+		case 2:     _Read32Bit_ImgRead0(curpixel, userdata, object); break;
+		case 3:     _Read32Bit_ImgRead1(curpixel, userdata, object); break;
+		default:    ((this)->*(_Read[index]))(curpixel, userdata, object); break;
+	}
+}
+
+template<int _Index>
+inline bool n64_rdp::Blend1(int blend, int index, UINT32* fr, UINT32* fg, UINT32* fb, int dith, int adseed, int partialreject, int sel0, int acmode, rdp_span_aux *userdata, const rdp_poly_state& object)
+{
+	switch (_Index)
+	{
+		case 0:     return blend ? Blender.Blend1CycleBlendNoACVGNoDither(fr, fg, fb, dith, adseed, partialreject, sel0, acmode, userdata, object)
+								: Blender.Blend1CycleNoBlendNoACVGNoDither(fr, fg, fb, dith, adseed, partialreject, sel0, acmode, userdata, object);
+		case 1:     return blend ? Blender.Blend1CycleBlendNoACVGDither(fr, fg, fb, dith, adseed, partialreject, sel0, acmode, userdata, object)
+								: Blender.Blend1CycleNoBlendNoACVGDither(fr, fg, fb, dith, adseed, partialreject, sel0, acmode, userdata, object);
+		case 2:     return blend ? Blender.Blend1CycleBlendACVGNoDither(fr, fg, fb, dith, adseed, partialreject, sel0, acmode, userdata, object)
+								: Blender.Blend1CycleNoBlendACVGNoDither(fr, fg, fb, dith, adseed, partialreject, sel0, acmode, userdata, object);
+		case 3:     return blend ? Blender.Blend1CycleBlendACVGDither(fr, fg, fb, dith, adseed, partialreject, sel0, acmode, userdata, object)
+								: Blender.Blend1CycleNoBlendACVGDither(fr, fg, fb, dith, adseed, partialreject, sel0, acmode, userdata, object);
+		default:    return ((&Blender)->*(Blender.blend1[(blend << 2) | index]))(fr, fg, fb, dith, adseed, partialreject, sel0, acmode, userdata, object);
+	}
+}
+
+template<int _Index>
+inline bool n64_rdp::Blend2(int blend, int index, UINT32* fr, UINT32* fg, UINT32* fb, int dith, int adseed, int partialreject, int sel0, int sel1, int acmode, rdp_span_aux *userdata, const rdp_poly_state& object)
+{
+	switch (_Index)
+	{
+		case 0:     return blend ? Blender.Blend2CycleBlendNoACVGNoDither(fr, fg, fb, dith, adseed, partialreject, sel0, sel1, acmode, userdata, object)
+								: Blender.Blend2CycleNoBlendNoACVGNoDither(fr, fg, fb, dith, adseed, partialreject, sel0, sel1, acmode, userdata, object);
+		case 1:     return blend ? Blender.Blend2CycleBlendNoACVGDither(fr, fg, fb, dith, adseed, partialreject, sel0, sel1, acmode, userdata, object)
+								: Blender.Blend2CycleNoBlendNoACVGDither(fr, fg, fb, dith, adseed, partialreject, sel0, sel1, acmode, userdata, object);
+		case 2:     return blend ? Blender.Blend2CycleBlendACVGNoDither(fr, fg, fb, dith, adseed, partialreject, sel0, sel1, acmode, userdata, object)
+								: Blender.Blend2CycleNoBlendACVGNoDither(fr, fg, fb, dith, adseed, partialreject, sel0, sel1, acmode, userdata, object);
+		case 3:     return blend ? Blender.Blend2CycleBlendACVGDither(fr, fg, fb, dith, adseed, partialreject, sel0, sel1, acmode, userdata, object)
+								: Blender.Blend2CycleNoBlendACVGDither(fr, fg, fb, dith, adseed, partialreject, sel0, sel1, acmode, userdata, object);
+		default:    return ((&Blender)->*(Blender.blend2[(blend << 2) | index]))(fr, fg, fb, dith, adseed, partialreject, sel0, sel1, acmode, userdata, object);
+	}
+}
+
+template<int _TexCycle, int _ReadIndex, int _BlendIndex, int _CombineRGB, int _CombineAlpha>
+void n64_rdp::SpanDraw1CycleT(INT32 scanline, const extent_t &extent, const rdp_poly_state &object)
 {
 	int clipx1 = object.Scissor.m_xh;
 	int clipx2 = object.Scissor.m_xl;
@@ -159,7 +330,7 @@ void n64_rdp::SpanDraw1Cycle(INT32 scanline, const extent_t &extent, const rdp_p
 	TexPipe.CalculateClampDiffs(tile1, userdata, object, m_clamp_s_diff, m_clamp_t_diff);
 
 	bool partialreject = (userdata->ColorInputs.blender2b_a[0] == &userdata->InvPixelColor.i.a && userdata->ColorInputs.blender1b_a[0] == &userdata->PixelColor.i.a);
-	int sel0 = (OtherModes.force_blend ? 2 : 0) | ((userdata->ColorInputs.blender2b_a[0] == &userdata->MemoryColor.i.a) ? 1 : 0);
+	int sel0 = (object.OtherModes.force_blend ? 2 : 0) | ((userdata->ColorInputs.blender2b_a[0] == &userdata->MemoryColor.i.a) ? 1 : 0);
 
 	int drinc = object.SpanBase.m_span_dr;
 	int dginc = object.SpanBase.m_span_dg;
@@ -224,6 +395,7 @@ void n64_rdp::SpanDraw1Cycle(INT32 scanline, const extent_t &extent, const rdp_p
 	}
 
 	userdata->m_start_span = true;
+	userdata->m_noise_seed = object.NoiseSeed ^ (scanline * 0x9e3779b9);
 	for (int j = 0; j <= length; j++)
 	{
 		int sr = r.w >> 14;
@@ -242,15 +414,15 @@ void n64_rdp::SpanDraw1Cycle(INT32 scanline, const extent_t &extent, const rdp_p
 			RGBAZCorrectTriangle(offx, offy, &sr, &sg, &sb, &sa, &sz, userdata, object);
 			RGBAZClip(sr, sg, sb, sa, &sz, userdata);
 
-			((TexPipe).*(TexPipe.cycle[cycle0]))(&userdata->Texel0Color, &userdata->Texel0Color, sss, sst, tilenum, 0, userdata, object, m_clamp_s_diff, m_clamp_t_diff);
+			TexPipeCycle<_TexCycle>(cycle0, &userdata->Texel0Color, &userdata->Texel0Color, sss, sst, tilenum, 0, userdata, object, m_clamp_s_diff, m_clamp_t_diff);
 			//TexPipe.Cycle(&userdata->Texel0Color, &userdata->Texel0Color, sss, sst, tilenum, 0, userdata, object, m_clamp_s_diff, m_clamp_t_diff);
 
-			userdata->NoiseColor.i.r = userdata->NoiseColor.i.g = userdata->NoiseColor.i.b = rand() << 3; // Not accurate
+			userdata->NoiseColor.i.r = userdata->NoiseColor.i.g = userdata->NoiseColor.i.b = rdp_span_noise(userdata) << 3; // Not accurate
 
-			userdata->PixelColor.i.r = ColorCombinerEquation(*userdata->ColorInputs.combiner_rgbsub_a_r[1],*userdata->ColorInputs.combiner_rgbsub_b_r[1],*userdata->ColorInputs.combiner_rgbmul_r[1],*userdata->ColorInputs.combiner_rgbadd_r[1]);
-			userdata->PixelColor.i.g = ColorCombinerEquation(*userdata->ColorInputs.combiner_rgbsub_a_g[1],*userdata->ColorInputs.combiner_rgbsub_b_g[1],*userdata->ColorInputs.combiner_rgbmul_g[1],*userdata->ColorInputs.combiner_rgbadd_g[1]);
-			userdata->PixelColor.i.b = ColorCombinerEquation(*userdata->ColorInputs.combiner_rgbsub_a_b[1],*userdata->ColorInputs.combiner_rgbsub_b_b[1],*userdata->ColorInputs.combiner_rgbmul_b[1],*userdata->ColorInputs.combiner_rgbadd_b[1]);
-			userdata->PixelColor.i.a = AlphaCombinerEquation(*userdata->ColorInputs.combiner_alphasub_a[1],*userdata->ColorInputs.combiner_alphasub_b[1],*userdata->ColorInputs.combiner_alphamul[1],*userdata->ColorInputs.combiner_alphaadd[1]);
+			userdata->PixelColor.i.r = CombineRGB<_CombineRGB>(*userdata->ColorInputs.combiner_rgbsub_a_r[1],*userdata->ColorInputs.combiner_rgbsub_b_r[1],*userdata->ColorInputs.combiner_rgbmul_r[1],*userdata->ColorInputs.combiner_rgbadd_r[1]);
+			userdata->PixelColor.i.g = CombineRGB<_CombineRGB>(*userdata->ColorInputs.combiner_rgbsub_a_g[1],*userdata->ColorInputs.combiner_rgbsub_b_g[1],*userdata->ColorInputs.combiner_rgbmul_g[1],*userdata->ColorInputs.combiner_rgbadd_g[1]);
+			userdata->PixelColor.i.b = CombineRGB<_CombineRGB>(*userdata->ColorInputs.combiner_rgbsub_a_b[1],*userdata->ColorInputs.combiner_rgbsub_b_b[1],*userdata->ColorInputs.combiner_rgbmul_b[1],*userdata->ColorInputs.combiner_rgbadd_b[1]);
+			userdata->PixelColor.i.a = CombineAlpha<_CombineAlpha>(*userdata->ColorInputs.combiner_alphasub_a[1],*userdata->ColorInputs.combiner_alphasub_b[1],*userdata->ColorInputs.combiner_alphamul[1],*userdata->ColorInputs.combiner_alphaadd[1]);
 
 			//Alpha coverage combiner
 			GetAlphaCvg(&userdata->PixelColor.i.a, userdata, object);
@@ -259,13 +431,13 @@ void n64_rdp::SpanDraw1Cycle(INT32 scanline, const extent_t &extent, const rdp_p
 			UINT32 zbcur = zb + curpixel;
 			UINT32 zhbcur = zhb + curpixel;
 
-			((this)->*(_Read[read_index]))(curpixel, userdata, object);
+			ReadPixel<_ReadIndex>(read_index, curpixel, userdata, object);
 
 			if(ZCompare(zbcur, zhbcur, sz, dzpix, userdata, object))
 			{
-				GetDitherValues(scanline, j, &cdith, &adith, object);
+				GetDitherValues(scanline, j, &cdith, &adith, userdata, object);
 
-				bool rendered = ((&Blender)->*(Blender.blend1[(userdata->BlendEnable << 2) | blend_index]))(&fir, &fig, &fib, cdith, adith, partialreject, sel0, acmode, userdata, object);
+				bool rendered = Blend1<_BlendIndex>(userdata->BlendEnable, blend_index, &fir, &fig, &fib, cdith, adith, partialreject, sel0, acmode, userdata, object);
 
 				if (rendered)
 				{
@@ -295,7 +467,8 @@ void n64_rdp::SpanDraw1Cycle(INT32 scanline, const extent_t &extent, const rdp_p
 	}
 }
 
-void n64_rdp::SpanDraw2Cycle(INT32 scanline, const extent_t &extent, const rdp_poly_state &object, int threadid)
+template<int _TexCycle, int _ReadIndex, int _BlendIndex, int _CombineRGB0, int _CombineAlpha0, int _CombineRGB1, int _CombineAlpha1>
+void n64_rdp::SpanDraw2CycleT(INT32 scanline, const extent_t &extent, const rdp_poly_state &object)
 {
 	int clipx1 = object.Scissor.m_xh;
 	int clipx2 = object.Scissor.m_xl;
@@ -329,8 +502,8 @@ void n64_rdp::SpanDraw2Cycle(INT32 scanline, const extent_t &extent, const rdp_p
 	TexPipe.CalculateClampDiffs(tile1, userdata, object, m_clamp_s_diff, m_clamp_t_diff);
 
 	bool partialreject = (userdata->ColorInputs.blender2b_a[1] == &userdata->InvPixelColor.i.a && userdata->ColorInputs.blender1b_a[1] == &userdata->PixelColor.i.a);
-	int sel0 = (OtherModes.force_blend ? 2 : 0) | ((userdata->ColorInputs.blender2b_a[0] == &userdata->MemoryColor.i.a) ? 1 : 0);
-	int sel1 = (OtherModes.force_blend ? 2 : 0) | ((userdata->ColorInputs.blender2b_a[1] == &userdata->MemoryColor.i.a) ? 1 : 0);
+	int sel0 = (object.OtherModes.force_blend ? 2 : 0) | ((userdata->ColorInputs.blender2b_a[0] == &userdata->MemoryColor.i.a) ? 1 : 0);
+	int sel1 = (object.OtherModes.force_blend ? 2 : 0) | ((userdata->ColorInputs.blender2b_a[1] == &userdata->MemoryColor.i.a) ? 1 : 0);
 
 	int dzpix = object.SpanBase.m_span_dzpix;
 	int drinc = flip ? (object.SpanBase.m_span_dr) : -object.SpanBase.m_span_dr;
@@ -384,6 +557,7 @@ void n64_rdp::SpanDraw2Cycle(INT32 scanline, const extent_t &extent, const rdp_p
 	}
 
 	userdata->m_start_span = true;
+	userdata->m_noise_seed = object.NoiseSeed ^ (scanline * 0x9e3779b9);
 	for (int j = 0; j <= length; j++)
 	{
 		int sr = r.w >> 14;
@@ -414,27 +588,27 @@ void n64_rdp::SpanDraw2Cycle(INT32 scanline, const extent_t &extent, const rdp_p
 			RGBAZCorrectTriangle(offx, offy, &sr, &sg, &sb, &sa, &sz, userdata, object);
 			RGBAZClip(sr, sg, sb, sa, &sz, userdata);
 
-			((TexPipe).*(TexPipe.cycle[cycle0]))(&userdata->Texel0Color, &userdata->Texel0Color, sss, sst, tile1, 0, userdata, object, m_clamp_s_diff, m_clamp_t_diff);
-			((TexPipe).*(TexPipe.cycle[cycle1]))(&userdata->Texel1Color, &userdata->Texel0Color, sss, sst, tile2, 1, userdata, object, m_clamp_s_diff, m_clamp_t_diff);
-			((TexPipe).*(TexPipe.cycle[cycle1]))(&userdata->NextTexelColor, &userdata->NextTexelColor, sss, sst, tile2, 1, userdata, object, m_clamp_s_diff, m_clamp_t_diff);
+			TexPipeCycle<_TexCycle>(cycle0, &userdata->Texel0Color, &userdata->Texel0Color, sss, sst, tile1, 0, userdata, object, m_clamp_s_diff, m_clamp_t_diff);
+			TexPipeCycle<_TexCycle>(cycle1, &userdata->Texel1Color, &userdata->Texel0Color, sss, sst, tile2, 1, userdata, object, m_clamp_s_diff, m_clamp_t_diff);
+			TexPipeCycle<_TexCycle>(cycle1, &userdata->NextTexelColor, &userdata->NextTexelColor, sss, sst, tile2, 1, userdata, object, m_clamp_s_diff, m_clamp_t_diff);
 			//TexPipe.Cycle(&userdata->Texel0Color, &userdata->Texel0Color, sss, sst, tile1, 0, userdata, object, m_clamp_s_diff, m_clamp_t_diff);
 			//TexPipe.Cycle(&userdata->Texel1Color, &userdata->Texel0Color, sss, sst, tile2, 1, userdata, object, m_clamp_s_diff, m_clamp_t_diff);
 			//TexPipe.Cycle(&userdata->NextTexelColor, &userdata->NextTexelColor, sss, sst, tile2, 1, userdata, object, m_clamp_s_diff, m_clamp_t_diff);
 
-			userdata->NoiseColor.i.r = userdata->NoiseColor.i.g = userdata->NoiseColor.i.b = rand() << 3; // Not accurate
-			userdata->CombinedColor.i.r = ColorCombinerEquation(*userdata->ColorInputs.combiner_rgbsub_a_r[0],
+			userdata->NoiseColor.i.r = userdata->NoiseColor.i.g = userdata->NoiseColor.i.b = rdp_span_noise(userdata) << 3; // Not accurate
+			userdata->CombinedColor.i.r = CombineRGB<_CombineRGB0>(*userdata->ColorInputs.combiner_rgbsub_a_r[0],
 																*userdata->ColorInputs.combiner_rgbsub_b_r[0],
 																*userdata->ColorInputs.combiner_rgbmul_r[0],
 																*userdata->ColorInputs.combiner_rgbadd_r[0]);
-			userdata->CombinedColor.i.g = ColorCombinerEquation(*userdata->ColorInputs.combiner_rgbsub_a_g[0],
+			userdata->CombinedColor.i.g = CombineRGB<_CombineRGB0>(*userdata->ColorInputs.combiner_rgbsub_a_g[0],
 																*userdata->ColorInputs.combiner_rgbsub_b_g[0],
 																*userdata->ColorInputs.combiner_rgbmul_g[0],
 																*userdata->ColorInputs.combiner_rgbadd_g[0]);
-			userdata->CombinedColor.i.b = ColorCombinerEquation(*userdata->ColorInputs.combiner_rgbsub_a_b[0],
+			userdata->CombinedColor.i.b = CombineRGB<_CombineRGB0>(*userdata->ColorInputs.combiner_rgbsub_a_b[0],
 																*userdata->ColorInputs.combiner_rgbsub_b_b[0],
 																*userdata->ColorInputs.combiner_rgbmul_b[0],
 																*userdata->ColorInputs.combiner_rgbadd_b[0]);
-			userdata->CombinedColor.i.a = AlphaCombinerEquation(*userdata->ColorInputs.combiner_alphasub_a[0],
+			userdata->CombinedColor.i.a = CombineAlpha<_CombineAlpha0>(*userdata->ColorInputs.combiner_alphasub_a[0],
 																*userdata->ColorInputs.combiner_alphasub_b[0],
 																*userdata->ColorInputs.combiner_alphamul[0],
 																*userdata->ColorInputs.combiner_alphaadd[0]);
@@ -442,19 +616,19 @@ void n64_rdp::SpanDraw2Cycle(INT32 scanline, const extent_t &extent, const rdp_p
 			userdata->Texel0Color = userdata->Texel1Color;
 			userdata->Texel1Color = userdata->NextTexelColor;
 
-			userdata->PixelColor.i.r = ColorCombinerEquation(*userdata->ColorInputs.combiner_rgbsub_a_r[1],
+			userdata->PixelColor.i.r = CombineRGB<_CombineRGB1>(*userdata->ColorInputs.combiner_rgbsub_a_r[1],
 																*userdata->ColorInputs.combiner_rgbsub_b_r[1],
 																*userdata->ColorInputs.combiner_rgbmul_r[1],
 																*userdata->ColorInputs.combiner_rgbadd_r[1]);
-			userdata->PixelColor.i.g = ColorCombinerEquation(*userdata->ColorInputs.combiner_rgbsub_a_g[1],
+			userdata->PixelColor.i.g = CombineRGB<_CombineRGB1>(*userdata->ColorInputs.combiner_rgbsub_a_g[1],
 																*userdata->ColorInputs.combiner_rgbsub_b_g[1],
 																*userdata->ColorInputs.combiner_rgbmul_g[1],
 																*userdata->ColorInputs.combiner_rgbadd_g[1]);
-			userdata->PixelColor.i.b = ColorCombinerEquation(*userdata->ColorInputs.combiner_rgbsub_a_b[1],
+			userdata->PixelColor.i.b = CombineRGB<_CombineRGB1>(*userdata->ColorInputs.combiner_rgbsub_a_b[1],
 																*userdata->ColorInputs.combiner_rgbsub_b_b[1],
 																*userdata->ColorInputs.combiner_rgbmul_b[1],
 																*userdata->ColorInputs.combiner_rgbadd_b[1]);
-			userdata->PixelColor.i.a = AlphaCombinerEquation(*userdata->ColorInputs.combiner_alphasub_a[1],
+			userdata->PixelColor.i.a = CombineAlpha<_CombineAlpha1>(*userdata->ColorInputs.combiner_alphasub_a[1],
 																*userdata->ColorInputs.combiner_alphasub_b[1],
 																*userdata->ColorInputs.combiner_alphamul[1],
 																*userdata->ColorInputs.combiner_alphaadd[1]);
@@ -466,13 +640,13 @@ void n64_rdp::SpanDraw2Cycle(INT32 scanline, const extent_t &extent, const rdp_p
 			UINT32 zbcur = zb + curpixel;
 			UINT32 zhbcur = zhb + curpixel;
 
-			((this)->*(_Read[read_index]))(curpixel, userdata, object);
+			ReadPixel<_ReadIndex>(read_index, curpixel, userdata, object);
 
 			if(ZCompare(zbcur, zhbcur, sz, dzpix, userdata, object))
 			{
-				GetDitherValues(scanline, j, &cdith, &adith, object);
+				GetDitherValues(scanline, j, &cdith, &adith, userdata, object);
 
-				bool rendered = ((&Blender)->*(Blender.blend2[(userdata->BlendEnable << 2) | blend_index]))(&fir, &fig, &fib, cdith, adith, partialreject, sel0, sel1, acmode, userdata, object);
+				bool rendered = Blend2<_BlendIndex>(userdata->BlendEnable, blend_index, &fir, &fig, &fib, cdith, adith, partialreject, sel0, sel1, acmode, userdata, object);
 
 				if (rendered)
 				{
@@ -500,6 +674,80 @@ void n64_rdp::SpanDraw2Cycle(INT32 scanline, const extent_t &extent, const rdp_p
 	}
 }
 
+// the combiner shape index into s_span_1cycle/s_span_2cycle, for shapes that are not COMBINE_GENERIC
+#define SPAN_COMBINE_INDEX(rgb, alpha)  ((((rgb) - COMBINE_ADD) << 1) | ((alpha) - COMBINE_ADD))
+
+#define SPAN_1CYCLE_SHAPES(tex, read) \
+	{ \
+		&n64_rdp::SpanDraw1CycleT<tex, read, 1, COMBINE_ADD, COMBINE_ADD>, \
+		&n64_rdp::SpanDraw1CycleT<tex, read, 1, COMBINE_ADD, COMBINE_MODULATE>, \
+		&n64_rdp::SpanDraw1CycleT<tex, read, 1, COMBINE_MODULATE, COMBINE_ADD>, \
+		&n64_rdp::SpanDraw1CycleT<tex, read, 1, COMBINE_MODULATE, COMBINE_MODULATE> \
+	}
+
+#define SPAN_2CYCLE_SHAPES(tex, read) \
+	{ \
+		&n64_rdp::SpanDraw2CycleT<tex, read, 1, COMBINE_ADD, COMBINE_ADD, COMBINE_ADD, COMBINE_ADD>, \
+		&n64_rdp::SpanDraw2CycleT<tex, read, 1, COMBINE_ADD, COMBINE_MODULATE, COMBINE_ADD, COMBINE_ADD>, \
+		&n64_rdp::SpanDraw2CycleT<tex, read, 1, COMBINE_MODULATE, COMBINE_ADD, COMBINE_ADD, COMBINE_ADD>, \
+		&n64_rdp::SpanDraw2CycleT<tex, read, 1, COMBINE_MODULATE, COMBINE_MODULATE, COMBINE_ADD, COMBINE_ADD> \
+	}
+
+// point sampled or bilinear filtered, 16-bit and dithered without alpha
+// coverage select; in two cycle mode, the second combiner cycle only
+// passes its input through
+const n64_rdp::SpanDrawer n64_rdp::s_span_1cycle[2][2][4] =
+{
+	{ SPAN_1CYCLE_SHAPES(0, 0), SPAN_1CYCLE_SHAPES(0, 1) },
+	{ SPAN_1CYCLE_SHAPES(3, 0), SPAN_1CYCLE_SHAPES(3, 1) }
+};
+
+const n64_rdp::SpanDrawer n64_rdp::s_span_2cycle[2][2][4] =
+{
+	{ SPAN_2CYCLE_SHAPES(0, 0), SPAN_2CYCLE_SHAPES(0, 1) },
+	{ SPAN_2CYCLE_SHAPES(3, 0), SPAN_2CYCLE_SHAPES(3, 1) }
+};
+
+void n64_rdp::SpanDraw1Cycle(INT32 scanline, const extent_t &extent, const rdp_poly_state &object, int threadid)
+{
+	const rdp_span_aux *userdata = (const rdp_span_aux*)extent.userdata;
+	int cycle0 = ((object.OtherModes.sample_type & 1) << 1) | (object.OtherModes.bi_lerp0 & 1);
+	int rgb = CombineKeyRGB(userdata, 1);
+	int alpha = CombineKeyAlpha(userdata, 1);
+
+	if ((cycle0 == 0 || cycle0 == 3) && object.MiscState.FBSize == PIXEL_SIZE_16BIT &&
+		!object.OtherModes.alpha_cvg_select && object.OtherModes.rgb_dither_sel < 3 &&
+		rgb != COMBINE_GENERIC && alpha != COMBINE_GENERIC)
+	{
+		(this->*s_span_1cycle[cycle0 == 3][object.OtherModes.image_read_en ? 1 : 0][SPAN_COMBINE_INDEX(rgb, alpha)])(scanline, extent, object);
+	}
+	else
+	{
+		SpanDraw1CycleT<SPAN_MODE_ANY, SPAN_MODE_ANY, SPAN_MODE_ANY, COMBINE_GENERIC, COMBINE_GENERIC>(scanline, extent, object);
+	}
+}
+
+void n64_rdp::SpanDraw2Cycle(INT32 scanline, const extent_t &extent, const rdp_poly_state &object, int threadid)
+{
+	const rdp_span_aux *userdata = (const rdp_span_aux*)extent.userdata;
+	int cycle0 = ((object.OtherModes.sample_type & 1) << 1) | (object.OtherModes.bi_lerp0 & 1);
+	int cycle1 = ((object.OtherModes.sample_type & 1) << 1) | (object.OtherModes.bi_lerp1 & 1);
+	int rgb = CombineKeyRGB(userdata, 0);
+	int alpha = CombineKeyAlpha(userdata, 0);
+
+	if ((cycle0 == 0 || cycle0 == 3) && cycle1 == cycle0 && object.MiscState.FBSize == PIXEL_SIZE_16BIT &&
+		!object.OtherModes.alpha_cvg_select && object.OtherModes.rgb_dither_sel < 3 &&
+		rgb != COMBINE_GENERIC && alpha != COMBINE_GENERIC &&
+		CombineKeyRGB(userdata, 1) == COMBINE_ADD && CombineKeyAlpha(userdata, 1) == COMBINE_ADD)
+	{
+		(this->*s_span_2cycle[cycle0 == 3][object.OtherModes.image_read_en ? 1 : 0][SPAN_COMBINE_INDEX(rgb, alpha)])(scanline, extent, object);
+	}
+	else
+	{
+		SpanDraw2CycleT<SPAN_MODE_ANY, SPAN_MODE_ANY, SPAN_MODE_ANY, COMBINE_GENERIC, COMBINE_GENERIC, COMBINE_GENERIC, COMBINE_GENERIC>(scanline, extent, object);
+	}
+}
+
 void n64_rdp::SpanDrawCopy(INT32 scanline, const extent_t &extent, const rdp_poly_state &object, int threadid)
 {
 	int clipx1 = object.Scissor.m_xh;
@@ -557,13 +805,37 @@ void n64_rdp::SpanDrawFill(INT32 scanline, const extent_t &extent, const rdp_pol
 	int clipx1 = object.Scissor.m_xh;
 	int clipx2 = object.Scissor.m_xl;
 
-	int xinc = flip ? 1 : -1;
-
 	int fb_index = object.MiscState.FBWidth * scanline;
 
 	int xstart = extent.startx;
 	int xend_scissored = extent.stopx;
 
+#if !RDP_RANGE_CHECK
+	// a fill writes the same colour to every pixel between the two ends of the
+	// span, so clip the run once and write it a word at a time
+	if (object.MiscState.FBSize == PIXEL_SIZE_16BIT || object.MiscState.FBSize == PIXEL_SIZE_32BIT)
+	{
+		int xmin = MAX(flip ? xend_scissored : xstart, clipx1);
+		int xmax = MIN(flip ? xstart : xend_scissored, clipx2 - 1);
+		if (xmin > xmax)
+		{
+			return;
+		}
+
+		if (object.MiscState.FBSize == PIXEL_SIZE_16BIT)
+		{
+			_FillRun16Bit(fb_index + xmin, xmax - xmin + 1, object);
+		}
+		else
+		{
+			_FillRun32Bit(fb_index + xmin, xmax - xmin + 1, object);
+		}
+		return;
+	}
+#endif
+
+	int xinc = flip ? 1 : -1;
+
 	int x = xend_scissored;
 
 	int length = flip ? (xstart - xend_scissored) : (xend_scissored - xstart);
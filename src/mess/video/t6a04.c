@@ -13,6 +13,7 @@
 
 #include "emu.h"
 #include "video/t6a04.h"
+#include "validity.h"
 
 // devices
 const device_type T6A04 = &device_creator<t6a04_device>;
@@ -47,7 +48,7 @@ void t6a04_device::device_config_complete()
 void t6a04_device::device_validity_check(validity_checker &valid) const
 {
 	if (height == 0 || width == 0)
-		mame_printf_error("Configured with invalid parameter\n");
+		valid.error("Configured with invalid parameter\n");
 }
 
 //**************************************************************************
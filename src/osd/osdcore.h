@@ -166,6 +166,50 @@ file_error osd_read(osd_file *file, void *buffer, UINT64 offset, UINT32 length,
 file_error osd_write(osd_file *file, const void *buffer, UINT64 offset, UINT32 length, UINT32 *actual);
 
 
+/*-----------------------------------------------------------------------------
+    osd_map: map the start of an open file read-only into memory
+
+    Parameters:
+
+        file - handle to a file previously opened via osd_open
+
+        length - number of bytes to map, starting at offset 0
+
+        base - pointer to a pointer to receive the address of the mapped
+            data; valid only if the function returns FILERR_NONE
+
+    Return value:
+
+        a file_error describing any error that occurred while mapping the
+        file, or FILERR_NONE if no error occurred
+
+    Notes:
+
+        Mapping is optional; an OSD may always fail, and callers must fall
+        back to osd_read. A mapping sees writes made to the file through
+        osd_write, but does not grow when the file does.
+-----------------------------------------------------------------------------*/
+file_error osd_map(osd_file *file, UINT64 length, const void **base);
+
+
+/*-----------------------------------------------------------------------------
+    osd_unmap: release a mapping made by osd_map
+
+    Parameters:
+
+        file - handle to the file that was mapped
+
+        base - address returned by osd_map
+
+        length - length that was passed to osd_map
+
+    Return value:
+
+        None
+-----------------------------------------------------------------------------*/
+void osd_unmap(osd_file *file, const void *base, UINT64 length);
+
+
 /*-----------------------------------------------------------------------------
     osd_rmfile: deletes a file
 
@@ -255,6 +299,7 @@ struct osd_directory_entry
 	const char *        name;           /* name of the entry */
 	osd_dir_entry_type  type;           /* type of the entry */
 	UINT64              size;           /* size of the entry */
+	UINT64              mtime;          /* last modification time in OSD-defined units, or 0 if unknown */
 };
 
 
@@ -101,6 +101,26 @@ file_error osd_write(osd_file *file, const void *buffer, UINT64 offset, UINT32 l
 }
 
 
+//============================================================
+//  osd_map
+//============================================================
+
+file_error osd_map(osd_file *file, UINT64 length, const void **base)
+{
+	// stdio has no way to map a file
+	return FILERR_FAILURE;
+}
+
+
+//============================================================
+//  osd_unmap
+//============================================================
+
+void osd_unmap(osd_file *file, const void *base, UINT64 length)
+{
+}
+
+
 //============================================================
 //  osd_rmfile
 //============================================================
@@ -150,6 +170,7 @@ osd_directory_entry *osd_stat(const char *path)
 	result->name = (char *)(result + 1);
 	result->type = ENTTYPE_NONE;
 	result->size = 0;
+	result->mtime = 0;
 
 	FILE *f = fopen(path, "rb");
 	if (f != NULL)
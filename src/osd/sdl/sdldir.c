@@ -118,12 +118,17 @@ static osd_dir_entry_type get_attributes_stat(const char *file)
 }
 #endif
 
-static UINT64 osd_get_file_size(const char *file)
+static void osd_get_file_info(const char *file, osd_directory_entry *ent)
 {
 	sdl_stat st;
 	if(sdl_stat_fn(file, &st))
-		return 0;
-	return st.st_size;
+	{
+		ent->size = 0;
+		ent->mtime = 0;
+		return;
+	}
+	ent->size = st.st_size;
+	ent->mtime = st.st_mtime;
 }
 
 //============================================================
@@ -213,7 +218,7 @@ const osd_directory_entry *osd_readdir(osd_directory *dir)
 	#else
 	dir->ent.type = get_attributes_stat(temp);
 	#endif
-	dir->ent.size = osd_get_file_size(temp);
+	osd_get_file_info(temp, &dir->ent);
 	osd_free(temp);
 	return &dir->ent;
 }
@@ -24,6 +24,9 @@
 #endif
 
 #include <sys/stat.h>
+#if !defined(SDLMAME_WIN32) && !defined(SDLMAME_OS2)
+#include <sys/mman.h>
+#endif
 #include <fcntl.h>
 #include <unistd.h>
 #include <stdio.h>
@@ -387,6 +390,40 @@ file_error osd_close(osd_file *file)
 	}
 }
 
+//============================================================
+//  osd_map
+//============================================================
+
+file_error osd_map(osd_file *file, UINT64 length, const void **base)
+{
+#if defined(SDLMAME_WIN32) || defined(SDLMAME_OS2) || defined(SDLMAME_EMSCRIPTEN)
+	return FILERR_FAILURE;
+#else
+	// only plain files can be mapped, and only if they fit in our address space
+	if (file->type != SDLFILE_FILE || length == 0 || (size_t)length != length)
+		return FILERR_FAILURE;
+
+	void *result = mmap(NULL, length, PROT_READ, MAP_SHARED, file->handle, 0);
+	if (result == MAP_FAILED)
+		return error_to_file_error(errno);
+	*base = result;
+	return FILERR_NONE;
+#endif
+}
+
+
+//============================================================
+//  osd_unmap
+//============================================================
+
+void osd_unmap(osd_file *file, const void *base, UINT64 length)
+{
+#if !defined(SDLMAME_WIN32) && !defined(SDLMAME_OS2) && !defined(SDLMAME_EMSCRIPTEN)
+	munmap(const_cast<void *>(base), length);
+#endif
+}
+
+
 //============================================================
 //  osd_rmfile
 //============================================================
@@ -261,6 +261,40 @@ file_error osd_close(osd_file *file)
 }
 
 
+//============================================================
+//  osd_map
+//============================================================
+
+file_error osd_map(osd_file *file, UINT64 length, const void **base)
+{
+	// only plain files can be mapped, and only if they fit in our address space
+	if (file->type != WINFILE_FILE || length == 0 || (SIZE_T)length != length)
+		return FILERR_FAILURE;
+
+	// the view keeps the mapping object alive, so we can drop our handle right away
+	HANDLE mapping = CreateFileMapping(file->handle, NULL, PAGE_READONLY, (DWORD)(length >> 32), (DWORD)length, NULL);
+	if (mapping == NULL)
+		return win_error_to_mame_file_error(GetLastError());
+	void *result = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, (SIZE_T)length);
+	DWORD error = GetLastError();
+	CloseHandle(mapping);
+	if (result == NULL)
+		return win_error_to_mame_file_error(error);
+	*base = result;
+	return FILERR_NONE;
+}
+
+
+//============================================================
+//  osd_unmap
+//============================================================
+
+void osd_unmap(osd_file *file, const void *base, UINT64 length)
+{
+	UnmapViewOfFile(base);
+}
+
+
 //============================================================
 //  osd_rmfile
 //============================================================
@@ -460,6 +494,7 @@ osd_directory_entry *osd_stat(const char *path)
 	result->name = ((char *) result) + sizeof(*result);
 	result->type = win_attributes_to_entry_type(find_data.dwFileAttributes);
 	result->size = find_data.nFileSizeLow | ((UINT64) find_data.nFileSizeHigh << 32);
+	result->mtime = find_data.ftLastWriteTime.dwLowDateTime | ((UINT64) find_data.ftLastWriteTime.dwHighDateTime << 32);
 
 done:
 	if (t_path != NULL)
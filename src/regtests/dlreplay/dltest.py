@@ -0,0 +1,68 @@
+import os
+import subprocess
+import sys
+import shutil
+
+# Writes the synthetic voodoo capture and replays it through every polygon
+# manager dlreplay knows, with and without drawing; each must produce the
+# same checksum as the poly.c baseline.
+
+def runProcess(cmd):
+	process = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+	(stdout, stderr) = process.communicate()
+	return process.returncode, stdout, stderr
+
+def replay(renderer, extra):
+	exitcode, stdout, stderr = runProcess([dlreplayBin, captureFile, "-passes", "2", "-renderer", renderer] + extra)
+	if not exitcode == 0:
+		print renderer + " - replay failed with " + str(exitcode) + " (" + stderr + ")"
+		return None
+	for line in stdout.splitlines():
+		if line.startswith("Checksum: "):
+			return line[len("Checksum: "):]
+	print renderer + " - no checksum reported"
+	return None
+
+currentDirectory = os.path.dirname(os.path.realpath(__file__))
+tempPath = os.path.join(currentDirectory, "temp")
+if os.name == 'nt':
+	dlreplayBin = os.path.normpath(os.path.join(currentDirectory, "..", "..", "..", "dlreplay.exe"))
+else:
+	dlreplayBin = os.path.normpath(os.path.join(currentDirectory, "..", "..", "..", "dlreplay"))
+
+if not os.path.exists(dlreplayBin):
+	print dlreplayBin + " does not exist"
+	sys.exit(1)
+
+if os.path.exists(tempPath):
+	shutil.rmtree(tempPath)
+os.makedirs(tempPath)
+
+captureFile = os.path.join(tempPath, "test.dlc")
+exitcode, stdout, stderr = runProcess([dlreplayBin, "-writetest", captureFile])
+if not exitcode == 0:
+	print "writing the test capture failed with " + str(exitcode) + " (" + stderr + ")"
+	sys.exit(1)
+
+failure = False
+
+for extra in [[], ["-nodraw"]]:
+	mode = " ".join(extra) if len(extra) > 0 else "drawing"
+	expected = replay("poly", extra)
+	if expected is None:
+		failure = True
+		continue
+	for renderer in ["buckets", "tiles"]:
+		found = replay(renderer, extra)
+		if found is None:
+			failure = True
+		elif not found == expected:
+			print renderer + " (" + mode + ") - expected: " + expected + " found: " + found
+			failure = True
+
+if not failure:
+	shutil.rmtree(tempPath)
+	print "All tests finished successfully"
+else:
+	print "Tests failed"
+	sys.exit(1)
@@ -0,0 +1,96 @@
+import os
+import subprocess
+import sys
+import shutil
+
+# Runs N64 RDP based sets twice, once with a single processor so that every
+# span is drawn in queue order and once with the worker threads, and compares
+# the per-frame checksums. The emulator has to be built with
+# LOG_RDP_FRAME_CRCS set in src/mame/video/n64.c, which writes them to
+# rdp_frames.txt in the current directory.
+
+# MAMERR_MISSING_FILES, returned when the ROMs for a set are not available
+MISSING_FILES = 2
+
+def runProcess(cmd, cwd):
+	process = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE, cwd=cwd)
+	(stdout, stderr) = process.communicate()
+	return process.returncode, stdout, stderr
+
+def readCRCs(path):
+	if not os.path.exists(path):
+		return []
+	f = open(path, 'r')
+	lines = f.read().splitlines()
+	f.close()
+	return lines
+
+def runSet(name, serial):
+	runPath = os.path.join(tempPath, name + ("_serial" if serial else "_threaded"))
+	os.makedirs(runPath)
+	cmd = [emulatorBin, name, "-rompath", romPath, "-video", "none", "-nosound", "-frameskip", "0", "-nothrottle", "-skip_gameinfo", "-str", seconds]
+	cmd += ["-numprocessors", "1" if serial else "auto"]
+	exitcode, stdout, stderr = runProcess(cmd, runPath)
+	return exitcode, stderr, readCRCs(os.path.join(runPath, "rdp_frames.txt"))
+
+currentDirectory = os.path.dirname(os.path.realpath(__file__))
+tempPath = os.path.join(currentDirectory, "temp")
+
+if len(sys.argv) < 2:
+	print "usage: rdptest.py <emulator> [set ...]"
+	sys.exit(1)
+
+emulatorBin = os.path.normpath(os.path.join(currentDirectory, "..", "..", "..", sys.argv[1]))
+if not os.path.exists(emulatorBin):
+	print emulatorBin + " does not exist"
+	sys.exit(1)
+
+sets = sys.argv[2:]
+if len(sets) == 0:
+	sets = [ "starsldr", "vivdolls", "mtetrisc", "11beat" ]
+seconds = "10"
+romPath = os.path.abspath("roms")
+
+if os.path.exists(tempPath):
+	shutil.rmtree(tempPath)
+os.makedirs(tempPath)
+
+failure = False
+tested = 0
+
+for name in sets:
+	exitcode, stderr, serial = runSet(name, True)
+	if exitcode == MISSING_FILES:
+		print name + " - skipped, ROMs not found"
+		continue
+	if not exitcode == 0:
+		print name + " - serial run failed with " + str(exitcode) + " (" + stderr + ")"
+		failure = True
+		continue
+
+	exitcode, stderr, threaded = runSet(name, False)
+	if not exitcode == 0:
+		print name + " - threaded run failed with " + str(exitcode) + " (" + stderr + ")"
+		failure = True
+		continue
+
+	tested += 1
+	if len(serial) == 0:
+		print name + " - no frames were logged, is LOG_RDP_FRAME_CRCS set?"
+		failure = True
+		continue
+	if not len(serial) == len(threaded):
+		print name + " - frame count mismatch (" + str(len(serial)) + " serial, " + str(len(threaded)) + " threaded)"
+		failure = True
+	for i in range(min(len(serial), len(threaded))):
+		if not serial[i] == threaded[i]:
+			print name + " - expected: " + serial[i] + " found: " + threaded[i]
+			failure = True
+			break
+
+if not failure:
+	shutil.rmtree(tempPath)
+	print "All tests finished successfully (" + str(tested) + " of " + str(len(sets)) + " sets tested)"
+else:
+	print "Tests failed"
+	sys.exit(1)
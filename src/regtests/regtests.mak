@@ -65,3 +65,27 @@ jedutiltest:
 chdmantest:
 	@echo Running chdman unittest
 	$(PYTHON) $(SRC)/regtests/chdman/chdtest.py
+
+
+
+#-------------------------------------------------
+# N64 RDP, threaded against serial span rendering;
+# not part of 'make tests' since it needs ROMs and
+# an emulator built with LOG_RDP_FRAME_CRCS
+#-------------------------------------------------
+
+n64rdptest:
+	@echo Running N64 RDP frame checksum test
+	$(PYTHON) $(SRC)/regtests/n64rdp/rdptest.py $(EMULATOR)
+
+
+
+#-------------------------------------------------
+# display list replay, every polygon manager on
+# the synthetic voodoo capture; not part of
+# 'make tests' since dlreplay is not a default tool
+#-------------------------------------------------
+
+dlreplaytest: dlreplay$(EXE)
+	@echo Running display list replay test
+	$(PYTHON) $(SRC)/regtests/dlreplay/dltest.py
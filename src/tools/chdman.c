@@ -35,6 +35,9 @@ const UINT32 IDE_SECTOR_SIZE = 512;
 // temporary input buffer size
 const UINT32 TEMP_BUFFER_SIZE = 32 * 1024 * 1024;
 
+// largest amount of input the benchmark command holds in memory
+const UINT32 BENCHMARK_MAX_BYTES = 256 * 1024 * 1024;
+
 // modes
 const int MODE_NORMAL = 0;
 const int MODE_CUEBIN = 1;
@@ -59,6 +62,7 @@ const int MODE_GDI = 2;
 #define COMMAND_ADD_METADATA "addmeta"
 #define COMMAND_DEL_METADATA "delmeta"
 #define COMMAND_DUMP_METADATA "dumpmeta"
+#define COMMAND_BENCHMARK "benchmark"
 
 // option strings
 #define OPTION_INPUT "input"
@@ -109,6 +113,7 @@ static void do_extract_ld(parameters_t &params);
 static void do_add_metadata(parameters_t &params);
 static void do_del_metadata(parameters_t &params);
 static void do_dump_metadata(parameters_t &params);
+static void do_benchmark(parameters_t &params);
 
 
 
@@ -162,6 +167,21 @@ struct metadata_index_info
 };
 
 
+// ======================> pipeline_stage
+
+// a buffer being hashed or written on a helper thread while the next one is read
+struct pipeline_stage
+{
+	osd_work_item *     item;               // work item, if queued
+	sha1_creator *      sha1;               // SHA-1 to append to, or NULL
+	core_file *         file;               // file to write to, or NULL
+	UINT64              offset;             // offset within the file
+	const UINT8 *       data;               // data to process
+	UINT32              length;             // length of the data
+	bool                error;              // did the write fail?
+};
+
+
 // ======================> fatal_error
 
 class fatal_error : public std::exception
@@ -490,7 +510,7 @@ static const option_description s_options[] =
 	{ OPTION_INDEX,                 "ix",   true, " <index>: indexed instance of this metadata tag" },
 	{ OPTION_VALUE_TEXT,            "vt",   true, " <text>: text for the metadata" },
 	{ OPTION_VALUE_FILE,            "vf",   true, " <file>: file containing data to add" },
-	{ OPTION_NUMPROCESSORS,         "np",   true, " <processors>: limit the number of processors to use during compression" },
+	{ OPTION_NUMPROCESSORS,         "np",   true, " <processors>: limit the number of processors to use during compression, verification or extraction" },
 	{ OPTION_NO_CHECKSUM,           "nocs", false, ": do not include this metadata information in the overall SHA-1" },
 	{ OPTION_FIX,                   "f",    false, ": fix the SHA-1 if it is incorrect" },
 	{ OPTION_VERBOSE,               "v",    false, ": output additional information" },
@@ -510,7 +530,8 @@ static const command_description s_commands[] =
 	{ COMMAND_VERIFY, do_verify, ": verifies a CHD's integrity",
 		{
 			REQUIRED OPTION_INPUT,
-			OPTION_INPUT_PARENT
+			OPTION_INPUT_PARENT,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -585,7 +606,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_START_BYTE,
 			OPTION_INPUT_START_HUNK,
 			OPTION_INPUT_LENGTH_BYTES,
-			OPTION_INPUT_LENGTH_HUNKS
+			OPTION_INPUT_LENGTH_HUNKS,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -598,7 +620,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_START_BYTE,
 			OPTION_INPUT_START_HUNK,
 			OPTION_INPUT_LENGTH_BYTES,
-			OPTION_INPUT_LENGTH_HUNKS
+			OPTION_INPUT_LENGTH_HUNKS,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -609,6 +632,7 @@ static const command_description s_commands[] =
 			OPTION_OUTPUT_FORCE,
 			REQUIRED OPTION_INPUT,
 			OPTION_INPUT_PARENT,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -667,6 +691,18 @@ static const command_description s_commands[] =
 			REQUIRED OPTION_TAG,
 			OPTION_INDEX
 		}
+	},
+
+	{ COMMAND_BENCHMARK, do_benchmark, ": measure ratio and speed of each codec and hash backend on the input file",
+		{
+			REQUIRED OPTION_INPUT,
+			OPTION_INPUT_START_BYTE,
+			OPTION_INPUT_START_HUNK,
+			OPTION_INPUT_LENGTH_BYTES,
+			OPTION_INPUT_LENGTH_HUNKS,
+			OPTION_HUNK_SIZE,
+			OPTION_COMPRESSION
+		}
 	}
 };
 
@@ -852,6 +888,78 @@ UINT64 parse_number(const char *string)
 }
 
 
+//-------------------------------------------------
+//  pipeline_process - hash or write a buffer;
+//  runs on the pipeline thread
+//-------------------------------------------------
+
+static void *pipeline_process(void *param, int threadid)
+{
+	pipeline_stage &stage = *reinterpret_cast<pipeline_stage *>(param);
+	if (stage.sha1 != NULL)
+		stage.sha1->append(stage.data, stage.length);
+	if (stage.file != NULL)
+	{
+		core_fseek(stage.file, stage.offset, SEEK_SET);
+		stage.error = (core_fwrite(stage.file, stage.data, stage.length) != stage.length);
+	}
+	return NULL;
+}
+
+
+//-------------------------------------------------
+//  pipeline_wait - wait for the previous buffer
+//  to finish; returns false if its write failed
+//-------------------------------------------------
+
+static bool pipeline_wait(pipeline_stage &stage)
+{
+	if (stage.item != NULL)
+	{
+		while (!osd_work_item_wait(stage.item, 10 * osd_ticks_per_second())) ;
+		osd_work_item_release(stage.item);
+		stage.item = NULL;
+	}
+	bool result = !stage.error;
+	stage.error = false;
+	return result;
+}
+
+
+//-------------------------------------------------
+//  pipeline_submit - hand a buffer to the
+//  pipeline thread, or process it immediately if
+//  there is no thread
+//-------------------------------------------------
+
+static void pipeline_submit(osd_work_queue *queue, pipeline_stage &stage, const UINT8 *data, UINT32 length, UINT64 offset = 0)
+{
+	stage.data = data;
+	stage.length = length;
+	stage.offset = offset;
+	if (queue != NULL)
+		stage.item = osd_work_item_queue(queue, pipeline_process, &stage, 0);
+	if (stage.item == NULL)
+		pipeline_process(&stage, 0);
+}
+
+
+//-------------------------------------------------
+//  report_throughput - print the elapsed time and
+//  data rate for a verify or extract
+//-------------------------------------------------
+
+static void report_throughput(const char *verb, UINT64 bytes, osd_ticks_t ticks)
+{
+	astring tempstr;
+	double seconds = double(ticks) / double(osd_ticks_per_second());
+	printf("%s %s bytes in %.2f seconds", verb, big_int_string(tempstr, bytes), seconds);
+	if (seconds > 0)
+		printf(" (%.1f MB/s)", double(bytes) / (1024.0 * 1024.0) / seconds);
+	printf("\n");
+}
+
+
 //-------------------------------------------------
 //  guess_chs - given a file and an offset,
 //  compute a best guess CHS value set
@@ -1456,26 +1564,51 @@ static void do_verify(parameters_t &params)
 	if (raw_sha1 == sha1_t::null)
 		report_error(0, "No verification to be done; CHD has no checksum");
 
-	// create an array to read into
-	dynamic_buffer buffer((TEMP_BUFFER_SIZE / input_chd.hunk_bytes()) * input_chd.hunk_bytes());
+	// process numprocessors
+	parse_numprocessors(params);
+
+	// create a pair of arrays to read into; one is hashed while the other is filled
+	dynamic_buffer buffer[2];
+	buffer[0].resize((TEMP_BUFFER_SIZE / input_chd.hunk_bytes()) * input_chd.hunk_bytes());
+	buffer[1].resize(buffer[0].count());
+	osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
 
 	// read all the data and build up an SHA-1
 	sha1_creator rawsha1;
-	for (UINT64 offset = 0; offset < input_chd.logical_bytes(); )
+	pipeline_stage stage = { NULL, &rawsha1, NULL, 0, NULL, 0, false };
+	osd_ticks_t starttime = osd_ticks();
+	int curbuf = 0;
+	try
 	{
-		progress(false, "Verifying, %.1f%% complete... \r", 100.0 * double(offset) / double(input_chd.logical_bytes()));
+		for (UINT64 offset = 0; offset < input_chd.logical_bytes(); )
+		{
+			progress(false, "Verifying, %.1f%% complete... \r", 100.0 * double(offset) / double(input_chd.logical_bytes()));
 
-		// determine how much to read
-		UINT32 bytes_to_read = MIN((UINT32)buffer.count(), input_chd.logical_bytes() - offset);
-		chd_error err = input_chd.read_bytes(offset, buffer, bytes_to_read);
-		if (err != CHDERR_NONE)
-			report_error(1, "Error reading CHD file (%s): %s", params.find(OPTION_INPUT)->cstr(), chd_file::error_string(err));
+			// determine how much to read
+			UINT32 bytes_to_read = MIN((UINT32)buffer[curbuf].count(), input_chd.logical_bytes() - offset);
+			chd_error err = input_chd.read_bytes(offset, buffer[curbuf], bytes_to_read);
+			if (err != CHDERR_NONE)
+				report_error(1, "Error reading CHD file (%s): %s", params.find(OPTION_INPUT)->cstr(), chd_file::error_string(err));
 
-		// add to the checksum
-		rawsha1.append(buffer, bytes_to_read);
-		offset += bytes_to_read;
+			// add to the checksum once the previous buffer is done
+			pipeline_wait(stage);
+			pipeline_submit(queue, stage, buffer[curbuf], bytes_to_read);
+			curbuf ^= 1;
+			offset += bytes_to_read;
+		}
+		pipeline_wait(stage);
 	}
+	catch (...)
+	{
+		pipeline_wait(stage);
+		if (queue != NULL)
+			osd_work_queue_free(queue);
+		throw;
+	}
+	if (queue != NULL)
+		osd_work_queue_free(queue);
 	sha1_t computed_sha1 = rawsha1.finish();
+	report_throughput("Verified", input_chd.logical_bytes(), osd_ticks() - starttime);
 
 	// finish up
 	if (raw_sha1 != computed_sha1)
@@ -2166,42 +2299,64 @@ static void do_extract_raw(parameters_t &params)
 		printf("Input length: %s\n", big_int_string(tempstr, input_end - input_start));
 	}
 
+	// process numprocessors
+	parse_numprocessors(params);
+
 	// catch errors so we can close & delete the output file
 	core_file *output_file = NULL;
+	osd_work_queue *queue = NULL;
+	pipeline_stage stage = { NULL, NULL, NULL, 0, NULL, 0, false };
 	try
 	{
 		// process output file
 		file_error filerr = core_fopen(*output_file_str, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE, &output_file);
 		if (filerr != FILERR_NONE)
 			report_error(1, "Unable to open file (%s)", output_file_str->cstr());
-
-		// copy all data
-		dynamic_buffer buffer((TEMP_BUFFER_SIZE / input_chd.hunk_bytes()) * input_chd.hunk_bytes());
+		stage.file = output_file;
+		queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+
+		// copy all data; one buffer is written while the other is filled
+		dynamic_buffer buffer[2];
+		buffer[0].resize((TEMP_BUFFER_SIZE / input_chd.hunk_bytes()) * input_chd.hunk_bytes());
+		buffer[1].resize(buffer[0].count());
+		osd_ticks_t starttime = osd_ticks();
+		int curbuf = 0;
 		for (UINT64 offset = input_start; offset < input_end; )
 		{
 			progress(false, "Extracting, %.1f%% complete... \r", 100.0 * double(offset - input_start) / double(input_end - input_start));
 
 			// determine how much to read
-			UINT32 bytes_to_read = MIN((UINT32)buffer.count(), input_end - offset);
-			chd_error err = input_chd.read_bytes(offset, buffer, bytes_to_read);
+			UINT32 bytes_to_read = MIN((UINT32)buffer[curbuf].count(), input_end - offset);
+			chd_error err = input_chd.read_bytes(offset, buffer[curbuf], bytes_to_read);
 			if (err != CHDERR_NONE)
 				report_error(1, "Error reading CHD file (%s): %s", params.find(OPTION_INPUT)->cstr(), chd_file::error_string(err));
 
-			// write to the output
-			UINT32 count = core_fwrite(output_file, buffer, bytes_to_read);
-			if (count != bytes_to_read)
+			// write to the output once the previous buffer is out
+			if (!pipeline_wait(stage))
 				report_error(1, "Error writing to file; check disk space (%s)", output_file_str->cstr());
+			pipeline_submit(queue, stage, buffer[curbuf], bytes_to_read, offset - input_start);
+			curbuf ^= 1;
 
 			// advance
 			offset += bytes_to_read;
 		}
+		if (!pipeline_wait(stage))
+			report_error(1, "Error writing to file; check disk space (%s)", output_file_str->cstr());
 
 		// finish up
 		core_fclose(output_file);
+		if (queue != NULL)
+			osd_work_queue_free(queue);
 		printf("Extraction complete                                    \n");
+		report_throughput("Extracted", input_end - input_start, osd_ticks() - starttime);
 	}
 	catch (...)
 	{
+		// let any write in flight finish before the file goes away
+		pipeline_wait(stage);
+		if (queue != NULL)
+			osd_work_queue_free(queue);
+
 		// delete the output file
 		if (output_file != NULL)
 		{
@@ -2231,6 +2386,9 @@ static void do_extract_cd(parameters_t &params)
 		report_error(1, "Unable to recognize CHD file as a CD");
 	const cdrom_toc *toc = cdrom_get_toc(cdrom);
 
+	// process numprocessors
+	parse_numprocessors(params);
+
 	// verify output file doesn't exist
 	astring *output_file_str = params.find(OPTION_OUTPUT);
 	if (output_file_str != NULL)
@@ -2258,6 +2416,8 @@ static void do_extract_cd(parameters_t &params)
 	// catch errors so we can close & delete the output file
 	core_file *output_bin_file = NULL;
 	core_file *output_toc_file = NULL;
+	osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+	pipeline_stage stage = { NULL, NULL, NULL, 0, NULL, 0, false };
 	try
 	{
 		int mode = MODE_NORMAL;
@@ -2295,14 +2455,20 @@ static void do_extract_cd(parameters_t &params)
 			core_fprintf(output_toc_file, "%d\n", toc->numtrks);
 		}
 
-		// iterate over tracks and copy all data
+		// iterate over tracks and copy all data; one buffer is written while the other is filled
 		UINT64 outputoffs = 0;
 		UINT32 discoffs = 0;
-		dynamic_buffer buffer;
+		dynamic_buffer buffers[2];
+		int curbuf = 0;
+		osd_ticks_t starttime = osd_ticks();
 		for (int tracknum = 0; tracknum < toc->numtrks; tracknum++)
 		{
 			astring trackbin_name(basename);
 
+			// the previous track's last write must land before we touch its file or buffers
+			if (!pipeline_wait(stage))
+				report_error(1, "Error writing to file (%s): %s\n", output_file_str->cstr(), chd_file::error_string(CHDERR_WRITE_ERROR));
+
 			if (mode == MODE_GDI)
 			{
 				char temp[8];
@@ -2345,8 +2511,10 @@ static void do_extract_cd(parameters_t &params)
 				output_frame_size = trackinfo.datasize;
 			}
 
-			// resize the buffer for the track
-			buffer.resize((TEMP_BUFFER_SIZE / output_frame_size) * output_frame_size);
+			// resize the buffers for the track
+			buffers[0].resize((TEMP_BUFFER_SIZE / output_frame_size) * output_frame_size);
+			buffers[1].resize(buffers[0].count());
+			stage.file = output_bin_file;
 
 			// now read and output the actual data
 			UINT32 bufferoffs = 0;
@@ -2354,6 +2522,7 @@ static void do_extract_cd(parameters_t &params)
 			for (UINT32 frame = 0; frame < actualframes; frame++)
 			{
 				progress(false, "Extracting, %.1f%% complete... \r", 100.0 * double(outputoffs) / double(total_bytes));
+				dynamic_buffer &buffer = buffers[curbuf];
 
 				// read the data
 				cdrom_read_data(cdrom, cdrom_get_track_start_phys(cdrom, tracknum) + frame, &buffer[bufferoffs], trackinfo.trktype, true);
@@ -2379,10 +2548,10 @@ static void do_extract_cd(parameters_t &params)
 				// write it out if we need to
 				if (bufferoffs == buffer.count() || frame == actualframes - 1)
 				{
-					core_fseek(output_bin_file, outputoffs, SEEK_SET);
-					UINT32 byteswritten = core_fwrite(output_bin_file, buffer, bufferoffs);
-					if (byteswritten != bufferoffs)
+					if (!pipeline_wait(stage))
 						report_error(1, "Error writing frame %d to file (%s): %s\n", frame, output_file_str->cstr(), chd_file::error_string(CHDERR_WRITE_ERROR));
+					pipeline_submit(queue, stage, buffer, bufferoffs, outputoffs);
+					curbuf ^= 1;
 					outputoffs += bufferoffs;
 					bufferoffs = 0;
 				}
@@ -2390,14 +2559,24 @@ static void do_extract_cd(parameters_t &params)
 
 			discoffs += trackinfo.padframes;
 		}
+		if (!pipeline_wait(stage))
+			report_error(1, "Error writing to file (%s): %s\n", output_file_str->cstr(), chd_file::error_string(CHDERR_WRITE_ERROR));
 
 		// finish up
 		core_fclose(output_bin_file);
 		core_fclose(output_toc_file);
+		if (queue != NULL)
+			osd_work_queue_free(queue);
 		printf("Extraction complete                                    \n");
+		report_throughput("Extracted", total_bytes, osd_ticks() - starttime);
 	}
 	catch (...)
 	{
+		// let any write in flight finish before the files go away
+		pipeline_wait(stage);
+		if (queue != NULL)
+			osd_work_queue_free(queue);
+
 		// delete the output files
 		if (output_bin_file != NULL)
 			core_fclose(output_bin_file);
@@ -2756,6 +2935,189 @@ static void do_dump_metadata(parameters_t &params)
 }
 
 
+//-------------------------------------------------
+//  do_benchmark - compress and decompress the
+//  input with each codec and report the results
+//-------------------------------------------------
+
+static void do_benchmark(parameters_t &params)
+{
+	// process input file
+	core_file *input_file = NULL;
+	astring *input_file_str = params.find(OPTION_INPUT);
+	file_error filerr = core_fopen(*input_file_str, OPEN_FLAG_READ, &input_file);
+	if (filerr != FILERR_NONE)
+		report_error(1, "Unable to open file (%s)", input_file_str->cstr());
+
+	// process hunk size
+	UINT32 hunk_size = 4096;
+	parse_hunk_size(params, 1, hunk_size);
+
+	// process input start/end
+	UINT64 input_start;
+	UINT64 input_end;
+	parse_input_start_end(params, core_fsize(input_file), hunk_size, hunk_size, input_start, input_end);
+	if (input_end - input_start > BENCHMARK_MAX_BYTES)
+		input_end = input_start + BENCHMARK_MAX_BYTES;
+
+	// process compression; by default try all the general-purpose codecs
+	chd_codec_type compression[4];
+	chd_codec_type default_list[] = { CHD_CODEC_ZLIB, CHD_CODEC_LZMA, CHD_CODEC_HUFFMAN, CHD_CODEC_FLAC, CHD_CODEC_LZFAST };
+	const chd_codec_type *codec_list = default_list;
+	int codec_count = ARRAY_LENGTH(default_list);
+	if (params.find(OPTION_COMPRESSION) != NULL)
+	{
+		parse_compression(params, compression);
+		codec_list = compression;
+		for (codec_count = 0; codec_count < 4 && compression[codec_count] != CHD_CODEC_NONE; codec_count++) ;
+	}
+
+	// read the input into memory, padding the final hunk with zeros like a CHD would
+	UINT32 hunks = (input_end - input_start + hunk_size - 1) / hunk_size;
+	dynamic_buffer source(UINT64(hunks) * hunk_size);
+	memset(source, 0, source.count());
+	core_fseek(input_file, input_start, SEEK_SET);
+	UINT32 bytes = input_end - input_start;
+	if (core_fread(input_file, source, bytes) != bytes)
+		report_error(1, "Error reading input file (%s)", input_file_str->cstr());
+	core_fclose(input_file);
+
+	// print some info
+	astring tempstr;
+	printf("Input file:   %s\n", input_file_str->cstr());
+	printf("Input length: %s\n", big_int_string(tempstr, bytes));
+	printf("Hunk size:    %s\n", big_int_string(tempstr, hunk_size));
+	printf("\n");
+	printf("Codec                   Ratio    Compress   Decompress\n");
+	printf("----------------------  ------  -----------  -----------\n");
+
+	// each hunk's compressed data lives at its hunk offset; a length equal to
+	// the hunk size means it was incompressible and is stored raw
+	dynamic_buffer compressed(source.count());
+	dynamic_buffer decompressed(source.count());
+	dynamic_array<UINT32> complen(hunks);
+	chd_file dummy;
+	for (int codecnum = 0; codecnum < codec_count; codecnum++)
+	{
+		chd_codec_type type = codec_list[codecnum];
+		tempstr.reset().cat((type >> 24) & 0xff).cat((type >> 16) & 0xff).cat((type >> 8) & 0xff).cat(type & 0xff);
+		tempstr.cat(" (").cat(chd_codec_list::codec_name(type)).cat(")");
+		printf("%-22s  ", tempstr.cstr());
+		fflush(stdout);
+
+		// create the codecs; some have hunk size requirements of their own
+		chd_compressor *compressor = NULL;
+		chd_decompressor *decompressor = NULL;
+		try
+		{
+			compressor = chd_codec_list::new_compressor(type, dummy, hunk_size);
+			decompressor = chd_codec_list::new_decompressor(type, dummy, hunk_size);
+		}
+		catch (chd_error &)
+		{
+			delete compressor;
+			printf("not supported with this hunk size\n");
+			continue;
+		}
+
+		// compress every hunk
+		UINT64 total = 0;
+		osd_ticks_t starttime = osd_ticks();
+		for (UINT32 hunknum = 0; hunknum < hunks; hunknum++)
+		{
+			UINT64 offset = UINT64(hunknum) * hunk_size;
+			try
+			{
+				complen[hunknum] = compressor->compress(&source[offset], hunk_size, &compressed[offset]);
+			}
+			catch (chd_error &)
+			{
+				complen[hunknum] = hunk_size;
+			}
+			total += complen[hunknum];
+		}
+		osd_ticks_t comptime = osd_ticks() - starttime;
+
+		// decompress every hunk
+		bool ok = true;
+		starttime = osd_ticks();
+		for (UINT32 hunknum = 0; hunknum < hunks && ok; hunknum++)
+		{
+			UINT64 offset = UINT64(hunknum) * hunk_size;
+			if (complen[hunknum] == hunk_size)
+				memcpy(&decompressed[offset], &source[offset], hunk_size);
+			else
+			{
+				try
+				{
+					decompressor->decompress(&compressed[offset], complen[hunknum], &decompressed[offset], hunk_size);
+				}
+				catch (chd_error &)
+				{
+					ok = false;
+				}
+			}
+		}
+		osd_ticks_t decomptime = osd_ticks() - starttime;
+		delete compressor;
+		delete decompressor;
+
+		// verify and report
+		if (!ok || memcmp(source, decompressed, source.count()) != 0)
+		{
+			printf("FAILED to round-trip\n");
+			continue;
+		}
+		double megabytes = double(source.count()) / (1024.0 * 1024.0);
+		double ticks_per_second = double(osd_ticks_per_second());
+		printf("%5.1f%%  %6.1f MB/s  %6.1f MB/s\n", 100.0 * double(total) / double(source.count()),
+				megabytes * ticks_per_second / double(MAX(comptime, 1)),
+				megabytes * ticks_per_second / double(MAX(decomptime, 1)));
+	}
+
+	// time each hashing backend this CPU supports over the same data
+	printf("\n");
+	printf("Hash    Backend      Speed\n");
+	printf("------  ----------  ----------\n");
+	for (int algnum = 0; algnum < 2; algnum++)
+	{
+		hashing_backend::algorithm alg = hashing_backend::algorithm(algnum);
+		int original = hashing_backend::current(alg);
+		astring reference;
+		for (int backend = 0; backend < hashing_backend::count(alg); backend++)
+		{
+			hashing_backend::select(alg, backend);
+			printf("%-6s  %-10s  ", (alg == hashing_backend::ALGORITHM_CRC32) ? "CRC-32" : "SHA-1", hashing_backend::name(alg, backend));
+			fflush(stdout);
+
+			// repeat until enough time has passed to give a stable figure
+			UINT64 hashed = 0;
+			osd_ticks_t starttime = osd_ticks();
+			osd_ticks_t elapsed;
+			astring digest;
+			do
+			{
+				if (alg == hashing_backend::ALGORITHM_CRC32)
+					crc32_creator::simple(source, source.count()).as_string(digest);
+				else
+					sha1_creator::simple(source, source.count()).as_string(digest);
+				hashed += source.count();
+				elapsed = osd_ticks() - starttime;
+			} while (elapsed < osd_ticks_per_second() / 4);
+
+			// every backend must agree with the portable one
+			if (backend == 0)
+				reference = digest;
+			if (digest != reference)
+				printf("FAILED to match %s\n", hashing_backend::name(alg, 0));
+			else
+				printf("%5.2f GB/s\n", double(hashed) / (1024.0 * 1024.0 * 1024.0) * double(osd_ticks_per_second()) / double(elapsed));
+		}
+		hashing_backend::select(alg, original);
+	}
+}
+
+
 //-------------------------------------------------
 //  main - entry point
 //-------------------------------------------------
@@ -0,0 +1,117 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    dlpoly.c
+
+    poly.c renderer for the display list replay tool.
+
+****************************************************************************
+
+    The devices render through polynew.h; this keeps the original
+    poly.c manager around as the baseline that dlreplay measures
+    them against. It lives in its own file because poly.h and
+    polynew.h both define poly_manager.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "video/voodoo.h"
+#include "video/poly.h"
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+// the device's object data, opaque to us, held as poly.c extra data
+struct replay_polydata
+{
+	union
+	{
+		UINT8                   bytes[VOODOO_REPLAY_OBJECT_SIZE];
+		UINT64                  align64;
+		void *                  alignptr;
+	} object;
+	voodoo_replay_span_func span;
+};
+
+
+// ======================> poly_replay_renderer
+
+// replays through poly.c with the same limits the device used to have
+class poly_replay_renderer : public voodoo_replay_renderer
+{
+public:
+	poly_replay_renderer()
+		: m_poly(poly_alloc(64, sizeof(replay_polydata), 0)),
+			m_last(NULL) { }
+	virtual ~poly_replay_renderer() { poly_free(m_poly); }
+
+	virtual void *object_alloc()
+	{
+		m_last = (replay_polydata *)poly_get_extra_data(m_poly);
+		return m_last->object.bytes;
+	}
+
+	virtual UINT32 render_triangle(const rectangle &cliprect, voodoo_replay_span_func span, const float *x, const float *y)
+	{
+		poly_vertex vert[3];
+		for (int vnum = 0; vnum < 3; vnum++)
+		{
+			vert[vnum].x = x[vnum];
+			vert[vnum].y = y[vnum];
+		}
+		m_last->span = span;
+		return poly_render_triangle(m_poly, NULL, cliprect, render_span, 0, &vert[0], &vert[1], &vert[2]);
+	}
+
+	virtual UINT32 render_block(const rectangle &cliprect, voodoo_replay_span_func span, INT32 startx, INT32 stopx, INT32 starty, INT32 stopy)
+	{
+		// in blocks of scanlines, just like the device's fastfill
+		poly_extent extents[64];
+		UINT32 pixels = 0;
+
+		for (int extnum = 0; extnum < ARRAY_LENGTH(extents); extnum++)
+		{
+			extents[extnum].startx = startx;
+			extents[extnum].stopx = stopx;
+		}
+		m_last->span = span;
+		for (int y = starty; y < stopy; y += ARRAY_LENGTH(extents))
+		{
+			int count = MIN(stopy - y, ARRAY_LENGTH(extents));
+			pixels += poly_render_triangle_custom(m_poly, NULL, cliprect, render_span, y, count, extents);
+		}
+		return pixels;
+	}
+
+	virtual void wait(const char *debug_reason) { poly_wait(m_poly, debug_reason); }
+
+private:
+	static void render_span(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid)
+	{
+		const replay_polydata *data = (const replay_polydata *)extradata;
+		(*data->span)(data->object.bytes, scanline, extent->startx, extent->stopx, threadid);
+	}
+
+	poly_manager *          m_poly;
+	replay_polydata *       m_last;
+};
+
+
+
+/***************************************************************************
+    INTERFACE
+***************************************************************************/
+
+/*-------------------------------------------------
+    poly_replay_renderer_alloc - create a replay
+    renderer that goes through poly.c
+-------------------------------------------------*/
+
+voodoo_replay_renderer *poly_replay_renderer_alloc()
+{
+	return global_alloc(poly_replay_renderer);
+}
@@ -0,0 +1,205 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    dlreplay.c
+
+    Replay display list captures through the 3D hardware rasterizers
+    and report throughput.
+
+****************************************************************************
+
+    Captures are written by the devices themselves when built with
+    capturing enabled (see CAPTURE_FRAMES in voodoo.c). The replay
+    itself lives with the device and renders through the device's
+    own polygon manager and rasterizers, on the work queue, with no
+    machine around it, so rasterizer changes can be measured in
+    isolation. The checksum covers video memory at the end of every
+    frame; it only depends on the capture and the rasterizer output,
+    so it can be compared across builds to catch rendering changes.
+
+    The device's polygon manager can sort the work into scanline
+    buckets (the default) or bin it into screen tiles, and the same
+    capture can also be replayed through the old poly.c manager as a
+    baseline, to compare them on identical work: every renderer is
+    timed the same way, from the first record of a frame until
+    everything queued for it has been drawn, and must produce the
+    same checksum. With -nodraw the rasterizers are skipped, which
+    leaves the cost of triangle setup and of handing the work to
+    the threads.
+
+    Without access to a real capture, -writetest writes a synthetic
+    one that mixes fastfills with textured, depth tested and alpha
+    blended triangles of all sizes, in an order the output depends
+    on; src/regtests/dlreplay replays it through every renderer and
+    checks that the checksums agree.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "drivenum.h"
+#include "video/voodoo.h"
+#include "dlcapture.h"
+#include <zlib.h>
+
+
+
+// the poly.c baseline, in dlpoly.c
+voodoo_replay_renderer *poly_replay_renderer_alloc();
+
+
+
+/***************************************************************************
+    DRIVER LIST
+***************************************************************************/
+
+// the core still refers to the driver list; the replay runs no drivers,
+// so only the empty one is linked instead of the generated list
+const game_driver * const driver_list::s_drivers_sorted[1] = { &GAME_NAME(___empty) };
+int driver_list::s_driver_count = 1;
+
+
+
+/***************************************************************************
+    MAIN
+***************************************************************************/
+
+/*-------------------------------------------------
+    usage - print usage
+-------------------------------------------------*/
+
+static int usage(const char *argv0)
+{
+	fprintf(stderr, "Usage: \n");
+	fprintf(stderr, "  %s <capture.dlc> [-passes <n>] [-renderer poly|buckets|tiles] [-nodraw] [-verbose]\n", argv0);
+	fprintf(stderr, "  %s -writetest <capture.dlc>\n", argv0);
+	return 1;
+}
+
+
+/*-------------------------------------------------
+    main - main entry point
+-------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+	display_list_reader reader;
+	const char *filename = NULL;
+	const char *rendername = "buckets";
+	bool verbose = false;
+	UINT32 flags = 0;
+	int passes = 3;
+	int result = 0;
+
+	// parse the command line
+	for (int arg = 1; arg < argc; arg++)
+	{
+		if (strcmp(argv[arg], "-passes") == 0 && arg + 1 < argc)
+		{
+			passes = atoi(argv[++arg]);
+			if (passes < 1)
+				passes = 1;
+		}
+		else if (strcmp(argv[arg], "-renderer") == 0 && arg + 1 < argc)
+			rendername = argv[++arg];
+		else if (strcmp(argv[arg], "-writetest") == 0 && arg + 1 < argc && argc == 3)
+		{
+			// a synthetic capture, for comparing renderers without a real one
+			const char *testname = argv[++arg];
+			if (voodoo_replay_write_test(testname, 10) != FILERR_NONE)
+			{
+				fprintf(stderr, "Error: unable to create capture file '%s'\n", testname);
+				return 1;
+			}
+			return 0;
+		}
+		else if (strcmp(argv[arg], "-nodraw") == 0)
+			flags |= VOODOO_REPLAY_NO_DRAW;
+		else if (strcmp(argv[arg], "-verbose") == 0)
+			verbose = true;
+		else if (argv[arg][0] != '-' && filename == NULL)
+			filename = argv[arg];
+		else
+			return usage(argv[0]);
+	}
+	if (filename == NULL)
+		return usage(argv[0]);
+
+	if (strcmp(rendername, "poly") != 0 && strcmp(rendername, "buckets") != 0 && strcmp(rendername, "tiles") != 0)
+		return usage(argv[0]);
+	if (strcmp(rendername, "tiles") == 0)
+		flags |= VOODOO_REPLAY_TILES;
+
+	// load the capture
+	if (reader.open(filename) != FILERR_NONE)
+	{
+		fprintf(stderr, "Error: unable to read capture file '%s'\n", filename);
+		return 1;
+	}
+	if (strcmp(reader.device(), "voodoo") != 0)
+	{
+		fprintf(stderr, "Error: unsupported capture device '%s'\n", reader.device());
+		return 1;
+	}
+
+	voodoo_state *v = voodoo_replay_alloc(reader, flags);
+	if (v == NULL)
+	{
+		fprintf(stderr, "Error: capture file '%s' is version %d or has no valid setup record\n", filename, reader.version());
+		return 1;
+	}
+
+	// buckets and tiles are the device's own polygon manager and need no renderer
+	voodoo_replay_renderer *renderer = NULL;
+	if (strcmp(rendername, "poly") == 0)
+		renderer = poly_replay_renderer_alloc();
+
+	// replay it the requested number of times; the first pass warms the caches
+	UINT32 checksum = 0;
+	for (int pass = 0; pass < passes && result == 0; pass++)
+	{
+		UINT32 frames = 0, triangles = 0, fills = 0, passsum = 0;
+		UINT64 pixels = 0;
+		osd_ticks_t ticks = 0;
+		voodoo_replay_stats stats;
+		int status;
+
+		reader.rewind();
+		while ((status = voodoo_replay_frame(v, reader, stats, renderer)) > 0)
+		{
+			if (verbose && pass == 0)
+				printf("Frame %5d: %08X, %d triangles, %d fills\n", frames, stats.crc, stats.triangles, stats.fills);
+			passsum = crc32(passsum, (const Bytef *)&stats.crc, sizeof(stats.crc));
+			triangles += stats.triangles;
+			fills += stats.fills;
+			pixels += stats.pixels;
+			ticks += stats.ticks;
+			frames++;
+		}
+		if (status < 0)
+		{
+			fprintf(stderr, "Error: capture file '%s' is corrupt\n", filename);
+			result = 1;
+			break;
+		}
+
+		double seconds = (double)ticks / (double)osd_ticks_per_second();
+		printf("Pass %d (%s%s): %d frames, %d triangles, %d fills, %.1f Mpix in %.3f sec = %.2f fps, %.1f Mpix/s\n",
+				pass + 1, rendername, (flags & VOODOO_REPLAY_NO_DRAW) ? ", no drawing" : "", frames, triangles, fills, (double)pixels / 1e6,
+				seconds, (seconds > 0) ? frames / seconds : 0.0, (seconds > 0) ? (double)pixels / 1e6 / seconds : 0.0);
+
+		// every pass replays from the same snapshot, so the output must match
+		if (pass == 0)
+			checksum = passsum;
+		else if (passsum != checksum)
+		{
+			fprintf(stderr, "Error: pass %d checksum %08X does not match %08X\n", pass + 1, passsum, checksum);
+			result = 1;
+		}
+	}
+	printf("Checksum: %08X\n", checksum);
+
+	voodoo_replay_free(v);
+	global_free(renderer);
+	return result;
+}
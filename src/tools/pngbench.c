@@ -0,0 +1,305 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    pngbench.c
+
+    PNG writer benchmark over typical emulator framebuffers.
+
+****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "osdcore.h"
+#include "png.h"
+
+#include <new>
+
+/***************************************************************************
+    CONSTANTS & DEFINES
+***************************************************************************/
+
+#define TEMP_FILENAME           "pngbench.tmp"
+#define MIN_ITERATIONS          3
+#define MIN_SECONDS             0.5
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+struct bench_image
+{
+	const char *    name;
+	bitmap_rgb32    bitmap;
+};
+
+/***************************************************************************
+    PROTOTYPES
+***************************************************************************/
+
+static void make_tilemap(bitmap_rgb32 &bitmap);
+static void make_vector(bitmap_rgb32 &bitmap);
+static void make_shaded(bitmap_rgb32 &bitmap);
+static void make_noise(bitmap_rgb32 &bitmap);
+static int benchmark_image(const char *name, bitmap_rgb32 &bitmap, osd_work_queue *queue);
+
+/***************************************************************************
+    MAIN
+***************************************************************************/
+
+/*-------------------------------------------------
+    main - main entry point
+-------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+	osd_work_queue *queue;
+	bench_image image[4];
+	int error = 0;
+	int imagenum;
+	int argnum;
+
+	if (argc > 1 && argv[1][0] == '-')
+	{
+		fprintf(stderr, "Usage:\npngbench [<image.png> ...]\n\nWithout arguments, synthetic framebuffers are used.\n");
+		return 10;
+	}
+
+	queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	printf("%-24s %-9s %-9s %10s %10s\n", "image", "level", "threads", "bytes", "ms/image");
+
+	/* benchmark any images we were given */
+	for (argnum = 1; argnum < argc; argnum++)
+	{
+		bitmap_argb32 source;
+		bitmap_rgb32 bitmap;
+		core_file *file;
+		int x, y;
+
+		if (core_fopen(argv[argnum], OPEN_FLAG_READ, &file) != FILERR_NONE || png_read_bitmap(file, source) != PNGERR_NONE)
+		{
+			if (file != NULL)
+				core_fclose(file);
+			fprintf(stderr, "Could not read %s\n", argv[argnum]);
+			error = 1;
+			continue;
+		}
+		core_fclose(file);
+
+		bitmap.allocate(source.width(), source.height());
+		for (y = 0; y < source.height(); y++)
+			for (x = 0; x < source.width(); x++)
+				bitmap.pix32(y, x) = source.pix32(y, x) & 0xffffff;
+		error |= benchmark_image(argv[argnum], bitmap, queue);
+	}
+
+	/* otherwise use the synthetic set */
+	if (argc == 1)
+	{
+		image[0].name = "tilemap 320x240";
+		image[0].bitmap.allocate(320, 240);
+		make_tilemap(image[0].bitmap);
+		image[1].name = "vector 640x480";
+		image[1].bitmap.allocate(640, 480);
+		make_vector(image[1].bitmap);
+		image[2].name = "shaded 640x480";
+		image[2].bitmap.allocate(640, 480);
+		make_shaded(image[2].bitmap);
+		image[3].name = "noise 320x240";
+		image[3].bitmap.allocate(320, 240);
+		make_noise(image[3].bitmap);
+
+		for (imagenum = 0; imagenum < ARRAY_LENGTH(image); imagenum++)
+			error |= benchmark_image(image[imagenum].name, image[imagenum].bitmap, queue);
+	}
+
+	if (queue != NULL)
+		osd_work_queue_free(queue);
+	osd_rmfile(TEMP_FILENAME);
+	return error;
+}
+
+/***************************************************************************
+    SYNTHETIC FRAMEBUFFERS
+***************************************************************************/
+
+/*-------------------------------------------------
+    make_tilemap - 8x8 tiles from a small set and
+    a 16-colour palette, with a few sprites on
+    top, like a typical 2D raster game
+-------------------------------------------------*/
+
+static void make_tilemap(bitmap_rgb32 &bitmap)
+{
+	static const UINT32 palette[16] =
+	{
+		0x000000, 0x1d2b53, 0x7e2553, 0x008751, 0xab5236, 0x5f574f, 0xc2c3c7, 0xfff1e8,
+		0xff004d, 0xffa300, 0xffec27, 0x00e436, 0x29adff, 0x83769c, 0xff77a8, 0xffccaa
+	};
+	UINT8 tiles[16][8][8];
+	int tile, sprite, x, y;
+
+	srand(1);
+	for (tile = 0; tile < 16; tile++)
+		for (y = 0; y < 8; y++)
+			for (x = 0; x < 8; x++)
+				tiles[tile][y][x] = (tile < 4) ? tile : rand() % 16;
+
+	/* background from a repeating map, mostly plain tiles */
+	for (y = 0; y < bitmap.height(); y++)
+		for (x = 0; x < bitmap.width(); x++)
+		{
+			int tx = x / 8, ty = y / 8;
+			int map = ((tx * 7 + ty * 13) % 23 < 18) ? (ty % 4) : 4 + (tx + ty) % 12;
+			bitmap.pix32(y, x) = palette[tiles[map][y % 8][x % 8]];
+		}
+
+	/* 16x16 sprites */
+	for (sprite = 0; sprite < 24; sprite++)
+	{
+		int sx = rand() % (bitmap.width() - 16), sy = rand() % (bitmap.height() - 16);
+		for (y = 0; y < 16; y++)
+			for (x = 0; x < 16; x++)
+				if ((x - 8) * (x - 8) + (y - 8) * (y - 8) < 56)
+					bitmap.pix32(sy + y, sx + x) = palette[(sprite + x / 4) % 16];
+	}
+}
+
+
+/*-------------------------------------------------
+    make_vector - mostly black with thin bright
+    lines, like a vector game
+-------------------------------------------------*/
+
+static void make_vector(bitmap_rgb32 &bitmap)
+{
+	int line, step;
+
+	bitmap.fill(0);
+	srand(2);
+	for (line = 0; line < 60; line++)
+	{
+		int x0 = rand() % bitmap.width(), y0 = rand() % bitmap.height();
+		int x1 = rand() % bitmap.width(), y1 = rand() % bitmap.height();
+		int steps = MAX(abs(x1 - x0), abs(y1 - y0)) + 1;
+		UINT32 color = ((rand() % 2) ? 0xffffff : 0x40ff40) & ~(rand() % 0x3f3f3f);
+		for (step = 0; step < steps; step++)
+			bitmap.pix32(y0 + (y1 - y0) * step / steps, x0 + (x1 - x0) * step / steps) = color;
+	}
+}
+
+
+/*-------------------------------------------------
+    make_shaded - smooth gradients with a little
+    dither, like a 3D game
+-------------------------------------------------*/
+
+static void make_shaded(bitmap_rgb32 &bitmap)
+{
+	int x, y;
+
+	srand(3);
+	for (y = 0; y < bitmap.height(); y++)
+		for (x = 0; x < bitmap.width(); x++)
+		{
+			int r = (x * 255 / bitmap.width() + rand() % 4) & 0xff;
+			int g = (y * 255 / bitmap.height() + rand() % 4) & 0xff;
+			int b = ((x + y) * 127 / bitmap.width()) & 0xff;
+			bitmap.pix32(y, x) = (r << 16) | (g << 8) | b;
+		}
+}
+
+
+/*-------------------------------------------------
+    make_noise - random pixels, the worst case
+-------------------------------------------------*/
+
+static void make_noise(bitmap_rgb32 &bitmap)
+{
+	int x, y;
+
+	srand(4);
+	for (y = 0; y < bitmap.height(); y++)
+		for (x = 0; x < bitmap.width(); x++)
+			bitmap.pix32(y, x) = ((rand() & 0xff) << 16) | ((rand() & 0xff) << 8) | (rand() & 0xff);
+}
+
+/***************************************************************************
+    BENCHMARK
+***************************************************************************/
+
+/*-------------------------------------------------
+    benchmark_image - time writing an image at
+    a few levels, with and without the work
+    queue, and check that it reads back intact
+-------------------------------------------------*/
+
+static int benchmark_image(const char *name, bitmap_rgb32 &bitmap, osd_work_queue *queue)
+{
+	static const int levels[] = { PNG_LEVEL_FASTEST, PNG_LEVEL_DEFAULT, PNG_LEVEL_SMALLEST };
+	int levelnum, threaded;
+
+	for (levelnum = 0; levelnum < ARRAY_LENGTH(levels); levelnum++)
+		for (threaded = 0; threaded < ((queue != NULL) ? 2 : 1); threaded++)
+		{
+			osd_ticks_t start = osd_ticks(), elapsed;
+			UINT64 size = 0;
+			int iterations;
+
+			/* write it until we have a stable time */
+			for (iterations = 0; iterations < MIN_ITERATIONS || (elapsed = osd_ticks() - start) < MIN_SECONDS * osd_ticks_per_second(); iterations++)
+			{
+				png_info pnginfo = { 0 };
+				core_file *file;
+				png_error pngerr;
+
+				if (core_fopen(TEMP_FILENAME, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE, &file) != FILERR_NONE)
+				{
+					fprintf(stderr, "Could not create %s\n", TEMP_FILENAME);
+					return 1;
+				}
+				pnginfo.level = levels[levelnum];
+				pnginfo.workqueue = threaded ? queue : NULL;
+				pngerr = png_write_bitmap(file, &pnginfo, bitmap, 0, NULL);
+				size = core_fsize(file);
+				core_fclose(file);
+				png_free(&pnginfo);
+				if (pngerr != PNGERR_NONE)
+				{
+					fprintf(stderr, "Could not write %s (%d)\n", name, pngerr);
+					return 1;
+				}
+			}
+			elapsed = osd_ticks() - start;
+
+			/* make sure the last one decodes to what we wrote */
+			{
+				bitmap_argb32 readback;
+				core_file *file;
+				int x, y;
+
+				if (core_fopen(TEMP_FILENAME, OPEN_FLAG_READ, &file) != FILERR_NONE || png_read_bitmap(file, readback) != PNGERR_NONE)
+				{
+					if (file != NULL)
+						core_fclose(file);
+					fprintf(stderr, "Could not read back %s\n", name);
+					return 1;
+				}
+				core_fclose(file);
+				for (y = 0; y < bitmap.height(); y++)
+					for (x = 0; x < bitmap.width(); x++)
+						if ((readback.pix32(y, x) & 0xffffff) != (bitmap.pix32(y, x) & 0xffffff))
+						{
+							fprintf(stderr, "%s: mismatch at %d,%d\n", name, x, y);
+							return 1;
+						}
+			}
+
+			printf("%-24s %-9s %-9s %10d %10.2f\n", name,
+					(levels[levelnum] == PNG_LEVEL_FASTEST) ? "fastest" : (levels[levelnum] == PNG_LEVEL_SMALLEST) ? "smallest" : "default",
+					threaded ? "queue" : "single", (int)size,
+					(double)elapsed * 1000.0 / (double)osd_ticks_per_second() / (double)iterations);
+		}
+	return 0;
+}
@@ -62,6 +62,7 @@ TOOLS += \
 	src2html$(EXE) \
 	split$(EXE) \
 	pngcmp$(EXE) \
+	pngbench$(EXE) \
 	nltool$(EXE) \
 
 
@@ -119,6 +120,23 @@ unidasm$(EXE): $(UNIDASMOBJS) $(LIBDASM) $(LIBEMU) $(LIBUTIL) $(LIBOCORE) $(ZLIB
 
 
 
+#-------------------------------------------------
+# dlreplay - not part of TOOLS, since it needs
+# the emulator core; build it with 'make dlreplay'
+#-------------------------------------------------
+
+DLREPLAYOBJS = \
+	$(TOOLSOBJ)/dlreplay.o \
+	$(TOOLSOBJ)/dlpoly.o \
+	$(VIDEOOBJ)/voodoo.o \
+	$(VIDEOOBJ)/poly.o \
+
+dlreplay$(EXE): $(DLREPLAYOBJS) $(VERSIONOBJ) $(EMUINFOOBJ) $(LIBEMU) $(LIBUTIL) $(EXPAT) $(SOFTFLOAT) $(JPEG_LIB) $(FLAC_LIB) $(7Z_LIB) $(FORMATS_LIB) $(LUA_LIB) $(WEB_LIB) $(ZLIB) $(LIBOCORE)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+
+
 #-------------------------------------------------
 # ldresample
 #-------------------------------------------------
@@ -208,6 +226,17 @@ pngcmp$(EXE): $(PNGCMPOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB)
 	@echo Linking $@...
 	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
 
+#-------------------------------------------------
+# pngbench
+#-------------------------------------------------
+
+PNGBENCHOBJS = \
+	$(TOOLSOBJ)/pngbench.o \
+
+pngbench$(EXE): $(PNGBENCHOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
 #-------------------------------------------------
 # nltool
 #-------------------------------------------------
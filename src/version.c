@@ -10,3 +10,7 @@
 
 extern const char build_version[];
 const char build_version[] = "0.152 ("__DATE__")";
+
+// identifies this particular build, for caches of data derived from the drivers
+extern const char build_id[];
+const char build_id[] = __DATE__ " " __TIME__;